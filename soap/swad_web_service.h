@@ -341,6 +341,14 @@ struct swad__getDirectoryTreeOutput
    char *tree;		// full tree in xml format
   };
 
+/* getDirectoryTreeIfChanged */
+struct swad__getDirectoryTreeIfChangedOutput
+  {
+   char *version;	// version of the tree, to be sent in next requests
+   int changed;		// 1 ==> tree has changed and is returned; 0 ==> tree has not changed
+   char *tree;		// full tree in xml format (empty if not changed)
+  };
+
 /* getFile */
 struct swad__getFileOutput
   {
@@ -403,6 +411,8 @@ int swad__sendMyGroups (char *wsKey,int courseCode,char *myGroups,
 /* File browsers */
 int swad__getDirectoryTree (char *wsKey,int courseCode,int groupCode,int treeCode,
                             struct swad__getDirectoryTreeOutput *getDirectoryTreeOut);
+int swad__getDirectoryTreeIfChanged (char *wsKey,int courseCode,int groupCode,int treeCode,char *version,
+                                     struct swad__getDirectoryTreeIfChangedOutput *getDirectoryTreeIfChangedOut);
 int swad__getFile (char *wsKey,int fileCode,
                    struct swad__getFileOutput *getFileOut);
 int swad__getMarks (char *wsKey,int fileCode,
@@ -193,7 +193,7 @@ CREATE TABLE IF NOT EXISTS connected (
 	LastTime DATETIME NOT NULL,
 	UNIQUE INDEX(UsrCod),
 	INDEX(RoleInLastCrs),
-	INDEX(LastCrsCod));
+	INDEX(LastCrsCod)) ENGINE = MEMORY;
 --
 -- Table countries: stores the countries
 --
@@ -445,6 +445,16 @@ CREATE TABLE IF NOT EXISTS expanded_folders (
 	INDEX(FileBrowser,Cod),
 	INDEX(WorksUsrCod));
 --
+-- Table figures: stores figures shown in statistics, computed periodically for each scope
+--
+CREATE TABLE IF NOT EXISTS figures (
+	Figure INT NOT NULL,
+	Scope ENUM('Sys','Cty','Ins','Ctr','Deg','Crs') NOT NULL DEFAULT 'Sys',
+	Cod INT NOT NULL DEFAULT -1,
+	Value INT NOT NULL,
+	LastUpdate DATETIME NOT NULL,
+	UNIQUE INDEX(Figure,Scope,Cod));
+--
 -- Table file_browser_last: stores the last click of every user in each file browser zone
 --
 CREATE TABLE IF NOT EXISTS file_browser_last (
@@ -475,6 +485,23 @@ CREATE TABLE IF NOT EXISTS file_view (
 	NumViews INT NOT NULL DEFAULT 0,
 	UNIQUE INDEX(FilCod,UsrCod),INDEX(UsrCod));
 --
+-- Table file_view_counters: stores the number of views of each file, updated periodically from file_view_pending
+--
+CREATE TABLE IF NOT EXISTS file_view_counters (
+	FilCod INT NOT NULL,
+	NumLoggedUsrs INT NOT NULL DEFAULT 0,
+	NumViewsFromLoggedUsrs INT NOT NULL DEFAULT 0,
+	NumPublicViews INT NOT NULL DEFAULT 0,
+	UNIQUE INDEX(FilCod));
+--
+-- Table file_view_pending: stores the views of files not yet added to file_view and file_view_counters
+--
+CREATE TABLE IF NOT EXISTS file_view_pending (
+	ViewCod INT NOT NULL AUTO_INCREMENT,
+	FilCod INT NOT NULL,
+	UsrCod INT NOT NULL,
+	UNIQUE INDEX(ViewCod));
+--
 -- Table files: stores metadata about each file
 --
 CREATE TABLE IF NOT EXISTS files (
@@ -493,6 +520,15 @@ CREATE TABLE IF NOT EXISTS files (
 	INDEX(ZoneUsrCod),
 	INDEX(PublisherUsrCod));
 --
+-- Table forum_counters: stores the number of threads and posts in each forum
+--
+CREATE TABLE IF NOT EXISTS forum_counters (
+	ForumType TINYINT NOT NULL,
+	Location INT NOT NULL DEFAULT -1,
+	NumThrs INT NOT NULL DEFAULT 0,
+	NumPsts INT NOT NULL DEFAULT 0,
+	UNIQUE INDEX(ForumType,Location));
+--
 -- Table forum_disabled_post: stores the forum post that have been disabled
 --
 CREATE TABLE IF NOT EXISTS forum_disabled_post (
@@ -521,6 +557,16 @@ CREATE TABLE IF NOT EXISTS forum_post (
 	INDEX(CreatTime),
 	INDEX(ModifTime));
 --
+-- Table forum_read: stores the last time each user read any thread in each forum
+--
+CREATE TABLE IF NOT EXISTS forum_read (
+	UsrCod INT NOT NULL,
+	ForumType TINYINT NOT NULL,
+	Location INT NOT NULL DEFAULT -1,
+	ReadTime DATETIME NOT NULL,
+	UNIQUE INDEX(UsrCod,ForumType,Location),
+	INDEX(ForumType,Location));
+--
 -- Table forum_thr_clip: stores the clipboards used to move threads from one forum to another
 --
 CREATE TABLE IF NOT EXISTS forum_thr_clip (
@@ -546,6 +592,9 @@ CREATE TABLE IF NOT EXISTS forum_thread (
 	Location INT NOT NULL DEFAULT -1,
 	FirstPstCod INT NOT NULL,
 	LastPstCod INT NOT NULL,
+	NumPsts INT NOT NULL DEFAULT 0,
+	NumWriters INT NOT NULL DEFAULT 0,
+	NumReaders INT NOT NULL DEFAULT 0,
 	UNIQUE INDEX(ThrCod),
 	INDEX(ForumType),
 	INDEX(Location),
@@ -638,6 +687,37 @@ CREATE TABLE IF NOT EXISTS log_full (
 	INDEX(UsrCod),
 	INDEX(ClickTime,Role));
 --
+-- Table log_prof: stores the time spent in each phase of a sample of clicks
+--
+CREATE TABLE IF NOT EXISTS log_prof (
+	LogCod INT NOT NULL,
+	ActCod INT NOT NULL,
+	ClickTime DATETIME NOT NULL,
+	TimeParams INT NOT NULL,
+	TimeSession INT NOT NULL,
+	TimePriori INT NOT NULL,
+	TimePosteriori INT NOT NULL,
+	TimePage INT NOT NULL,
+	TimeSend INT NOT NULL,
+	NumQueries INT NOT NULL,
+	TimeQueries INT NOT NULL,
+	UNIQUE INDEX(LogCod),
+	INDEX(ActCod),
+	INDEX(ClickTime));
+--
+-- Table log_prof_queries: stores the slowest database queries of the clicks in log_prof
+--
+CREATE TABLE IF NOT EXISTS log_prof_queries (
+	LogCod INT NOT NULL,
+	ActCod INT NOT NULL,
+	QryInd TINYINT NOT NULL,
+	Site VARCHAR(255) NOT NULL,
+	Query TEXT NOT NULL,
+	NumRows INT NOT NULL,
+	Time INT NOT NULL,
+	UNIQUE INDEX(LogCod,QryInd),
+	INDEX(ActCod));
+--
 -- Table log_recent: stores the log of the most recent clicks, used to speed up queries related to log
 --
 CREATE TABLE IF NOT EXISTS log_recent (
@@ -690,8 +770,19 @@ CREATE TABLE IF NOT EXISTS marks_properties (
 	FilCod INT NOT NULL AUTO_INCREMENT,
 	Header INT NOT NULL,
 	Footer INT NOT NULL,
+	HeaderEnd INT NOT NULL DEFAULT -1,
+	FooterStart INT NOT NULL DEFAULT -1,
 	UNIQUE INDEX(FilCod));
 --
+-- Table marks_rows: stores the position of the row of each user's ID in files of marks
+--
+CREATE TABLE IF NOT EXISTS marks_rows (
+	FilCod INT NOT NULL,
+	UsrID CHAR(16) NOT NULL,
+	RowStart INT NOT NULL,
+	RowEnd INT NOT NULL,
+	UNIQUE INDEX(FilCod,UsrID));
+--
 -- Table msg_banned: stores the users whose messages are banned (FromUsrCod is a recipien banned from ToUsrCod)
 --
 CREATE TABLE IF NOT EXISTS msg_banned (
@@ -820,6 +911,14 @@ CREATE TABLE IF NOT EXISTS notif (
 	INDEX(ToUsrCod),
 	INDEX(TimeNotif));
 --
+-- Table notif_unseen: stores the number of unseen and new notifications of each user
+--
+CREATE TABLE IF NOT EXISTS notif_unseen (
+	UsrCod INT NOT NULL,
+	NumUnseen INT NOT NULL DEFAULT 0,
+	NumNew INT NOT NULL DEFAULT 0,
+	UNIQUE INDEX(UsrCod));
+--
 -- Table pending_emails: stores the emails pending of confirmation
 --
 CREATE TABLE IF NOT EXISTS pending_emails (
@@ -1011,6 +1110,15 @@ CREATE TABLE IF NOT EXISTS svy_answers (
 	Answer TEXT NOT NULL,
 	UNIQUE INDEX(QstCod,AnsInd));
 --
+-- Table svy_answers_counters: stores the number of users who have marked each answer, split in several counters
+--
+CREATE TABLE IF NOT EXISTS svy_answers_counters (
+	QstCod INT NOT NULL,
+	AnsInd TINYINT NOT NULL,
+	Shard TINYINT NOT NULL,
+	NumUsrs INT NOT NULL DEFAULT 0,
+	UNIQUE INDEX(QstCod,AnsInd,Shard));
+--
 -- Table svy_grp: stores the groups associated to each survey
 --
 CREATE TABLE IF NOT EXISTS svy_grp (
@@ -1255,6 +1363,17 @@ CREATE TABLE IF NOT EXISTS usr_follow (
 	UNIQUE INDEX (FollowedCod,FollowerCod),
 	INDEX (FollowTime));
 --
+-- Table usr_follow_suggested: stores a pool of users to follow, computed periodically for each user
+--
+CREATE TABLE IF NOT EXISTS usr_follow_suggested (
+	UsrCod INT NOT NULL,
+	SuggestedCod INT NOT NULL,
+	Score INT NOT NULL DEFAULT 0,
+	CreatTime DATETIME NOT NULL,
+	UNIQUE INDEX (UsrCod,SuggestedCod),
+	INDEX (SuggestedCod),
+	INDEX (CreatTime));
+--
 -- Table usr_IDs: stores the users' IDs
 --
 CREATE TABLE IF NOT EXISTS usr_IDs (
@@ -1338,86 +1338,85 @@ Profile:
 
        1151. ActAutUsrInt		Authentify user internally (directly from the platform)
        1152. ActAutUsrNew		Authentify user internally (directly from the platform, only if user has not password)
-       1153. ActAutUsrChgLan		Change language to my language just after authentication
-       1154. ActAnnSee			Mark announcement as seen
-       1155. ActChgMyRol		Change type of logged user
-
-       1156. ActChkUsrAcc		Check if already exists a new account without password associated to a ID
-       1157. ActCreUsrAcc		Create new user account
-       1158. ActRemID_Me		Remove one of my user's IDs
-       1159. ActNewIDMe			Create a new user's ID for me
-       1160. ActRemOldNic		Remove one of my old nicknames
-       1161. ActChgNic			Change my nickname
-       1162. ActRemMaiMe		Remove one of my old e-mails
-       1163. ActNewMaiMe		Change my e-mail address
-       1164. ActCnfMai			Confirm e-mail address
-       1165. ActFrmChgMyPwd		Show form to the change of the password
-       1166. ActChgPwd			Change the password
-       1167. ActReqRemMyAcc		Request the removal of my account
-       1168. ActRemMyAcc		Remove my account
-
-       1169. ActChgMyData		Update my personal data
-
-       1170. ActReqMyPho		Show form to send my photo
-       1171. ActDetMyPho		Receive my photo and detect faces on it
-       1172. ActUpdMyPho		Update my photo
-       1173. ActReqRemMyPho		Request the removal of my photo
-       1174. ActRemMyPho		Remove my photo
-
-       1175. ActEdiPri			Edit my privacy
-       1176. ActChgPriPho		Change privacy of my photo
-       1177. ActChgPriPrf		Change privacy of my public profile
-
-       1178. ActReqEdiMyIns		Request the edition of my institution, centre and department
-       1179. ActChgCtyMyIns		Change the country of my institution
-       1180. ActChgMyIns		Change my institution
-       1181. ActChgMyCtr		Change my centre
-       1182. ActChgMyDpt		Change my department
-       1183. ActChgMyOff		Change my office
-       1184. ActChgMyOffPho		Change my office phone
-
-       1185. ActReqEdiMyNet		Request the edition of my social networks
-       1186. ActChgMyNet		Change my web and social networks
-
-       1187. ActChgThe			Change theme
-       1188. ActReqChgLan		Ask if change language
-       1189. ActChgLan			Change language
-       1190. ActChg1stDay		Change first day of the week
-       1191. ActChgCol			Change side columns
-       1192. ActHidLftCol		Hide left side column
-       1193. ActHidRgtCol		Hide right side column
-       1194. ActShoLftCol		Show left side column
-       1195. ActShoRgtCol		Show right side column
-       1196. ActChgIco			Change icon set
-       1197. ActChgMnu			Change menu
-       1198. ActChgNtfPrf		Change whether to notify by e-mail new messages
-       1199. ActPrnUsrQR		Show my QR code ready to print
-
-       1200. ActPrnMyTT			Show the timetable listo to impresin of all my courses
-       1201. ActEdiTut			Edit the timetable of tutoras
-       1202. ActChgTut			Modify the timetable of tutoras
-       1203. ActChgMyTT1stDay		Change first day of week and show timetable of the course
-
-       1204. ActReqRemFilBrf		Request removal of a file of the briefcase
-       1205. ActRemFilBrf		Remove a file of the briefcase
-       1206. ActRemFolBrf		Remove a folder empty of the briefcase
-       1207. ActCopBrf			Set source of copy in the briefcase
-       1208. ActPasBrf			Paste a folder or file in the briefcase
-       1209. ActRemTreBrf		Remove a folder no empty of the briefcase
-       1210. ActFrmCreBrf		Form to crear a folder or file in the briefcase
-       1211. ActCreFolBrf		Create a new folder in the briefcase
-       1212. ActCreLnkBrf		Create a new link in the briefcase
-       1213. ActRenFolBrf		Rename a folder of the briefcase
-       1214. ActRcvFilBrfDZ		Receive a file in the briefcase using Dropzone.js
-       1215. ActRcvFilBrfCla		Receive a file in the briefcase using the classic way
-       1216. ActExpBrf			Expand a folder in briefcase
-       1217. ActConBrf			Contract a folder in briefcase
-       1218. ActZIPBrf			Compress a folder in briefcase
-       1219. ActReqDatBrf		Ask for metadata of a file in the briefcase
-       1220. ActChgDatBrf		Change metadata of a file in the briefcase
-       1221. ActDowBrf			Download a file in the briefcase
-       1222. ActReqRemOldBrf		Ask for removing old files in the briefcase
-       1223. ActRemOldBrf		Remove old files in the briefcase
+       1153. ActAnnSee			Mark announcement as seen
+       1154. ActChgMyRol		Change type of logged user
+
+       1155. ActChkUsrAcc		Check if already exists a new account without password associated to a ID
+       1156. ActCreUsrAcc		Create new user account
+       1157. ActRemID_Me		Remove one of my user's IDs
+       1158. ActNewIDMe			Create a new user's ID for me
+       1159. ActRemOldNic		Remove one of my old nicknames
+       1160. ActChgNic			Change my nickname
+       1161. ActRemMaiMe		Remove one of my old e-mails
+       1162. ActNewMaiMe		Change my e-mail address
+       1163. ActCnfMai			Confirm e-mail address
+       1164. ActFrmChgMyPwd		Show form to the change of the password
+       1165. ActChgPwd			Change the password
+       1166. ActReqRemMyAcc		Request the removal of my account
+       1167. ActRemMyAcc		Remove my account
+
+       1168. ActChgMyData		Update my personal data
+
+       1169. ActReqMyPho		Show form to send my photo
+       1170. ActDetMyPho		Receive my photo and detect faces on it
+       1171. ActUpdMyPho		Update my photo
+       1172. ActReqRemMyPho		Request the removal of my photo
+       1173. ActRemMyPho		Remove my photo
+
+       1174. ActEdiPri			Edit my privacy
+       1175. ActChgPriPho		Change privacy of my photo
+       1176. ActChgPriPrf		Change privacy of my public profile
+
+       1177. ActReqEdiMyIns		Request the edition of my institution, centre and department
+       1178. ActChgCtyMyIns		Change the country of my institution
+       1179. ActChgMyIns		Change my institution
+       1180. ActChgMyCtr		Change my centre
+       1181. ActChgMyDpt		Change my department
+       1182. ActChgMyOff		Change my office
+       1183. ActChgMyOffPho		Change my office phone
+
+       1184. ActReqEdiMyNet		Request the edition of my social networks
+       1185. ActChgMyNet		Change my web and social networks
+
+       1186. ActChgThe			Change theme
+       1187. ActReqChgLan		Ask if change language
+       1188. ActChgLan			Change language
+       1189. ActChg1stDay		Change first day of the week
+       1190. ActChgCol			Change side columns
+       1191. ActHidLftCol		Hide left side column
+       1192. ActHidRgtCol		Hide right side column
+       1193. ActShoLftCol		Show left side column
+       1194. ActShoRgtCol		Show right side column
+       1195. ActChgIco			Change icon set
+       1196. ActChgMnu			Change menu
+       1197. ActChgNtfPrf		Change whether to notify by e-mail new messages
+       1198. ActPrnUsrQR		Show my QR code ready to print
+
+       1199. ActPrnMyTT			Show the timetable listo to impresin of all my courses
+       1200. ActEdiTut			Edit the timetable of tutoras
+       1201. ActChgTut			Modify the timetable of tutoras
+       1202. ActChgMyTT1stDay		Change first day of week and show timetable of the course
+
+       1203. ActReqRemFilBrf		Request removal of a file of the briefcase
+       1204. ActRemFilBrf		Remove a file of the briefcase
+       1205. ActRemFolBrf		Remove a folder empty of the briefcase
+       1206. ActCopBrf			Set source of copy in the briefcase
+       1207. ActPasBrf			Paste a folder or file in the briefcase
+       1208. ActRemTreBrf		Remove a folder no empty of the briefcase
+       1209. ActFrmCreBrf		Form to crear a folder or file in the briefcase
+       1210. ActCreFolBrf		Create a new folder in the briefcase
+       1211. ActCreLnkBrf		Create a new link in the briefcase
+       1212. ActRenFolBrf		Rename a folder of the briefcase
+       1213. ActRcvFilBrfDZ		Receive a file in the briefcase using Dropzone.js
+       1214. ActRcvFilBrfCla		Receive a file in the briefcase using the classic way
+       1215. ActExpBrf			Expand a folder in briefcase
+       1216. ActConBrf			Contract a folder in briefcase
+       1217. ActZIPBrf			Compress a folder in briefcase
+       1218. ActReqDatBrf		Ask for metadata of a file in the briefcase
+       1219. ActChgDatBrf		Change metadata of a file in the briefcase
+       1220. ActDowBrf			Download a file in the briefcase
+       1221. ActReqRemOldBrf		Ask for removing old files in the briefcase
+       1222. ActRemOldBrf		Remove old files in the briefcase
 */
 
 struct Act_Actions Act_Actions[Act_NUM_ACTIONS] =
@@ -2751,7 +2750,7 @@ struct Act_Actions Act_Actions[Act_NUM_ACTIONS] =
 
    /* ActSeeUseGbl	*/{  84,-1,TabUnk,ActReqUseGbl		,0x1FF,0x1FF,0x1FF,Act_CONT_NORM,Act_THIS_WINDOW,NULL				,Sta_ShowFigures		,NULL},
    /* ActPrnPhoDeg	*/{ 448,-1,TabUnk,ActSeePhoDeg		,0x1FF,0x1FF,0x1FF,Act_CONT_NORM,Act_BLNK_WINDOW,NULL				,Pho_PrintPhotoDegree  		,NULL},
-   /* ActCalPhoDeg	*/{ 444,-1,TabUnk,ActSeePhoDeg		,0x1FF,0x1FF,0x1FF,Act_CONT_NORM,Act_THIS_WINDOW,NULL				,Pho_CalcPhotoDegree		,NULL},
+   /* ActCalPhoDeg	*/{ 444,-1,TabUnk,ActSeePhoDeg		,0x100,0x100,0x100,Act_CONT_NORM,Act_THIS_WINDOW,NULL				,Pho_CalcPhotoDegree		,NULL},
    /* ActSeeAccGbl	*/{  79,-1,TabUnk,ActReqAccGbl		,0x1FE,0x1FE,0x1FE,Act_CONT_NORM,Act_THIS_WINDOW,NULL				,Sta_SeeGblAccesses		,NULL},
    /* ActReqAccCrs	*/{ 594,-1,TabUnk,ActReqAccGbl		,0x110,0x100,0x000,Act_CONT_NORM,Act_THIS_WINDOW,Sta_SetIniEndDates		,Sta_AskShowCrsHits		,NULL},
    /* ActSeeAccCrs	*/{ 119,-1,TabUnk,ActReqAccGbl		,0x110,0x100,0x000,Act_CONT_NORM,Act_THIS_WINDOW,NULL				,Sta_SeeCrsAccesses		,NULL},
@@ -2778,7 +2777,6 @@ struct Act_Actions Act_Actions[Act_NUM_ACTIONS] =
 
    /* ActAutUsrInt	*/{   6,-1,TabUnk,ActFrmRolSes		,0x1FF,0x1FF,0x1FF,Act_CONT_NORM,Act_THIS_WINDOW,NULL				,Usr_WelcomeUsr			,NULL},
    /* ActAutUsrNew	*/{1585,-1,TabUnk,ActFrmRolSes		,0x1FF,0x1FF,0x1FF,Act_CONT_NORM,Act_THIS_WINDOW,NULL				,Usr_WelcomeUsr			,NULL},
-   /* ActAutUsrChgLan	*/{1077,-1,TabUnk,ActFrmRolSes		,0x1FE,0x1FE,0x1FE,Act_CONT_NORM,Act_THIS_WINDOW,NULL				,Usr_WelcomeUsr			,NULL},
    /* ActAnnSee		*/{1234,-1,TabUnk,ActFrmRolSes		,0x1FE,0x1FE,0x1FE,Act_CONT_NORM,Act_THIS_WINDOW,NULL				,Ann_MarkAnnouncementAsSeen	,NULL},
    /* ActChgMyRol	*/{ 589,-1,TabUnk,ActFrmRolSes		,0x1FE,0x1FE,0x1FE,Act_CONT_NORM,Act_THIS_WINDOW,Rol_ChangeMyRole		,Usr_ShowFormsLogoutAndRole	,NULL},
 
@@ -3945,7 +3943,7 @@ Act_Action_t Act_FromActCodToAction[1+Act_MAX_ACTION_COD] =	// Do not reuse uniq
 	ActSeeLstStdAtt,	// #1074
 	ActPrnLstStdAtt,	// #1075
 	ActRecAttMe,		// #1076
-	ActAutUsrChgLan,	// #1077
+	-1,			// #1077 (obsolete action)
 	ActSeeDocCrs,		// #1078
 	ActSeeMrkCrs,		// #1079
 	ActReqSeeUsrTstExa,	// #1080
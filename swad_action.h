@@ -55,7 +55,7 @@ typedef enum
 
 typedef int Act_Action_t;	// Must be a signed type, because -1 is used to indicate obsolete action
 
-#define Act_NUM_ACTIONS	(1+9+51+14+93+73+70+249+186+155+172+36+31+85)
+#define Act_NUM_ACTIONS	(1+9+51+14+93+73+70+249+186+155+172+36+31+84)
 
 #define Act_MAX_ACTION_COD 1601
 
@@ -1377,87 +1377,86 @@ typedef int Act_Action_t;	// Must be a signed type, because -1 is used to indica
 #define ActLogOut		(ActSeeMyUsgRep+12)
 #define ActAutUsrInt		(ActSeeMyUsgRep+13)
 #define ActAutUsrNew		(ActSeeMyUsgRep+14)
-#define ActAutUsrChgLan		(ActSeeMyUsgRep+15)
-#define ActAnnSee		(ActSeeMyUsgRep+16)
-#define ActChgMyRol		(ActSeeMyUsgRep+17)
-#define ActChkUsrAcc		(ActSeeMyUsgRep+18)
-#define ActCreUsrAcc		(ActSeeMyUsgRep+19)
-#define ActRemID_Me		(ActSeeMyUsgRep+20)
-#define ActNewIDMe		(ActSeeMyUsgRep+21)
-#define ActRemOldNic		(ActSeeMyUsgRep+22)
-#define ActChgNic		(ActSeeMyUsgRep+23)
-#define ActRemMaiMe		(ActSeeMyUsgRep+24)
-#define ActNewMaiMe		(ActSeeMyUsgRep+25)
-#define ActCnfMai		(ActSeeMyUsgRep+26)
-#define ActFrmChgMyPwd		(ActSeeMyUsgRep+27)
-#define ActChgPwd		(ActSeeMyUsgRep+28)
-#define ActReqRemMyAcc		(ActSeeMyUsgRep+29)
-#define ActRemMyAcc		(ActSeeMyUsgRep+30)
-
-#define ActChgMyData		(ActSeeMyUsgRep+31)
-
-#define ActReqMyPho		(ActSeeMyUsgRep+32)
-#define ActDetMyPho		(ActSeeMyUsgRep+33)
-#define ActUpdMyPho		(ActSeeMyUsgRep+34)
-#define ActReqRemMyPho		(ActSeeMyUsgRep+35)
-#define ActRemMyPho		(ActSeeMyUsgRep+36)
-
-#define ActEdiPri		(ActSeeMyUsgRep+37)
-#define ActChgPriPho		(ActSeeMyUsgRep+38)
-#define ActChgPriPrf		(ActSeeMyUsgRep+39)
-
-#define ActReqEdiMyIns		(ActSeeMyUsgRep+40)
-#define ActChgCtyMyIns		(ActSeeMyUsgRep+41)
-#define ActChgMyIns		(ActSeeMyUsgRep+42)
-#define ActChgMyCtr		(ActSeeMyUsgRep+43)
-#define ActChgMyDpt		(ActSeeMyUsgRep+44)
-#define ActChgMyOff		(ActSeeMyUsgRep+45)
-#define ActChgMyOffPho		(ActSeeMyUsgRep+46)
-
-#define ActReqEdiMyNet		(ActSeeMyUsgRep+47)
-#define ActChgMyNet		(ActSeeMyUsgRep+48)
-
-#define ActChgThe		(ActSeeMyUsgRep+49)
-#define ActReqChgLan		(ActSeeMyUsgRep+50)
-#define ActChgLan		(ActSeeMyUsgRep+51)
-#define ActChg1stDay		(ActSeeMyUsgRep+52)
-#define ActChgCol		(ActSeeMyUsgRep+53)
-#define ActHidLftCol		(ActSeeMyUsgRep+54)
-#define ActHidRgtCol		(ActSeeMyUsgRep+55)
-#define ActShoLftCol		(ActSeeMyUsgRep+56)
-#define ActShoRgtCol		(ActSeeMyUsgRep+57)
-#define ActChgIco		(ActSeeMyUsgRep+58)
-#define ActChgMnu		(ActSeeMyUsgRep+59)
-#define ActChgNtfPrf		(ActSeeMyUsgRep+60)
-
-#define ActPrnUsrQR		(ActSeeMyUsgRep+61)
-
-#define ActPrnMyTT		(ActSeeMyUsgRep+62)
-#define ActEdiTut		(ActSeeMyUsgRep+63)
-#define ActChgTut		(ActSeeMyUsgRep+64)
-#define ActChgMyTT1stDay	(ActSeeMyUsgRep+65)
-
-#define ActReqRemFilBrf		(ActSeeMyUsgRep+66)
-#define ActRemFilBrf		(ActSeeMyUsgRep+67)
-#define ActRemFolBrf		(ActSeeMyUsgRep+68)
-#define ActCopBrf		(ActSeeMyUsgRep+69)
-#define ActPasBrf		(ActSeeMyUsgRep+70)
-#define ActRemTreBrf		(ActSeeMyUsgRep+71)
-#define ActFrmCreBrf		(ActSeeMyUsgRep+72)
-#define ActCreFolBrf		(ActSeeMyUsgRep+73)
-#define ActCreLnkBrf		(ActSeeMyUsgRep+74)
-#define ActRenFolBrf		(ActSeeMyUsgRep+75)
-#define ActRcvFilBrfDZ		(ActSeeMyUsgRep+76)
-#define ActRcvFilBrfCla		(ActSeeMyUsgRep+77)
-#define ActExpBrf		(ActSeeMyUsgRep+78)
-#define ActConBrf		(ActSeeMyUsgRep+79)
-#define ActZIPBrf		(ActSeeMyUsgRep+80)
-#define ActReqDatBrf		(ActSeeMyUsgRep+81)
-#define ActChgDatBrf		(ActSeeMyUsgRep+82)
-#define ActDowBrf		(ActSeeMyUsgRep+83)
-
-#define ActReqRemOldBrf		(ActSeeMyUsgRep+84)
-#define ActRemOldBrf		(ActSeeMyUsgRep+85)
+#define ActAnnSee		(ActSeeMyUsgRep+15)
+#define ActChgMyRol		(ActSeeMyUsgRep+16)
+#define ActChkUsrAcc		(ActSeeMyUsgRep+17)
+#define ActCreUsrAcc		(ActSeeMyUsgRep+18)
+#define ActRemID_Me		(ActSeeMyUsgRep+19)
+#define ActNewIDMe		(ActSeeMyUsgRep+20)
+#define ActRemOldNic		(ActSeeMyUsgRep+21)
+#define ActChgNic		(ActSeeMyUsgRep+22)
+#define ActRemMaiMe		(ActSeeMyUsgRep+23)
+#define ActNewMaiMe		(ActSeeMyUsgRep+24)
+#define ActCnfMai		(ActSeeMyUsgRep+25)
+#define ActFrmChgMyPwd		(ActSeeMyUsgRep+26)
+#define ActChgPwd		(ActSeeMyUsgRep+27)
+#define ActReqRemMyAcc		(ActSeeMyUsgRep+28)
+#define ActRemMyAcc		(ActSeeMyUsgRep+29)
+
+#define ActChgMyData		(ActSeeMyUsgRep+30)
+
+#define ActReqMyPho		(ActSeeMyUsgRep+31)
+#define ActDetMyPho		(ActSeeMyUsgRep+32)
+#define ActUpdMyPho		(ActSeeMyUsgRep+33)
+#define ActReqRemMyPho		(ActSeeMyUsgRep+34)
+#define ActRemMyPho		(ActSeeMyUsgRep+35)
+
+#define ActEdiPri		(ActSeeMyUsgRep+36)
+#define ActChgPriPho		(ActSeeMyUsgRep+37)
+#define ActChgPriPrf		(ActSeeMyUsgRep+38)
+
+#define ActReqEdiMyIns		(ActSeeMyUsgRep+39)
+#define ActChgCtyMyIns		(ActSeeMyUsgRep+40)
+#define ActChgMyIns		(ActSeeMyUsgRep+41)
+#define ActChgMyCtr		(ActSeeMyUsgRep+42)
+#define ActChgMyDpt		(ActSeeMyUsgRep+43)
+#define ActChgMyOff		(ActSeeMyUsgRep+44)
+#define ActChgMyOffPho		(ActSeeMyUsgRep+45)
+
+#define ActReqEdiMyNet		(ActSeeMyUsgRep+46)
+#define ActChgMyNet		(ActSeeMyUsgRep+47)
+
+#define ActChgThe		(ActSeeMyUsgRep+48)
+#define ActReqChgLan		(ActSeeMyUsgRep+49)
+#define ActChgLan		(ActSeeMyUsgRep+50)
+#define ActChg1stDay		(ActSeeMyUsgRep+51)
+#define ActChgCol		(ActSeeMyUsgRep+52)
+#define ActHidLftCol		(ActSeeMyUsgRep+53)
+#define ActHidRgtCol		(ActSeeMyUsgRep+54)
+#define ActShoLftCol		(ActSeeMyUsgRep+55)
+#define ActShoRgtCol		(ActSeeMyUsgRep+56)
+#define ActChgIco		(ActSeeMyUsgRep+57)
+#define ActChgMnu		(ActSeeMyUsgRep+58)
+#define ActChgNtfPrf		(ActSeeMyUsgRep+59)
+
+#define ActPrnUsrQR		(ActSeeMyUsgRep+60)
+
+#define ActPrnMyTT		(ActSeeMyUsgRep+61)
+#define ActEdiTut		(ActSeeMyUsgRep+62)
+#define ActChgTut		(ActSeeMyUsgRep+63)
+#define ActChgMyTT1stDay	(ActSeeMyUsgRep+64)
+
+#define ActReqRemFilBrf		(ActSeeMyUsgRep+65)
+#define ActRemFilBrf		(ActSeeMyUsgRep+66)
+#define ActRemFolBrf		(ActSeeMyUsgRep+67)
+#define ActCopBrf		(ActSeeMyUsgRep+68)
+#define ActPasBrf		(ActSeeMyUsgRep+69)
+#define ActRemTreBrf		(ActSeeMyUsgRep+70)
+#define ActFrmCreBrf		(ActSeeMyUsgRep+71)
+#define ActCreFolBrf		(ActSeeMyUsgRep+72)
+#define ActCreLnkBrf		(ActSeeMyUsgRep+73)
+#define ActRenFolBrf		(ActSeeMyUsgRep+74)
+#define ActRcvFilBrfDZ		(ActSeeMyUsgRep+75)
+#define ActRcvFilBrfCla		(ActSeeMyUsgRep+76)
+#define ActExpBrf		(ActSeeMyUsgRep+77)
+#define ActConBrf		(ActSeeMyUsgRep+78)
+#define ActZIPBrf		(ActSeeMyUsgRep+79)
+#define ActReqDatBrf		(ActSeeMyUsgRep+80)
+#define ActChgDatBrf		(ActSeeMyUsgRep+81)
+#define ActDowBrf		(ActSeeMyUsgRep+82)
+
+#define ActReqRemOldBrf		(ActSeeMyUsgRep+83)
+#define ActRemOldBrf		(ActSeeMyUsgRep+84)
 
 /*****************************************************************************/
 /******************************** Public types *******************************/
@@ -33,6 +33,7 @@
 
 #include "swad_attendance.h"
 #include "swad_database.h"
+#include "swad_figure_cache.h"
 #include "swad_global.h"
 #include "swad_group.h"
 #include "swad_ID.h"
@@ -62,6 +63,25 @@ typedef enum
    Att_PRINT_VIEW,
   } Att_TypeOfView_t;
 
+struct Att_UsrIndex
+  {
+   long UsrCod;
+   unsigned NumUsr;
+  };
+
+// Attendance of a list of users to a list of attendance events,
+// got from database with a single query
+struct Att_UsrsInAttEvents
+  {
+   unsigned NumUsrs;
+   unsigned NumAttEvents;
+   struct Att_UsrIndex *UsrIndex;	// Users' codes sorted, to find the row of each user
+   unsigned char *Present;		// Bitset with NumUsrs * NumAttEvents bits
+   size_t *OffsetComments;		// Two offsets (student's and teacher's comment) for each user and event
+   char *Comments;			// All the comments, ended by '\0'. Offset 0 is an empty comment
+   size_t SizeComments;
+  };
+
 /*****************************************************************************/
 /****************************** Private variables ****************************/
 /*****************************************************************************/
@@ -99,16 +119,32 @@ static void Att_RemoveAttEventFromCurrentCrs (long AttCod);
 
 static void Att_ListAttOnlyMeAsStudent (struct AttendanceEvent *Att);
 static void Att_ListAttStudents (struct AttendanceEvent *Att);
-static void Att_WriteRowStdToCallTheRoll (unsigned NumStd,struct UsrData *UsrDat,struct AttendanceEvent *Att);
+static void Att_WriteRowStdToCallTheRoll (unsigned NumStd,struct UsrData *UsrDat,struct AttendanceEvent *Att,
+                                          const struct Att_UsrsInAttEvents *UsrsInAtt);
 static void Att_PutParamsCodGrps (long AttCod);
 static void Att_GetNumStdsTotalWhoAreInAttEvent (struct AttendanceEvent *Att);
 static unsigned Att_GetNumStdsFromAListWhoAreInAttEvent (long AttCod,long LstSelectedUsrCods[],unsigned NumStdsInList);
-static bool Att_CheckIfUsrIsInTableAttUsr (long AttCod,long UsrCod,bool *Present);
-static bool Att_CheckIfUsrIsPresentInAttEvent (long AttCod,long UsrCod);
 static bool Att_CheckIfUsrIsPresentInAttEventAndGetComments (long AttCod,long UsrCod,char *CommentStd,char *CommentTch);
+static void Att_GetUsrsInAttEvents (struct Att_UsrsInAttEvents *UsrsInAtt,
+                                    unsigned NumUsrs,const long *LstUsrCods,
+                                    unsigned NumAttEvents,const long *LstAttCods,
+                                    bool GetComments);
+static void Att_GetUsrsInSelectedAttEvents (struct Att_UsrsInAttEvents *UsrsInAtt,
+                                            unsigned NumUsrs,const long *LstUsrCods,
+                                            bool GetComments);
+static int Att_CompareUsrIndexes (const void *p1,const void *p2);
+static void Att_AddCommentToUsrsInAttEvents (struct Att_UsrsInAttEvents *UsrsInAtt,
+                                             size_t *OffsetComment,const char *Comment);
+static void Att_FreeUsrsInAttEvents (struct Att_UsrsInAttEvents *UsrsInAtt);
+static bool Att_CheckIfUsrIsPresentInUsrsInAttEvents (const struct Att_UsrsInAttEvents *UsrsInAtt,
+                                                      unsigned NumUsr,unsigned NumAttEvent);
+static void Att_GetCommentsFromUsrsInAttEvents (const struct Att_UsrsInAttEvents *UsrsInAtt,
+                                                unsigned NumUsr,unsigned NumAttEvent,
+                                                char *CommentStd,char *CommentTch);
 static void Att_RegUsrInAttEventChangingComments (long AttCod,long UsrCod,bool Present,
                                                   const char *CommentStd,const char *CommentTch);
 static void Att_RemoveUsrFromAttEvent (long AttCod,long UsrCod);
+static void Att_AddStrToQuery (char **Query,size_t *Length,size_t *Size,const char *Str);
 
 static void Usr_ListOrPrintMyAttendanceCrs (Att_TypeOfView_t TypeOfView);
 static void Usr_ListOrPrintStdsAttendanceCrs (Att_TypeOfView_t TypeOfView);
@@ -122,14 +158,19 @@ static void Att_PutIconToPrintStdsList (void);
 static void Att_PutParamsToPrintStdsList (void);
 
 static void Att_PutButtonToShowDetails (void);
+static void Att_GetDataOfAllAttEvents (void);
 static void Att_ListEventsToSelect (Att_TypeOfView_t TypeOfView);
 static void Att_ListStdsAttendanceTable (Att_TypeOfView_t TypeOfView,
                                          unsigned NumStdsInList,
-                                         long *LstSelectedUsrCods);
+                                         long *LstSelectedUsrCods,
+                                         const struct Att_UsrsInAttEvents *UsrsInAtt);
 static void Att_WriteTableHeadSeveralAttEvents (void);
-static void Att_WriteRowStdSeveralAttEvents (unsigned NumStd,struct UsrData *UsrDat);
-static void Att_ListStdsWithAttEventsDetails (unsigned NumStdsInList,long *LstSelectedUsrCods);
-static void Att_ListAttEventsForAStd (unsigned NumStd,struct UsrData *UsrDat);
+static void Att_WriteRowStdSeveralAttEvents (unsigned NumStd,struct UsrData *UsrDat,
+                                             const struct Att_UsrsInAttEvents *UsrsInAtt);
+static void Att_ListStdsWithAttEventsDetails (unsigned NumStdsInList,long *LstSelectedUsrCods,
+                                              const struct Att_UsrsInAttEvents *UsrsInAtt);
+static void Att_ListAttEventsForAStd (unsigned NumStd,struct UsrData *UsrDat,
+                                      const struct Att_UsrsInAttEvents *UsrsInAtt);
 
 /*****************************************************************************/
 /********************** List all the attendance events ***********************/
@@ -1666,8 +1707,14 @@ unsigned Att_GetNumCoursesWithAttEvents (Sco_Scope_t Scope)
    char Query[1024];
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
+   long Cod;
    unsigned NumCourses;
 
+   /***** Get number of courses with attendance events from cache *****/
+   Cod = Sco_GetCodOfScope (Scope);
+   if (FigCch_GetFigureFromCache (FigCch_NUM_CRSS_WITH_ATT_EVENTS,Scope,Cod,&NumCourses))
+      return NumCourses;
+
    /***** Get number of courses with attendance events from database *****/
    switch (Scope)
      {
@@ -1723,6 +1770,9 @@ unsigned Att_GetNumCoursesWithAttEvents (Sco_Scope_t Scope)
    /***** Free structure that stores the query result *****/
    DB_FreeMySQLResult (&mysql_res);
 
+   /***** Update number of courses in cache *****/
+   FigCch_UpdateFigureIntoCache (FigCch_NUM_CRSS_WITH_ATT_EVENTS,Scope,Cod,NumCourses);
+
    return NumCourses;
   }
 
@@ -1737,8 +1787,15 @@ unsigned Att_GetNumAttEvents (Sco_Scope_t Scope,unsigned *NumNotif)
    char Query[1024];
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
+   long Cod;
    unsigned NumAttEvents;
 
+   /***** Get number of attendance events from cache *****/
+   Cod = Sco_GetCodOfScope (Scope);
+   if (FigCch_GetFigureFromCache (FigCch_NUM_ATT_EVENTS,Scope,Cod,&NumAttEvents) &&
+       FigCch_GetFigureFromCache (FigCch_NUM_ATT_EVENTS_NOTIF,Scope,Cod,NumNotif))
+      return NumAttEvents;
+
    /***** Get number of attendance events from database *****/
    switch (Scope)
      {
@@ -1800,6 +1857,10 @@ unsigned Att_GetNumAttEvents (Sco_Scope_t Scope,unsigned *NumNotif)
    /***** Free structure that stores the query result *****/
    DB_FreeMySQLResult (&mysql_res);
 
+   /***** Update numbers in cache *****/
+   FigCch_UpdateFigureIntoCache (FigCch_NUM_ATT_EVENTS,Scope,Cod,NumAttEvents);
+   FigCch_UpdateFigureIntoCache (FigCch_NUM_ATT_EVENTS_NOTIF,Scope,Cod,*NumNotif);
+
    return NumAttEvents;
   }
 
@@ -1854,10 +1915,17 @@ static void Att_ListAttOnlyMeAsStudent (struct AttendanceEvent *Att)
    extern const char *Txt_Teachers_comment;
    extern const char *Txt_ROLES_SINGUL_Abc[Rol_NUM_ROLES][Usr_NUM_SEXS];
    extern const char *Txt_Save;
+   struct Att_UsrsInAttEvents UsrsInAtt;
 
    /***** Get my preference about photos in users' list for current course *****/
    Usr_GetMyPrefAboutListWithPhotosFromDB ();
 
+   /***** Get my attendance to this event *****/
+   Att_GetUsrsInAttEvents (&UsrsInAtt,
+                           1,&Gbl.Usrs.Me.UsrDat.UsrCod,
+                           1,&Att->AttCod,
+                           true);
+
    /***** Start form *****/
    if (Att->Open)
      {
@@ -1889,11 +1957,14 @@ static void Att_ListAttOnlyMeAsStudent (struct AttendanceEvent *Att)
 	    Txt_Teachers_comment);
 
    /* List of students (only me) */
-   Att_WriteRowStdToCallTheRoll (1,&Gbl.Usrs.Me.UsrDat,Att);
+   Att_WriteRowStdToCallTheRoll (1,&Gbl.Usrs.Me.UsrDat,Att,&UsrsInAtt);
 
    /* Footer */
    Lay_EndRoundFrameTable ();
 
+   /***** Free my attendance to this event *****/
+   Att_FreeUsrsInAttEvents (&UsrsInAtt);
+
    if (Att->Open)
      {
       /***** Send button *****/
@@ -1916,6 +1987,8 @@ static void Att_ListAttStudents (struct AttendanceEvent *Att)
    extern const char *Txt_Save;
    unsigned NumStd;
    struct UsrData UsrDat;
+   long *LstUsrCods;
+   struct Att_UsrsInAttEvents UsrsInAtt;
 
    /***** Form to select groups *****/
    Grp_ShowFormToSelectSeveralGroups (ActSeeOneAtt);
@@ -1931,6 +2004,19 @@ static void Att_ListAttStudents (struct AttendanceEvent *Att)
       /***** Initialize structure with user's data *****/
       Usr_UsrDataConstructor (&UsrDat);
 
+      /***** Get attendance of all the students in list to this event *****/
+      if ((LstUsrCods = (long *) malloc (Gbl.Usrs.LstUsrs[Rol_STUDENT].NumUsrs * sizeof (long))) == NULL)
+         Lay_ShowErrorAndExit ("Not enough memory to store list of user codes.");
+      for (NumStd = 0;
+	   NumStd < Gbl.Usrs.LstUsrs[Rol_STUDENT].NumUsrs;
+	   NumStd++)
+	 LstUsrCods[NumStd] = Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst[NumStd].UsrCod;
+      Att_GetUsrsInAttEvents (&UsrsInAtt,
+                              Gbl.Usrs.LstUsrs[Rol_STUDENT].NumUsrs,LstUsrCods,
+                              1,&Att->AttCod,
+                              true);
+      free ((void *) LstUsrCods);
+
       /***** Start form *****/
       Act_FormStart (ActRecAttStd);
       Att_PutParamAttCod (Att->AttCod);
@@ -1970,7 +2056,7 @@ static void Att_ListAttStudents (struct AttendanceEvent *Att)
 	 /* Get list of user's IDs */
          ID_GetListIDsFromUsrCod (&UsrDat);
 
-         Att_WriteRowStdToCallTheRoll (NumStd + 1,&UsrDat,Att);
+         Att_WriteRowStdToCallTheRoll (NumStd + 1,&UsrDat,Att,&UsrsInAtt);
         }
 
       /* Send button and end frame */
@@ -1979,6 +2065,9 @@ static void Att_ListAttStudents (struct AttendanceEvent *Att)
       /***** End form *****/
       Act_FormEnd ();
 
+      /***** Free attendance of students to this event *****/
+      Att_FreeUsrsInAttEvents (&UsrsInAtt);
+
       /***** Free memory used for user's data *****/
       Usr_UsrDataDestructor (&UsrDat);
      }
@@ -1996,7 +2085,10 @@ static void Att_ListAttStudents (struct AttendanceEvent *Att)
 /************ Write a row of a table with the data of a student **************/
 /*****************************************************************************/
 
-static void Att_WriteRowStdToCallTheRoll (unsigned NumStd,struct UsrData *UsrDat,struct AttendanceEvent *Att)
+// NumStd is the number of the student in list, starting at 1
+
+static void Att_WriteRowStdToCallTheRoll (unsigned NumStd,struct UsrData *UsrDat,struct AttendanceEvent *Att,
+                                          const struct Att_UsrsInAttEvents *UsrsInAtt)
   {
    extern const char *Txt_Present;
    extern const char *Txt_Absent;
@@ -2007,7 +2099,8 @@ static void Att_WriteRowStdToCallTheRoll (unsigned NumStd,struct UsrData *UsrDat
    char CommentTch[Cns_MAX_BYTES_TEXT+1];
 
    /***** Check if this student is already registered in the current event *****/
-   Present = Att_CheckIfUsrIsPresentInAttEventAndGetComments (Att->AttCod,UsrDat->UsrCod,CommentStd,CommentTch);
+   Present = Att_CheckIfUsrIsPresentInUsrsInAttEvents (UsrsInAtt,NumStd - 1,0);
+   Att_GetCommentsFromUsrsInAttEvents (UsrsInAtt,NumStd - 1,0,CommentStd,CommentTch);
 
    /***** Icon to show if the user is already registered *****/
    fprintf (Gbl.F.Out,"<tr>"
@@ -2214,8 +2307,12 @@ void Att_RegisterMeAsStdInAttEvent (void)
    4. Loop over the list Gbl.Usrs.Select.Std,
       that holds the list of the students marked as present,
       marking the students in Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst as Remove=false
-   5. Delete from att_usr all the students marked as Remove=true
-   6. Replace (insert without duplicated) into att_usr all the students marked as Remove=false
+   5. Get from att_usr the current attendance of all the students in the list
+   6. Compare the current attendance with the form:
+      - students present or with comments, and changed,
+        are inserted or updated into att_usr with a single query
+      - students absent without comments, and previously present or with comments,
+        are deleted from att_usr with a single query
  */
 void Att_RegisterStudentsInAttEvent (void)
   {
@@ -2233,6 +2330,22 @@ void Att_RegisterStudentsInAttEvent (void)
    char CommentParamName[10+10+1];
    char CommentStd[Cns_MAX_BYTES_TEXT+1];
    char CommentTch[Cns_MAX_BYTES_TEXT+1];
+   char CommentTchNew[Cns_MAX_BYTES_TEXT+1];
+   long *LstUsrCods;
+   struct Att_UsrsInAttEvents UsrsInAtt;
+   bool WasPresent;
+   char *QueryIns;
+   size_t LengthQueryIns;
+   size_t SizeQueryIns;
+   unsigned NumStdsToIns = 0;
+   char *QueryUpd;
+   size_t LengthQueryUpd;
+   size_t SizeQueryUpd;
+   char *QueryDel;
+   size_t LengthQueryDel;
+   size_t SizeQueryDel;
+   unsigned NumStdsToDel = 0;
+   char SubQuery[256];
 
    /***** Get attendance event code *****/
    if ((Att.AttCod = Att_GetParamAttCod ()) == -1L)
@@ -2287,28 +2400,85 @@ void Att_RegisterStudentsInAttEvent (void)
       /* Free memory used by list of selected students' codes */
       Usr_FreeListsSelectedUsrsCods ();
 
-      // 5. Delete from att_usr all the students marked as Remove=true
-      // 6. Replace (insert without duplicated) into att_usr all the students marked as Remove=false
+      /***** 5. Get from att_usr the current attendance of all the students in the list *****/
+      if ((LstUsrCods = (long *) malloc (Gbl.Usrs.LstUsrs[Rol_STUDENT].NumUsrs * sizeof (long))) == NULL)
+         Lay_ShowErrorAndExit ("Not enough memory to store list of user codes.");
+      for (NumStd = 0;
+	   NumStd < Gbl.Usrs.LstUsrs[Rol_STUDENT].NumUsrs;
+	   NumStd++)
+	 LstUsrCods[NumStd] = Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst[NumStd].UsrCod;
+      Att_GetUsrsInAttEvents (&UsrsInAtt,
+                              Gbl.Usrs.LstUsrs[Rol_STUDENT].NumUsrs,LstUsrCods,
+                              1,&Att.AttCod,
+                              true);
+      free ((void *) LstUsrCods);
+
+      /***** 6. Compare the current attendance with the form *****/
+      /* Start queries */
+      QueryIns = QueryUpd = QueryDel = NULL;
+      LengthQueryIns = SizeQueryIns =
+      LengthQueryUpd = SizeQueryUpd =
+      LengthQueryDel = SizeQueryDel = 0;
+      sprintf (SubQuery,"INSERT INTO att_usr"
+	                " (AttCod,UsrCod,Present,CommentStd,CommentTch)"
+	                " VALUES ");
+      Att_AddStrToQuery (&QueryIns,&LengthQueryIns,&SizeQueryIns,SubQuery);
+      sprintf (SubQuery,"UPDATE att_usr SET Present='N',CommentTch=''"
+	                " WHERE AttCod='%ld' AND UsrCod IN (",
+	       Att.AttCod);
+      Att_AddStrToQuery (&QueryUpd,&LengthQueryUpd,&SizeQueryUpd,SubQuery);
+      sprintf (SubQuery,"DELETE FROM att_usr"
+	                " WHERE AttCod='%ld' AND UsrCod IN (",
+	       Att.AttCod);
+      Att_AddStrToQuery (&QueryDel,&LengthQueryDel,&SizeQueryDel,SubQuery);
+
       for (NumStd = 0, NumStdsAbsent = NumStdsPresent = 0;
 	   NumStd < Gbl.Usrs.LstUsrs[Rol_STUDENT].NumUsrs;
 	   NumStd++)
 	{
-	 /***** Get comments for this student *****/
-	 Att_CheckIfUsrIsPresentInAttEventAndGetComments (Att.AttCod,Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst[NumStd].UsrCod,CommentStd,CommentTch);
+	 /***** Get current attendance and comments for this student *****/
+	 WasPresent = Att_CheckIfUsrIsPresentInUsrsInAttEvents (&UsrsInAtt,NumStd,0);
+	 Att_GetCommentsFromUsrsInAttEvents (&UsrsInAtt,NumStd,0,CommentStd,CommentTch);
+
+	 /***** Get teacher's comment from form *****/
 	 sprintf (CommentParamName,"CommentTch%ld",Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst[NumStd].UsrCod);
-	 Par_GetParToHTML (CommentParamName,CommentTch,Cns_MAX_BYTES_TEXT);
+	 Par_GetParToHTML (CommentParamName,CommentTchNew,Cns_MAX_BYTES_TEXT);
 
 	 Present = !Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst[NumStd].Remove;
 
 	 if (Present ||
 	     CommentStd[0] ||
-	     CommentTch[0])
-	    /***** Register student *****/
-	    Att_RegUsrInAttEventChangingComments (Att.AttCod,Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst[NumStd].UsrCod,
-					          Present,CommentStd,CommentTch);
-	 else
+	     CommentTchNew[0])
+	   {
+	    /***** Register student if changed *****/
+	    if (Present != WasPresent ||
+		strcmp (CommentTchNew,CommentTch))
+	      {
+	       sprintf (SubQuery,"%s('%ld','%ld','%c','',",
+			NumStdsToIns ? "," :
+				       "",
+			Att.AttCod,
+			Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst[NumStd].UsrCod,
+			Present ? 'Y' :
+				  'N');
+	       Att_AddStrToQuery (&QueryIns,&LengthQueryIns,&SizeQueryIns,SubQuery);
+	       Att_AddStrToQuery (&QueryIns,&LengthQueryIns,&SizeQueryIns,"'");
+	       Att_AddStrToQuery (&QueryIns,&LengthQueryIns,&SizeQueryIns,CommentTchNew);
+	       Att_AddStrToQuery (&QueryIns,&LengthQueryIns,&SizeQueryIns,"')");
+	       NumStdsToIns++;
+	      }
+	   }
+	 else if (WasPresent ||
+		  CommentTch[0])
+	   {
 	    /***** Remove student *****/
-	    Att_RemoveUsrFromAttEvent (Att.AttCod,Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst[NumStd].UsrCod);
+	    sprintf (SubQuery,NumStdsToDel ? ",'%ld'" :
+					     "'%ld'",
+		     Gbl.Usrs.LstUsrs[Rol_STUDENT].Lst[NumStd].UsrCod);
+	    Att_AddStrToQuery (&QueryUpd,&LengthQueryUpd,&SizeQueryUpd,SubQuery);
+	    Att_AddStrToQuery (&QueryDel,&LengthQueryDel,&SizeQueryDel,SubQuery);
+	    NumStdsToDel++;
+	   }
 
 	 if (Present)
             NumStdsPresent++;
@@ -2316,6 +2486,36 @@ void Att_RegisterStudentsInAttEvent (void)
 	    NumStdsAbsent++;
 	}
 
+      /***** Free current attendance *****/
+      Att_FreeUsrsInAttEvents (&UsrsInAtt);
+
+      /***** Register students changed *****/
+      // Student's comment is not changed,
+      // in order to not overwrite a comment written by the student meanwhile
+      if (NumStdsToIns)
+	{
+	 Att_AddStrToQuery (&QueryIns,&LengthQueryIns,&SizeQueryIns,
+	                    " ON DUPLICATE KEY UPDATE"
+			    " Present=VALUES(Present),CommentTch=VALUES(CommentTch)");
+	 DB_QueryINSERT (QueryIns,"can not register students in an event");
+	}
+      free ((void *) QueryIns);
+
+      /***** Remove students absent without comments *****/
+      // A student may have written a comment meanwhile,
+      // so the students are first set as absent without teacher's comment,
+      // and then only those without student's comment are removed
+      if (NumStdsToDel)
+	{
+	 Att_AddStrToQuery (&QueryUpd,&LengthQueryUpd,&SizeQueryUpd,")");
+	 DB_QueryUPDATE (QueryUpd,"can not set students as absent in an event");
+	 Att_AddStrToQuery (&QueryDel,&LengthQueryDel,&SizeQueryDel,
+	                    ") AND CommentStd=''");
+	 DB_QueryDELETE (QueryDel,"can not remove students from an event");
+	}
+      free ((void *) QueryUpd);
+      free ((void *) QueryDel);
+
       /***** Free memory for students list *****/
       Usr_FreeUsrsList (Rol_STUDENT);
 
@@ -2397,122 +2597,404 @@ static unsigned Att_GetNumStdsFromAListWhoAreInAttEvent (long AttCod,long LstSel
 /***************** Check if a student attended to an event *******************/
 /*****************************************************************************/
 
-static bool Att_CheckIfUsrIsInTableAttUsr (long AttCod,long UsrCod,bool *Present)
+static bool Att_CheckIfUsrIsPresentInAttEventAndGetComments (long AttCod,long UsrCod,char *CommentStd,char *CommentTch)
   {
    char Query[256];
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
    unsigned NumRows;
-   bool InDBTable;
+   bool Present;
 
-   /***** Check if a student is registered in an event in database *****/
-   sprintf (Query,"SELECT Present FROM att_usr"
+   /***** Check if a students is registered in an event in database *****/
+   sprintf (Query,"SELECT Present,CommentStd,CommentTch FROM att_usr"
                   " WHERE AttCod='%ld' AND UsrCod='%ld'",
             AttCod,UsrCod);
    if ((NumRows = (unsigned) DB_QuerySELECT (Query,&mysql_res,"can not get if a student is already registered in an event")))
      {
-      InDBTable = true;
-
       /* Get row */
       row = mysql_fetch_row (mysql_res);
 
       /* Get if present (row[0]) */
-      *Present = (row[0][0] == 'Y');
+      Present = (row[0][0] == 'Y');
+
+      /* Get student's comment (row[1]) */
+      strncpy (CommentStd,row[1],Cns_MAX_BYTES_TEXT);
+      CommentStd[Cns_MAX_BYTES_TEXT] = '\0';
+
+      /* Get teacher's comment (row[2]) */
+      strncpy (CommentTch,row[2],Cns_MAX_BYTES_TEXT);
+      CommentTch[Cns_MAX_BYTES_TEXT] = '\0';
      }
    else	// User is not present
      {
-      InDBTable = false;
-      *Present = false;
+      Present = false;
+      CommentStd[0] =
+      CommentTch[0] = '\0';
      }
 
    /***** Free structure that stores the query result *****/
    DB_FreeMySQLResult (&mysql_res);
 
-   return InDBTable;
+   return Present;
   }
 
 /*****************************************************************************/
-/***************** Check if a student attended to an event *******************/
+/******** Get attendance of a list of users to a list of events **************/
 /*****************************************************************************/
+// Only one query is made for all the users and events,
+// instead of one query for each user and event.
+// Events with code <= 0 in list are not got from database (users are absent)
 
-static bool Att_CheckIfUsrIsPresentInAttEvent (long AttCod,long UsrCod)
+static void Att_GetUsrsInAttEvents (struct Att_UsrsInAttEvents *UsrsInAtt,
+                                    unsigned NumUsrs,const long *LstUsrCods,
+                                    unsigned NumAttEvents,const long *LstAttCods,
+                                    bool GetComments)
   {
-   bool Present;
+   char *Query;
+   char SubQuery[1+1+10+1];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned long NumRows;
+   unsigned long NumRow;
+   unsigned NumUsr;
+   unsigned NumAttEvent;
+   unsigned NumAttEventsInQuery = 0;
+   long AttCod;
+   struct Att_UsrIndex UsrIndexToFind;
+   struct Att_UsrIndex *UsrIndexFound;
+   size_t NumCell;
+
+   /***** Initialize structure *****/
+   UsrsInAtt->NumUsrs      = NumUsrs;
+   UsrsInAtt->NumAttEvents = NumAttEvents;
+   UsrsInAtt->UsrIndex       = NULL;
+   UsrsInAtt->Present        = NULL;
+   UsrsInAtt->OffsetComments = NULL;
+   UsrsInAtt->Comments       = NULL;
+   UsrsInAtt->SizeComments   = 0;
+   if (!NumUsrs || !NumAttEvents)
+      return;
+
+   /***** Allocate memory for the matrix of users and events *****/
+   if ((UsrsInAtt->UsrIndex = (struct Att_UsrIndex *) malloc (NumUsrs * sizeof (struct Att_UsrIndex))) == NULL ||
+       (UsrsInAtt->Present = (unsigned char *) calloc ((NumUsrs * NumAttEvents + 7) / 8,sizeof (unsigned char))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store attendance.");
+   if (GetComments)
+     {
+      if ((UsrsInAtt->OffsetComments = (size_t *) calloc ((size_t) NumUsrs * NumAttEvents * 2,sizeof (size_t))) == NULL ||
+          (UsrsInAtt->Comments = (char *) malloc (1)) == NULL)
+         Lay_ShowErrorAndExit ("Not enough memory to store attendance.");
+      UsrsInAtt->Comments[0] = '\0';	// Offset 0 is an empty comment
+      UsrsInAtt->SizeComments = 1;
+     }
 
-   Att_CheckIfUsrIsInTableAttUsr (AttCod,UsrCod,&Present);
+   /***** Sort users' codes in order to find users quickly *****/
+   for (NumUsr = 0;
+	NumUsr < NumUsrs;
+	NumUsr++)
+     {
+      UsrsInAtt->UsrIndex[NumUsr].UsrCod = LstUsrCods[NumUsr];
+      UsrsInAtt->UsrIndex[NumUsr].NumUsr = NumUsr;
+     }
+   qsort ((void *) UsrsInAtt->UsrIndex,(size_t) NumUsrs,sizeof (struct Att_UsrIndex),
+          Att_CompareUsrIndexes);
 
-   return Present;
+   /***** Allocate space for query *****/
+   if ((Query = (char *) malloc ((size_t) (256+(NumUsrs+NumAttEvents)*(1+1+10)))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory for query.");
+
+   /***** Build query *****/
+   sprintf (Query,"SELECT AttCod,UsrCod,Present%s FROM att_usr"
+	          " WHERE AttCod IN (",
+	    GetComments ? ",CommentStd,CommentTch" :
+		          "");
+   for (NumAttEvent = 0;
+	NumAttEvent < NumAttEvents;
+	NumAttEvent++)
+      if (LstAttCods[NumAttEvent] > 0)
+	{
+	 sprintf (SubQuery,
+		  NumAttEventsInQuery ? ",%ld" :
+			                "%ld",
+		  LstAttCods[NumAttEvent]);
+	 strcat (Query,SubQuery);
+	 NumAttEventsInQuery++;
+	}
+   strcat (Query,") AND UsrCod IN (");
+   for (NumUsr = 0;
+	NumUsr < NumUsrs;
+	NumUsr++)
+     {
+      sprintf (SubQuery,
+	       NumUsr ? ",%ld" :
+		        "%ld",
+	       LstUsrCods[NumUsr]);
+      strcat (Query,SubQuery);
+     }
+   strcat (Query,")");
+
+   /***** Get attendance of users to events from database *****/
+   if (NumAttEventsInQuery)
+     {
+      NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get attendance of users to events");
+      for (NumRow = 0;
+	   NumRow < NumRows;
+	   NumRow++)
+	{
+	 row = mysql_fetch_row (mysql_res);
+
+	 /* Get event (row[0]) */
+	 AttCod = Str_ConvertStrCodToLongCod (row[0]);
+	 for (NumAttEvent = 0;
+	      NumAttEvent < NumAttEvents;
+	      NumAttEvent++)
+	    if (LstAttCods[NumAttEvent] == AttCod)
+	       break;
+	 if (NumAttEvent == NumAttEvents)	// Event not found
+	    continue;
+
+	 /* Get user (row[1]) */
+	 UsrIndexToFind.UsrCod = Str_ConvertStrCodToLongCod (row[1]);
+	 if ((UsrIndexFound = bsearch ((const void *) &UsrIndexToFind,
+				       (const void *) UsrsInAtt->UsrIndex,(size_t) NumUsrs,sizeof (struct Att_UsrIndex),
+				       Att_CompareUsrIndexes)) == NULL)	// User not found
+	    continue;
+	 NumCell = (size_t) UsrIndexFound->NumUsr * NumAttEvents + NumAttEvent;
+
+	 /* Get if present (row[2]) */
+	 if (row[2][0] == 'Y')
+	    UsrsInAtt->Present[NumCell / 8] |= (unsigned char) (1 << (NumCell % 8));
+
+	 /* Get student's comment (row[3]) and teacher's comment (row[4]) */
+	 if (GetComments)
+	   {
+	    Att_AddCommentToUsrsInAttEvents (UsrsInAtt,&UsrsInAtt->OffsetComments[NumCell * 2    ],row[3]);
+	    Att_AddCommentToUsrsInAttEvents (UsrsInAtt,&UsrsInAtt->OffsetComments[NumCell * 2 + 1],row[4]);
+	   }
+	}
+
+      /***** Free structure that stores the query result *****/
+      DB_FreeMySQLResult (&mysql_res);
+     }
+
+   /***** Free query *****/
+   free ((void *) Query);
   }
 
 /*****************************************************************************/
-/***************** Check if a student attended to an event *******************/
+/********* Get attendance of a list of users to the events selected **********/
 /*****************************************************************************/
+// The events of the matrix are all the events in Gbl.AttEvents,
+// but attendance is got only for the events selected
 
-static bool Att_CheckIfUsrIsPresentInAttEventAndGetComments (long AttCod,long UsrCod,char *CommentStd,char *CommentTch)
+static void Att_GetUsrsInSelectedAttEvents (struct Att_UsrsInAttEvents *UsrsInAtt,
+                                            unsigned NumUsrs,const long *LstUsrCods,
+                                            bool GetComments)
   {
-   char Query[256];
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row;
-   unsigned NumRows;
-   bool Present;
+   long *LstAttCods;
+   unsigned NumAttEvent;
 
-   /***** Check if a students is registered in an event in database *****/
-   sprintf (Query,"SELECT Present,CommentStd,CommentTch FROM att_usr"
-                  " WHERE AttCod='%ld' AND UsrCod='%ld'",
-            AttCod,UsrCod);
-   if ((NumRows = (unsigned) DB_QuerySELECT (Query,&mysql_res,"can not get if a student is already registered in an event")))
+   if (Gbl.AttEvents.Num)
      {
-      /* Get row */
-      row = mysql_fetch_row (mysql_res);
+      if ((LstAttCods = (long *) malloc (Gbl.AttEvents.Num * sizeof (long))) == NULL)
+	 Lay_ShowErrorAndExit ("Not enough memory to store list of attendance events.");
+      for (NumAttEvent = 0;
+	   NumAttEvent < Gbl.AttEvents.Num;
+	   NumAttEvent++)
+	 LstAttCods[NumAttEvent] = Gbl.AttEvents.Lst[NumAttEvent].Selected ? Gbl.AttEvents.Lst[NumAttEvent].AttCod :
+									     -1L;
+      Att_GetUsrsInAttEvents (UsrsInAtt,
+			      NumUsrs,LstUsrCods,
+			      Gbl.AttEvents.Num,LstAttCods,
+			      GetComments);
+      free ((void *) LstAttCods);
+     }
+   else
+      Att_GetUsrsInAttEvents (UsrsInAtt,
+			      NumUsrs,LstUsrCods,
+			      0,NULL,
+			      GetComments);
+  }
 
-      /* Get if present (row[0]) */
-      Present = (row[0][0] == 'Y');
+/*****************************************************************************/
+/******************** Compare two users' codes for sorting *******************/
+/*****************************************************************************/
 
-      /* Get student's comment (row[1]) */
-      strncpy (CommentStd,row[1],Cns_MAX_BYTES_TEXT);
+static int Att_CompareUsrIndexes (const void *p1,const void *p2)
+  {
+   long UsrCod1 = ((const struct Att_UsrIndex *) p1)->UsrCod;
+   long UsrCod2 = ((const struct Att_UsrIndex *) p2)->UsrCod;
+
+   return (UsrCod1 < UsrCod2) ? -1 :
+	 ((UsrCod1 > UsrCod2) ?  1 :
+			         0);
+  }
+
+/*****************************************************************************/
+/************ Add a comment to the attendance of users to events *************/
+/*****************************************************************************/
+
+static void Att_AddCommentToUsrsInAttEvents (struct Att_UsrsInAttEvents *UsrsInAtt,
+                                             size_t *OffsetComment,const char *Comment)
+  {
+   size_t Length;
+
+   if (Comment[0])	// Empty comments are not stored (offset 0)
+     {
+      Length = strlen (Comment);
+      if ((UsrsInAtt->Comments = (char *) realloc (UsrsInAtt->Comments,
+                                                   UsrsInAtt->SizeComments + Length + 1)) == NULL)
+	 Lay_ShowErrorAndExit ("Not enough memory to store comments.");
+      strcpy (&UsrsInAtt->Comments[UsrsInAtt->SizeComments],Comment);
+      *OffsetComment = UsrsInAtt->SizeComments;
+      UsrsInAtt->SizeComments += Length + 1;
+     }
+  }
+
+/*****************************************************************************/
+/************ Free memory used by attendance of users to events **************/
+/*****************************************************************************/
+
+static void Att_FreeUsrsInAttEvents (struct Att_UsrsInAttEvents *UsrsInAtt)
+  {
+   if (UsrsInAtt->UsrIndex)
+      free ((void *) UsrsInAtt->UsrIndex);
+   if (UsrsInAtt->Present)
+      free ((void *) UsrsInAtt->Present);
+   if (UsrsInAtt->OffsetComments)
+      free ((void *) UsrsInAtt->OffsetComments);
+   if (UsrsInAtt->Comments)
+      free ((void *) UsrsInAtt->Comments);
+   UsrsInAtt->NumUsrs      =
+   UsrsInAtt->NumAttEvents = 0;
+  }
+
+/*****************************************************************************/
+/***** Check if a user attended to an event, using the list got before *******/
+/*****************************************************************************/
+
+static bool Att_CheckIfUsrIsPresentInUsrsInAttEvents (const struct Att_UsrsInAttEvents *UsrsInAtt,
+                                                      unsigned NumUsr,unsigned NumAttEvent)
+  {
+   size_t NumCell;
+
+   if (NumUsr >= UsrsInAtt->NumUsrs ||
+       NumAttEvent >= UsrsInAtt->NumAttEvents)
+      return false;
+
+   NumCell = (size_t) NumUsr * UsrsInAtt->NumAttEvents + NumAttEvent;
+   return (UsrsInAtt->Present[NumCell / 8] & (1 << (NumCell % 8))) != 0;
+  }
+
+/*****************************************************************************/
+/****** Get the comments of a user in an event, using the list got before ****/
+/*****************************************************************************/
+
+static void Att_GetCommentsFromUsrsInAttEvents (const struct Att_UsrsInAttEvents *UsrsInAtt,
+                                                unsigned NumUsr,unsigned NumAttEvent,
+                                                char *CommentStd,char *CommentTch)
+  {
+   size_t NumCell;
+
+   CommentStd[0] =
+   CommentTch[0] = '\0';
+
+   if (UsrsInAtt->OffsetComments &&
+       NumUsr < UsrsInAtt->NumUsrs &&
+       NumAttEvent < UsrsInAtt->NumAttEvents)
+     {
+      NumCell = (size_t) NumUsr * UsrsInAtt->NumAttEvents + NumAttEvent;
+
+      strncpy (CommentStd,&UsrsInAtt->Comments[UsrsInAtt->OffsetComments[NumCell * 2    ]],Cns_MAX_BYTES_TEXT);
       CommentStd[Cns_MAX_BYTES_TEXT] = '\0';
 
-      /* Get teacher's comment (row[2]) */
-      strncpy (CommentTch,row[2],Cns_MAX_BYTES_TEXT);
+      strncpy (CommentTch,&UsrsInAtt->Comments[UsrsInAtt->OffsetComments[NumCell * 2 + 1]],Cns_MAX_BYTES_TEXT);
       CommentTch[Cns_MAX_BYTES_TEXT] = '\0';
      }
-   else	// User is not present
+  }
+
+/*****************************************************************************/
+/****** Register a list of users in an event not changing comments ***********/
+/*****************************************************************************/
+// Users already in event are set as present, keeping their comments.
+// Only one query is made for all the users
+
+void Att_RegUsrsInAttEventNotChangingComments (long AttCod,
+                                               unsigned NumUsrs,const long *LstUsrCods)
+  {
+   char *Query;
+   char SubQuery[1+1+10+1+10+1+3+1+2+1+2+1+1];	// ",(AttCod,UsrCod,'Y','','')"
+   unsigned NumUsr;
+
+   if (NumUsrs)
      {
-      Present = false;
-      CommentStd[0] =
-      CommentTch[0] = '\0';
-     }
+      /***** Allocate space for query *****/
+      if ((Query = (char *) malloc ((size_t) (256+NumUsrs*sizeof (SubQuery)))) == NULL)
+         Lay_ShowErrorAndExit ("Not enough memory for query.");
 
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
+      /***** Register users as present in database *****/
+      strcpy (Query,"INSERT INTO att_usr"
+		    " (AttCod,UsrCod,Present,CommentStd,CommentTch)"
+		    " VALUES ");
+      for (NumUsr = 0;
+	   NumUsr < NumUsrs;
+	   NumUsr++)
+	{
+	 sprintf (SubQuery,"%s(%ld,%ld,'Y','','')",
+		  NumUsr ? "," :
+			   "",
+		  AttCod,LstUsrCods[NumUsr]);
+	 strcat (Query,SubQuery);
+	}
+      strcat (Query," ON DUPLICATE KEY UPDATE Present='Y'");
+      DB_QueryINSERT (Query,"can not register users in an event");
 
-   return Present;
+      /***** Free query *****/
+      free ((void *) Query);
+     }
   }
 
 /*****************************************************************************/
-/******* Register a user in an attendance event not changing comments ********/
+/************ Set as absent the users of an event not in a list **************/
 /*****************************************************************************/
+// Users absent without comments are removed from the event
 
-void Att_RegUsrInAttEventNotChangingComments (long AttCod,long UsrCod)
+void Att_SetOtherUsrsAsAbsentInAttEvent (long AttCod,
+                                         unsigned NumUsrs,const long *LstUsrCods)
   {
-   bool Present;
-   char Query[128];
+   char *Query;
+   char SubQuery[1+1+10+1+1];
+   unsigned NumUsr;
 
-   /***** Check if user is already in table att_usr (present or not) *****/
-   if (Att_CheckIfUsrIsInTableAttUsr (AttCod,UsrCod,&Present))	// User is in table att_usr
+   /***** Allocate space for query *****/
+   if ((Query = (char *) malloc ((size_t) (256+NumUsrs*sizeof (SubQuery)))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory for query.");
+
+   /***** Mark users not in list as absent *****/
+   sprintf (Query,"UPDATE att_usr SET Present='N'"
+		  " WHERE AttCod='%ld'",
+	    AttCod);
+   if (NumUsrs)
      {
-      // If already present ==> nothing to do
-      if (!Present)
+      strcat (Query," AND UsrCod NOT IN (");
+      for (NumUsr = 0;
+	   NumUsr < NumUsrs;
+	   NumUsr++)
 	{
-	 /***** Set user as present in database *****/
-	 sprintf (Query,"UPDATE att_usr SET Present='Y'"
-			" WHERE AttCod='%ld' AND UsrCod='%ld'",
-		  AttCod,UsrCod);
-         DB_QueryUPDATE (Query,"can not set user as present in an event");
+	 sprintf (SubQuery,NumUsr ? ",'%ld'" :
+				    "'%ld'",
+		  LstUsrCods[NumUsr]);
+	 strcat (Query,SubQuery);
 	}
+      strcat (Query,")");
      }
-   else			// User is not in table att_usr
-      Att_RegUsrInAttEventChangingComments (AttCod,UsrCod,true,"","");
+   DB_QueryUPDATE (Query,"can not set other users as absent");
+
+   /***** Free query *****/
+   free ((void *) Query);
+
+   /***** Clean table att_usr *****/
+   Att_RemoveUsrsAbsentWithoutCommentsFromAttEvent (AttCod);
   }
 
 /*****************************************************************************/
@@ -2550,6 +3032,28 @@ static void Att_RemoveUsrFromAttEvent (long AttCod,long UsrCod)
    DB_QueryREPLACE (Query,"can not remove student from an event");
   }
 
+/*****************************************************************************/
+/**************** Add a string to a query of variable size *******************/
+/*****************************************************************************/
+
+static void Att_AddStrToQuery (char **Query,size_t *Length,size_t *Size,const char *Str)
+  {
+   size_t LengthStr = strlen (Str);
+
+   /***** Enlarge query if necessary *****/
+   if (*Length + LengthStr + 1 > *Size)
+     {
+      *Size = (*Size ? *Size * 2 :
+	               1024) + LengthStr;
+      if ((*Query = (char *) realloc (*Query,*Size)) == NULL)
+	 Lay_ShowErrorAndExit ("Not enough memory for query.");
+     }
+
+   /***** Add string at the end of query *****/
+   strcpy (*Query + *Length,Str);
+   *Length += LengthStr;
+  }
+
 /*****************************************************************************/
 /************ Remove users absent without comments from an event *************/
 /*****************************************************************************/
@@ -2656,6 +3160,7 @@ static void Usr_ListOrPrintMyAttendanceCrs (Att_TypeOfView_t TypeOfView)
   {
    unsigned NumAttEvent;
    char YN[1+1];
+   struct Att_UsrsInAttEvents UsrsInAtt;
 
    /***** Get list of attendance events *****/
    Att_GetListAttEvents (Att_OLDEST_FIRST);
@@ -2678,18 +3183,29 @@ static void Usr_ListOrPrintMyAttendanceCrs (Att_TypeOfView_t TypeOfView)
    /***** Get list of attendance events selected *****/
    Att_GetListSelectedAttCods (&Gbl.AttEvents.StrAttCodsSelected);
 
+   /***** Get data of all the events *****/
+   Att_GetDataOfAllAttEvents ();
+
    /***** List events to select *****/
    Att_ListEventsToSelect (TypeOfView);
 
    /***** Get my preference about photos in users' list for current course *****/
    Usr_GetMyPrefAboutListWithPhotosFromDB ();
 
+   /***** Get my attendance to the events selected *****/
+   Att_GetUsrsInSelectedAttEvents (&UsrsInAtt,
+                                   1,&Gbl.Usrs.Me.UsrDat.UsrCod,
+                                   Gbl.AttEvents.ShowDetails);
+
    /***** Show table with attendances for every student in list *****/
-   Att_ListStdsAttendanceTable (TypeOfView,1,&Gbl.Usrs.Me.UsrDat.UsrCod);
+   Att_ListStdsAttendanceTable (TypeOfView,1,&Gbl.Usrs.Me.UsrDat.UsrCod,&UsrsInAtt);
 
    /***** Show details or put button to show details *****/
    if (Gbl.AttEvents.ShowDetails)
-      Att_ListStdsWithAttEventsDetails (1,&Gbl.Usrs.Me.UsrDat.UsrCod);
+      Att_ListStdsWithAttEventsDetails (1,&Gbl.Usrs.Me.UsrDat.UsrCod,&UsrsInAtt);
+
+   /***** Free my attendance to the events selected *****/
+   Att_FreeUsrsInAttEvents (&UsrsInAtt);
 
    /***** Free memory for list of attendance events selected *****/
    free ((void *) Gbl.AttEvents.StrAttCodsSelected);
@@ -2722,6 +3238,7 @@ static void Usr_ListOrPrintStdsAttendanceCrs (Att_TypeOfView_t TypeOfView)
    long *LstSelectedUsrCods;
    unsigned NumAttEvent;
    char YN[1+1];
+   struct Att_UsrsInAttEvents UsrsInAtt;
 
    /***** Get list of attendance events *****/
    Att_GetListAttEvents (Att_OLDEST_FIRST);
@@ -2753,18 +3270,29 @@ static void Usr_ListOrPrintStdsAttendanceCrs (Att_TypeOfView_t TypeOfView)
       /***** Get list of attendance events selected *****/
       Att_GetListSelectedAttCods (&Gbl.AttEvents.StrAttCodsSelected);
 
+      /***** Get data of all the events *****/
+      Att_GetDataOfAllAttEvents ();
+
       /***** List events to select *****/
       Att_ListEventsToSelect (TypeOfView);
 
       /***** Get my preference about photos in users' list for current course *****/
       Usr_GetMyPrefAboutListWithPhotosFromDB ();
 
+      /***** Get attendance of students in list to the events selected *****/
+      Att_GetUsrsInSelectedAttEvents (&UsrsInAtt,
+                                      NumStdsInList,LstSelectedUsrCods,
+                                      Gbl.AttEvents.ShowDetails);
+
       /***** Show table with attendances for every student in list *****/
-      Att_ListStdsAttendanceTable (TypeOfView,NumStdsInList,LstSelectedUsrCods);
+      Att_ListStdsAttendanceTable (TypeOfView,NumStdsInList,LstSelectedUsrCods,&UsrsInAtt);
 
       /***** Show details or put button to show details *****/
       if (Gbl.AttEvents.ShowDetails)
-	 Att_ListStdsWithAttEventsDetails (NumStdsInList,LstSelectedUsrCods);
+	 Att_ListStdsWithAttEventsDetails (NumStdsInList,LstSelectedUsrCods,&UsrsInAtt);
+
+      /***** Free attendance of students to the events selected *****/
+      Att_FreeUsrsInAttEvents (&UsrsInAtt);
 
       /***** Free memory for list of attendance events selected *****/
       free ((void *) Gbl.AttEvents.StrAttCodsSelected);
@@ -2996,6 +3524,25 @@ static void Att_PutButtonToShowDetails (void)
    Act_FormEnd ();
   }
 
+/*****************************************************************************/
+/*********** Get data and number of students of all the events ***************/
+/*****************************************************************************/
+// The data are got only once, before listing events and students,
+// and they are used in all the rows of students
+
+static void Att_GetDataOfAllAttEvents (void)
+  {
+   unsigned NumAttEvent;
+
+   for (NumAttEvent = 0;
+	NumAttEvent < Gbl.AttEvents.Num;
+	NumAttEvent++)
+     {
+      Att_GetDataOfAttEventByCodAndCheckCrs (&Gbl.AttEvents.Lst[NumAttEvent]);
+      Att_GetNumStdsTotalWhoAreInAttEvent (&Gbl.AttEvents.Lst[NumAttEvent]);
+     }
+  }
+
 /*****************************************************************************/
 /********** Write list of those attendance events that have students *********/
 /*****************************************************************************/
@@ -3042,10 +3589,6 @@ static void Att_ListEventsToSelect (Att_TypeOfView_t TypeOfView)
 	NumAttEvent < Gbl.AttEvents.Num;
 	NumAttEvent++, UniqueId++, Gbl.RowEvenOdd = 1 - Gbl.RowEvenOdd)
      {
-      /* Get data of the attendance event from database */
-      Att_GetDataOfAttEventByCodAndCheckCrs (&Gbl.AttEvents.Lst[NumAttEvent]);
-      Att_GetNumStdsTotalWhoAreInAttEvent (&Gbl.AttEvents.Lst[NumAttEvent]);
-
       /* Write a row for this event */
       fprintf (Gbl.F.Out,"<tr>"
 			 "<td class=\"DAT CENTER_MIDDLE COLOR%u\">"
@@ -3110,7 +3653,8 @@ static void Att_ListEventsToSelect (Att_TypeOfView_t TypeOfView)
 
 static void Att_ListStdsAttendanceTable (Att_TypeOfView_t TypeOfView,
                                          unsigned NumStdsInList,
-                                         long *LstSelectedUsrCods)
+                                         long *LstSelectedUsrCods,
+                                         const struct Att_UsrsInAttEvents *UsrsInAtt)
   {
    extern const char *Txt_Attendance;
    extern const char *Txt_Number_of_students;
@@ -3148,7 +3692,7 @@ static void Att_ListStdsAttendanceTable (Att_TypeOfView_t TypeOfView,
 	 UsrDat.Accepted = Usr_CheckIfUsrBelongsToCrs (UsrDat.UsrCod,
 	                                               Gbl.CurrentCrs.Crs.CrsCod,
 	                                               true);
-	 Att_WriteRowStdSeveralAttEvents (NumStd,&UsrDat);
+	 Att_WriteRowStdSeveralAttEvents (NumStd,&UsrDat,UsrsInAtt);
 	}
      }
 
@@ -3216,16 +3760,11 @@ static void Att_WriteTableHeadSeveralAttEvents (void)
 	NumAttEvent < Gbl.AttEvents.Num;
 	NumAttEvent++)
       if (Gbl.AttEvents.Lst[NumAttEvent].Selected)
-	{
-	 /***** Get data of this attendance event *****/
-	 Att_GetDataOfAttEventByCodAndCheckCrs (&Gbl.AttEvents.Lst[NumAttEvent]);
-
 	 fprintf (Gbl.F.Out,"<th class=\"CENTER_MIDDLE\" title=\"%s\">"
 			    "%u"
 			    "</th>",
 		  Gbl.AttEvents.Lst[NumAttEvent].Title,
 		  NumAttEvent + 1);
-	}
 
    fprintf (Gbl.F.Out,"<th class=\"RIGHT_MIDDLE\">"
 	              "%s"
@@ -3238,7 +3777,8 @@ static void Att_WriteTableHeadSeveralAttEvents (void)
 /************ Write a row of a table with the data of a student **************/
 /*****************************************************************************/
 
-static void Att_WriteRowStdSeveralAttEvents (unsigned NumStd,struct UsrData *UsrDat)
+static void Att_WriteRowStdSeveralAttEvents (unsigned NumStd,struct UsrData *UsrDat,
+                                             const struct Att_UsrsInAttEvents *UsrsInAtt)
   {
    extern const char *Txt_Present;
    extern const char *Txt_Absent;
@@ -3299,7 +3839,7 @@ static void Att_WriteRowStdSeveralAttEvents (unsigned NumStd,struct UsrData *Usr
 	{
 	 /***** Check if this student is already registered in the current event *****/
 	 // Here it is not necessary to get comments
-	 Present = Att_CheckIfUsrIsPresentInAttEvent (Gbl.AttEvents.Lst[NumAttEvent].AttCod,UsrDat->UsrCod);
+	 Present = Att_CheckIfUsrIsPresentInUsrsInAttEvents (UsrsInAtt,NumStd,NumAttEvent);
 
 	 fprintf (Gbl.F.Out,"<td class=\"BM%u\">"
 	                    "<img src=\"%s/%s16x16.gif\""
@@ -3333,7 +3873,8 @@ static void Att_WriteRowStdSeveralAttEvents (unsigned NumStd,struct UsrData *Usr
 /**************** List the students with details and comments ****************/
 /*****************************************************************************/
 
-static void Att_ListStdsWithAttEventsDetails (unsigned NumStdsInList,long *LstSelectedUsrCods)
+static void Att_ListStdsWithAttEventsDetails (unsigned NumStdsInList,long *LstSelectedUsrCods,
+                                              const struct Att_UsrsInAttEvents *UsrsInAtt)
   {
    extern const char *Txt_Details;
    struct UsrData UsrDat;
@@ -3356,7 +3897,7 @@ static void Att_ListStdsWithAttEventsDetails (unsigned NumStdsInList,long *LstSe
 	 UsrDat.Accepted = Usr_CheckIfUsrBelongsToCrs (UsrDat.UsrCod,
 	                                               Gbl.CurrentCrs.Crs.CrsCod,
 	                                               true);
-	 Att_ListAttEventsForAStd (NumStd,&UsrDat);
+	 Att_ListAttEventsForAStd (NumStd,&UsrDat,UsrsInAtt);
 	}
      }
 
@@ -3371,7 +3912,8 @@ static void Att_ListStdsWithAttEventsDetails (unsigned NumStdsInList,long *LstSe
 /*************** Write list of attendance events for a student ***************/
 /*****************************************************************************/
 
-static void Att_ListAttEventsForAStd (unsigned NumStd,struct UsrData *UsrDat)
+static void Att_ListAttEventsForAStd (unsigned NumStd,struct UsrData *UsrDat,
+                                      const struct Att_UsrsInAttEvents *UsrsInAtt)
   {
    extern const char *Txt_Today;
    extern const char *Txt_Present;
@@ -3439,12 +3981,9 @@ static void Att_ListAttEventsForAStd (unsigned NumStd,struct UsrData *UsrDat)
 	NumAttEvent++, UniqueId++)
       if (Gbl.AttEvents.Lst[NumAttEvent].Selected)
 	{
-	 /***** Get data of the attendance event from database *****/
-	 Att_GetDataOfAttEventByCodAndCheckCrs (&Gbl.AttEvents.Lst[NumAttEvent]);
-         Att_GetNumStdsTotalWhoAreInAttEvent (&Gbl.AttEvents.Lst[NumAttEvent]);
-
 	 /***** Get comments for this student *****/
-	 Present = Att_CheckIfUsrIsPresentInAttEventAndGetComments (Gbl.AttEvents.Lst[NumAttEvent].AttCod,UsrDat->UsrCod,CommentStd,CommentTch);
+	 Present = Att_CheckIfUsrIsPresentInUsrsInAttEvents (UsrsInAtt,NumStd,NumAttEvent);
+	 Att_GetCommentsFromUsrsInAttEvents (UsrsInAtt,NumStd,NumAttEvent,CommentStd,CommentTch);
          ShowCommentStd = CommentStd[0];
 	 ShowCommentTch = CommentTch[0] &&
 	                  (Gbl.Usrs.Me.LoggedRole == Rol_TEACHER ||
@@ -116,7 +116,10 @@ void Att_SeeOneAttEvent (void);
 void Att_RegisterMeAsStdInAttEvent (void);
 void Att_RegisterStudentsInAttEvent (void);
 
-void Att_RegUsrInAttEventNotChangingComments (long AttCod,long UsrCod);
+void Att_RegUsrsInAttEventNotChangingComments (long AttCod,
+                                               unsigned NumUsrs,const long *LstUsrCods);
+void Att_SetOtherUsrsAsAbsentInAttEvent (long AttCod,
+                                         unsigned NumUsrs,const long *LstUsrCods);
 void Att_RemoveUsrsAbsentWithoutCommentsFromAttEvent (long AttCod);
 
 void Usr_ReqListStdsAttendanceCrs (void);
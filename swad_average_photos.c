@@ -0,0 +1,386 @@
+// swad_average_photos.c
+// Created on: 28/11/2016
+// Compute the average and median photos of the students of each degree.
+// It must be run periodically (for example from cron) in the directory
+// of the CGI, where the programs that compute the photos are installed,
+// so that computing photos never delays a request to SWAD.
+// Usage: swad_average_photos [maximum number of programs running at the same time]
+// Compile with: gcc -Wall -O1 swad_average_photos.c -o swad_average_photos -lmysqlclient -L/usr/lib64/mysql
+
+#include <mysql/mysql.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define DATABASE_HOST		"swad.ugr.es"
+#define DATABASE_USER		"swad"
+#define DATABASE_PASSWORD	"********"
+#define DATABASE_DBNAME		"swad"
+#define PATH_SWAD_PRIVATE	"/var/www/swad"
+#define PATH_SWAD_PUBLIC	"/var/www/html/swad"
+#define FOLDER_PHOTO		"photo"
+#define FOLDER_PHOTO_TMP	"tmp"
+
+#define MIN_TIME_TO_RECOMPUTE_AVG_PHOTO	(12UL*60UL*60UL)	// Same as Cfg_MIN_TIME_TO_RECOMPUTE_AVG_PHOTO
+
+#define DEFAULT_MAX_PROCESSES	4
+
+#define ROLE_STUDENT		3	// Rol_STUDENT
+
+/* Sexs, in the same order as Usr_Sex_t */
+#define NUM_SEXS		4
+#define SEX_ALL			3	// Usr_SEX_ALL
+const char *StringsSexDB[NUM_SEXS] =
+  {
+   "unknown",
+   "female",
+   "male",
+   "all",
+  };
+
+/* Types of average, in the same order as Pho_AvgPhotoTypeOfAverage_t */
+#define NUM_AVERAGE_PHOTO_TYPES	2
+const char *AvgPhotoDirs[NUM_AVERAGE_PHOTO_TYPES] =
+  {
+   "mdn_all",		// Cfg_FOLDER_DEGREE_PHOTO_MEDIAN
+   "avg_all",		// Cfg_FOLDER_DEGREE_PHOTO_AVERAGE
+  };
+const char *AvgPhotoPrograms[NUM_AVERAGE_PHOTO_TYPES] =
+  {
+   "./foto_mediana",	// Cfg_COMMAND_DEGREE_PHOTO_MEDIAN
+   "./foto_promedio",	// Cfg_COMMAND_DEGREE_PHOTO_AVERAGE
+  };
+
+/* Programs running for the current degree */
+struct Process
+  {
+   pid_t PID;
+   unsigned Sex;
+   struct timeval tvStart;
+  };
+
+MYSQL mysql;
+
+void ExecuteQuery (const char *Query)
+  {
+   if (mysql_query (&mysql,Query))
+     {
+      fprintf (stderr,"%s\n",mysql_error (&mysql));
+      exit (3);
+     }
+  }
+
+MYSQL_RES *ExecuteSelect (const char *Query)
+  {
+   MYSQL_RES *mysql_res;
+
+   ExecuteQuery (Query);
+   if ((mysql_res = mysql_store_result (&mysql)) == NULL)
+     {
+      fprintf (stderr,"%s\n",mysql_error (&mysql));
+      exit (4);
+     }
+   return mysql_res;
+  }
+
+int CheckIfPathExists (const char *Path)
+  {
+   return access (Path,F_OK) ? 0 :
+	                       1;
+  }
+
+/* Create a directory if it does not exist, as Fil_CreateDirIfNotExists */
+void CreateDirIfNotExists (const char *Path)
+  {
+   if (!CheckIfPathExists (Path))
+      if (mkdir (Path,(mode_t) 0xFFF) != 0)
+	{
+	 fprintf (stderr,"Can not create folder %s.\n",Path);
+	 exit (8);
+	}
+  }
+
+/* Create the directories where the programs write, as Pho_CalcPhotoDegree */
+void CreateDirsOfAveragePhotos (void)
+  {
+   char Path[PATH_MAX+1];
+   unsigned Type;
+
+   /***** Create public directories for average photos if not exist *****/
+   sprintf (Path,"%s/%s",PATH_SWAD_PUBLIC,FOLDER_PHOTO);
+   CreateDirIfNotExists (Path);
+   for (Type = 0;
+	Type < NUM_AVERAGE_PHOTO_TYPES;
+	Type++)
+     {
+      sprintf (Path,"%s/%s/%s",PATH_SWAD_PUBLIC,FOLDER_PHOTO,AvgPhotoDirs[Type]);
+      CreateDirIfNotExists (Path);
+     }
+
+   /***** Create private directory for lists of users' photos if not exists *****/
+   sprintf (Path,"%s/%s",PATH_SWAD_PRIVATE,FOLDER_PHOTO);
+   CreateDirIfNotExists (Path);
+   sprintf (Path,"%s/%s/%s",PATH_SWAD_PRIVATE,FOLDER_PHOTO,FOLDER_PHOTO_TMP);
+   CreateDirIfNotExists (Path);
+  }
+
+long ElapsedMicroseconds (const struct timeval *tvStart)
+  {
+   struct timeval tvEnd;
+
+   gettimeofday (&tvEnd,NULL);
+   return (tvEnd.tv_sec  - tvStart->tv_sec) * 1000000L +
+	  (tvEnd.tv_usec - tvStart->tv_usec);
+  }
+
+/* Wait for one of the programs running, and add its time to its sex */
+void WaitForOneProcess (struct Process *Processes,unsigned *NumProcesses,
+                        long TimeToCompute[NUM_SEXS])
+  {
+   pid_t PID;
+   int Status;
+   unsigned NumProc;
+
+   if ((PID = wait (&Status)) < 0)
+     {
+      *NumProcesses = 0;
+      return;
+     }
+   for (NumProc = 0;
+	NumProc < *NumProcesses;
+	NumProc++)
+      if (Processes[NumProc].PID == PID)
+	{
+	 if (!WIFEXITED (Status) || WEXITSTATUS (Status))
+	    fprintf (stderr,"The average photo has not been computed successfully.\n");
+	 TimeToCompute[Processes[NumProc].Sex] += ElapsedMicroseconds (&Processes[NumProc].tvStart);
+	 Processes[NumProc] = Processes[--(*NumProcesses)];
+	 return;
+	}
+  }
+
+/* Compute all the average photos of a degree in only one pass over its students */
+void ComputeAveragePhotosOfDegree (long DegCod,unsigned MaxProcesses)
+  {
+   char Query[1024];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumRows;
+   unsigned NumRow;
+   long UsrCod;
+   unsigned Sex;
+   unsigned UsrSex;
+   unsigned Type;
+   char FileNamePhotoNames[NUM_SEXS][PATH_MAX+1];
+   FILE *FilePhotoNames[NUM_SEXS];
+   char PathPrivRelPhoto[PATH_MAX+1];
+   char PathRelAvgPhoto[PATH_MAX+1];
+   unsigned NumStds[NUM_SEXS];
+   unsigned NumStdsWithPhoto[NUM_SEXS];
+   long TimeToCompute[NUM_SEXS];
+   struct Process *Processes;
+   unsigned NumProcesses = 0;
+
+   if ((Processes = (struct Process *) malloc (MaxProcesses * sizeof (struct Process))) == NULL)
+     {
+      fprintf (stderr,"Not enough memory.\n");
+      exit (5);
+     }
+
+   /***** Create one file with the paths of the photos for each sex *****/
+   for (Sex = 0;
+	Sex < NUM_SEXS;
+	Sex++)
+     {
+      NumStds[Sex] = NumStdsWithPhoto[Sex] = 0;
+      TimeToCompute[Sex] = 0;
+      sprintf (FileNamePhotoNames[Sex],"%s/%s/%s/%ld_%s.txt",
+	       PATH_SWAD_PRIVATE,FOLDER_PHOTO,FOLDER_PHOTO_TMP,DegCod,StringsSexDB[Sex]);
+      if ((FilePhotoNames[Sex] = fopen (FileNamePhotoNames[Sex],"wb")) == NULL)
+	{
+	 fprintf (stderr,"Can not open file to compute average photo.\n");
+	 exit (6);
+	}
+     }
+
+   /***** Get students of this degree with their sex *****/
+   sprintf (Query,"SELECT DISTINCT crs_usr.UsrCod,usr_data.Sex"
+		  " FROM courses,crs_usr,usr_data"
+		  " WHERE courses.DegCod='%ld'"
+		  " AND courses.CrsCod=crs_usr.CrsCod"
+		  " AND crs_usr.Role='%u'"
+		  " AND crs_usr.UsrCod=usr_data.UsrCod",
+	    DegCod,ROLE_STUDENT);
+   mysql_res = ExecuteSelect (Query);
+
+   /***** Only one pass: check photo of each student only once *****/
+   NumRows = (unsigned) mysql_num_rows (mysql_res);
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+      if (sscanf (row[0],"%ld",&UsrCod) != 1)
+	 continue;
+      for (UsrSex = 0;
+	   UsrSex < SEX_ALL;
+	   UsrSex++)
+	 if (!strcmp (row[1],StringsSexDB[UsrSex]))
+	    break;
+      if (UsrSex == SEX_ALL)
+	 UsrSex = 0;	// Unknown
+
+      NumStds[UsrSex]++;
+      NumStds[SEX_ALL]++;
+      sprintf (PathPrivRelPhoto,"%s/%s/%02u/%ld.jpg",
+	       PATH_SWAD_PRIVATE,FOLDER_PHOTO,(unsigned) (UsrCod % 100),UsrCod);
+      if (CheckIfPathExists (PathPrivRelPhoto))
+	{
+	 NumStdsWithPhoto[UsrSex]++;
+	 NumStdsWithPhoto[SEX_ALL]++;
+	 fprintf (FilePhotoNames[UsrSex ],"%s\n",PathPrivRelPhoto);
+	 fprintf (FilePhotoNames[SEX_ALL],"%s\n",PathPrivRelPhoto);
+	}
+     }
+   mysql_free_result (mysql_res);
+   for (Sex = 0;
+	Sex < NUM_SEXS;
+	Sex++)
+      fclose (FilePhotoNames[Sex]);
+
+   /***** Run the programs for all the sexs and types of average,
+          with no more than MaxProcesses running at the same time *****/
+   for (Sex = 0;
+	Sex < NUM_SEXS;
+	Sex++)
+      for (Type = 0;
+	   Type < NUM_AVERAGE_PHOTO_TYPES;
+	   Type++)
+	{
+	 /* Remove old file if exists */
+	 sprintf (PathRelAvgPhoto,"%s/%s/%s/%ld_%s.jpg",
+		  PATH_SWAD_PUBLIC,FOLDER_PHOTO,AvgPhotoDirs[Type],DegCod,StringsSexDB[Sex]);
+	 if (CheckIfPathExists (PathRelAvgPhoto))
+	    unlink (PathRelAvgPhoto);
+
+	 if (!NumStdsWithPhoto[Sex])
+	    continue;
+
+	 if (NumProcesses == MaxProcesses)
+	    WaitForOneProcess (Processes,&NumProcesses,TimeToCompute);
+
+	 gettimeofday (&Processes[NumProcesses].tvStart,NULL);
+	 Processes[NumProcesses].Sex = Sex;
+	 switch (Processes[NumProcesses].PID = fork ())
+	   {
+	    case -1:
+	       fprintf (stderr,"Can not run program that computes the average photo.\n");
+	       exit (7);
+	    case 0:	// Child
+	       execl (AvgPhotoPrograms[Type],AvgPhotoPrograms[Type],
+		      FileNamePhotoNames[Sex],PathRelAvgPhoto,(char *) NULL);
+	       _exit (127);
+	    default:	// Parent
+	       NumProcesses++;
+	       break;
+	   }
+	}
+   while (NumProcesses)
+      WaitForOneProcess (Processes,&NumProcesses,TimeToCompute);
+   free ((void *) Processes);
+
+   /***** Store stats in database *****/
+   for (Sex = 0;
+	Sex < NUM_SEXS;
+	Sex++)
+     {
+      sprintf (Query,"REPLACE INTO sta_degrees"
+		     " (DegCod,Sex,NumStds,NumStdsWithPhoto,TimeAvgPhoto,TimeToComputeAvgPhoto)"
+		     " VALUES ('%ld','%s','%u','%u',NOW(),'%ld')",
+	       DegCod,StringsSexDB[Sex],NumStds[Sex],NumStdsWithPhoto[Sex],TimeToCompute[Sex]);
+      ExecuteQuery (Query);
+      unlink (FileNamePhotoNames[Sex]);
+     }
+
+   printf (" %u students, %u with photo\n",
+	   NumStds[SEX_ALL],NumStdsWithPhoto[SEX_ALL]);
+  }
+
+int main (int argc, char *argv[])
+  {
+   char Query[1024];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumRows;
+   unsigned NumRow;
+   long DegCod;
+   unsigned MaxProcesses = DEFAULT_MAX_PROCESSES;
+
+   if (argc > 1)
+      if (sscanf (argv[1],"%u",&MaxProcesses) != 1 || MaxProcesses == 0)
+	{
+	 fprintf (stderr,"Usage: %s [maximum number of programs running at the same time]\n",argv[0]);
+	 return 1;
+	}
+
+   if (mysql_init (&mysql) == NULL)
+     {
+      fprintf (stderr,"Can not init MySQL.");
+      return 1;
+     }
+   if (!mysql_real_connect (&mysql,DATABASE_HOST,DATABASE_USER,DATABASE_PASSWORD,DATABASE_DBNAME,0,NULL,0))
+     {
+      fprintf (stderr,"Can not connect to database");
+      return 2;
+     }
+
+   /***** Create directories before running the programs that write into them *****/
+   CreateDirsOfAveragePhotos ();
+
+   /***** Delete all the degrees in sta_degrees table not present in degrees table *****/
+   ExecuteQuery ("DELETE FROM sta_degrees"
+                 " WHERE DegCod NOT IN (SELECT DegCod FROM degrees)");
+
+   /***** Get degrees with students,
+          from the least recently computed to the most recently computed *****/
+   sprintf (Query,"SELECT degrees.DegCod,MIN(sta_degrees.TimeAvgPhoto) AS T"
+		  " FROM degrees LEFT JOIN sta_degrees"
+		  " ON degrees.DegCod=sta_degrees.DegCod"
+		  " WHERE degrees.DegCod IN"
+		  " (SELECT DISTINCT courses.DegCod FROM courses,crs_usr"
+		  " WHERE courses.CrsCod=crs_usr.CrsCod"
+		  " AND crs_usr.Role='%u')"
+		  " GROUP BY degrees.DegCod"
+		  " HAVING T IS NULL"
+		  " OR T<FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')"
+		  " ORDER BY T",
+	    ROLE_STUDENT,MIN_TIME_TO_RECOMPUTE_AVG_PHOTO);
+   mysql_res = ExecuteSelect (Query);
+
+   /***** Compute average photos of each degree, showing progress *****/
+   NumRows = (unsigned) mysql_num_rows (mysql_res);
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+      if (sscanf (row[0],"%ld",&DegCod) == 1)
+	{
+	 printf ("Degree %u/%u (DegCod %ld):",NumRow + 1,NumRows,DegCod);
+	 fflush (stdout);
+	 ComputeAveragePhotosOfDegree (DegCod,MaxProcesses);
+	}
+     }
+   mysql_free_result (mysql_res);
+
+   mysql_close (&mysql);
+
+   printf ("# Degrees: %u\n",NumRows);
+   return 0;
+  }
@@ -0,0 +1,394 @@
+// swad_cache.c: cache of HTML fragments
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2016 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <linux/limits.h>	// For PATH_MAX
+#include <linux/stddef.h>	// For NULL
+#include <stdio.h>		// For FILE,fprintf
+#include <stdlib.h>		// For malloc, free
+#include <string.h>		// For string functions
+#include <sys/stat.h>		// For lstat
+#include <unistd.h>		// For unlink
+
+#include "swad_cache.h"
+#include "swad_config.h"
+#include "swad_cryptography.h"
+#include "swad_file.h"
+#include "swad_global.h"
+
+/*****************************************************************************/
+/************** External global variables from others modules ****************/
+/*****************************************************************************/
+
+extern struct Globals Gbl;
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+// Cached fragments are refreshed after these seconds,
+// so that figures shown inside them (number of users...) do not get too old
+#define Cac_TIME_TO_REFRESH_FRAGMENT ((time_t)(5UL*60UL))
+
+// Fragments are shared by all the users,
+// so the session id and the unique name of this execution,
+// which are written inside forms and ids, are replaced by these marks
+#define Cac_MARK_SESSION_ID	'\x1C'
+#define Cac_MARK_UNIQUE_NAME	'\x1D'
+
+// Folder of fragment + '/' + role, language, theme, icon set, form, row color and variant
+#define Cac_MAX_BYTES_FILE_NAME	(PATH_MAX+1+256)
+
+static const char *Cac_FolderFragment[Cac_NUM_FRAGMENTS] =
+  {
+   "ins_list",	// Cac_INS_LIST
+   "ctr_list",	// Cac_CTR_LIST
+   "deg_list",	// Cac_DEG_LIST
+   "crs_tt",	// Cac_CRS_TT
+   "my_tt",	// Cac_MY_TT
+   "tut_tt",	// Cac_TUT_TT
+  };
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***************************** Private variables *****************************/
+/*****************************************************************************/
+
+static struct
+  {
+   bool Building;			// Building a fragment to store it in cache?
+   FILE *Out;				// Output of the page, saved while building
+   FILE *Tmp;				// Temporary file where fragment is built
+   int NumFormAtStart;			// Gbl.Form.Num when fragment started
+   char FileName[Cac_MAX_BYTES_FILE_NAME+1];	// File in cache for this fragment
+  } Cac_Fragment =
+  {
+   false,
+   NULL,
+   NULL,
+   -1,
+   "",
+  };
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static void Cac_BuildPathFragment (Cac_Fragment_t Fragment,long Cod,char *Path);
+static bool Cac_WriteFragmentFromCache (const char *FileName);
+static void Cac_StoreFragmentInCache (const char *Fragment,size_t Length);
+static void Cac_DiscardFragment (void);
+
+/*****************************************************************************/
+/******************** Start writing a fragment of the page *******************/
+/*****************************************************************************/
+// Fragment is identified by the type of fragment, a code (country, institution...)
+// and a variant (order, current item highlighted...),
+// and it depends also on my role, my language, my theme and my icon set.
+// Return true if the fragment must be generated (cache miss),
+// and false if the fragment has been written from cache (cache hit).
+// When it returns true, Cac_EndFragment must be called after generating fragment.
+
+bool Cac_StartFragment (Cac_Fragment_t Fragment,long Cod,const char *Variant)
+  {
+   char Path[PATH_MAX+1];
+   struct stat FileStatus;
+
+   /***** Nested fragments are not cached *****/
+   if (Cac_Fragment.Building)
+      return true;
+
+   /***** Check if exists the directory for this fragment. If not exists, create it *****/
+   Cac_BuildPathFragment (Fragment,Cod,Path);
+
+   /***** Build the name of the file in cache *****/
+   // The number of the current form and the color of the current row are part of the name
+   // because forms ids and colors generated inside the fragment depend on them
+   sprintf (Cac_Fragment.FileName,"%s/%u_%u_%u_%u_%d_%u_%s.html",
+            Path,
+	    (unsigned) Gbl.Usrs.Me.LoggedRole,
+	    (unsigned) Gbl.Prefs.Language,
+	    (unsigned) Gbl.Prefs.Theme,
+	    (unsigned) Gbl.Prefs.IconSet,
+	    Gbl.Form.Num,
+	    Gbl.RowEvenOdd,
+	    Variant);
+
+   /***** Cache hit: write fragment from cache if it exists and it is recent *****/
+   if (lstat (Cac_Fragment.FileName,&FileStatus) == 0)
+      if (FileStatus.st_mtime >= Gbl.StartExecutionTimeUTC - Cac_TIME_TO_REFRESH_FRAGMENT)
+	 if (Cac_WriteFragmentFromCache (Cac_Fragment.FileName))
+	    return false;
+
+   /***** Cache miss: redirect output to a temporary file *****/
+   if ((Cac_Fragment.Tmp = tmpfile ()) == NULL)
+      return true;	// Fragment is generated but not cached
+   Cac_Fragment.Out = Gbl.F.Out;
+   Gbl.F.Out = Cac_Fragment.Tmp;
+   Cac_Fragment.NumFormAtStart = Gbl.Form.Num;
+   Cac_Fragment.Building = true;
+   return true;
+  }
+
+/*****************************************************************************/
+/********************* End writing a fragment of the page ********************/
+/*****************************************************************************/
+
+void Cac_EndFragment (void)
+  {
+   long Length;
+   char *Fragment;
+
+   if (!Cac_Fragment.Building)
+      return;
+
+   /***** Restore output *****/
+   Gbl.F.Out = Cac_Fragment.Out;
+   Cac_Fragment.Building = false;
+
+   /***** Get fragment built in temporary file *****/
+   fflush (Cac_Fragment.Tmp);
+   Length = ftell (Cac_Fragment.Tmp);
+   rewind (Cac_Fragment.Tmp);
+   if (Length > 0)
+     {
+      if ((Fragment = (char *) malloc ((size_t) Length)) == NULL)
+	{
+	 /* Not enough memory: copy fragment to output without caching it */
+	 Fil_FastCopyOfOpenFiles (Cac_Fragment.Tmp,Gbl.F.Out);
+	 fclose (Cac_Fragment.Tmp);
+	 return;
+	}
+      if (fread (Fragment,1,(size_t) Length,Cac_Fragment.Tmp) == (size_t) Length)
+	{
+	 /***** Write fragment to output *****/
+	 fwrite (Fragment,1,(size_t) Length,Gbl.F.Out);
+
+	 /***** Store fragment in cache *****/
+	 Cac_StoreFragmentInCache (Fragment,(size_t) Length);
+	}
+      free ((void *) Fragment);
+     }
+   fclose (Cac_Fragment.Tmp);
+  }
+
+/*****************************************************************************/
+/************ Abort writing a fragment when an error happens *****************/
+/*****************************************************************************/
+// Called before showing an error and exiting,
+// so the error is written to the page and the fragment is not stored in cache
+
+void Cac_AbortFragment (void)
+  {
+   if (Cac_Fragment.Building)
+      Cac_DiscardFragment ();
+  }
+
+/*****************************************************************************/
+/************** Restore output and discard fragment being built **************/
+/*****************************************************************************/
+
+static void Cac_DiscardFragment (void)
+  {
+   /***** Restore output *****/
+   Gbl.F.Out = Cac_Fragment.Out;
+   Cac_Fragment.Building = false;
+
+   /***** Remove temporary file *****/
+   fclose (Cac_Fragment.Tmp);	// A temporary file is removed when closed
+   Cac_Fragment.Tmp = NULL;
+  }
+
+/*****************************************************************************/
+/************* Build path to the folder of a fragment in cache ***************/
+/*****************************************************************************/
+
+static void Cac_BuildPathFragment (Cac_Fragment_t Fragment,long Cod,char *Path)
+  {
+   sprintf (Path,"%s/%s",
+	    Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_CACHE);
+   Fil_CreateDirIfNotExists (Path);
+   sprintf (Path,"%s/%s/%s",
+	    Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_CACHE,Cac_FolderFragment[Fragment]);
+   Fil_CreateDirIfNotExists (Path);
+   sprintf (Path,"%s/%s/%s/%ld",
+	    Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_CACHE,Cac_FolderFragment[Fragment],Cod);
+   Fil_CreateDirIfNotExists (Path);
+  }
+
+/*****************************************************************************/
+/********************** Write a fragment from cache **************************/
+/*****************************************************************************/
+// Return false if fragment can not be read from cache
+
+static bool Cac_WriteFragmentFromCache (const char *FileName)
+  {
+   FILE *FileCache;
+   int NumForms;
+   unsigned RowEvenOdd;
+   int Ch;
+
+   /***** Open file in cache *****/
+   if ((FileCache = fopen (FileName,"rb")) == NULL)
+      return false;
+
+   /***** Read header with number of forms and color of row after fragment *****/
+   if (fscanf (FileCache,"%d %u\n",&NumForms,&RowEvenOdd) != 2)
+     {
+      fclose (FileCache);
+      return false;
+     }
+
+   /***** Write fragment replacing marks *****/
+   while ((Ch = fgetc (FileCache)) != EOF)
+      switch (Ch)
+	{
+	 case Cac_MARK_SESSION_ID:
+	    fputs (Gbl.Session.Id,Gbl.F.Out);
+	    break;
+	 case Cac_MARK_UNIQUE_NAME:
+	    fputs (Gbl.UniqueNameEncrypted,Gbl.F.Out);
+	    break;
+	 default:
+	    fputc (Ch,Gbl.F.Out);
+	    break;
+	}
+   fclose (FileCache);
+
+   /***** Skip the forms written inside fragment *****/
+   Gbl.Form.Num += NumForms;
+   Gbl.RowEvenOdd = RowEvenOdd;
+
+   return true;
+  }
+
+/*****************************************************************************/
+/************************ Store a fragment in cache **************************/
+/*****************************************************************************/
+
+static void Cac_StoreFragmentInCache (const char *Fragment,size_t Length)
+  {
+   char FileNameNew[Cac_MAX_BYTES_FILE_NAME+1+Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+1];
+   FILE *FileCache;
+   bool Error;
+   size_t LengthSessionId = strlen (Gbl.Session.Id);
+   size_t LengthUniqueName = strlen (Gbl.UniqueNameEncrypted);
+   size_t i;
+
+   /***** Create a new file.
+          It will replace the old one when completely written,
+          so other concurrent executions never read a partial fragment *****/
+   sprintf (FileNameNew,"%s.%s",
+            Cac_Fragment.FileName,Gbl.UniqueNameEncrypted);
+   if ((FileCache = fopen (FileNameNew,"wb")) == NULL)
+      return;
+
+   /***** Write header with number of forms and color of row after fragment *****/
+   fprintf (FileCache,"%d %u\n",
+	    Gbl.Form.Num - Cac_Fragment.NumFormAtStart,
+	    Gbl.RowEvenOdd);
+
+   /***** Write fragment replacing session id and unique name by marks *****/
+   for (i = 0;
+	i < Length;
+	i++)
+      if (LengthSessionId &&
+	  i + LengthSessionId <= Length &&
+	  !strncmp (&Fragment[i],Gbl.Session.Id,LengthSessionId))
+	{
+	 fputc (Cac_MARK_SESSION_ID,FileCache);
+	 i += LengthSessionId - 1;
+	}
+      else if (LengthUniqueName &&
+	       i + LengthUniqueName <= Length &&
+	       !strncmp (&Fragment[i],Gbl.UniqueNameEncrypted,LengthUniqueName))
+	{
+	 fputc (Cac_MARK_UNIQUE_NAME,FileCache);
+	 i += LengthUniqueName - 1;
+	}
+      else
+	 fputc ((int) Fragment[i],FileCache);
+   Error = (ferror (FileCache) != 0);
+   if (fclose (FileCache))
+      Error = true;
+
+   /***** Replace old file by new one.
+          If the new file could not be written completely, discard it *****/
+   if (Error)
+      unlink (FileNameNew);
+   else if (rename (FileNameNew,Cac_Fragment.FileName))
+      unlink (FileNameNew);
+  }
+
+/*****************************************************************************/
+/*************** Invalidate a fragment stored in cache ***********************/
+/*****************************************************************************/
+// If Cod <= 0, all the fragments of this type are invalidated
+
+void Cac_InvalidateFragment (Cac_Fragment_t Fragment,long Cod)
+  {
+   char Path[PATH_MAX+1];
+
+   if (Cod > 0)
+      sprintf (Path,"%s/%s/%s/%ld",
+	       Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_CACHE,Cac_FolderFragment[Fragment],Cod);
+   else
+      sprintf (Path,"%s/%s/%s",
+	       Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_CACHE,Cac_FolderFragment[Fragment]);
+   Fil_RemoveTree (Path);
+  }
+
+/*****************************************************************************/
+/********************** Remove old fragments from cache **********************/
+/*****************************************************************************/
+// Files of fragments are named after many parameters (role, language, form...),
+// so many of them are never used again after being stored
+
+void Cac_RemoveOldFragments (void)
+  {
+   char PathCache[PATH_MAX+1];
+
+   sprintf (PathCache,"%s/%s",
+	    Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_CACHE);
+   Fil_CreateDirIfNotExists (PathCache);
+   Fil_RemoveOldTmpFiles (PathCache,Cfg_TIME_TO_DELETE_CACHE_FRAGMENTS,false);
+  }
+
+/*****************************************************************************/
+/******* Invalidate the lists of institutions, centres and degrees ***********/
+/*****************************************************************************/
+// Called when institutions, centres, degrees or courses are changed,
+// because each list shows also numbers of items in lower levels
+
+void Cac_InvalidateHierarchyLists (void)
+  {
+   Cac_InvalidateFragment (Cac_INS_LIST,-1L);
+   Cac_InvalidateFragment (Cac_CTR_LIST,-1L);
+   Cac_InvalidateFragment (Cac_DEG_LIST,-1L);
+  }
@@ -0,0 +1,60 @@
+// swad_cache.h: cache of HTML fragments
+
+#ifndef _SWAD_CAC
+#define _SWAD_CAC
+/*
+    SWAD (Shared Workspace At a Distance in Spanish),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2016 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <stdbool.h>		// For boolean type
+
+/*****************************************************************************/
+/************************** Public types and constants ***********************/
+/*****************************************************************************/
+
+#define Cac_NUM_FRAGMENTS 6
+typedef enum
+  {
+   Cac_INS_LIST = 0,	// List of institutions of a country
+   Cac_CTR_LIST = 1,	// List of centres of an institution
+   Cac_DEG_LIST = 2,	// List of degrees of a centre
+   Cac_CRS_TT   = 3,	// Timetable of a course
+   Cac_MY_TT    = 4,	// Timetable of a user (classes and office hours)
+   Cac_TUT_TT   = 5,	// Office hours of a teacher
+  } Cac_Fragment_t;
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+bool Cac_StartFragment (Cac_Fragment_t Fragment,long Cod,const char *Variant);
+void Cac_EndFragment (void);
+void Cac_AbortFragment (void);
+
+void Cac_InvalidateFragment (Cac_Fragment_t Fragment,long Cod);
+void Cac_InvalidateHierarchyLists (void);
+
+void Cac_RemoveOldFragments (void);
+
+#endif
@@ -32,6 +32,7 @@
 #include <sys/wait.h>		// For the macro WEXITSTATUS
 #include <unistd.h>		// For unlink
 
+#include "swad_cache.h"
 #include "swad_centre.h"
 #include "swad_constant.h"
 #include "swad_database.h"
@@ -706,22 +707,32 @@ static void Ctr_PutIconToChangePhoto (void)
 
 void Ctr_ShowCtrsOfCurrentIns (void)
   {
+   char Variant[64];
+
    if (Gbl.CurrentIns.Ins.InsCod > 0)
      {
       /***** Get parameter with the type of order in the list of centres *****/
       Ctr_GetParamCtrOrderType ();
 
-      /***** Get list of centres *****/
-      Ctr_GetListCentres (Gbl.CurrentIns.Ins.InsCod);
-
       /***** Write menu to select country and institution *****/
       Deg_WriteMenuAllCourses ();
 
-      /***** List centres *****/
-      Ctr_ListCentres ();
+      /***** List centres from cache or from database *****/
+      sprintf (Variant,"%u_%ld",
+               (unsigned) Gbl.Ctrs.SelectedOrderType,Gbl.CurrentCtr.Ctr.CtrCod);
+      if (Cac_StartFragment (Cac_CTR_LIST,Gbl.CurrentIns.Ins.InsCod,Variant))
+	{
+	 /***** Get list of centres *****/
+	 Ctr_GetListCentres (Gbl.CurrentIns.Ins.InsCod);
+
+	 /***** List centres *****/
+	 Ctr_ListCentres ();
 
-      /***** Free list of centres *****/
-      Ctr_FreeListCentres ();
+	 /***** Free list of centres *****/
+	 Ctr_FreeListCentres ();
+
+	 Cac_EndFragment ();
+	}
      }
   }
 
@@ -1706,6 +1717,9 @@ void Ctr_RemoveCentre (void)
                Ctr.CtrCod);
       DB_QueryDELETE (Query,"can not remove a centre");
 
+      /* Invalidate cached lists of institutions, centres and degrees */
+      Cac_InvalidateHierarchyLists ();
+
       /***** Write message to show the change made *****/
       sprintf (Gbl.Message,Txt_Centre_X_removed,
                Ctr.FullName);
@@ -1792,6 +1806,9 @@ static void Ctr_UpdateCtrInsDB (long CtrCod,long InsCod)
    sprintf (Query,"UPDATE centres SET InsCod='%ld' WHERE CtrCod='%ld'",
             InsCod,CtrCod);
    DB_QueryUPDATE (Query,"can not update the institution of a centre");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
 
 /*****************************************************************************/
@@ -1821,6 +1838,9 @@ void Ctr_ChangeCentrePlace (void)
    sprintf (Query,"UPDATE centres SET PlcCod='%ld' WHERE CtrCod='%ld'",
             NewPlcCod,Ctr->CtrCod);
    DB_QueryUPDATE (Query,"can not update the place of a centre");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
    Ctr->PlcCod = NewPlcCod;
 
    /***** Write message to show the change made *****/
@@ -1929,6 +1949,9 @@ static void Ctr_RenameCentre (struct Centre *Ctr,Cns_ShrtOrFullName_t ShrtOrFull
                      FieldName,NewCtrName,Ctr->CtrCod);
             DB_QueryUPDATE (Query,"can not update the name of a centre");
 
+            /* Invalidate cached lists of institutions, centres and degrees */
+            Cac_InvalidateHierarchyLists ();
+
             /* Write message to show the change made */
             sprintf (Gbl.Message,Txt_The_centre_X_has_been_renamed_as_Y,
                      CurrentCtrName,NewCtrName);
@@ -2043,6 +2066,9 @@ static void Ctr_UpdateCtrWWWDB (long CtrCod,const char NewWWW[Cns_MAX_LENGTH_WWW
    sprintf (Query,"UPDATE centres SET WWW='%s' WHERE CtrCod='%ld'",
 	    NewWWW,CtrCod);
    DB_QueryUPDATE (Query,"can not update the web of a centre");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
 
 /*****************************************************************************/
@@ -2079,6 +2105,9 @@ void Ctr_ChangeCtrStatus (void)
             (unsigned) Status,Ctr->CtrCod);
    DB_QueryUPDATE (Query,"can not update the status of a centre");
 
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
+
    Ctr->Status = Status;
 
    /***** Write message to show the change made *****/
@@ -2716,6 +2745,9 @@ static void Ctr_CreateCentre (struct Centre *Ctr,unsigned Status)
             Ctr->ShrtName,Ctr->FullName,Ctr->WWW);
    Ctr->CtrCod = DB_QueryINSERTandReturnCode (Query,"can not create a new centre");
 
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
+
    /***** Write success message *****/
    sprintf (Gbl.Message,Txt_Created_new_centre_X,
             Ctr->FullName);
@@ -156,13 +156,125 @@
 /****************************** Public constants *****************************/
 /*****************************************************************************/
 
-#define Log_PLATFORM_VERSION	"SWAD 16.50 (2016-11-10)"
+#define Log_PLATFORM_VERSION	"SWAD 16.77.22 (2016-11-29)"
 #define CSS_FILE		"swad16.48.4.css"
 #define JS_FILE			"swad16.46.1.js"
 
 // Number of lines (includes comments but not blank lines) has been got with the following command:
 // nl swad*.c swad*.h css/swad*.css py/swad*.py js/swad*.js soap/swad*.h sql/swad*.sql | tail -1
 /*
+        Version 16.77.22: Nov 29, 2016	Wrong questions in an XML file are found before importing any question. (212534 lines)
+        Version 16.77.21: Nov 29, 2016	Transactions are rolled back on error only if a transaction has been started. (212484 lines)
+        Version 16.77.20: Nov 29, 2016	Content of CDATA sections in XML is added to the content of the element. (212532 lines)
+        Version 16.77.19: Nov 29, 2016	Program swad_average_photos creates the directories of average photos if they do not exist. (212398 lines)
+        Version 16.77.18: Nov 29, 2016	Links to photos are built again without accessing the file system. (212363 lines)
+        Version 16.77.17: Nov 29, 2016	If Markdown conversion of course info fails, the old info is kept and an alert is shown. (212379 lines)
+        Version 16.77.16: Nov 29, 2016	A cached directory tree removed by a concurrent request is treated as a cache miss. (212346 lines)
+        Version 16.77.15: Nov 29, 2016	Comments and CDATA sections containing '>' are skipped correctly when reading XML.
+					If an error is found while importing test questions, no question is stored. (212338 lines)
+        Version 16.77.14: Nov 29, 2016	Fixed size of paths of compiled syllabus. (212274 lines)
+        Version 16.77.13: Nov 29, 2016	Users' photos not completely published are published when shown.
+					Fixed bounded copy of URL of photo of a given size. (212272 lines)
+        Version 16.77.12: Nov 29, 2016	Sending files through the web server disabled by default.
+					By default, each download still creates a temporary public directory with a link to the file,
+					and old temporary directories are still scanned and removed.
+					To avoid this work on each download, a site must:
+					1. Set Cfg_HTTP_HEADER_TO_SEND_FILE to "X-Sendfile" in swad_config.h and rebuild swad.
+					2. Install Apache mod_xsendfile and add to the configuration of swad virtual host:
+					   XSendFile On
+					   XSendFilePath <private swad directory, Cfg_PATH_SWAD_PRIVATE>
+					HTML, SVG, JavaScript and XML files sent as attachments. (212247 lines)
+        Version 16.77.11: Nov 29, 2016	Figures about forums stored in cache. (212226 lines)
+        Version 16.77.10: Nov 29, 2016	Changes in a course invalidate only cached timetables of users in that course. (212201 lines)
+        Version 16.77.9:  Nov 29, 2016	Fragment of page being cached is discarded on error. Old fragments are removed from cache. (212171 lines)
+        Version 16.77.8:  Nov 29, 2016	Data, roles, IDs, nicknames and e-mails of students got at once when listing records. (212117 lines)
+        Version 16.77.7:  Nov 29, 2016	Fixed bug in forums: counters of a forum computed and stored atomically. (211858 lines)
+        Version 16.77.6:  Nov 29, 2016	Students with comments are not removed from an attendance event, only set as absent. (211853 lines)
+        Version 16.77.5:  Nov 29, 2016	Data of attendance events are got only once when listing attendance of students. (211836 lines)
+        Version 16.77.4:  Nov 29, 2016	The course info in rich text is only replaced if the conversion from Markdown to HTML succeeds. (211824 lines)
+        Version 16.77.3:  Nov 29, 2016	Files of marks not indexed are scanned as before, instead of being indexed when viewed. (211806 lines)
+        Version 16.77.2:  Nov 29, 2016	Removed action to switch to my language after authentication, never reached with a single binary. (211678 lines)
+        Version 16.77.1:  Nov 29, 2016	Sending a message to several users invalidates their counters of unseen notifications. (211701 lines)
+        Version 16.77:    Nov 29, 2016	Counters of unseen notifications are always invalidated and recomputed in a transaction. (211703 lines)
+        Version 16.76:    Nov 29, 2016	Fixed cache of directory trees in web service: language in key, version computed once, removed with course. (211723 lines)
+        Version 16.75:    Nov 28, 2016	Questions are imported from an XML file reading one question at a time, and stored in blocks of questions in one transaction. (211718 lines)
+        Version 16.74:    Nov 28, 2016	Time spent in each phase of an action and slowest database queries are stored for a sample of accesses. (211475 lines)
+					2 changes necessary in database:
+CREATE TABLE IF NOT EXISTS log_prof (LogCod INT NOT NULL,ActCod INT NOT NULL,ClickTime DATETIME NOT NULL,TimeParams INT NOT NULL,TimeSession INT NOT NULL,TimePriori INT NOT NULL,TimePosteriori INT NOT NULL,TimePage INT NOT NULL,TimeSend INT NOT NULL,NumQueries INT NOT NULL,TimeQueries INT NOT NULL,UNIQUE INDEX(LogCod),INDEX(ActCod),INDEX(ClickTime));
+CREATE TABLE IF NOT EXISTS log_prof_queries (LogCod INT NOT NULL,ActCod INT NOT NULL,QryInd TINYINT NOT NULL,Site VARCHAR(255) NOT NULL,Query TEXT NOT NULL,NumRows INT NOT NULL,Time INT NOT NULL,UNIQUE INDEX(LogCod,QryInd),INDEX(ActCod));
+
+        Version 16.73:    Nov 28, 2016	Answers to a survey are stored in a single transaction, with counters split in shards. (210782 lines)
+					1 change necessary in database:
+CREATE TABLE IF NOT EXISTS svy_answers_counters (QstCod INT NOT NULL,AnsInd TINYINT NOT NULL,Shard TINYINT NOT NULL,NumUsrs INT NOT NULL DEFAULT 0,UNIQUE INDEX(QstCod,AnsInd,Shard));
+
+        Version 16.72:    Nov 28, 2016	New program swad_average_photos to compute average photos of degrees periodically.
+					Only system administrators can compute average photos from SWAD. (210676 lines)
+        Version 16.71:    Nov 28, 2016	Syllabus is loaded from a binary form built from its XML file. (210361 lines)
+        Version 16.70:    Nov 28, 2016	Users to follow are suggested from a pool precomputed for each user. (210164 lines)
+					1 change necessary in database:
+CREATE TABLE IF NOT EXISTS usr_follow_suggested (UsrCod INT NOT NULL,SuggestedCod INT NOT NULL,Score INT NOT NULL DEFAULT 0,CreatTime DATETIME NOT NULL,UNIQUE INDEX (UsrCod,SuggestedCod),INDEX (SuggestedCod),INDEX (CreatTime));
+
+        Version 16.69:    Nov 28, 2016	Table of connected users is kept in memory.
+					Old connected users are removed only when some sessions expire. (210032 lines)
+					1 change necessary in database:
+ALTER TABLE connected ENGINE=MEMORY;
+
+        Version 16.68:    Nov 28, 2016	File views are appended to a journal and folded periodically into views and counters. (210019 lines)
+					2 changes necessary in database:
+CREATE TABLE IF NOT EXISTS file_view_counters (FilCod INT NOT NULL,NumLoggedUsrs INT NOT NULL DEFAULT 0,NumViewsFromLoggedUsrs INT NOT NULL DEFAULT 0,NumPublicViews INT NOT NULL DEFAULT 0,UNIQUE INDEX(FilCod));
+CREATE TABLE IF NOT EXISTS file_view_pending (ViewCod INT NOT NULL AUTO_INCREMENT,FilCod INT NOT NULL,UsrCod INT NOT NULL,UNIQUE INDEX(ViewCod));
+
+        Version 16.67:    Nov 27, 2016	Photos are published as files when updated, with smaller copies for lists and class photos.
+					Links to photos are built without accessing the file system. (209787 lines)
+					1 change necessary to publish existing photos:
+mysql -N -u swad -p -e "SELECT UsrCod,Photo FROM usr_data WHERE Photo<>''" swad | while read UsrCod Photo; do Priv=/var/www/swad/photo/$(printf "%02u" $((UsrCod % 100)))/$UsrCod.jpg; Publ=/var/www/html/swad/photo/$Photo; rm -f $Publ.jpg; cp $Priv $Publ.jpg; convert $Priv -resize '42x56' -quality 85 ${Publ}_42x56.jpg; convert $Priv -resize '93x124' -quality 85 ${Publ}_93x124.jpg; done
+
+        Version 16.66:    Nov 26, 2016	Files downloaded from file browsers are sent by the web server through X-Sendfile, with ETag, Last-Modified and Range support, without creating temporary public links. (209696 lines)
+        Version 16.65:    Nov 25, 2016	Registering/removing several users in a course resolves all the users' IDs with a single query and commits changes in blocks. (209580 lines)
+        Version 16.64:    Nov 24, 2016	Figures shown in statistics of hierarchy, attendance and messages are cached for each scope in a new table. (209375 lines)
+					1 change necessary in database:
+CREATE TABLE IF NOT EXISTS figures (Figure INT NOT NULL,Scope ENUM('Sys','Cty','Ins','Ctr','Deg','Crs') NOT NULL DEFAULT 'Sys',Cod INT NOT NULL DEFAULT -1,Value INT NOT NULL,LastUpdate DATETIME NOT NULL,UNIQUE INDEX(Figure,Scope,Cod));
+
+        Version 16.63:    Nov 23, 2016	Views of timetables are cached. Column spans are computed once per timetable.
+					Names of courses and groups are got with the timetable instead of one query per cell. (208988 lines)
+        Version 16.62:    Nov 22, 2016	Lists of institutions, centres and degrees are cached as HTML fragments.
+					New module swad_cache to store fragments of pages in private cache directory. (208856 lines)
+        Version 16.61:    Nov 21, 2016	Listing several records of students gets the users in course
+					and the texts of all the fields of their records in two queries. (208445 lines)
+        Version 16.60:    Nov 20, 2016	Messages are delivered to all the recipients at once,
+					getting their data in one query and inserting received messages and notifications in batches. (208222 lines)
+        Version 16.59:    Nov 19, 2016	Number of posts, writers and readers stored in each forum thread.
+					Number of threads and posts of each forum stored in a new table.
+					Last time each user read each forum stored in a new table. (208022 lines)
+					7 changes necessary in database:
+ALTER TABLE forum_thread ADD COLUMN NumPsts INT NOT NULL DEFAULT 0 AFTER LastPstCod;
+ALTER TABLE forum_thread ADD COLUMN NumWriters INT NOT NULL DEFAULT 0 AFTER NumPsts;
+ALTER TABLE forum_thread ADD COLUMN NumReaders INT NOT NULL DEFAULT 0 AFTER NumWriters;
+UPDATE forum_thread SET NumPsts=(SELECT COUNT(*) FROM forum_post WHERE forum_post.ThrCod=forum_thread.ThrCod),NumWriters=(SELECT COUNT(DISTINCT UsrCod) FROM forum_post WHERE forum_post.ThrCod=forum_thread.ThrCod),NumReaders=(SELECT COUNT(*) FROM forum_thr_read WHERE forum_thr_read.ThrCod=forum_thread.ThrCod);
+CREATE TABLE IF NOT EXISTS forum_counters (ForumType TINYINT NOT NULL,Location INT NOT NULL DEFAULT -1,NumThrs INT NOT NULL DEFAULT 0,NumPsts INT NOT NULL DEFAULT 0,UNIQUE INDEX(ForumType,Location));
+CREATE TABLE IF NOT EXISTS forum_read (UsrCod INT NOT NULL,ForumType TINYINT NOT NULL,Location INT NOT NULL DEFAULT -1,ReadTime DATETIME NOT NULL,UNIQUE INDEX(UsrCod,ForumType,Location),INDEX(ForumType,Location));
+INSERT INTO forum_read (UsrCod,ForumType,Location,ReadTime) SELECT forum_thr_read.UsrCod,forum_thread.ForumType,forum_thread.Location,MAX(forum_thr_read.ReadTime) FROM forum_thr_read,forum_thread WHERE forum_thr_read.ThrCod=forum_thread.ThrCod GROUP BY forum_thr_read.UsrCod,forum_thread.ForumType,forum_thread.Location;
+
+        Version 16.58:    Nov 18, 2016	Roll call of students in an attendance event is stored with one INSERT ... ON DUPLICATE KEY UPDATE and one DELETE.
+					Web service function sendAttendanceUsers registers all the users with a single query. (207828 lines)
+        Version 16.57:    Nov 17, 2016	Attendance of a list of students to several events is got from database with a single query, instead of one query for each student and event. (207720 lines)
+        Version 16.56:    Nov 16, 2016	Rich text of course info is converted from Markdown to HTML when it is saved, and the HTML is stored in the course directory, instead of running pandoc on every view. (207405 lines)
+        Version 16.55:    Nov 15, 2016	Files of marks are indexed on upload, so the row of each student is found without parsing the whole file. (207313 lines)
+					3 changes necessary in database:
+ALTER TABLE marks_properties ADD COLUMN HeaderEnd INT NOT NULL DEFAULT -1 AFTER Footer;
+ALTER TABLE marks_properties ADD COLUMN FooterStart INT NOT NULL DEFAULT -1 AFTER HeaderEnd;
+CREATE TABLE IF NOT EXISTS marks_rows (FilCod INT NOT NULL,UsrID CHAR(16) NOT NULL,RowStart INT NOT NULL,RowEnd INT NOT NULL,UNIQUE INDEX(FilCod,UsrID));
+
+        Version 16.54:    Nov 14, 2016	A single binary swad with texts in all languages, selected at run time, instead of one binary for each language.
+					New script swad_text_tables.sh to generate tables of texts. (207145 lines)
+        Version 16.53:    Nov 13, 2016	Notifications to all users about a new event are stored with INSERT ... SELECT, checking users' preferences in the query. (207102 lines)
+        Version 16.52:    Nov 12, 2016	Table with number of unseen and new notifications of each user, to avoid counting them on every page. (207054 lines)
+					1 change necessary in database:
+CREATE TABLE IF NOT EXISTS notif_unseen (UsrCod INT NOT NULL,NumUnseen INT NOT NULL DEFAULT 0,NumNew INT NOT NULL DEFAULT 0,UNIQUE INDEX(UsrCod));
+
+        Version 16.51:    Nov 11, 2016	Cache of directory trees in web service.
+					New web service function getDirectoryTreeIfChanged.
+					Skip queries in getTests when test questions have not changed. (206861 lines)
         Version 16.50:    Nov 10, 2016	My frequent actions are moved from PROFILE tab to STATS tab.
 					Some messages translated. (206558 lines)
         Version 16.49.1:  Nov 10, 2016	Message translated. (206556 lines)
@@ -349,6 +349,13 @@
 /* Folder for temporary public links to file zones, used when displaying file browsers, inside public swad directory */
 #define Cfg_FOLDER_FILE_BROWSER_TMP		"tmp"			// Created automatically the first time it is accessed
 
+/* HTTP header used to pass to the web server the sending of a file to download.
+   If empty, files are downloaded through temporary public links.
+   To enable it, set it to "X-Sendfile" and install Apache mod_xsendfile with:
+   XSendFile On
+   XSendFilePath <private swad directory> */
+#define Cfg_HTTP_HEADER_TO_SEND_FILE		""
+
 /* Folder where temporary files are created for students' marks, inside private swad directory */
 #define Cfg_FOLDER_MARK				"mark"			// Created automatically the first time it is accessed
 
@@ -371,6 +378,12 @@
 /* Folders for temporary users' photos inside photos directories */
 #define Cfg_FOLDER_PHOTO_TMP			"tmp"			// Created automatically the first time it is accessed
 
+/* Folder for cached responses of the web service, inside private swad directory */
+#define Cfg_FOLDER_WS_CACHE			"ws"			// Created automatically the first time it is accessed
+
+/* Folder for cached fragments of HTML pages, inside private swad directory */
+#define Cfg_FOLDER_CACHE			"cache"			// Created automatically the first time it is accessed
+
 /* Folder for reports, inside public swad directory */
 #define Cfg_FOLDER_REP 				"rep"			// Created automatically the first time it is accessed
 
@@ -395,6 +408,7 @@
 #define Cfg_SYLLABUS_FOLDER_LECTURES		"lec"
 #define Cfg_SYLLABUS_FOLDER_PRACTICALS		"pra"
 #define Cfg_SYLLABUS_FILENAME			"syllabus.xml"
+#define Cfg_SYLLABUS_COMPILED_FILENAME		"syllabus.bin"	// Binary form of syllabus.xml, built from it
 
 /* Main folders in file browsers */
 #define Cfg_CRS_INFO_INTRODUCTION		"intro"
@@ -450,6 +464,8 @@
 
 #define Cfg_DAYS_IN_RECENT_LOG				  8	// Only accesses in these last days + 1 are stored in recent log.
 								// Important!!! Must be 1 <= Cfg_DAYS_IN_RECENT_LOG <= 29
+#define Cfg_PROFILE_ONE_OF_N_ACCESSES			 10	// Times of phases and slowest queries are stored for one of each these accesses (0 = never)
+#define Cfg_DAYS_IN_PROFILE_LOG				  8	// Only profiles in these last days are stored in profile log.
 #define Cfg_TIMES_PER_SECOND_REFRESH_CONNECTED		  2	// Execute this CGI to refresh connected users about these times per second
 #define Cfg_MIN_TIME_TO_REFRESH_CONNECTED		((time_t)(                   60UL))	// Refresh period of connected users in seconds
 #define Cfg_MAX_TIME_TO_REFRESH_CONNECTED		((time_t)(              15UL*60UL))	// Refresh period of connected users in seconds
@@ -467,6 +483,8 @@
 
 #define Cfg_TIME_TO_DELETE_HTML_OUTPUT			((time_t)(              30UL*60UL))	// Remove the HTML output files older than these seconds
 
+#define Cfg_TIME_TO_DELETE_CACHE_FRAGMENTS		((time_t)(          2UL*60UL*60UL))	// Fragments of pages stored in cache are deleted after these seconds
+
 #define Cfg_TIME_TO_ABORT_FILE_UPLOAD			((time_t)(              55UL*60UL))	// After these seconds uploading data, abort upload.
 
 #define Cfg_TIME_TO_DELETE_BROWSER_TMP_FILES		((time_t)(          2UL*60UL*60UL))  	// Temporary files are deleted after these seconds
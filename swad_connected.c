@@ -59,9 +59,7 @@ static void Con_ShowConnectedUsrsBelongingToLocation (void);
 
 static void Con_ShowConnectedUsrsWithARoleBelongingToCurrentLocationOnMainZone (Rol_Role_t Role);
 static void Con_ShowConnectedUsrsWithARoleBelongingToCurrentCrsOnRightColumn (Rol_Role_t Role);
-static unsigned Con_GetConnectedGuestsTotal (void);
-static unsigned Con_GetConnectedStdsTotal (void);
-static unsigned Con_GetConnectedTchsTotal (void);
+static void Con_GetConnectedUsrsTotal (unsigned UsrsTotal[Rol_NUM_ROLES]);
 static void Con_GetNumConnectedUsrsWithARoleBelongingCurrentLocation (Rol_Role_t Role,struct ConnectedUsrs *Usrs);
 static void Con_ComputeConnectedUsrsWithARoleCurrentCrsOneByOne (Rol_Role_t Role);
 static void Con_ShowConnectedUsrsCurrentCrsOneByOneOnRightColumn (Rol_Role_t Role);
@@ -340,10 +338,18 @@ void Con_ShowGlobalConnectedUsrs (void)
    extern const char *Txt_users[Usr_NUM_SEXS];
    extern const char *Txt_ROLES_SINGUL_abc[Rol_NUM_ROLES][Usr_NUM_SEXS];
    extern const char *Txt_ROLES_PLURAL_abc[Rol_NUM_ROLES][Usr_NUM_SEXS];
-   unsigned StdsTotal = Con_GetConnectedStdsTotal ();
-   unsigned TchsTotal = Con_GetConnectedTchsTotal ();
-   unsigned WithoutCoursesTotal = Con_GetConnectedGuestsTotal ();
-   unsigned UsrsTotal = StdsTotal + TchsTotal + WithoutCoursesTotal;
+   unsigned UsrsTotalWithRole[Rol_NUM_ROLES];
+   unsigned StdsTotal;
+   unsigned TchsTotal;
+   unsigned WithoutCoursesTotal;
+   unsigned UsrsTotal;
+
+   /***** Get number of connected users with each role *****/
+   Con_GetConnectedUsrsTotal (UsrsTotalWithRole);
+   StdsTotal           = UsrsTotalWithRole[Rol_STUDENT];
+   TchsTotal           = UsrsTotalWithRole[Rol_TEACHER];
+   WithoutCoursesTotal = UsrsTotalWithRole[Rol__GUEST_];
+   UsrsTotal = StdsTotal + TchsTotal + WithoutCoursesTotal;
 
    /***** Container start *****/
    fprintf (Gbl.F.Out,"<div class=\"CONNECTED LEFT_RIGHT_CONTENT_WIDTH\">");
@@ -709,67 +715,62 @@ void Con_UpdateMeInConnectedList (void)
 /*****************************************************************************/
 /************************** Remove old connected uses ************************/
 /*****************************************************************************/
+// Call this function only when some sessions have been removed
 
 void Con_RemoveOldConnected (void)
   {
-   char Query[512];
-
    /***** Remove old users from connected list *****/
-   sprintf (Query,"DELETE FROM connected WHERE UsrCod NOT IN"
-                  " (SELECT DISTINCT(UsrCod) FROM sessions)");
-   DB_QueryDELETE (Query,"can not remove old users from list of connected users");
+   DB_QueryDELETE ("DELETE connected FROM connected"
+                   " LEFT JOIN sessions ON connected.UsrCod=sessions.UsrCod"
+                   " WHERE sessions.UsrCod IS NULL",
+                   "can not remove old users from list of connected users");
   }
 
 /*****************************************************************************/
-/*************************** Get connected guests ***************************/
+/****************** Get number of connected users by role ********************/
 /*****************************************************************************/
+// All the roles are counted with only one query
 
-static unsigned Con_GetConnectedGuestsTotal (void)
+static void Con_GetConnectedUsrsTotal (unsigned UsrsTotal[Rol_NUM_ROLES])
   {
-   char Query[128];
-
-   if (!Gbl.DB.DatabaseIsOpen)
-      return 0;
-
-   /***** Get number of connected users not belonging to any course *****/
-   sprintf (Query,"SELECT COUNT(*) FROM connected"
-	          " WHERE RoleInLastCrs='%u'",
-            (unsigned) Rol__GUEST_);
-   return (unsigned) DB_QueryCOUNT (Query,"can not get number of connected users who not belong to any course");
-  }
-
-/*****************************************************************************/
-/*************************** Get connected students **************************/
-/*****************************************************************************/
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned long NumRows;
+   unsigned long NumRow;
+   Rol_Role_t Role;
+   unsigned UnsignedNum;
 
-static unsigned Con_GetConnectedStdsTotal (void)
-  {
-   char Query[128];
+   /***** Reset number of connected users with each role *****/
+   for (Role = (Rol_Role_t) 0;
+	Role < Rol_NUM_ROLES;
+	Role++)
+      UsrsTotal[Role] = 0;
 
    if (!Gbl.DB.DatabaseIsOpen)
-      return 0;
-
-   /***** Get number of connected students from database *****/
-   sprintf (Query,"SELECT COUNT(*) FROM connected WHERE RoleInLastCrs='%u'",
-            (unsigned) Rol_STUDENT);
-   return (unsigned) DB_QueryCOUNT (Query,"can not get number of connected students");
-  }
-
-/*****************************************************************************/
-/*************************** Get connected teachers **************************/
-/*****************************************************************************/
+      return;
 
-static unsigned Con_GetConnectedTchsTotal (void)
-  {
-   char Query[256];
+   /***** Get number of connected users with each role from database *****/
+   NumRows = DB_QuerySELECT ("SELECT RoleInLastCrs,COUNT(*) FROM connected"
+	                     " GROUP BY RoleInLastCrs",
+                             &mysql_res,"can not get number of connected users");
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
 
-   if (!Gbl.DB.DatabaseIsOpen)
-      return 0;
+      /* Get role (row[0]) */
+      if (sscanf (row[0],"%u",&UnsignedNum) == 1)
+	 if (UnsignedNum < Rol_NUM_ROLES)
+	   {
+	    /* Get number of users with this role (row[1]) */
+	    if (sscanf (row[1],"%u",&UsrsTotal[UnsignedNum]) != 1)
+	       UsrsTotal[UnsignedNum] = 0;
+	   }
+     }
 
-   /***** Get number of connected teachers from database *****/
-   sprintf (Query,"SELECT COUNT(*) FROM connected WHERE RoleInLastCrs='%u'",
-            (unsigned) Rol_TEACHER);
-   return (unsigned) DB_QueryCOUNT (Query,"can not get number of connected teachers");
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
   }
 
 /*****************************************************************************/
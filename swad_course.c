@@ -31,6 +31,7 @@
 #include <stdlib.h>		// For getenv, etc.
 #include <string.h>		// For string functions
 
+#include "swad_cache.h"
 #include "swad_course.h"
 #include "swad_constant.h"
 #include "swad_database.h"
@@ -47,6 +48,7 @@
 #include "swad_RSS.h"
 #include "swad_tab.h"
 #include "swad_theme.h"
+#include "swad_timetable.h"
 
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
@@ -1988,6 +1990,9 @@ static void Crs_CreateCourse (struct Course *Crs,unsigned Status)
             Crs->ShrtName,Crs->FullName);
    Crs->CrsCod = DB_QueryINSERTandReturnCode (Query,"can not create a new course");
 
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
+
    /***** Create success message *****/
    sprintf (Gbl.Message,Txt_Created_new_course_X,Crs->FullName);
   }
@@ -2191,6 +2196,9 @@ void Crs_RemoveCourseCompletely (long CrsCod)
    /***** Remove course from table of courses in database *****/
    sprintf (Query,"DELETE FROM courses WHERE CrsCod='%ld'",CrsCod);
    DB_QueryDELETE (Query,"can not remove a course");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
 
 /*****************************************************************************/
@@ -2209,6 +2217,10 @@ static void Crs_EmptyCourseCompletely (long CrsCod)
    Crs.CrsCod = CrsCod;
    Crs_GetDataOfCourseByCod (&Crs);
 
+   /***** Invalidate cached timetables of this course and all its users,
+          before removing them from the course *****/
+   TT_InvalidateCachedTimeTables (CrsCod,-1L);
+
    /***** Remove all the students in the course *****/
    Enr_RemAllStdsInCrs (&Crs);
 
@@ -2321,6 +2333,11 @@ static void Crs_EmptyCourseCompletely (long CrsCod)
    sprintf (PathRelCrs,"%s/%s/%ld",
             Cfg_PATH_SWAD_PUBLIC,Cfg_FOLDER_CRS,CrsCod);
    Fil_RemoveTree (PathRelCrs);
+
+   /***** Remove cached directory trees of the course for web service *****/
+   sprintf (PathRelCrs,"%s/%s/%ld",
+            Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_WS_CACHE,CrsCod);
+   Fil_RemoveTree (PathRelCrs);
   }
 
 /*****************************************************************************/
@@ -2474,6 +2491,9 @@ static void Crs_UpdateCrsDegDB (long CrsCod,long DegCod)
    sprintf (Query,"UPDATE courses SET DegCod='%ld' WHERE CrsCod='%ld'",
 	    DegCod,CrsCod);
    DB_QueryUPDATE (Query,"can not move course to another degree");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
 
 /*****************************************************************************/
@@ -2790,6 +2810,9 @@ void Crs_ChangeCrsStatus (void)
             (unsigned) Status,Crs->CrsCod);
    DB_QueryUPDATE (Query,"can not update the status of a course");
 
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
+
    Crs->Status = Status;
 
    /***** Create message to show the change made *****/
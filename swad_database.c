@@ -33,6 +33,7 @@
 #include "swad_config.h"
 #include "swad_database.h"
 #include "swad_global.h"
+#include "swad_profiler.h"
 #include "swad_text.h"
 
 /*****************************************************************************/
@@ -489,7 +490,7 @@ mysql> DESCRIBE connected;
                    "LastTime DATETIME NOT NULL,"
                    "UNIQUE INDEX(UsrCod),"
                    "INDEX(RoleInLastCrs),"
-                   "INDEX(LastCrsCod))");
+                   "INDEX(LastCrsCod)) ENGINE = MEMORY;");
 
    /***** Table countries *****/
 /*
@@ -981,6 +982,28 @@ mysql> DESCRIBE expanded_folders;
                    "INDEX(FileBrowser,Cod),"
                    "INDEX(WorksUsrCod))");
 
+   /***** Table figures *****/
+/*
+mysql> DESCRIBE figures;
++------------+-------------------------------------------+------+-----+---------+-------+
+| Field      | Type                                      | Null | Key | Default | Extra |
++------------+-------------------------------------------+------+-----+---------+-------+
+| Figure     | int(11)                                   | NO   | PRI | NULL    |       |
+| Scope      | enum('Sys','Cty','Ins','Ctr','Deg','Crs') | NO   | PRI | Sys     |       |
+| Cod        | int(11)                                   | NO   | PRI | -1      |       |
+| Value      | int(11)                                   | NO   |     | NULL    |       |
+| LastUpdate | datetime                                  | NO   |     | NULL    |       |
++------------+-------------------------------------------+------+-----+---------+-------+
+5 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS figures ("
+                   "Figure INT NOT NULL,"
+                   "Scope ENUM('Sys','Cty','Ins','Ctr','Deg','Crs') NOT NULL DEFAULT 'Sys',"
+                   "Cod INT NOT NULL DEFAULT -1,"
+                   "Value INT NOT NULL,"
+                   "LastUpdate DATETIME NOT NULL,"
+                   "UNIQUE INDEX(Figure,Scope,Cod))");
+
    /***** Table file_browser_last *****/
 /*
 mysql> DESCRIBE file_browser_last;
@@ -1047,6 +1070,44 @@ mysql> DESCRIBE file_view;
 		   "UNIQUE INDEX(FilCod,UsrCod),"
 		   "INDEX(UsrCod))");
 
+   /***** Table file_view_counters *****/
+/*
+mysql> DESCRIBE file_view_counters;
++------------------------+---------+------+-----+---------+-------+
+| Field                  | Type    | Null | Key | Default | Extra |
++------------------------+---------+------+-----+---------+-------+
+| FilCod                 | int(11) | NO   | PRI | NULL    |       |
+| NumLoggedUsrs          | int(11) | NO   |     | 0       |       |
+| NumViewsFromLoggedUsrs | int(11) | NO   |     | 0       |       |
+| NumPublicViews         | int(11) | NO   |     | 0       |       |
++------------------------+---------+------+-----+---------+-------+
+4 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS file_view_counters ("
+		   "FilCod INT NOT NULL,"
+		   "NumLoggedUsrs INT NOT NULL DEFAULT 0,"
+		   "NumViewsFromLoggedUsrs INT NOT NULL DEFAULT 0,"
+		   "NumPublicViews INT NOT NULL DEFAULT 0,"
+		   "UNIQUE INDEX(FilCod))");
+
+   /***** Table file_view_pending *****/
+/*
+mysql> DESCRIBE file_view_pending;
++---------+---------+------+-----+---------+----------------+
+| Field   | Type    | Null | Key | Default | Extra          |
++---------+---------+------+-----+---------+----------------+
+| ViewCod | int(11) | NO   | PRI | NULL    | auto_increment |
+| FilCod  | int(11) | NO   |     | NULL    |                |
+| UsrCod  | int(11) | NO   |     | NULL    |                |
++---------+---------+------+-----+---------+----------------+
+3 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS file_view_pending ("
+		   "ViewCod INT NOT NULL AUTO_INCREMENT,"
+		   "FilCod INT NOT NULL,"
+		   "UsrCod INT NOT NULL,"
+		   "UNIQUE INDEX(ViewCod))");
+
    /***** Table files *****/
 /*
 mysql> DESCRIBE files;
@@ -1082,6 +1143,26 @@ mysql> DESCRIBE files;
                    "INDEX(ZoneUsrCod),"
                    "INDEX(PublisherUsrCod))");
 
+   /***** Table forum_counters *****/
+/*
+mysql> DESCRIBE forum_counters;
++-----------+------------+------+-----+---------+-------+
+| Field     | Type       | Null | Key | Default | Extra |
++-----------+------------+------+-----+---------+-------+
+| ForumType | tinyint(4) | NO   | PRI | NULL    |       |
+| Location  | int(11)    | NO   | PRI | -1      |       |
+| NumThrs   | int(11)    | NO   |     | 0       |       |
+| NumPsts   | int(11)    | NO   |     | 0       |       |
++-----------+------------+------+-----+---------+-------+
+4 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS forum_counters ("
+                   "ForumType TINYINT NOT NULL,"
+                   "Location INT NOT NULL DEFAULT -1,"
+                   "NumThrs INT NOT NULL DEFAULT 0,"
+                   "NumPsts INT NOT NULL DEFAULT 0,"
+                   "UNIQUE INDEX(ForumType,Location))");
+
    /***** Table forum_disabled_post *****/
 /*
 mysql> DESCRIBE forum_disabled_post;
@@ -1138,6 +1219,27 @@ mysql> DESCRIBE forum_post;
                    "INDEX(CreatTime),"
                    "INDEX(ModifTime))");
 
+   /***** Table forum_read *****/
+/*
+mysql> DESCRIBE forum_read;
++-----------+------------+------+-----+---------+-------+
+| Field     | Type       | Null | Key | Default | Extra |
++-----------+------------+------+-----+---------+-------+
+| UsrCod    | int(11)    | NO   | PRI | NULL    |       |
+| ForumType | tinyint(4) | NO   | PRI | NULL    |       |
+| Location  | int(11)    | NO   | PRI | -1      |       |
+| ReadTime  | datetime   | NO   |     | NULL    |       |
++-----------+------------+------+-----+---------+-------+
+4 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS forum_read ("
+                   "UsrCod INT NOT NULL,"
+                   "ForumType TINYINT NOT NULL,"
+                   "Location INT NOT NULL DEFAULT -1,"
+                   "ReadTime DATETIME NOT NULL,"
+                   "UNIQUE INDEX(UsrCod,ForumType,Location),"
+                   "INDEX(ForumType,Location))");
+
    /***** Table forum_thr_clip *****/
 /*
 mysql> DESCRIBE forum_thr_clip;
@@ -1186,8 +1288,11 @@ mysql> DESCRIBE forum_thread;
 | Location    | int(11)    | NO   | MUL | -1      |                |
 | FirstPstCod | int(11)    | NO   | UNI | NULL    |                |
 | LastPstCod  | int(11)    | NO   | UNI | NULL    |                |
+| NumPsts     | int(11)    | NO   |     | 0       |                |
+| NumWriters  | int(11)    | NO   |     | 0       |                |
+| NumReaders  | int(11)    | NO   |     | 0       |                |
 +-------------+------------+------+-----+---------+----------------+
-5 rows in set (0.00 sec)
+8 rows in set (0.00 sec)
 */
    DB_CreateTable ("CREATE TABLE IF NOT EXISTS forum_thread ("
                    "ThrCod INT NOT NULL AUTO_INCREMENT,"
@@ -1195,6 +1300,9 @@ mysql> DESCRIBE forum_thread;
                    "Location INT NOT NULL DEFAULT -1,"
                    "FirstPstCod INT NOT NULL,"
                    "LastPstCod INT NOT NULL,"
+                   "NumPsts INT NOT NULL DEFAULT 0,"
+                   "NumWriters INT NOT NULL DEFAULT 0,"
+                   "NumReaders INT NOT NULL DEFAULT 0,"
                    "UNIQUE INDEX(ThrCod),"
                    "INDEX(ForumType),"
                    "INDEX(Location),"
@@ -1378,6 +1486,69 @@ mysql> DESCRIBE log_full;
                    "INDEX(UsrCod),"
                    "INDEX(ClickTime,Role))");
 
+   /***** Table log_prof *****/
+/*
+mysql> DESCRIBE log_prof;
++----------------+----------+------+-----+---------+-------+
+| Field          | Type     | Null | Key | Default | Extra |
++----------------+----------+------+-----+---------+-------+
+| LogCod         | int(11)  | NO   | PRI | NULL    |       |
+| ActCod         | int(11)  | NO   | MUL | NULL    |       |
+| ClickTime      | datetime | NO   | MUL | NULL    |       |
+| TimeParams     | int(11)  | NO   |     | NULL    |       |
+| TimeSession    | int(11)  | NO   |     | NULL    |       |
+| TimePriori     | int(11)  | NO   |     | NULL    |       |
+| TimePosteriori | int(11)  | NO   |     | NULL    |       |
+| TimePage       | int(11)  | NO   |     | NULL    |       |
+| TimeSend       | int(11)  | NO   |     | NULL    |       |
+| NumQueries     | int(11)  | NO   |     | NULL    |       |
+| TimeQueries    | int(11)  | NO   |     | NULL    |       |
++----------------+----------+------+-----+---------+-------+
+11 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS log_prof ("
+                   "LogCod INT NOT NULL,"
+                   "ActCod INT NOT NULL,"
+                   "ClickTime DATETIME NOT NULL,"
+                   "TimeParams INT NOT NULL,"
+                   "TimeSession INT NOT NULL,"
+                   "TimePriori INT NOT NULL,"
+                   "TimePosteriori INT NOT NULL,"
+                   "TimePage INT NOT NULL,"
+                   "TimeSend INT NOT NULL,"
+                   "NumQueries INT NOT NULL,"
+                   "TimeQueries INT NOT NULL,"
+                   "UNIQUE INDEX(LogCod),"
+                   "INDEX(ActCod),"
+                   "INDEX(ClickTime))");
+
+   /***** Table log_prof_queries *****/
+/*
+mysql> DESCRIBE log_prof_queries;
++---------+--------------+------+-----+---------+-------+
+| Field   | Type         | Null | Key | Default | Extra |
++---------+--------------+------+-----+---------+-------+
+| LogCod  | int(11)      | NO   | PRI | NULL    |       |
+| ActCod  | int(11)      | NO   | MUL | NULL    |       |
+| QryInd  | tinyint(4)   | NO   | PRI | NULL    |       |
+| Site    | varchar(255) | NO   |     | NULL    |       |
+| Query   | text         | NO   |     | NULL    |       |
+| NumRows | int(11)      | NO   |     | NULL    |       |
+| Time    | int(11)      | NO   |     | NULL    |       |
++---------+--------------+------+-----+---------+-------+
+7 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS log_prof_queries ("
+                   "LogCod INT NOT NULL,"
+                   "ActCod INT NOT NULL,"
+                   "QryInd TINYINT NOT NULL,"
+                   "Site VARCHAR(255) NOT NULL,"
+                   "Query TEXT NOT NULL,"
+                   "NumRows INT NOT NULL,"
+                   "Time INT NOT NULL,"
+                   "UNIQUE INDEX(LogCod,QryInd),"
+                   "INDEX(ActCod))");
+
    /***** Table log_recent *****/
 /*
 mysql> DESCRIBE log_recent;
@@ -1469,21 +1640,45 @@ mysql> DESCRIBE mail_domains;
    /***** Table marks_properties *****/
 /*
 mysql> DESCRIBE marks_properties;
-+--------+---------+------+-----+---------+-------+
-| Field  | Type    | Null | Key | Default | Extra |
-+--------+---------+------+-----+---------+-------+
-| FilCod | int(11) | NO   | PRI | NULL    |       |
-| Header | int(11) | NO   |     | NULL    |       |
-| Footer | int(11) | NO   |     | NULL    |       |
-+--------+---------+------+-----+---------+-------+
-3 rows in set (0.00 sec)
++-------------+---------+------+-----+---------+-------+
+| Field       | Type    | Null | Key | Default | Extra |
++-------------+---------+------+-----+---------+-------+
+| FilCod      | int(11) | NO   | PRI | NULL    |       |
+| Header      | int(11) | NO   |     | NULL    |       |
+| Footer      | int(11) | NO   |     | NULL    |       |
+| HeaderEnd   | int(11) | NO   |     | -1      |       |
+| FooterStart | int(11) | NO   |     | -1      |       |
++-------------+---------+------+-----+---------+-------+
+5 rows in set (0.00 sec)
 */
    DB_CreateTable ("CREATE TABLE IF NOT EXISTS marks_properties ("
                    "FilCod INT NOT NULL,"
                    "Header INT NOT NULL,"
                    "Footer INT NOT NULL,"
+                   "HeaderEnd INT NOT NULL DEFAULT -1,"
+                   "FooterStart INT NOT NULL DEFAULT -1,"
                    "UNIQUE INDEX(FilCod))");
 
+   /***** Table marks_rows *****/
+/*
+mysql> DESCRIBE marks_rows;
++----------+----------+------+-----+---------+-------+
+| Field    | Type     | Null | Key | Default | Extra |
++----------+----------+------+-----+---------+-------+
+| FilCod   | int(11)  | NO   | PRI | NULL    |       |
+| UsrID    | char(16) | NO   | PRI | NULL    |       |
+| RowStart | int(11)  | NO   |     | NULL    |       |
+| RowEnd   | int(11)  | NO   |     | NULL    |       |
++----------+----------+------+-----+---------+-------+
+4 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS marks_rows ("
+                   "FilCod INT NOT NULL,"
+                   "UsrID CHAR(16) NOT NULL,"
+                   "RowStart INT NOT NULL,"
+                   "RowEnd INT NOT NULL,"
+                   "UNIQUE INDEX(FilCod,UsrID))");
+
    /***** Table msg_banned *****/
 /*
 mysql> DESCRIBE msg_banned;
@@ -1741,6 +1936,24 @@ mysql> DESCRIBE notif;
                    "INDEX(CrsCod),"
                    "INDEX(TimeNotif))");
 
+   /***** Table notif_unseen *****/
+/*
+mysql> DESCRIBE notif_unseen;
++-----------+---------+------+-----+---------+-------+
+| Field     | Type    | Null | Key | Default | Extra |
++-----------+---------+------+-----+---------+-------+
+| UsrCod    | int(11) | NO   | PRI | NULL    |       |
+| NumUnseen | int(11) | NO   |     | 0       |       |
+| NumNew    | int(11) | NO   |     | 0       |       |
++-----------+---------+------+-----+---------+-------+
+3 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS notif_unseen ("
+                   "UsrCod INT NOT NULL,"
+                   "NumUnseen INT NOT NULL DEFAULT 0,"
+                   "NumNew INT NOT NULL DEFAULT 0,"
+                   "UNIQUE INDEX(UsrCod))");
+
    /***** Table pending_emails *****/
 /*
 MariaDB [swad]> DESCRIBE pending_emails;
@@ -2140,6 +2353,26 @@ mysql> DESCRIBE svy_answers;
                    "Answer TEXT NOT NULL,"
                    "UNIQUE INDEX(QstCod,AnsInd))");
 
+   /***** Table svy_answers_counters *****/
+/*
+mysql> DESCRIBE svy_answers_counters;
++---------+------------+------+-----+---------+-------+
+| Field   | Type       | Null | Key | Default | Extra |
++---------+------------+------+-----+---------+-------+
+| QstCod  | int(11)    | NO   | PRI | NULL    |       |
+| AnsInd  | tinyint(4) | NO   | PRI | NULL    |       |
+| Shard   | tinyint(4) | NO   | PRI | NULL    |       |
+| NumUsrs | int(11)    | NO   |     | 0       |       |
++---------+------------+------+-----+---------+-------+
+4 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS svy_answers_counters ("
+                   "QstCod INT NOT NULL,"
+                   "AnsInd TINYINT NOT NULL,"
+                   "Shard TINYINT NOT NULL,"
+                   "NumUsrs INT NOT NULL DEFAULT 0,"
+                   "UNIQUE INDEX(QstCod,AnsInd,Shard))");
+
    /***** Table svy_grp *****/
 /*
 mysql> DESCRIBE svy_grp;
@@ -2644,6 +2877,28 @@ mysql> DESCRIBE usr_follow;
 	           "UNIQUE INDEX (FollowedCod,FollowerCod),"
 	           "INDEX (FollowTime))");
 
+   /***** Table usr_follow_suggested *****/
+   /*
+mysql> DESCRIBE usr_follow_suggested;
++--------------+----------+------+-----+---------+-------+
+| Field        | Type     | Null | Key | Default | Extra |
++--------------+----------+------+-----+---------+-------+
+| UsrCod       | int(11)  | NO   | PRI | NULL    |       |
+| SuggestedCod | int(11)  | NO   | PRI | NULL    |       |
+| Score        | int(11)  | NO   |     | 0       |       |
+| CreatTime    | datetime | NO   | MUL | NULL    |       |
++--------------+----------+------+-----+---------+-------+
+4 rows in set (0.00 sec)
+   */
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS usr_follow_suggested ("
+	           "UsrCod INT NOT NULL,"
+	           "SuggestedCod INT NOT NULL,"
+	           "Score INT NOT NULL DEFAULT 0,"
+	           "CreatTime DATETIME NOT NULL,"
+	           "UNIQUE INDEX (UsrCod,SuggestedCod),"
+	           "INDEX (SuggestedCod),"
+	           "INDEX (CreatTime))");
+
 /***** Table usr_IDs *****/
 /*
 mysql> DESCRIBE usr_IDs;
@@ -2845,16 +3100,21 @@ void DB_CloseDBConnection (void)
 
 unsigned long DB_QuerySELECT (const char *Query,MYSQL_RES **mysql_res,const char *MsgError)
   {
+   unsigned long NumRows;
+
    /***** Query database *****/
+   Pfl_StartQuery ();
    if (mysql_query (&Gbl.mysql,Query))
       DB_ExitOnMySQLError (MsgError);
 
    /***** Store query result *****/
    if ((*mysql_res = mysql_store_result (&Gbl.mysql)) == NULL)
       DB_ExitOnMySQLError (MsgError);
+   NumRows = (unsigned long) mysql_num_rows (*mysql_res);
+   Pfl_EndQuery (Query,MsgError,NumRows);
 
    /***** Return number of rows of result *****/
-   return (unsigned long) mysql_num_rows (*mysql_res);
+   return NumRows;
   }
 
 /*****************************************************************************/
@@ -2888,8 +3148,10 @@ unsigned long DB_QueryCOUNT (const char *Query,const char *MsgError)
 void DB_QueryINSERT (const char *Query,const char *MsgError)
   {
    /***** Query database *****/
+   Pfl_StartQuery ();
    if (mysql_query (&Gbl.mysql,Query))
       DB_ExitOnMySQLError (MsgError);
+   Pfl_EndQuery (Query,MsgError,(unsigned long) mysql_affected_rows (&Gbl.mysql));
   }
 
 /*****************************************************************************/
@@ -2899,13 +3161,32 @@ void DB_QueryINSERT (const char *Query,const char *MsgError)
 long DB_QueryINSERTandReturnCode (const char *Query,const char *MsgError)
   {
    /***** Query database *****/
+   Pfl_StartQuery ();
    if (mysql_query (&Gbl.mysql,Query))
       DB_ExitOnMySQLError (MsgError);
+   Pfl_EndQuery (Query,MsgError,(unsigned long) mysql_affected_rows (&Gbl.mysql));
 
    /***** Return the code of the inserted item *****/
    return (long) mysql_insert_id (&Gbl.mysql);
   }
 
+/*****************************************************************************/
+/**** Make an INSERT query in database and return number of rows inserted ****/
+/*****************************************************************************/
+// Useful for INSERT ... SELECT queries
+
+unsigned long DB_QueryINSERTandReturnNumRows (const char *Query,const char *MsgError)
+  {
+   /***** Query database *****/
+   Pfl_StartQuery ();
+   if (mysql_query (&Gbl.mysql,Query))
+      DB_ExitOnMySQLError (MsgError);
+   Pfl_EndQuery (Query,MsgError,(unsigned long) mysql_affected_rows (&Gbl.mysql));
+
+   /***** Return the number of rows inserted *****/
+   return (unsigned long) mysql_affected_rows (&Gbl.mysql);
+  }
+
 /*****************************************************************************/
 /******************** Make an REPLACE query in database **********************/
 /*****************************************************************************/
@@ -2913,8 +3194,10 @@ long DB_QueryINSERTandReturnCode (const char *Query,const char *MsgError)
 void DB_QueryREPLACE (const char *Query,const char *MsgError)
   {
    /***** Query database *****/
+   Pfl_StartQuery ();
    if (mysql_query (&Gbl.mysql,Query))
       DB_ExitOnMySQLError (MsgError);
+   Pfl_EndQuery (Query,MsgError,(unsigned long) mysql_affected_rows (&Gbl.mysql));
   }
 
 /*****************************************************************************/
@@ -2924,8 +3207,10 @@ void DB_QueryREPLACE (const char *Query,const char *MsgError)
 void DB_QueryUPDATE (const char *Query,const char *MsgError)
   {
    /***** Query database *****/
+   Pfl_StartQuery ();
    if (mysql_query (&Gbl.mysql,Query))
       DB_ExitOnMySQLError (MsgError);
+   Pfl_EndQuery (Query,MsgError,(unsigned long) mysql_affected_rows (&Gbl.mysql));
 
    /***** Return number of rows updated *****/
    //return (unsigned long) mysql_affected_rows (&Gbl.mysql);
@@ -2938,8 +3223,10 @@ void DB_QueryUPDATE (const char *Query,const char *MsgError)
 void DB_QueryDELETE (const char *Query,const char *MsgError)
   {
    /***** Query database *****/
+   Pfl_StartQuery ();
    if (mysql_query (&Gbl.mysql,Query))
       DB_ExitOnMySQLError (MsgError);
+   Pfl_EndQuery (Query,MsgError,(unsigned long) mysql_affected_rows (&Gbl.mysql));
   }
 
 /*****************************************************************************/
@@ -2949,8 +3236,10 @@ void DB_QueryDELETE (const char *Query,const char *MsgError)
 void DB_Query (const char *Query,const char *MsgError)
   {
    /***** Query database *****/
+   Pfl_StartQuery ();
    if (mysql_query (&Gbl.mysql,Query))
       DB_ExitOnMySQLError (MsgError);
+   Pfl_EndQuery (Query,MsgError,(unsigned long) mysql_affected_rows (&Gbl.mysql));
   }
 
 /*****************************************************************************/
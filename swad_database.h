@@ -40,6 +40,7 @@ unsigned long DB_QuerySELECT (const char *Query,MYSQL_RES **mysql_res,const char
 unsigned long DB_QueryCOUNT (const char *Query,const char *MsgError);
 void DB_QueryINSERT (const char *Query,const char *MsgError);
 long DB_QueryINSERTandReturnCode (const char *Query,const char *MsgError);
+unsigned long DB_QueryINSERTandReturnNumRows (const char *Query,const char *MsgError);
 void DB_QueryREPLACE (const char *Query,const char *MsgError);
 void DB_QueryUPDATE (const char *Query,const char *MsgError);
 void DB_QueryDELETE (const char *Query,const char *MsgError);
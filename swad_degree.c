@@ -33,6 +33,7 @@
 #include <string.h>		// For string functions
 #include <mysql/mysql.h>	// To access MySQL databases
 
+#include "swad_cache.h"
 #include "swad_changelog.h"
 #include "swad_config.h"
 #include "swad_database.h"
@@ -1078,21 +1079,30 @@ void Deg_InitCurrentCourse (void)
 
 void Deg_ShowDegsOfCurrentCtr (void)
   {
+   char Variant[64];
+
    if (Gbl.CurrentCtr.Ctr.CtrCod > 0)
      {
-      /***** Get list of centres and degrees *****/
-      Ctr_GetListCentres (Gbl.CurrentIns.Ins.InsCod);
-      Deg_GetListDegsOfCurrentCtr ();
-
       /***** Write menu to select country, institution and centre *****/
       Deg_WriteMenuAllCourses ();
 
-      /***** Show list of degrees *****/
-      Deg_ListDegrees ();
+      /***** Show list of degrees from cache or from database *****/
+      sprintf (Variant,"%ld",Gbl.CurrentDeg.Deg.DegCod);
+      if (Cac_StartFragment (Cac_DEG_LIST,Gbl.CurrentCtr.Ctr.CtrCod,Variant))
+	{
+	 /***** Get list of centres and degrees *****/
+	 Ctr_GetListCentres (Gbl.CurrentIns.Ins.InsCod);
+	 Deg_GetListDegsOfCurrentCtr ();
+
+	 /***** Show list of degrees *****/
+	 Deg_ListDegrees ();
+
+	 /***** Free list of degrees and centres *****/
+	 Deg_FreeListDegs (&Gbl.CurrentCtr.Ctr.Degs);
+	 Ctr_FreeListCentres ();
 
-      /***** Free list of degrees and centres *****/
-      Deg_FreeListDegs (&Gbl.CurrentCtr.Ctr.Degs);
-      Ctr_FreeListCentres ();
+	 Cac_EndFragment ();
+	}
      }
   }
 
@@ -1597,6 +1607,9 @@ static void Deg_CreateDegree (struct Degree *Deg,unsigned Status)
             Gbl.Usrs.Me.UsrDat.UsrCod,Deg->ShrtName,Deg->FullName,Deg->WWW);
    Deg->DegCod = DB_QueryINSERTandReturnCode (Query,"can not create a new degree");
 
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
+
    /***** Write success message *****/
    sprintf (Gbl.Message,Txt_Created_new_degree_X,
             Deg->FullName);
@@ -2334,6 +2347,9 @@ void Deg_RemoveDegreeCompletely (long DegCod)
             DegCod);
    DB_QueryDELETE (Query,"can not remove a degree");
 
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
+
    /***** Delete all the degrees in sta_degrees table not present in degrees table *****/
    Pho_RemoveObsoleteStatDegrees ();
   }
@@ -2434,6 +2450,9 @@ static void Deg_RenameDegree (struct Degree *Deg,Cns_ShrtOrFullName_t ShrtOrFull
                      FieldName,NewDegName,Deg->DegCod);
             DB_QueryUPDATE (Query,"can not update the name of a degree");
 
+            /* Invalidate cached lists of institutions, centres and degrees */
+            Cac_InvalidateHierarchyLists ();
+
             /* Write message to show the change made */
             sprintf (Gbl.Message,Txt_The_name_of_the_degree_X_has_changed_to_Y,
                      CurrentDegName,NewDegName);
@@ -2541,6 +2560,9 @@ static void Deg_UpdateDegCtrDB (long DegCod,long CtrCod)
    sprintf (Query,"UPDATE degrees SET CtrCod='%ld' WHERE DegCod='%ld'",
             CtrCod,DegCod);
    DB_QueryUPDATE (Query,"can not update the centre of a degree");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
 
 /*****************************************************************************/
@@ -2627,6 +2649,9 @@ static void Deg_UpdateDegWWWDB (long DegCod,const char NewWWW[Cns_MAX_LENGTH_WWW
    sprintf (Query,"UPDATE degrees SET WWW='%s' WHERE DegCod='%ld'",
 	    NewWWW,DegCod);
    DB_QueryUPDATE (Query,"can not update the web of a degree");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
 
 /*****************************************************************************/
@@ -2663,6 +2688,9 @@ void Deg_ChangeDegStatus (void)
             (unsigned) Status,Deg->DegCod);
    DB_QueryUPDATE (Query,"can not update the status of a degree");
 
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
+
    Deg->Status = Status;
 
    /***** Write message to show the change made *****/
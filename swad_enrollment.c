@@ -33,10 +33,12 @@
 #include "swad_database.h"
 #include "swad_duplicate.h"
 #include "swad_enrollment.h"
+#include "swad_follow.h"
 #include "swad_global.h"
 #include "swad_ID.h"
 #include "swad_notification.h"
 #include "swad_parameter.h"
+#include "swad_timetable.h"
 #include "swad_user.h"
 
 /*****************************************************************************/
@@ -47,6 +49,9 @@
 /***************************** Private constants *****************************/
 /*****************************************************************************/
 
+// When registering/removing several users, changes are committed in blocks
+#define Enr_MAX_USRS_IN_TRANSACTION 100
+
 /*****************************************************************************/
 /****************************** Internal types *******************************/
 /*****************************************************************************/
@@ -73,6 +78,20 @@ typedef enum
    Enr_REMOVE_WORKS,
   } Enr_RemoveUsrWorks_t;
 
+// A user's ID, nickname or e-mail written in the form, and users found for it
+struct Enr_UsrToRegRem
+  {
+   char UsrIDNickOrEmail[Usr_MAX_BYTES_USR_LOGIN+1];
+   bool ItLooksLikeAUsrID;
+   struct ListUsrCods ListUsrCods;
+  };
+
+struct Enr_ListUsrsToRegRem
+  {
+   unsigned Num;
+   struct Enr_UsrToRegRem *Lst;
+  };
+
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
 /*****************************************************************************/
@@ -96,6 +115,18 @@ static void Enr_PutAreaToEnterUsrsIDs (void);
 static void Enr_PutActionsRegRemSeveralUsrs (void);
 
 static void Enr_ReceiveFormUsrsCrs (Rol_Role_t Role);
+static void Enr_GetListUsrsToRegRem (const char *ListUsrsIDs,
+                                     struct Enr_ListUsrsToRegRem *ListUsrs);
+static void Enr_GetUsrCodsFromUsrIDs (struct Enr_ListUsrsToRegRem *ListUsrs,
+                                      unsigned NumUsrIDs);
+static int Enr_CompareUsrsToRegRem (const void *p1,const void *p2);
+static void Enr_FreeListUsrsToRegRem (struct Enr_ListUsrsToRegRem *ListUsrs);
+static void Enr_SortListUsrsByUsrCod (Rol_Role_t Role);
+static struct UsrInList *Enr_SearchUsrInList (Rol_Role_t Role,long UsrCod);
+static int Enr_CompareUsrsInList (const void *p1,const void *p2);
+static void Enr_StartTransaction (void);
+static void Enr_CommitTransactionIfFull (unsigned *NumUsrsInTransaction);
+static void Enr_CommitTransaction (void);
 
 static void Enr_RegisterUsr (struct UsrData *UsrDat,Rol_Role_t RegRemRole,
                              struct ListCodGrps *LstGrps,unsigned *NumUsrsRegistered);
@@ -257,6 +288,12 @@ void Enr_RegisterUsrInCurrentCrs (struct UsrData *UsrDat,Rol_Role_t NewRole,
    UsrDat->RoleInCurrentCrsDB = NewRole;
    UsrDat->Roles |= NewRole;
 
+   /***** Invalidate cached timetables of this user *****/
+   TT_InvalidateCachedTimeTables (Gbl.CurrentCrs.Crs.CrsCod,UsrDat->UsrCod);
+
+   /***** Users to follow suggested to this user must be computed again *****/
+   Fol_RemoveUsrsToFollow (UsrDat->UsrCod);
+
    /***** Create notification for this user.
 	  If this user wants to receive notifications by e-mail,
 	  activate the sending of a notification *****/
@@ -1209,16 +1246,18 @@ static void Enr_ReceiveFormUsrsCrs (Rol_Role_t Role)
       bool RegisterUsrs;
      } WhatToDo;
    char *ListUsrsIDs;
-   struct ListUsrCods ListUsrCods;	// List with users' codes for a given user's ID
+   struct Enr_ListUsrsToRegRem ListUsrs;
+   unsigned NumUsrToRegRem;
+   struct ListUsrCods *ListUsrCods;	// List with users' codes for a given user's ID
    unsigned NumUsrFound;
-   const char *Ptr;
+   struct UsrInList *UsrInList;
    unsigned NumCurrentUsr;
+   unsigned NumUsrsInTransaction;
    unsigned NumUsrsRegistered = 0;
    unsigned NumUsrsRemoved = 0;
    unsigned NumUsrsEliminated = 0;
    struct ListCodGrps LstGrps;
    struct UsrData UsrDat;
-   bool ItLooksLikeAUsrID;
    Enr_RegRemUsrsAction_t RegRemUsrsAction;
    bool ErrorInForm = false;
 
@@ -1336,6 +1375,9 @@ static void Enr_ReceiveFormUsrsCrs (Rol_Role_t Role)
 	 Lay_ShowErrorAndExit ("Not enough memory to store users' IDs.");
       Par_GetParToText ("UsrsIDs",ListUsrsIDs,ID_MAX_BYTES_LIST_USRS_IDS);
 
+      /***** Get users' codes for all the users' IDs at once *****/
+      Enr_GetListUsrsToRegRem (ListUsrsIDs,&ListUsrs);
+
       /***** Initialize structure with user's data *****/
       Usr_UsrDataConstructor (&UsrDat);
 
@@ -1347,6 +1389,9 @@ static void Enr_ReceiveFormUsrsCrs (Rol_Role_t Role)
 
 	 if (Gbl.Usrs.LstUsrs[Role].NumUsrs)
 	   {
+	    /***** Sort list of users in order to search in it *****/
+	    Enr_SortListUsrsByUsrCod (Role);
+
 	    /***** Initialize list of users to remove *****/
 	    for (NumCurrentUsr = 0;
 		 NumCurrentUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
@@ -1354,79 +1399,29 @@ static void Enr_ReceiveFormUsrsCrs (Rol_Role_t Role)
 	       Gbl.Usrs.LstUsrs[Role].Lst[NumCurrentUsr].Remove = !WhatToDo.RemoveSpecifiedUsrs;
 
 	    /***** Loop 1: go through form list setting if a student must be removed *****/
-	    /* Get users from a list of users' IDs */
-	    Ptr = ListUsrsIDs;
-	    while (*Ptr)
+	    for (NumUsrToRegRem = 0;
+		 NumUsrToRegRem < ListUsrs.Num;
+		 NumUsrToRegRem++)
 	      {
-	       /* Reset user */
-	       UsrDat.UsrCod = -1L;
-
-	       /* Find next string in text */
-	       Str_GetNextStringUntilSeparator (&Ptr,UsrDat.UsrIDNickOrEmail,Usr_MAX_BYTES_USR_LOGIN);
-
-	       /* Reset default list of users' codes */
-	       ListUsrCods.NumUsrs = 0;
-	       ListUsrCods.Lst = NULL;
-
-	       /* Check if string is a user's ID, user's nickname or user's e-mail address */
-	       if (Nck_CheckIfNickWithArrobaIsValid (UsrDat.UsrIDNickOrEmail))	// 1: It's a nickname
-		 {
-		  if ((UsrDat.UsrCod = Nck_GetUsrCodFromNickname (UsrDat.UsrIDNickOrEmail)) > 0)
-		    {
-		     ListUsrCods.NumUsrs = 1;
-		     Usr_AllocateListUsrCods (&ListUsrCods);
-		     ListUsrCods.Lst[0] = UsrDat.UsrCod;
-		    }
-		 }
-	       else if (Mai_CheckIfEmailIsValid (UsrDat.UsrIDNickOrEmail))	// 2: It's an e-mail
-		 {
-		  if ((UsrDat.UsrCod = Mai_GetUsrCodFromEmail (UsrDat.UsrIDNickOrEmail)) > 0)
-		    {
-		     ListUsrCods.NumUsrs = 1;
-		     Usr_AllocateListUsrCods (&ListUsrCods);
-		     ListUsrCods.Lst[0] = UsrDat.UsrCod;
-		    }
-		 }
-	       else								// 3: It looks like a user's ID
-		 {
-		  // Users' IDs are always stored internally in capitals and without leading zeros
-		  Str_RemoveLeadingZeros (UsrDat.UsrIDNickOrEmail);
-		  if (ID_CheckIfUsrIDSeemsAValidID (UsrDat.UsrIDNickOrEmail))
-		    {
-		     /***** Find users for this user's ID *****/
-		     ID_ReallocateListIDs (&UsrDat,1);	// Only one user's ID
-		     strcpy (UsrDat.IDs.List[0].ID,UsrDat.UsrIDNickOrEmail);
-		     Str_ConvertToUpperText (UsrDat.IDs.List[0].ID);
-		     ID_GetListUsrCodsFromUsrID (&UsrDat,NULL,&ListUsrCods,false);
-		    }
-		 }
+	       ListUsrCods = &ListUsrs.Lst[NumUsrToRegRem].ListUsrCods;
 
 	       if (WhatToDo.RemoveSpecifiedUsrs)	// Remove the specified users (of the role)
 		 {
-	          if (ListUsrCods.NumUsrs == 1)		// If more than one user found ==> do not remove
-		     for (NumCurrentUsr = 0;
-			  NumCurrentUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
-			  NumCurrentUsr++)
-			if (Gbl.Usrs.LstUsrs[Role].Lst[NumCurrentUsr].UsrCod == ListUsrCods.Lst[0])	// User found
-			   Gbl.Usrs.LstUsrs[Role].Lst[NumCurrentUsr].Remove = true;	// Mark as removable
+	          if (ListUsrCods->NumUsrs == 1)		// If more than one user found ==> do not remove
+		     if ((UsrInList = Enr_SearchUsrInList (Role,ListUsrCods->Lst[0])))	// User found
+			UsrInList->Remove = true;	// Mark as removable
 		 }
 	       else	// Remove all the users (of the role) except these specified
-		 {
-		  for (NumCurrentUsr = 0;
-		       NumCurrentUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
-		       NumCurrentUsr++)
-		     for (NumUsrFound = 0;
-			  NumUsrFound < ListUsrCods.NumUsrs;
-			  NumUsrFound++)
-			if (Gbl.Usrs.LstUsrs[Role].Lst[NumCurrentUsr].UsrCod == ListUsrCods.Lst[NumUsrFound])	// User found
-			   Gbl.Usrs.LstUsrs[Role].Lst[NumCurrentUsr].Remove = false;	// Mark as not removable
-		 }
-
-	       /* Free memory used for list of users' codes found for this ID */
-	       Usr_FreeListUsrCods (&ListUsrCods);
+		  for (NumUsrFound = 0;
+		       NumUsrFound < ListUsrCods->NumUsrs;
+		       NumUsrFound++)
+		     if ((UsrInList = Enr_SearchUsrInList (Role,ListUsrCods->Lst[NumUsrFound])))	// User found
+			UsrInList->Remove = false;	// Mark as not removable
 	      }
 
 	    /***** Loop 2: go through users list removing users *****/
+	    Enr_StartTransaction ();
+	    NumUsrsInTransaction = 0;
 	    for (NumCurrentUsr = 0;
 		 NumCurrentUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
 		 NumCurrentUsr++)
@@ -1463,8 +1458,10 @@ static void Enr_ReceiveFormUsrsCrs (Rol_Role_t Role)
 			   NumUsrsRemoved++;
 			  }
 		       }
+		     Enr_CommitTransactionIfFull (&NumUsrsInTransaction);
 		    }
 		 }
+	    Enr_CommitTransaction ();
 	   }
 
 	 /***** Free memory for users list *****/
@@ -1474,71 +1471,50 @@ static void Enr_ReceiveFormUsrsCrs (Rol_Role_t Role)
       /***** Register users *****/
       if (WhatToDo.RegisterUsrs)	// TODO: !!!!! NO CAMBIAR EL ROL DE LOS USUARIOS QUE YA ESTN EN LA ASIGNATURA SI HAY MS DE UN USUARIO ENCONTRADO PARA EL MISMO DNI !!!!!!
 	{
-	 /***** Get users from a list of users' IDs ******/
-	 Ptr = ListUsrsIDs;
-	 while (*Ptr)
+	 /***** Get list of users who already belong to current course with this role *****/
+         Usr_GetListUsrs (Role,Sco_SCOPE_CRS);
+	 Enr_SortListUsrsByUsrCod (Role);
+
+	 /***** Register users from the list of users' IDs ******/
+	 Enr_StartTransaction ();
+	 NumUsrsInTransaction = 0;
+	 for (NumUsrToRegRem = 0;
+	      NumUsrToRegRem < ListUsrs.Num;
+	      NumUsrToRegRem++)
 	   {
-	    /* Reset user */
-	    UsrDat.UsrCod = -1L;
-	    ItLooksLikeAUsrID = false;
-
-	    /* Find next string in text */
-	    Str_GetNextStringUntilSeparator (&Ptr,UsrDat.UsrIDNickOrEmail,Usr_MAX_BYTES_USR_LOGIN);
-
-	    /* Reset default list of users' codes */
-	    ListUsrCods.NumUsrs = 0;
-	    ListUsrCods.Lst = NULL;
-
-	    /* Check if the string is a user's ID, a user's nickname or a user's e-mail address */
-	    if (Nck_CheckIfNickWithArrobaIsValid (UsrDat.UsrIDNickOrEmail))	// 1: It's a nickname
-	      {
-	       if ((UsrDat.UsrCod = Nck_GetUsrCodFromNickname (UsrDat.UsrIDNickOrEmail)) > 0)
-		 {
-		  ListUsrCods.NumUsrs = 1;
-		  Usr_AllocateListUsrCods (&ListUsrCods);
-		  ListUsrCods.Lst[0] = UsrDat.UsrCod;
-		 }
-	      }
-	    else if (Mai_CheckIfEmailIsValid (UsrDat.UsrIDNickOrEmail))		// 2: It's an e-mail
-	      {
-	       if ((UsrDat.UsrCod = Mai_GetUsrCodFromEmail (UsrDat.UsrIDNickOrEmail)) > 0)
-		 {
-		  ListUsrCods.NumUsrs = 1;
-		  Usr_AllocateListUsrCods (&ListUsrCods);
-		  ListUsrCods.Lst[0] = UsrDat.UsrCod;
-		 }
-	      }
-	    else								// 3: It looks like a user's ID
-	      {
-	       // Users' IDs are always stored internally in capitals and without leading zeros
-	       Str_RemoveLeadingZeros (UsrDat.UsrIDNickOrEmail);
-	       if (ID_CheckIfUsrIDSeemsAValidID (UsrDat.UsrIDNickOrEmail))
-		 {
-		  ItLooksLikeAUsrID = true;
-
-		  /* Find users for this user's ID */
-		  ID_ReallocateListIDs (&UsrDat,1);	// Only one user's ID
-		  strcpy (UsrDat.IDs.List[0].ID,UsrDat.UsrIDNickOrEmail);
-	          Str_ConvertToUpperText (UsrDat.IDs.List[0].ID);
-		  ID_GetListUsrCodsFromUsrID (&UsrDat,NULL,&ListUsrCods,false);
-		 }
-	      }
+	    ListUsrCods = &ListUsrs.Lst[NumUsrToRegRem].ListUsrCods;
 
 	    /* Register user(s) */
-	    if (ListUsrCods.NumUsrs)	// User(s) found
+	    if (ListUsrCods->NumUsrs)	// User(s) found
 	       for (NumUsrFound = 0;
-		    NumUsrFound < ListUsrCods.NumUsrs;
+		    NumUsrFound < ListUsrCods->NumUsrs;
 		    NumUsrFound++)
 		 {
-		  UsrDat.UsrCod = ListUsrCods.Lst[NumUsrFound];
-		  Enr_RegisterUsr (&UsrDat,Role,&LstGrps,&NumUsrsRegistered);
+		  UsrDat.UsrCod = ListUsrCods->Lst[NumUsrFound];
+		  if (!LstGrps.NumGrps &&
+		      Enr_SearchUsrInList (Role,UsrDat.UsrCod))
+		     // User already belongs to the course with this role
+		     // and there are no groups to register in ==> nothing to change
+		     NumUsrsRegistered++;
+		  else
+		    {
+		     Enr_RegisterUsr (&UsrDat,Role,&LstGrps,&NumUsrsRegistered);
+		     Enr_CommitTransactionIfFull (&NumUsrsInTransaction);
+		    }
 		 }
-	    else if (ItLooksLikeAUsrID)	// User not found. He/she is a new user. Register him/her using ID
+	    else if (ListUsrs.Lst[NumUsrToRegRem].ItLooksLikeAUsrID)	// User not found. He/she is a new user. Register him/her using ID
+	      {
+	       UsrDat.UsrCod = -1L;
+	       ID_ReallocateListIDs (&UsrDat,1);	// Only one user's ID
+	       strcpy (UsrDat.IDs.List[0].ID,ListUsrs.Lst[NumUsrToRegRem].UsrIDNickOrEmail);
 	       Enr_RegisterUsr (&UsrDat,Role,&LstGrps,&NumUsrsRegistered);
-
-	    /* Free memory used for list of users' codes found for this ID */
-	    Usr_FreeListUsrCods (&ListUsrCods);
+	       Enr_CommitTransactionIfFull (&NumUsrsInTransaction);
+	      }
 	   }
+	 Enr_CommitTransaction ();
+
+	 /***** Free memory for users list *****/
+	 Usr_FreeUsrsList (Role);
 	}
 
       /***** Free memory used for user's data *****/
@@ -1599,6 +1575,7 @@ static void Enr_ReceiveFormUsrsCrs (Rol_Role_t Role)
 	   }
 
       /***** Free memory used by the list of user's IDs *****/
+      Enr_FreeListUsrsToRegRem (&ListUsrs);
       free (ListUsrsIDs);
 
       /***** Free memory with the list of groups to/from which register/remove users *****/
@@ -1609,6 +1586,279 @@ static void Enr_ReceiveFormUsrsCrs (Rol_Role_t Role)
      }
   }
 
+/*****************************************************************************/
+/********* Get list of users' IDs, nicknames or e-mails from a text **********/
+/*****************************************************************************/
+// The list must be freed by caller
+
+static void Enr_GetListUsrsToRegRem (const char *ListUsrsIDs,
+                                     struct Enr_ListUsrsToRegRem *ListUsrs)
+  {
+   const char *Ptr;
+   char UsrIDNickOrEmail[Usr_MAX_BYTES_USR_LOGIN+1];
+   struct Enr_UsrToRegRem *UsrToRegRem;
+   unsigned NumUsrIDs = 0;
+   long UsrCod;
+
+   ListUsrs->Num = 0;
+   ListUsrs->Lst = NULL;
+
+   /***** Count users' IDs, nicknames or e-mails in text *****/
+   Ptr = ListUsrsIDs;
+   while (*Ptr)
+     {
+      Str_GetNextStringUntilSeparator (&Ptr,UsrIDNickOrEmail,Usr_MAX_BYTES_USR_LOGIN);
+      if (UsrIDNickOrEmail[0])
+	 ListUsrs->Num++;
+     }
+   if (!ListUsrs->Num)
+      return;
+
+   /***** Allocate memory for the list *****/
+   if ((ListUsrs->Lst = (struct Enr_UsrToRegRem *) calloc (ListUsrs->Num,sizeof (struct Enr_UsrToRegRem))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store list of users.");
+
+   /***** Fill the list *****/
+   Ptr = ListUsrsIDs;
+   UsrToRegRem = ListUsrs->Lst;
+   while (*Ptr)
+     {
+      /* Find next string in text */
+      Str_GetNextStringUntilSeparator (&Ptr,UsrIDNickOrEmail,Usr_MAX_BYTES_USR_LOGIN);
+      if (!UsrIDNickOrEmail[0])
+	 continue;
+      strcpy (UsrToRegRem->UsrIDNickOrEmail,UsrIDNickOrEmail);
+
+      /* Check if string is a user's ID, user's nickname or user's e-mail address */
+      UsrCod = -1L;
+      if (Nck_CheckIfNickWithArrobaIsValid (UsrToRegRem->UsrIDNickOrEmail))	// 1: It's a nickname
+	 UsrCod = Nck_GetUsrCodFromNickname (UsrToRegRem->UsrIDNickOrEmail);
+      else if (Mai_CheckIfEmailIsValid (UsrToRegRem->UsrIDNickOrEmail))		// 2: It's an e-mail
+	 UsrCod = Mai_GetUsrCodFromEmail (UsrToRegRem->UsrIDNickOrEmail);
+      else									// 3: It looks like a user's ID
+	{
+	 // Users' IDs are always stored internally in capitals and without leading zeros
+	 Str_RemoveLeadingZeros (UsrToRegRem->UsrIDNickOrEmail);
+	 if (ID_CheckIfUsrIDSeemsAValidID (UsrToRegRem->UsrIDNickOrEmail))
+	   {
+	    UsrToRegRem->ItLooksLikeAUsrID = true;
+	    Str_ConvertToUpperText (UsrToRegRem->UsrIDNickOrEmail);
+	    NumUsrIDs++;
+	   }
+	}
+
+      if (UsrCod > 0)
+	{
+	 UsrToRegRem->ListUsrCods.NumUsrs = 1;
+	 Usr_AllocateListUsrCods (&UsrToRegRem->ListUsrCods);
+	 UsrToRegRem->ListUsrCods.Lst[0] = UsrCod;
+	}
+
+      UsrToRegRem++;
+     }
+
+   /***** Sort the list and remove repeated users' IDs, nicknames or e-mails *****/
+   qsort ((void *) ListUsrs->Lst,(size_t) ListUsrs->Num,sizeof (struct Enr_UsrToRegRem),
+          Enr_CompareUsrsToRegRem);
+   for (UsrToRegRem = ListUsrs->Lst + 1;
+	UsrToRegRem < ListUsrs->Lst + ListUsrs->Num;
+	)
+      if (Enr_CompareUsrsToRegRem (UsrToRegRem - 1,UsrToRegRem))
+	 UsrToRegRem++;
+      else	// Repeated
+	{
+	 if (UsrToRegRem->ItLooksLikeAUsrID)
+	    NumUsrIDs--;
+	 Usr_FreeListUsrCods (&UsrToRegRem->ListUsrCods);
+	 ListUsrs->Num--;
+	 memmove ((void *) UsrToRegRem,(const void *) (UsrToRegRem + 1),
+	          (ListUsrs->Lst + ListUsrs->Num - UsrToRegRem) * sizeof (struct Enr_UsrToRegRem));
+	}
+
+   /***** Get users' codes for all the users' IDs at once *****/
+   if (NumUsrIDs)
+      Enr_GetUsrCodsFromUsrIDs (ListUsrs,NumUsrIDs);
+  }
+
+/*****************************************************************************/
+/******* Get users' codes for all the users' IDs in list with one query ******/
+/*****************************************************************************/
+// The list must be sorted
+
+static void Enr_GetUsrCodsFromUsrIDs (struct Enr_ListUsrsToRegRem *ListUsrs,
+                                      unsigned NumUsrIDs)
+  {
+   char *Query;
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned long NumRows;
+   unsigned long NumRow;
+   unsigned NumUsrToRegRem;
+   bool FirstID = true;
+   struct Enr_UsrToRegRem Key;
+   struct Enr_UsrToRegRem *UsrToRegRem;
+   struct ListUsrCods *ListUsrCods;
+   long UsrCod;
+
+   /***** Allocate memory for query string *****/
+   if ((Query = (char *) malloc (128 + NumUsrIDs * (1 + ID_MAX_LENGTH_USR_ID + 2))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store list of user's IDs.");
+
+   /***** Get users' codes from database *****/
+   strcpy (Query,"SELECT UsrID,UsrCod FROM usr_IDs WHERE UsrID IN (");
+   for (NumUsrToRegRem = 0;
+	NumUsrToRegRem < ListUsrs->Num;
+	NumUsrToRegRem++)
+      if (ListUsrs->Lst[NumUsrToRegRem].ItLooksLikeAUsrID)
+	{
+	 if (!FirstID)
+	    strcat (Query,",");
+	 strcat (Query,"'");
+	 strcat (Query,ListUsrs->Lst[NumUsrToRegRem].UsrIDNickOrEmail);
+	 strcat (Query,"'");
+	 FirstID = false;
+	}
+   strcat (Query,")");
+   NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get user's codes");
+
+   /***** Free memory for query string *****/
+   free ((void *) Query);
+
+   /***** Add each user's code to the user's ID it belongs to *****/
+   Key.ItLooksLikeAUsrID = true;
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get user's ID (row[0]) */
+      strncpy (Key.UsrIDNickOrEmail,row[0],Usr_MAX_BYTES_USR_LOGIN);
+      Key.UsrIDNickOrEmail[Usr_MAX_BYTES_USR_LOGIN] = '\0';
+      Str_ConvertToUpperText (Key.UsrIDNickOrEmail);
+
+      /* Get user's code (row[1]) */
+      if ((UsrCod = Str_ConvertStrCodToLongCod (row[1])) > 0)
+	 if ((UsrToRegRem = bsearch ((const void *) &Key,
+	                             (const void *) ListUsrs->Lst,(size_t) ListUsrs->Num,
+	                             sizeof (struct Enr_UsrToRegRem),
+	                             Enr_CompareUsrsToRegRem)))
+	   {
+	    ListUsrCods = &UsrToRegRem->ListUsrCods;
+	    if ((ListUsrCods->Lst = (long *) realloc (ListUsrCods->Lst,
+	                                              (ListUsrCods->NumUsrs + 1) * sizeof (long))) == NULL)
+	       Lay_ShowErrorAndExit ("Not enough memory to store list of users' codes.");
+	    ListUsrCods->Lst[ListUsrCods->NumUsrs++] = UsrCod;
+	   }
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/********** Compare two users' IDs, nicknames or e-mails to sort them ********/
+/*****************************************************************************/
+
+static int Enr_CompareUsrsToRegRem (const void *p1,const void *p2)
+  {
+   const struct Enr_UsrToRegRem *Usr1 = (const struct Enr_UsrToRegRem *) p1;
+   const struct Enr_UsrToRegRem *Usr2 = (const struct Enr_UsrToRegRem *) p2;
+
+   if (Usr1->ItLooksLikeAUsrID != Usr2->ItLooksLikeAUsrID)
+      return Usr1->ItLooksLikeAUsrID ? 1 :
+	                               -1;
+   return strcmp (Usr1->UsrIDNickOrEmail,Usr2->UsrIDNickOrEmail);
+  }
+
+/*****************************************************************************/
+/******** Free list of users' IDs, nicknames or e-mails and their codes ******/
+/*****************************************************************************/
+
+static void Enr_FreeListUsrsToRegRem (struct Enr_ListUsrsToRegRem *ListUsrs)
+  {
+   unsigned NumUsrToRegRem;
+
+   if (ListUsrs->Lst)
+     {
+      for (NumUsrToRegRem = 0;
+	   NumUsrToRegRem < ListUsrs->Num;
+	   NumUsrToRegRem++)
+	 Usr_FreeListUsrCods (&ListUsrs->Lst[NumUsrToRegRem].ListUsrCods);
+      free ((void *) ListUsrs->Lst);
+      ListUsrs->Lst = NULL;
+     }
+   ListUsrs->Num = 0;
+  }
+
+/*****************************************************************************/
+/********** Sort list of users of a role by user's code to search it *********/
+/*****************************************************************************/
+
+static void Enr_SortListUsrsByUsrCod (Rol_Role_t Role)
+  {
+   if (Gbl.Usrs.LstUsrs[Role].NumUsrs)
+      qsort ((void *) Gbl.Usrs.LstUsrs[Role].Lst,(size_t) Gbl.Usrs.LstUsrs[Role].NumUsrs,
+             sizeof (struct UsrInList),Enr_CompareUsrsInList);
+  }
+
+/*****************************************************************************/
+/********** Search a user in a list of users sorted by user's code ***********/
+/*****************************************************************************/
+// Return NULL if not found
+
+static struct UsrInList *Enr_SearchUsrInList (Rol_Role_t Role,long UsrCod)
+  {
+   struct UsrInList Key;
+
+   if (!Gbl.Usrs.LstUsrs[Role].NumUsrs)
+      return NULL;
+
+   Key.UsrCod = UsrCod;
+   return bsearch ((const void *) &Key,
+                   (const void *) Gbl.Usrs.LstUsrs[Role].Lst,
+                   (size_t) Gbl.Usrs.LstUsrs[Role].NumUsrs,
+                   sizeof (struct UsrInList),Enr_CompareUsrsInList);
+  }
+
+static int Enr_CompareUsrsInList (const void *p1,const void *p2)
+  {
+   long UsrCod1 = ((const struct UsrInList *) p1)->UsrCod;
+   long UsrCod2 = ((const struct UsrInList *) p2)->UsrCod;
+
+   return (UsrCod1 < UsrCod2) ? -1 :
+	  ((UsrCod1 > UsrCod2) ? 1 :
+		                 0);
+  }
+
+/*****************************************************************************/
+/**************** Start / commit a block of registrations ********************/
+/*****************************************************************************/
+// Registering thousands of users one query at a time is too slow
+// if each change is committed separately
+
+static void Enr_StartTransaction (void)
+  {
+   DB_Query ("START TRANSACTION","can not start transaction");
+   Gbl.DB.OpenTransaction = true;
+  }
+
+static void Enr_CommitTransactionIfFull (unsigned *NumUsrsInTransaction)
+  {
+   if (++(*NumUsrsInTransaction) >= Enr_MAX_USRS_IN_TRANSACTION)
+     {
+      Enr_CommitTransaction ();
+      Enr_StartTransaction ();
+      *NumUsrsInTransaction = 0;
+     }
+  }
+
+static void Enr_CommitTransaction (void)
+  {
+   DB_Query ("COMMIT","can not commit transaction");
+   Gbl.DB.OpenTransaction = false;
+  }
+
 /*****************************************************************************/
 /********************** Register a user using his/her ID *********************/
 /*****************************************************************************/
@@ -3763,6 +4013,9 @@ static void Enr_EffectivelyRemUsrFromCrs (struct UsrData *UsrDat,struct Course *
                Crs->CrsCod,UsrDat->UsrCod);
       DB_QueryDELETE (Query,"can not remove a user from a course");
 
+      /***** Users to follow suggested to this user must be computed again *****/
+      Fol_RemoveUsrsToFollow (UsrDat->UsrCod);
+
       if (QuietOrVerbose == Cns_VERBOSE)
         {
          sprintf (Gbl.Message,Txt_THE_USER_X_has_been_removed_from_the_course_Y,
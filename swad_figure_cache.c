@@ -0,0 +1,177 @@
+// swad_figure_cache.c: cache of figures shown in statistics
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2016 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <stdio.h>		// For sprintf
+
+#include "swad_database.h"
+#include "swad_figure_cache.h"
+#include "swad_global.h"
+
+/*****************************************************************************/
+/************** External global variables from others modules ****************/
+/*****************************************************************************/
+
+extern struct Globals Gbl;
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+// Figures are computed again from the original tables after these seconds.
+// They are refreshed when they are read after that time,
+// so only the figures of scopes that are really viewed are computed.
+// Figures about test questions are not cached,
+// because they include the sum of scores, which is not an integer
+#define FigCch_TIME_TO_REFRESH_FIGURE ((time_t)(60UL*60UL))	// 1 hour
+
+/*****************************************************************************/
+/***************************** Private variables *****************************/
+/*****************************************************************************/
+
+// All the cached figures for a scope are read from database at once
+static struct
+  {
+   bool Loaded;
+   Sco_Scope_t Scope;
+   long Cod;
+   bool Valid[FigCch_NUM_FIGURES];
+   unsigned Value[FigCch_NUM_FIGURES];
+  } FigCch_Figures;	// Loaded is initialized to false
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static void FigCch_LoadFiguresOfScope (Sco_Scope_t Scope,long Cod);
+
+/*****************************************************************************/
+/*********************** Get a figure from cache *****************************/
+/*****************************************************************************/
+// Return true if the figure is in cache and is not too old
+
+bool FigCch_GetFigureFromCache (FigCch_Figure_t Figure,
+                                Sco_Scope_t Scope,long Cod,
+                                unsigned *Value)
+  {
+   /***** Load figures of this scope if not yet loaded *****/
+   if (!FigCch_Figures.Loaded ||
+       FigCch_Figures.Scope != Scope ||
+       FigCch_Figures.Cod   != Cod)
+      FigCch_LoadFiguresOfScope (Scope,Cod);
+
+   /***** Get figure *****/
+   if (FigCch_Figures.Valid[Figure])
+     {
+      *Value = FigCch_Figures.Value[Figure];
+      return true;
+     }
+   return false;
+  }
+
+/*****************************************************************************/
+/********** Load from database all the recent figures of a scope *************/
+/*****************************************************************************/
+
+static void FigCch_LoadFiguresOfScope (Sco_Scope_t Scope,long Cod)
+  {
+   extern const char *Sco_ScopeDB[Sco_NUM_SCOPES];
+   char Query[256];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned long NumRows;
+   unsigned long NumRow;
+   FigCch_Figure_t Figure;
+   unsigned UnsignedNum;
+
+   /***** Reset figures *****/
+   FigCch_Figures.Loaded = true;
+   FigCch_Figures.Scope = Scope;
+   FigCch_Figures.Cod = Cod;
+   for (Figure = (FigCch_Figure_t) 0;
+	Figure < FigCch_NUM_FIGURES;
+	Figure++)
+      FigCch_Figures.Valid[Figure] = false;
+
+   /***** Get recent figures of this scope from database *****/
+   sprintf (Query,"SELECT Figure,Value FROM figures"
+                  " WHERE Scope='%s' AND Cod='%ld'"
+                  " AND LastUpdate>FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')",
+            Sco_ScopeDB[Scope],Cod,
+            (unsigned long) FigCch_TIME_TO_REFRESH_FIGURE);
+   NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get cached figures");
+
+   /***** Store figures *****/
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get figure (row[0]) */
+      if (sscanf (row[0],"%u",&UnsignedNum) == 1)
+	 if (UnsignedNum < FigCch_NUM_FIGURES)
+	   {
+	    Figure = (FigCch_Figure_t) UnsignedNum;
+
+	    /* Get value (row[1]) */
+	    if (sscanf (row[1],"%u",&FigCch_Figures.Value[Figure]) == 1)
+	       FigCch_Figures.Valid[Figure] = true;
+	   }
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/************************* Update a figure in cache **************************/
+/*****************************************************************************/
+
+void FigCch_UpdateFigureIntoCache (FigCch_Figure_t Figure,
+                                   Sco_Scope_t Scope,long Cod,
+                                   unsigned Value)
+  {
+   extern const char *Sco_ScopeDB[Sco_NUM_SCOPES];
+   char Query[256];
+
+   /***** Update figure in database *****/
+   sprintf (Query,"REPLACE INTO figures"
+                  " (Figure,Scope,Cod,Value,LastUpdate)"
+                  " VALUES"
+                  " ('%u','%s','%ld','%u',NOW())",
+            (unsigned) Figure,Sco_ScopeDB[Scope],Cod,Value);
+   DB_QueryREPLACE (Query,"can not update cached figure");
+
+   /***** Update figure in memory *****/
+   if (FigCch_Figures.Loaded &&
+       FigCch_Figures.Scope == Scope &&
+       FigCch_Figures.Cod   == Cod)
+     {
+      FigCch_Figures.Valid[Figure] = true;
+      FigCch_Figures.Value[Figure] = Value;
+     }
+  }
@@ -0,0 +1,98 @@
+// swad_figure_cache.h: cache of figures shown in statistics
+
+#ifndef _SWAD_FIG_CCH
+#define _SWAD_FIG_CCH
+/*
+    SWAD (Shared Workspace At a Distance in Spanish),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2016 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <stdbool.h>		// For boolean type
+
+#include "swad_scope.h"
+
+/*****************************************************************************/
+/************************** Public types and constants ***********************/
+/*****************************************************************************/
+
+// Don't change the numbers, they are stored in database
+#define FigCch_NUM_FIGURES 78
+typedef enum
+  {
+   FigCch_NUM_CTYS			=  0,
+   FigCch_NUM_CTYS_WITH_INSS		=  1,
+   FigCch_NUM_CTYS_WITH_CTRS		=  2,
+   FigCch_NUM_CTYS_WITH_DEGS		=  3,
+   FigCch_NUM_CTYS_WITH_CRSS		=  4,
+   FigCch_NUM_CTYS_WITH_TCHS		=  5,
+   FigCch_NUM_CTYS_WITH_STDS		=  6,
+
+   FigCch_NUM_INSS			=  7,
+   FigCch_NUM_INSS_WITH_CTRS		=  8,
+   FigCch_NUM_INSS_WITH_DEGS		=  9,
+   FigCch_NUM_INSS_WITH_CRSS		= 10,
+   FigCch_NUM_INSS_WITH_TCHS		= 11,
+   FigCch_NUM_INSS_WITH_STDS		= 12,
+
+   FigCch_NUM_CTRS			= 13,
+   FigCch_NUM_CTRS_WITH_DEGS		= 14,
+   FigCch_NUM_CTRS_WITH_CRSS		= 15,
+   FigCch_NUM_CTRS_WITH_TCHS		= 16,
+   FigCch_NUM_CTRS_WITH_STDS		= 17,
+
+   FigCch_NUM_DEGS			= 18,
+   FigCch_NUM_DEGS_WITH_CRSS		= 19,
+   FigCch_NUM_DEGS_WITH_TCHS		= 20,
+   FigCch_NUM_DEGS_WITH_STDS		= 21,
+
+   FigCch_NUM_CRSS			= 22,
+   FigCch_NUM_CRSS_WITH_TCHS		= 23,
+   FigCch_NUM_CRSS_WITH_STDS		= 24,
+
+   FigCch_NUM_CRSS_WITH_ATT_EVENTS	= 25,
+   FigCch_NUM_ATT_EVENTS		= 26,
+   FigCch_NUM_ATT_EVENTS_NOTIF		= 27,
+
+   FigCch_NUM_MSGS_SENT			= 28,
+   FigCch_NUM_MSGS_SENT_DELETED		= 29,
+
+   // One figure for each type of forum (For_NUM_TYPES_FORUM = 12),
+   // so add the type of forum to these numbers
+   FigCch_NUM_FORUMS			= 30,	// 30...41
+   FigCch_NUM_FORUM_THREADS		= 42,	// 42...53
+   FigCch_NUM_FORUM_POSTS		= 54,	// 54...65
+   FigCch_NUM_FORUM_USRS_NOTIF		= 66,	// 66...77
+  } FigCch_Figure_t;
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+bool FigCch_GetFigureFromCache (FigCch_Figure_t Figure,
+                                Sco_Scope_t Scope,long Cod,
+                                unsigned *Value);
+void FigCch_UpdateFigureIntoCache (FigCch_Figure_t Figure,
+                                   Sco_Scope_t Scope,long Cod,
+                                   unsigned Value);
+
+#endif
@@ -1551,6 +1551,8 @@ static void Brw_PutFormToCreateALink (const char *FileNameToShow);
 static bool Brw_RcvFileInFileBrw (Brw_UploadType_t UploadType);
 static bool Brw_CheckIfUploadIsAllowed (const char *FileType);
 
+static void Brw_SendFileThroughWebServer (const char *PathInTree,const char *FileName);
+static const char *Brw_GetMIMETypeFromFileName (const char *FileName,bool *Inline);
 static bool Brw_CheckIfICanEditFileMetadata (long PublisherUsrCod);
 static void Brw_WriteBigLinkToDownloadFile (const char *URL,
                                             struct FileMetadata *FileMetadata,
@@ -1562,7 +1564,8 @@ static Brw_License_t Brw_GetParLicense (void);
 static void Brw_GetFileViewsFromLoggedUsrs (struct FileMetadata *FileMetadata);
 static void Brw_GetFileViewsFromNonLoggedUsrs (struct FileMetadata *FileMetadata);
 static unsigned Brw_GetFileViewsFromMe (long FilCod);
-static void Brw_UpdateFileViews (unsigned NumViews,long FilCod);
+static void Brw_GetFileViewsCounters (struct FileMetadata *FileMetadata);
+static void Brw_AddFileViewToJournal (long FilCod);
 static bool Brw_GetIfFolderHasPublicFiles (const char *Path);
 
 static void Brw_ChangeFileOrFolderHiddenInDB (const char *Path,bool IsHidden);
@@ -4050,6 +4053,15 @@ void Brw_RemoveInsFilesFromDB (long InsCod)
 	    InsCod);
    DB_QueryDELETE (Query,"can not remove file views to files of an institution");
 
+   /***** Remove from database the counters of file views *****/
+   sprintf (Query,"DELETE FROM file_view_counters USING file_view_counters,files"
+		  " WHERE files.FileBrowser IN ('%u','%u') AND files.Cod='%ld'"
+		  " AND files.FilCod=file_view_counters.FilCod",
+	    (unsigned) Brw_ADMI_DOCUM_INS,
+	    (unsigned) Brw_ADMI_SHARE_INS,
+	    InsCod);
+   DB_QueryDELETE (Query,"can not remove counters of file views to files of an institution");
+
    /***** Remove from database expanded folders *****/
    sprintf (Query,"DELETE LOW_PRIORITY FROM expanded_folders"
 		  " WHERE FileBrowser IN ('%u','%u') AND Cod='%ld'",
@@ -4110,6 +4122,15 @@ void Brw_RemoveCtrFilesFromDB (long CtrCod)
 	    CtrCod);
    DB_QueryDELETE (Query,"can not remove file views to files of a centre");
 
+   /***** Remove from database the counters of file views *****/
+   sprintf (Query,"DELETE FROM file_view_counters USING file_view_counters,files"
+		  " WHERE files.FileBrowser IN ('%u','%u') AND files.Cod='%ld'"
+		  " AND files.FilCod=file_view_counters.FilCod",
+	    (unsigned) Brw_ADMI_DOCUM_CTR,
+	    (unsigned) Brw_ADMI_SHARE_CTR,
+	    CtrCod);
+   DB_QueryDELETE (Query,"can not remove counters of file views to files of a centre");
+
    /***** Remove from database expanded folders *****/
    sprintf (Query,"DELETE LOW_PRIORITY FROM expanded_folders"
 		  " WHERE FileBrowser IN ('%u','%u') AND Cod='%ld'",
@@ -4168,6 +4189,15 @@ void Brw_RemoveDegFilesFromDB (long DegCod)
 	    DegCod);
    DB_QueryDELETE (Query,"can not remove file views to files of a degree");
 
+   /***** Remove from database the counters of file views *****/
+   sprintf (Query,"DELETE FROM file_view_counters USING file_view_counters,files"
+		  " WHERE files.FileBrowser IN ('%u','%u') AND files.Cod='%ld'"
+		  " AND files.FilCod=file_view_counters.FilCod",
+	    (unsigned) Brw_ADMI_DOCUM_DEG,
+	    (unsigned) Brw_ADMI_SHARE_DEG,
+	    DegCod);
+   DB_QueryDELETE (Query,"can not remove counters of file views to files of a degree");
+
    /***** Remove from database expanded folders *****/
    sprintf (Query,"DELETE LOW_PRIORITY FROM expanded_folders"
 		  " WHERE FileBrowser IN ('%u','%u') AND Cod='%ld'",
@@ -4227,6 +4257,15 @@ void Brw_RemoveCrsFilesFromDB (long CrsCod)
 	    CrsCod);
    DB_QueryDELETE (Query,"can not remove the properties of marks associated to a course");
 
+   /***** Remove indexes of files of marks *****/
+   sprintf (Query,"DELETE FROM marks_rows USING files,marks_rows"
+	          " WHERE files.FileBrowser='%u'"
+	          " AND files.Cod='%ld'"
+	          " AND files.FilCod=marks_rows.FilCod",
+	    (unsigned) Brw_ADMI_MARKS_CRS,
+	    CrsCod);
+   DB_QueryDELETE (Query,"can not remove the indexes of marks associated to a course");
+
    /***** Remove from database the entries that store the file views *****/
    sprintf (Query,"DELETE FROM file_view USING file_view,files"
 		  " WHERE files.FileBrowser IN ('%u','%u','%u','%u','%u','%u')"
@@ -4241,6 +4280,20 @@ void Brw_RemoveCrsFilesFromDB (long CrsCod)
 	    CrsCod);
    DB_QueryDELETE (Query,"can not remove file views to files of a course");
 
+   /***** Remove from database the counters of file views *****/
+   sprintf (Query,"DELETE FROM file_view_counters USING file_view_counters,files"
+		  " WHERE files.FileBrowser IN ('%u','%u','%u','%u','%u','%u')"
+		  " AND files.Cod='%ld'"
+		  " AND files.FilCod=file_view_counters.FilCod",
+	    (unsigned) Brw_ADMI_DOCUM_CRS,
+	    (unsigned) Brw_ADMI_TEACH_CRS,
+	    (unsigned) Brw_ADMI_SHARE_CRS,
+	    (unsigned) Brw_ADMI_ASSIG_USR,
+	    (unsigned) Brw_ADMI_WORKS_USR,
+	    (unsigned) Brw_ADMI_MARKS_CRS,
+	    CrsCod);
+   DB_QueryDELETE (Query,"can not remove counters of file views to files of a course");
+
    /***** Remove from database expanded folders *****/
    sprintf (Query,"DELETE LOW_PRIORITY FROM expanded_folders"
 		  " WHERE FileBrowser IN ('%u','%u','%u','%u','%u','%u','%u','%u')"
@@ -4329,6 +4382,15 @@ void Brw_RemoveGrpFilesFromDB (long GrpCod)
 	    GrpCod);
    DB_QueryDELETE (Query,"can not remove the properties of marks associated to a group");
 
+   /***** Remove indexes of files of marks *****/
+   sprintf (Query,"DELETE FROM marks_rows USING files,marks_rows"
+	          " WHERE files.FileBrowser='%u'"
+	          " AND files.Cod='%ld'"
+	          " AND files.FilCod=marks_rows.FilCod",
+	    (unsigned) Brw_ADMI_MARKS_GRP,
+	    GrpCod);
+   DB_QueryDELETE (Query,"can not remove the indexes of marks associated to a group");
+
    /***** Remove from database the entries that store the file views *****/
    sprintf (Query,"DELETE FROM file_view USING file_view,files"
 		  " WHERE files.FileBrowser IN ('%u','%u','%u','%u')"
@@ -4341,6 +4403,18 @@ void Brw_RemoveGrpFilesFromDB (long GrpCod)
 	    GrpCod);
    DB_QueryDELETE (Query,"can not remove file views to files of a group");
 
+   /***** Remove from database the counters of file views *****/
+   sprintf (Query,"DELETE FROM file_view_counters USING file_view_counters,files"
+		  " WHERE files.FileBrowser IN ('%u','%u','%u','%u')"
+		  " AND files.Cod='%ld'"
+		  " AND files.FilCod=file_view_counters.FilCod",
+	    (unsigned) Brw_ADMI_DOCUM_GRP,
+	    (unsigned) Brw_ADMI_TEACH_GRP,
+	    (unsigned) Brw_ADMI_SHARE_GRP,
+	    (unsigned) Brw_ADMI_MARKS_GRP,
+	    GrpCod);
+   DB_QueryDELETE (Query,"can not remove counters of file views to files of a group");
+
    /***** Remove from database expanded folders *****/
    sprintf (Query,"DELETE LOW_PRIORITY FROM expanded_folders"
 		  " WHERE FileBrowser IN ('%u','%u','%u','%u')"
@@ -4510,6 +4584,16 @@ void Brw_RemoveWrkFilesFromDB (long CrsCod,long UsrCod)
 	    CrsCod,UsrCod);
    DB_QueryDELETE (Query,"can not remove file views");
 
+   /***** Remove from database the counters of file views *****/
+   sprintf (Query,"DELETE FROM file_view_counters USING file_view_counters,files"
+		  " WHERE files.FileBrowser IN ('%u','%u')"
+		  " AND files.Cod='%ld' AND files.ZoneUsrCod='%ld'"
+		  " AND files.FilCod=file_view_counters.FilCod",
+	    (unsigned) Brw_ADMI_ASSIG_USR,
+	    (unsigned) Brw_ADMI_WORKS_USR,
+	    CrsCod,UsrCod);
+   DB_QueryDELETE (Query,"can not remove counters of file views");
+
    /***** Remove from database expanded folders *****/
    sprintf (Query,"DELETE LOW_PRIORITY FROM expanded_folders"
 		  " WHERE FileBrowser IN ('%u','%u')"
@@ -4564,6 +4648,13 @@ void Brw_RemoveUsrFilesFromDB (long UsrCod)
 	    UsrCod);
    DB_QueryDELETE (Query,"can not remove file views to files of a user");
 
+   /***** Remove from database the counters of file views *****/
+   sprintf (Query,"DELETE FROM file_view_counters USING file_view_counters,files"
+		 " WHERE files.ZoneUsrCod='%ld'"
+		 " AND files.FilCod=file_view_counters.FilCod",
+	    UsrCod);
+   DB_QueryDELETE (Query,"can not remove counters of file views to files of a user");
+
    /***** Remove from database expanded folders *****/
    sprintf (Query,"DELETE LOW_PRIORITY FROM expanded_folders"
 	          " WHERE UsrCod='%ld'",
@@ -7873,7 +7964,7 @@ static bool Brw_PasteTreeIntoFolder (const char *PathOrg,const char *PathDstInTr
 
 		  /* Add a new entry of marks into database */
 		  if (AdminMarks)
-		     Mrk_AddMarksToDB (FilCod,&Marks);
+		     Mrk_AddMarksToDB (FilCod,PathDstWithFile,&Marks);
 
 		  if (FileType == Brw_IS_FILE)
 		     (Pasted->NumFiles)++;
@@ -8680,7 +8771,7 @@ static bool Brw_RcvFileInFileBrw (Brw_UploadType_t UploadType)
 
                            /* Add a new entry of marks into database */
 			   if (AdminMarks)
-                              Mrk_AddMarksToDB (FileMetadata.FilCod,&Marks);
+                              Mrk_AddMarksToDB (FileMetadata.FilCod,Path,&Marks);
 
                            /* Notify new file */
 			   if (!Brw_CheckIfFileOrFolderIsHidden (&FileMetadata))
@@ -9546,6 +9637,7 @@ void Brw_DownloadFile (void)
    char URL[PATH_MAX+1];
    bool Found;
    bool ICanView = false;
+   bool SendFileThroughWebServer = false;
 
    /***** Get parameters related to file browser *****/
    Brw_GetParAndInitFileBrowser ();
@@ -9601,6 +9693,11 @@ void Brw_DownloadFile (void)
 	 if (Gbl.FileBrowser.Type == Brw_SHOW_MARKS_CRS ||
 	     Gbl.FileBrowser.Type == Brw_SHOW_MARKS_GRP)
 	    URL[0] = '\0';
+	 else if (Cfg_HTTP_HEADER_TO_SEND_FILE[0] &&
+	          FileMetadata.FileType == Brw_IS_FILE)
+	    // Permissions have been checked,
+	    // so the web server can send the private file directly
+	    SendFileThroughWebServer = true;
 	 else
 	    Brw_GetLinkToDownloadFile (Gbl.FileBrowser.Priv.PathInTreeUntilFilFolLnk,
 				       Gbl.FileBrowser.FilFolLnkName,
@@ -9646,10 +9743,11 @@ void Brw_DownloadFile (void)
       Brw_InsFoldersInPathAndUpdOtherFoldersInExpandedFolders (Gbl.FileBrowser.Priv.PathInTreeUntilFilFolLnk);
 
       /***** Download the file *****/
-      fprintf (stdout,"Location: %s\n\n",URL);
-      // TODO: Put headers Content-type and Content-disposition:
-      // See: http://stackoverflow.com/questions/381954/how-do-i-fix-firefox-trying-to-save-image-as-htm
-      // http://elouai.com/force-download.php
+      if (SendFileThroughWebServer)
+	 Brw_SendFileThroughWebServer (Gbl.FileBrowser.Priv.PathInTreeUntilFilFolLnk,
+				       Gbl.FileBrowser.FilFolLnkName);
+      else
+	 fprintf (stdout,"Location: %s\n\n",URL);
       Gbl.Layout.HTMLStartWritten =
       Gbl.Layout.DivsEndWritten   =
       Gbl.Layout.HTMLEndWritten   = true;	// Don't write HTML at all
@@ -9694,6 +9792,135 @@ void Brw_DownloadFile (void)
      }
   }
 
+/*****************************************************************************/
+/************** Pass the sending of a file to the web server *****************/
+/*****************************************************************************/
+// The web server (for example Apache with mod_xsendfile) sends the file,
+// serving partial (Range) requests, so no temporary public link is needed
+
+static void Brw_SendFileThroughWebServer (const char *PathInTree,const char *FileName)
+  {
+   char FullPathIncludingFile[PATH_MAX+1+PATH_MAX+1+NAME_MAX+1];
+   struct stat FileStatus;
+   char ETag[64];
+   char LastModified[64];
+   const char *IfNoneMatch;
+   const char *IfModifiedSince;
+   bool NotModified;
+   const char *MIMEType;
+   bool Inline;
+   char FileNameInHeader[NAME_MAX+1];
+   char *Ptr;
+
+   /***** Construct absolute path to file in the private directory *****/
+   sprintf (FullPathIncludingFile,"%s/%s/%s",
+	    Gbl.FileBrowser.Priv.PathAboveRootFolder,
+	    PathInTree,FileName);
+   if (lstat (FullPathIncludingFile,&FileStatus))
+      Lay_ShowErrorAndExit ("Can not get information about a file.");
+
+   /***** Validators to check if the copy in the browser is up to date *****/
+   sprintf (ETag,"\"%lx-%lx\"",
+            (unsigned long) FileStatus.st_size,
+            (unsigned long) FileStatus.st_mtime);
+   strftime (LastModified,sizeof (LastModified),
+             "%a, %d %b %Y %H:%M:%S GMT",gmtime (&FileStatus.st_mtime));
+
+   /***** Check if the browser already has this version of the file *****/
+   if ((IfNoneMatch = getenv ("HTTP_IF_NONE_MATCH")))
+      NotModified = (strstr (IfNoneMatch,ETag) != NULL);
+   else if ((IfModifiedSince = getenv ("HTTP_IF_MODIFIED_SINCE")))
+      NotModified = !strcmp (IfModifiedSince,LastModified);
+   else
+      NotModified = false;
+
+   /***** Quotes can not be inside the file name in header *****/
+   strncpy (FileNameInHeader,FileName,NAME_MAX);
+   FileNameInHeader[NAME_MAX] = '\0';
+   for (Ptr = FileNameInHeader;
+	*Ptr;
+	Ptr++)
+      if (*Ptr == '"' || *Ptr == '\r' || *Ptr == '\n')
+	 *Ptr = '_';
+
+   /***** Get MIME type and if file can be shown inside the browser *****/
+   MIMEType = Brw_GetMIMETypeFromFileName (FileName,&Inline);
+
+   /***** Write HTTP headers *****/
+   if (NotModified)
+      fprintf (stdout,"Status: 304 Not Modified\n"
+		      "ETag: %s\n"
+		      "Last-Modified: %s\n"
+		      "\n",
+	       ETag,LastModified);
+   else
+      fprintf (stdout,"Content-Type: %s\n"
+		      "Content-Disposition: %s; filename=\"%s\"\n"
+		      "X-Content-Type-Options: nosniff\n"
+		      "ETag: %s\n"
+		      "Last-Modified: %s\n"
+		      "Accept-Ranges: bytes\n"
+		      "%s: %s\n"
+		      "\n",
+	       MIMEType,
+	       Inline ? "inline" :
+		        "attachment",
+	       FileNameInHeader,
+	       ETag,
+	       LastModified,
+	       Cfg_HTTP_HEADER_TO_SEND_FILE,FullPathIncludingFile);
+  }
+
+/*****************************************************************************/
+/*************** Get MIME type of a file from its extension ******************/
+/*****************************************************************************/
+// Only usual types that browsers can show are considered,
+// the rest of files are sent as binary data.
+// Files are served from the same origin as SWAD,
+// so types that may run scripts (HTML, SVG, JavaScript, XML)
+// are not shown inside the browser, but downloaded as attachments
+
+static const char *Brw_GetMIMETypeFromFileName (const char *FileName,bool *Inline)
+  {
+   static const struct
+     {
+      const char *Extension;
+      const char *MIMEType;
+      bool Inline;
+     } MIMETypes[] =
+     {
+      {"pdf" ,"application/pdf"		,true },
+      {"htm" ,"text/html"		,false},
+      {"html","text/html"		,false},
+      {"txt" ,"text/plain"		,true },
+      {"css" ,"text/css"		,true },
+      {"js"  ,"application/javascript"	,false},
+      {"xml" ,"text/xml"		,false},
+      {"gif" ,"image/gif"		,true },
+      {"jpg" ,"image/jpeg"		,true },
+      {"jpeg","image/jpeg"		,true },
+      {"png" ,"image/png"		,true },
+      {"svg" ,"image/svg+xml"		,false},
+      {"mp3" ,"audio/mpeg"		,true },
+      {"ogg" ,"audio/ogg"		,true },
+      {"mp4" ,"video/mp4"		,true },
+      {"webm","video/webm"		,true },
+     };
+   unsigned NumType;
+
+   for (NumType = 0;
+	NumType < sizeof (MIMETypes) / sizeof (MIMETypes[0]);
+	NumType++)
+      if (Str_FileIs (FileName,MIMETypes[NumType].Extension))
+	{
+	 *Inline = MIMETypes[NumType].Inline;
+	 return MIMETypes[NumType].MIMEType;
+	}
+
+   *Inline = false;
+   return "application/octet-stream";
+  }
+
 /*****************************************************************************/
 /*********** Check if I have permission to change file metadata **************/
 /*****************************************************************************/
@@ -10419,11 +10646,8 @@ void Brw_GetAndUpdateFileViews (struct FileMetadata *FileMetadata)
   {
    if (FileMetadata->FilCod > 0)
      {
-      /***** Get file views from logged users *****/
-      Brw_GetFileViewsFromLoggedUsrs (FileMetadata);
-
-      /***** Get file views from non logged users *****/
-      Brw_GetFileViewsFromNonLoggedUsrs (FileMetadata);
+      /***** Get file views from denormalized counters *****/
+      Brw_GetFileViewsCounters (FileMetadata);
 
       /***** Get number of my views *****/
       if (Gbl.Usrs.Me.Logged)
@@ -10436,12 +10660,9 @@ void Brw_GetAndUpdateFileViews (struct FileMetadata *FileMetadata)
       else
          FileMetadata->NumMyViews = FileMetadata->NumPublicViews;
 
-      /***** Update number of my views (if I am not logged, UsrCod == -1L) *****/
-      Brw_UpdateFileViews (FileMetadata->NumMyViews,FileMetadata->FilCod);
-
-      /***** Increment number of file views in my user's figures *****/
-      if (Gbl.Usrs.Me.Logged)
-         Prf_IncrementNumFileViewsUsr (Gbl.Usrs.Me.UsrDat.UsrCod);
+      /***** Append this view to journal (if I am not logged, UsrCod == -1L) *****/
+      // File views and user's figures are updated later from journal
+      Brw_AddFileViewToJournal (FileMetadata->FilCod);
      }
    else
       FileMetadata->NumMyViews             =
@@ -10456,8 +10677,9 @@ void Brw_GetAndUpdateFileViews (struct FileMetadata *FileMetadata)
 
 void Brw_UpdateMyFileViews (long FilCod)
   {
-   /***** Update number of my views *****/
-   Brw_UpdateFileViews (Brw_GetFileViewsFromMe (FilCod),FilCod);
+   /***** Append this view to journal *****/
+   if (FilCod > 0)
+      Brw_AddFileViewToJournal (FilCod);
   }
 
 /*****************************************************************************/
@@ -10607,32 +10829,161 @@ static unsigned Brw_GetFileViewsFromMe (long FilCod)
   }
 
 /*****************************************************************************/
-/*************************** Update file views *******************************/
+/************** Get file views from denormalized counters ********************/
 /*****************************************************************************/
-
-static void Brw_UpdateFileViews (unsigned NumViews,long FilCod)
+/*
+   Input:  FileMetadata->FilCod
+   Output: FileMetadata->NumPublicViews
+           FileMetadata->NumViewsFromLoggedUsrs
+           FileMetadata->NumLoggedUsrs
+*/
+static void Brw_GetFileViewsCounters (struct FileMetadata *FileMetadata)
   {
    char Query[256];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   bool Found;
 
-   if (NumViews)
+   /***** Get counters of views of this file *****/
+   sprintf (Query,"SELECT NumLoggedUsrs,NumViewsFromLoggedUsrs,NumPublicViews"
+		  " FROM file_view_counters"
+		  " WHERE FilCod='%ld'",
+	    FileMetadata->FilCod);
+   if ((Found = (DB_QuerySELECT (Query,&mysql_res,"can not get counters of views of a file") != 0)))
      {
-      /* Update number of views in database */
-      sprintf (Query,"UPDATE file_view SET NumViews=NumViews+1"
-		     " WHERE FilCod='%ld' AND UsrCod='%ld'",
-	       FilCod,Gbl.Usrs.Me.UsrDat.UsrCod);
-      DB_QueryUPDATE (Query,"can not update number of views of a file");
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get number of distinct users (row[0]) */
+      if (sscanf (row[0],"%u",&(FileMetadata->NumLoggedUsrs)) != 1)
+	 FileMetadata->NumLoggedUsrs = 0;
+
+      /* Get number of views from logged users (row[1]) */
+      if (sscanf (row[1],"%u",&(FileMetadata->NumViewsFromLoggedUsrs)) != 1)
+	 FileMetadata->NumViewsFromLoggedUsrs = 0;
+
+      /* Get number of public views (row[2]) */
+      if (sscanf (row[2],"%u",&(FileMetadata->NumPublicViews)) != 1)
+	 FileMetadata->NumPublicViews = 0;
      }
-   else	// NumViews == 0
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   if (!Found)
      {
-      /* Insert number of views in database */
-      sprintf (Query,"INSERT INTO file_view"
-		     " (FilCod,UsrCod,NumViews)"
-		     " VALUES ('%ld','%ld','1')",
-	       FilCod,Gbl.Usrs.Me.UsrDat.UsrCod);
-      DB_QueryINSERT (Query,"can not insert number of views of a file");
+      /***** Counters not yet created for this file ==>
+             compute them from file views and store them *****/
+      Brw_GetFileViewsFromLoggedUsrs (FileMetadata);
+      Brw_GetFileViewsFromNonLoggedUsrs (FileMetadata);
+
+      sprintf (Query,"INSERT IGNORE INTO file_view_counters"
+		     " (FilCod,NumLoggedUsrs,NumViewsFromLoggedUsrs,NumPublicViews)"
+		     " VALUES ('%ld','%u','%u','%u')",
+	       FileMetadata->FilCod,
+	       FileMetadata->NumLoggedUsrs,
+	       FileMetadata->NumViewsFromLoggedUsrs,
+	       FileMetadata->NumPublicViews);
+      DB_QueryINSERT (Query,"can not create counters of views of a file");
      }
   }
 
+/*****************************************************************************/
+/********************* Append a file view to journal *************************/
+/*****************************************************************************/
+// Only an insertion is made here, so concurrent views of the same file
+// do not contend on the same rows of file_view.
+// Views are folded into file_view and counters by Brw_MergePendingFileViews
+
+static void Brw_AddFileViewToJournal (long FilCod)
+  {
+   char Query[128];
+
+   /***** Insert view into journal *****/
+   sprintf (Query,"INSERT INTO file_view_pending"
+		  " (FilCod,UsrCod)"
+		  " VALUES ('%ld','%ld')",
+	    FilCod,Gbl.Usrs.Me.UsrDat.UsrCod);
+   DB_QueryINSERT (Query,"can not insert view of a file");
+  }
+
+/*****************************************************************************/
+/************* Fold pending file views into views and counters ***************/
+/*****************************************************************************/
+// This function is called periodically, not in every file view
+
+void Brw_MergePendingFileViews (void)
+  {
+   char Query[1024];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   long MaxViewCod = -1L;
+
+   DB_Query ("START TRANSACTION","can not start transaction");
+   Gbl.DB.OpenTransaction = true;
+
+   /***** Get last pending view,
+          locking journal against other merges *****/
+   // Views appended after this one will be merged next time
+   DB_QuerySELECT ("SELECT MAX(ViewCod) FROM file_view_pending FOR UPDATE",
+                   &mysql_res,"can not get pending views of files");
+   row = mysql_fetch_row (mysql_res);
+   if (row[0])
+      if (sscanf (row[0],"%ld",&MaxViewCod) != 1)
+	 MaxViewCod = -1L;
+   DB_FreeMySQLResult (&mysql_res);
+
+   if (MaxViewCod > 0)
+     {
+      /***** Add pending views to views of each user in each file *****/
+      // Views of files removed in the meantime are discarded
+      sprintf (Query,"INSERT INTO file_view (FilCod,UsrCod,NumViews)"
+		     " SELECT file_view_pending.FilCod,file_view_pending.UsrCod,COUNT(*)"
+		     " FROM file_view_pending,files"
+		     " WHERE file_view_pending.ViewCod<='%ld'"
+		     " AND file_view_pending.FilCod=files.FilCod"
+		     " GROUP BY file_view_pending.FilCod,file_view_pending.UsrCod"
+		     " ON DUPLICATE KEY UPDATE NumViews=NumViews+VALUES(NumViews)",
+	       MaxViewCod);
+      DB_QueryINSERT (Query,"can not update views of files");
+
+      /***** Add pending views to figures of each user *****/
+      // If NumFileViews < 0 ==> not yet calculated, so do nothing
+      sprintf (Query,"UPDATE usr_figures,"
+		     "(SELECT UsrCod,COUNT(*) AS NumViews"
+		     " FROM file_view_pending"
+		     " WHERE ViewCod<='%ld' AND UsrCod>'0'"
+		     " GROUP BY UsrCod) AS pending"
+		     " SET usr_figures.NumFileViews=usr_figures.NumFileViews+pending.NumViews"
+		     " WHERE usr_figures.UsrCod=pending.UsrCod"
+		     " AND usr_figures.NumFileViews>=0",
+	       MaxViewCod);
+      DB_QueryUPDATE (Query,"can not update users' file views");
+
+      /***** Update counters of views of the files viewed *****/
+      sprintf (Query,"REPLACE INTO file_view_counters"
+		     " (FilCod,NumLoggedUsrs,NumViewsFromLoggedUsrs,NumPublicViews)"
+		     " SELECT FilCod,"
+		     "COUNT(DISTINCT IF(UsrCod>'0',UsrCod,NULL)),"
+		     "SUM(IF(UsrCod>'0',NumViews,0)),"
+		     "SUM(IF(UsrCod<='0',NumViews,0))"
+		     " FROM file_view"
+		     " WHERE FilCod IN"
+		     " (SELECT DISTINCT FilCod FROM file_view_pending"
+		     " WHERE ViewCod<='%ld')"
+		     " GROUP BY FilCod",
+	       MaxViewCod);
+      DB_QueryREPLACE (Query,"can not update counters of views of files");
+
+      /***** Remove merged views from journal *****/
+      sprintf (Query,"DELETE FROM file_view_pending WHERE ViewCod<='%ld'",
+	       MaxViewCod);
+      DB_QueryDELETE (Query,"can not remove pending views of files");
+     }
+
+   DB_Query ("COMMIT","can not commit transaction");
+   Gbl.DB.OpenTransaction = false;
+  }
+
 /*****************************************************************************/
 /*********** Check if a folder contains file(s) marked as public *************/
 /*****************************************************************************/
@@ -10927,6 +11278,13 @@ static void Brw_RemoveOneFileOrFolderFromDB (const char *Path)
 		     " AND files.FilCod=marks_properties.FilCod",
 	       (unsigned) FileBrowser,Cod,Path);
       DB_QueryDELETE (Query,"can not remove properties of marks from database");
+
+      sprintf (Query,"DELETE FROM marks_rows USING files,marks_rows"
+		     " WHERE files.FileBrowser='%u' AND files.Cod='%ld'"
+		     " AND files.Path='%s'"
+		     " AND files.FilCod=marks_rows.FilCod",
+	       (unsigned) FileBrowser,Cod,Path);
+      DB_QueryDELETE (Query,"can not remove indexes of marks from database");
      }
 
    /***** Remove from database the entries that store the file views *****/
@@ -10937,6 +11295,14 @@ static void Brw_RemoveOneFileOrFolderFromDB (const char *Path)
 	    (unsigned) FileBrowser,Cod,ZoneUsrCod,Path);
    DB_QueryDELETE (Query,"can not remove file views from database");
 
+   /***** Remove from database the counters of file views *****/
+   sprintf (Query,"DELETE FROM file_view_counters USING file_view_counters,files"
+	          " WHERE files.FileBrowser='%u' AND files.Cod='%ld' AND files.ZoneUsrCod='%ld'"
+	          " AND files.Path='%s'"
+	          " AND files.FilCod=file_view_counters.FilCod",
+	    (unsigned) FileBrowser,Cod,ZoneUsrCod,Path);
+   DB_QueryDELETE (Query,"can not remove counters of file views from database");
+
    /***** Remove from database the entry that stores the data of a file *****/
    sprintf (Query,"DELETE FROM files"
                   " WHERE FileBrowser='%u' AND Cod='%ld' AND ZoneUsrCod='%ld'"
@@ -10972,6 +11338,13 @@ static void Brw_RemoveChildrenOfFolderFromDB (const char *Path)
 		     " AND files.FilCod=marks_properties.FilCod",
 	       (unsigned) FileBrowser,Cod,Path);
       DB_QueryDELETE (Query,"can not remove properties of marks from database");
+
+      sprintf (Query,"DELETE FROM marks_rows USING files,marks_rows"
+		     " WHERE files.FileBrowser='%u' AND files.Cod='%ld'"
+		     " AND files.Path LIKE '%s/%%'"
+		     " AND files.FilCod=marks_rows.FilCod",
+	       (unsigned) FileBrowser,Cod,Path);
+      DB_QueryDELETE (Query,"can not remove indexes of marks from database");
      }
 
    /***** Remove from database the entries that store the file views *****/
@@ -10982,6 +11355,14 @@ static void Brw_RemoveChildrenOfFolderFromDB (const char *Path)
             (unsigned) FileBrowser,Cod,ZoneUsrCod,Path);
    DB_QueryDELETE (Query,"can not remove file views from database");
 
+   /***** Remove from database the counters of file views *****/
+   sprintf (Query,"DELETE FROM file_view_counters USING file_view_counters,files"
+                  " WHERE files.FileBrowser='%u' AND files.Cod='%ld' AND files.ZoneUsrCod='%ld'"
+                  " AND files.Path LIKE '%s/%%'"
+	          " AND files.FilCod=file_view_counters.FilCod",
+            (unsigned) FileBrowser,Cod,ZoneUsrCod,Path);
+   DB_QueryDELETE (Query,"can not remove counters of file views from database");
+
    /***** Remove from database the entries that store the data of files *****/
    sprintf (Query,"DELETE FROM files"
                   " WHERE FileBrowser='%u' AND Cod='%ld' AND ZoneUsrCod='%ld'"
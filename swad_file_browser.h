@@ -206,6 +206,7 @@ void Brw_GetFileMetadataByCod (struct FileMetadata *FileMetadata);
 bool Brw_GetFileTypeSizeAndDate (struct FileMetadata *FileMetadata);
 void Brw_GetAndUpdateFileViews (struct FileMetadata *FileMetadata);
 void Brw_UpdateMyFileViews (long FilCod);
+void Brw_MergePendingFileViews (void);
 unsigned long Brw_GetNumFileViewsUsr (long UsrCod);
 unsigned Brw_GetNumFilesUsr (long UsrCod);
 unsigned Brw_GetNumPublicFilesUsr (long UsrCod);
@@ -48,6 +48,13 @@
 
 #define Fol_MAX_USRS_TO_FOLLOW_SUGGESTED (Fol_NUM_COLUMNS_FOLLOW * 3)
 
+// Size of the pool of users to follow precomputed for each user
+#define Fol_MAX_LIKELY_KNOWN_USRS_IN_POOL   (Fol_MAX_USRS_TO_FOLLOW_SUGGESTED * 10)
+#define Fol_MAX_LIKELY_UNKNOWN_USRS_IN_POOL (Fol_MAX_USRS_TO_FOLLOW_SUGGESTED *  5)
+
+// The pool of users to follow is computed again after these seconds
+#define Fol_TIME_TO_RECOMPUTE_USRS_TO_FOLLOW ((time_t)(24UL*60UL*60UL))	// 1 day
+
 /*****************************************************************************/
 /****************************** Internal types *******************************/
 /*****************************************************************************/
@@ -66,6 +73,8 @@ extern struct Globals Gbl;
 /***************************** Private prototypes ****************************/
 /*****************************************************************************/
 
+static bool Fol_CheckIfUsrsToFollowAreComputed (void);
+static void Fol_ComputeUsrsToFollow (void);
 static void Fol_PutIconsWhoToFollow (void);
 static void Fol_PutIconToUpdateWhoToFollow (void);
 
@@ -101,10 +110,9 @@ void Fol_PutLinkWhoToFollow (void)
 
 void Fol_SuggestWhoToFollow (void)
   {
-   extern const char *Pri_VisibilityDB[Pri_NUM_OPTIONS_PRIVACY];
    extern const char *Txt_Who_to_follow;
    extern const char *Txt_No_user_to_whom_you_can_follow_Try_again_later;
-   char Query[2048];
+   char Query[1024];
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
    unsigned NumUsrs;
@@ -114,17 +122,123 @@ void Fol_SuggestWhoToFollow (void)
    /***** Put link to request user's profile *****/
    Prf_PutLinkRequestUserProfile ();
 
-   /***** First try: build query to get users to follow *****/
-   // Get only users with surname 1 and first name
-   sprintf (Query,"SELECT DISTINCT UsrCod FROM"
+   /***** Compute pool of users to follow if not computed recently *****/
+   if (!Fol_CheckIfUsrsToFollowAreComputed ())
+      Fol_ComputeUsrsToFollow ();
+
+   /***** Build query to get a sample of users from pool *****/
+   // Users with more links to me are more likely to be selected
+   sprintf (Query,"SELECT SuggestedCod FROM"
                   " ("
-		  /***** Likely known users *****/
-                  "(SELECT DISTINCT UsrCod FROM"
+                  "(SELECT SuggestedCod FROM usr_follow_suggested"
+                  " WHERE UsrCod='%ld' AND Score>'0'"
+		  // Get only Fol_MAX_USRS_TO_FOLLOW_SUGGESTED*2 likely known users
+                  " ORDER BY Score*RAND() DESC LIMIT %u)"
+                  " UNION "
+                  "(SELECT SuggestedCod FROM usr_follow_suggested"
+                  " WHERE UsrCod='%ld' AND Score='0'"
+		  // Get only Fol_MAX_USRS_TO_FOLLOW_SUGGESTED likely unknown users
+                  " ORDER BY RAND() LIMIT %u)"
+                  ") AS UsrsToFollow"
+		  // Get only Fol_MAX_USRS_TO_FOLLOW_SUGGESTED users
+                  " ORDER BY RAND() LIMIT %u",
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Fol_MAX_USRS_TO_FOLLOW_SUGGESTED*2,	// 2/3 likely known users
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Fol_MAX_USRS_TO_FOLLOW_SUGGESTED,	// 1/3 likely unknown users
+	    Fol_MAX_USRS_TO_FOLLOW_SUGGESTED);
+
+   /***** Get users *****/
+   NumUsrs = (unsigned) DB_QuerySELECT (Query,&mysql_res,"can not get followed users");
+   if (NumUsrs)
+     {
+      /***** Start frame *****/
+      Lay_StartRoundFrame ("560px",Txt_Who_to_follow,Fol_PutIconsWhoToFollow);
+
+      /***** Initialize structure with user's data *****/
+      Usr_UsrDataConstructor (&UsrDat);
+
+      /***** Start listing *****/
+      fprintf (Gbl.F.Out,"<table class=\"FRAME_TABLE CELLS_PAD_2\">");
+
+      for (NumUsr = 0;
+	   NumUsr < NumUsrs;
+	   NumUsr++)
+	{
+	 /***** Get user *****/
+	 row = mysql_fetch_row (mysql_res);
+
+	 /* Get user's code (row[0]) */
+	 UsrDat.UsrCod = Str_ConvertStrCodToLongCod (row[0]);
+
+	 /***** Show user *****/
+	 if ((NumUsr % Fol_NUM_COLUMNS_FOLLOW) == 0)
+	    fprintf (Gbl.F.Out,"<tr>");
+	 if (Usr_ChkUsrCodAndGetAllUsrDataFromUsrCod (&UsrDat))
+	    Fol_ShowFollowedOrFollower (&UsrDat);
+	 if ((NumUsr % Fol_NUM_COLUMNS_FOLLOW) == (Fol_NUM_COLUMNS_FOLLOW-1) ||
+	     NumUsr == NumUsrs - 1)
+	    fprintf (Gbl.F.Out,"</tr>");
+	}
+
+      /***** End listing *****/
+      fprintf (Gbl.F.Out,"</table>");
+
+      /***** Free memory used for user's data *****/
+      Usr_UsrDataDestructor (&UsrDat);
+
+      /***** End frame *****/
+      Lay_EndRoundFrame ();
+     }
+   else
+      Lay_ShowAlert (Lay_INFO,Txt_No_user_to_whom_you_can_follow_Try_again_later);
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/************ Check if my pool of users to follow is up to date **************/
+/*****************************************************************************/
+
+static bool Fol_CheckIfUsrsToFollowAreComputed (void)
+  {
+   char Query[256];
+
+   /***** Get if there are recent users to follow in my pool *****/
+   sprintf (Query,"SELECT COUNT(*) FROM usr_follow_suggested"
+		  " WHERE UsrCod='%ld'"
+		  " AND CreatTime>FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')",
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    (unsigned long) Fol_TIME_TO_RECOMPUTE_USRS_TO_FOLLOW);
+   return (DB_QueryCOUNT (Query,"can not check users to follow") != 0);
+  }
+
+/*****************************************************************************/
+/****************** Compute my pool of users to follow ***********************/
+/*****************************************************************************/
+/* Likely known users are ranked by the number of links to me:
+   my followed who follow them and courses shared with them.
+   Some likely unknown random users are added with score 0. */
+
+static void Fol_ComputeUsrsToFollow (void)
+  {
+   extern const char *Pri_VisibilityDB[Pri_NUM_OPTIONS_PRIVACY];
+   char Query[2048];
+
+   /***** Remove my old pool *****/
+   Fol_RemoveUsrsToFollow (Gbl.Usrs.Me.UsrDat.UsrCod);
+
+   /***** Insert likely known users into my pool *****/
+   // Get only users with surname 1 and first name
+   sprintf (Query,"INSERT INTO usr_follow_suggested"
+		  " (UsrCod,SuggestedCod,Score,CreatTime)"
+		  " SELECT '%ld',UsrCod,COUNT(*) AS Score,NOW() FROM"
                   " ("
 		  // Users followed by my followed whose privacy is
                   // Pri_VISIBILITY_SYSTEM or Pri_VISIBILITY_WORLD
                   "("
-                  "SELECT DISTINCT usr_follow.FollowedCod AS UsrCod"
+                  "SELECT usr_follow.FollowedCod AS UsrCod"
                   " FROM usr_follow,"
                   "(SELECT FollowedCod FROM usr_follow"
                   " WHERE FollowerCod='%ld') AS my_followed,"
@@ -136,12 +250,12 @@ void Fol_SuggestWhoToFollow (void)
 		  " AND usr_data.Surname1<>''"	// Surname 1 not empty
 		  " AND usr_data.FirstName<>''"	// First name not empty
                   ")"
-                  " UNION "
+                  " UNION ALL "
 		  // Users who share any course with me
 		  // and whose privacy is Pri_VISIBILITY_COURSE,
                   // Pri_VISIBILITY_SYSTEM or Pri_VISIBILITY_WORLD
                   "("
-                  "SELECT DISTINCT crs_usr.UsrCod"
+                  "SELECT crs_usr.UsrCod"
                   " FROM crs_usr,"
                   "(SELECT CrsCod FROM crs_usr"
                   " WHERE UsrCod='%ld') AS my_crs,"
@@ -153,11 +267,11 @@ void Fol_SuggestWhoToFollow (void)
 		  " AND usr_data.Surname1<>''"	// Surname 1 not empty
 		  " AND usr_data.FirstName<>''"	// First name not empty
                   ")"
-                  " UNION "
+                  " UNION ALL "
 		  // Users who share any course with me with another role
 		  // and whose privacy is Pri_VISIBILITY_USER
                   "("
-                  "SELECT DISTINCT crs_usr.UsrCod"
+                  "SELECT crs_usr.UsrCod"
                   " FROM crs_usr,"
                   "(SELECT CrsCod,Role FROM crs_usr"
                   " WHERE UsrCod='%ld') AS my_crs_role,"
@@ -174,15 +288,30 @@ void Fol_SuggestWhoToFollow (void)
                   " WHERE UsrCod NOT IN"
                   " (SELECT FollowedCod FROM usr_follow"
                   " WHERE FollowerCod='%ld')"
-		  // Get only Fol_MAX_USRS_TO_FOLLOW_SUGGESTED*2 users
-		  " ORDER BY RAND() LIMIT %u"
-                  ")"
-                  " UNION "
-                  "("
-		  /***** Likely unknown users *****/
-		  // Add some likely unknown random users with privacy
-                  // Pri_VISIBILITY_SYSTEM or Pri_VISIBILITY_WORLD
-		  "SELECT UsrCod FROM usr_data"
+                  " GROUP BY UsrCod"
+		  // Get only the best ranked users
+		  " ORDER BY Score DESC LIMIT %u",
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Pri_VisibilityDB[Pri_VISIBILITY_SYSTEM],
+	    Pri_VisibilityDB[Pri_VISIBILITY_WORLD ],
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Pri_VisibilityDB[Pri_VISIBILITY_COURSE],
+	    Pri_VisibilityDB[Pri_VISIBILITY_SYSTEM],
+	    Pri_VisibilityDB[Pri_VISIBILITY_WORLD ],
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Pri_VisibilityDB[Pri_VISIBILITY_USER  ],
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Fol_MAX_LIKELY_KNOWN_USRS_IN_POOL);
+   DB_QueryINSERT (Query,"can not store users to follow");
+
+   /***** Insert some likely unknown random users into my pool *****/
+   // Users with privacy Pri_VISIBILITY_SYSTEM or Pri_VISIBILITY_WORLD
+   sprintf (Query,"INSERT IGNORE INTO usr_follow_suggested"
+		  " (UsrCod,SuggestedCod,Score,CreatTime)"
+		  " SELECT '%ld',UsrCod,'0',NOW() FROM usr_data"
 		  " WHERE UsrCod<>'%ld'"
 		  " AND ProfileVisibility IN ('%s','%s')"
 		  " AND Surname1<>''"	// Surname 1 not empty
@@ -191,81 +320,14 @@ void Fol_SuggestWhoToFollow (void)
 		  " AND UsrCod NOT IN"
 		  " (SELECT FollowedCod FROM usr_follow"
 		  " WHERE FollowerCod='%ld')"
-		  // Get only Fol_MAX_USRS_TO_FOLLOW_SUGGESTED users
-		  " ORDER BY RAND() LIMIT %u"
-		  ")"
-                  ") AS UsrsToFollow"
-		  // Get only Fol_MAX_USRS_TO_FOLLOW_SUGGESTED users
-                  " ORDER BY RAND() LIMIT %u",
-   Gbl.Usrs.Me.UsrDat.UsrCod,
-   Gbl.Usrs.Me.UsrDat.UsrCod,
-   Pri_VisibilityDB[Pri_VISIBILITY_SYSTEM],
-   Pri_VisibilityDB[Pri_VISIBILITY_WORLD ],
-   Gbl.Usrs.Me.UsrDat.UsrCod,
-   Gbl.Usrs.Me.UsrDat.UsrCod,
-   Pri_VisibilityDB[Pri_VISIBILITY_COURSE],
-   Pri_VisibilityDB[Pri_VISIBILITY_SYSTEM],
-   Pri_VisibilityDB[Pri_VISIBILITY_WORLD ],
-   Gbl.Usrs.Me.UsrDat.UsrCod,
-   Pri_VisibilityDB[Pri_VISIBILITY_USER  ],
-   Gbl.Usrs.Me.UsrDat.UsrCod,
-   Fol_MAX_USRS_TO_FOLLOW_SUGGESTED*2,	// 2/3 likely known users
-
-   Gbl.Usrs.Me.UsrDat.UsrCod,
-   Pri_VisibilityDB[Pri_VISIBILITY_SYSTEM],
-   Pri_VisibilityDB[Pri_VISIBILITY_WORLD ],
-   Gbl.Usrs.Me.UsrDat.UsrCod,
-   Fol_MAX_USRS_TO_FOLLOW_SUGGESTED,	// 1/3 likely unknown users
-
-   Fol_MAX_USRS_TO_FOLLOW_SUGGESTED);
-
-   /***** Get users *****/
-   NumUsrs = (unsigned) DB_QuerySELECT (Query,&mysql_res,"can not get followed users");
-   if (NumUsrs)
-     {
-      /***** Start frame *****/
-      Lay_StartRoundFrame ("560px",Txt_Who_to_follow,Fol_PutIconsWhoToFollow);
-
-      /***** Initialize structure with user's data *****/
-      Usr_UsrDataConstructor (&UsrDat);
-
-      /***** Start listing *****/
-      fprintf (Gbl.F.Out,"<table class=\"FRAME_TABLE CELLS_PAD_2\">");
-
-      for (NumUsr = 0;
-	   NumUsr < NumUsrs;
-	   NumUsr++)
-	{
-	 /***** Get user *****/
-	 row = mysql_fetch_row (mysql_res);
-
-	 /* Get user's code (row[0]) */
-	 UsrDat.UsrCod = Str_ConvertStrCodToLongCod (row[0]);
-
-	 /***** Show user *****/
-	 if ((NumUsr % Fol_NUM_COLUMNS_FOLLOW) == 0)
-	    fprintf (Gbl.F.Out,"<tr>");
-	 if (Usr_ChkUsrCodAndGetAllUsrDataFromUsrCod (&UsrDat))
-	    Fol_ShowFollowedOrFollower (&UsrDat);
-	 if ((NumUsr % Fol_NUM_COLUMNS_FOLLOW) == (Fol_NUM_COLUMNS_FOLLOW-1) ||
-	     NumUsr == NumUsrs - 1)
-	    fprintf (Gbl.F.Out,"</tr>");
-	}
-
-      /***** End listing *****/
-      fprintf (Gbl.F.Out,"</table>");
-
-      /***** Free memory used for user's data *****/
-      Usr_UsrDataDestructor (&UsrDat);
-
-      /***** End frame *****/
-      Lay_EndRoundFrame ();
-     }
-   else
-      Lay_ShowAlert (Lay_INFO,Txt_No_user_to_whom_you_can_follow_Try_again_later);
-
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
+		  " ORDER BY RAND() LIMIT %u",
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Pri_VisibilityDB[Pri_VISIBILITY_SYSTEM],
+	    Pri_VisibilityDB[Pri_VISIBILITY_WORLD ],
+	    Gbl.Usrs.Me.UsrDat.UsrCod,
+	    Fol_MAX_LIKELY_UNKNOWN_USRS_IN_POOL);
+   DB_QueryINSERT (Query,"can not store users to follow");
   }
 
 /*****************************************************************************/
@@ -788,6 +850,13 @@ void Fol_FollowUsr (void)
 		     Gbl.Usrs.Other.UsrDat.UsrCod);
 	    DB_QueryREPLACE (Query,"can not follow user");
 
+	    /***** Remove followed user from my pool of users to follow *****/
+	    sprintf (Query,"DELETE FROM usr_follow_suggested"
+			   " WHERE UsrCod='%ld' AND SuggestedCod='%ld'",
+		     Gbl.Usrs.Me.UsrDat.UsrCod,
+		     Gbl.Usrs.Other.UsrDat.UsrCod);
+	    DB_QueryDELETE (Query,"can not remove user to follow");
+
 	    /***** This follow must be notified by e-mail? *****/
             CreateNotif = (Gbl.Usrs.Other.UsrDat.Prefs.NotifNtfEvents & (1 << Ntf_EVENT_FOLLOWER));
             NotifyByEmail = CreateNotif &&
@@ -833,6 +902,9 @@ void Fol_UnfollowUsr (void)
 		  Gbl.Usrs.Me.UsrDat.UsrCod,
                   Gbl.Usrs.Other.UsrDat.UsrCod);
 	 DB_QueryREPLACE (Query,"can not unfollow user");
+
+	 /***** My pool of users to follow must be computed again *****/
+	 Fol_RemoveUsrsToFollow (Gbl.Usrs.Me.UsrDat.UsrCod);
         }
 
       /***** Show user's profile again *****/
@@ -950,4 +1022,37 @@ void Fol_RemoveUsrFromUsrFollow (long UsrCod)
 	          " WHERE FollowerCod='%ld' OR FollowedCod='%ld'",
 	    UsrCod,UsrCod);
    DB_QueryDELETE (Query,"can not remove user from followers and followed");
+
+   sprintf (Query,"DELETE FROM usr_follow_suggested"
+	          " WHERE UsrCod='%ld' OR SuggestedCod='%ld'",
+	    UsrCod,UsrCod);
+   DB_QueryDELETE (Query,"can not remove user from users to follow");
+  }
+
+/*****************************************************************************/
+/************ Remove the pool of users to follow of a user *******************/
+/*****************************************************************************/
+// The pool will be computed again the next time it is needed
+
+void Fol_RemoveUsrsToFollow (long UsrCod)
+  {
+   char Query[128];
+
+   sprintf (Query,"DELETE FROM usr_follow_suggested WHERE UsrCod='%ld'",
+	    UsrCod);
+   DB_QueryDELETE (Query,"can not remove users to follow");
+  }
+
+/*****************************************************************************/
+/*************** Remove old pools of users to follow *************************/
+/*****************************************************************************/
+
+void Fol_RemoveOldUsrsToFollow (void)
+  {
+   char Query[256];
+
+   sprintf (Query,"DELETE LOW_PRIORITY FROM usr_follow_suggested"
+	          " WHERE CreatTime<FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')",
+	    (unsigned long) Fol_TIME_TO_RECOMPUTE_USRS_TO_FOLLOW);
+   DB_QueryDELETE (Query,"can not remove old users to follow");
   }
@@ -63,5 +63,7 @@ void Fol_GetAndShowRankingFollowers (void);
 void Fol_GetNotifFollower (char *SummaryStr,char **ContentStr);
 
 void Fol_RemoveUsrFromUsrFollow (long UsrCod);
+void Fol_RemoveUsrsToFollow (long UsrCod);
+void Fol_RemoveOldUsrsToFollow (void);
 
 #endif
@@ -268,12 +268,11 @@ static void For_GetThrSubject (long ThrCod,char *Subject,size_t MaxSize);
 static void For_UpdateThrFirstAndLastPst (long ThrCod,long FirstPstCod,long LastPstCod);
 static void For_UpdateThrLastPst (long ThrCod,long LastPstCod);
 static long For_GetLastPstCod (long ThrCod);
+static void For_GetForumOfThr (long ThrCod,For_ForumType_t *ForumType,long *Location);
 
 static void For_UpdateThrReadTime (long ThrCod,time_t ReadTimeUTC);
-static unsigned For_GetNumOfReadersOfThr (long ThrCod);
-static unsigned For_GetNumOfWritersInThr (long ThrCod);
-static unsigned For_GetNumPstsInThr (long ThrCod);
-static unsigned For_GetNumMyPstInThr (long ThrCod);
+static void For_UpdateNumPstsAndWritersInThr (long ThrCod);
+static void For_RebuildForumReadTimes (For_ForumType_t ForumType,long Location);
 static time_t For_GetThrReadTime (long ThrCod);
 static void For_ShowThreadPosts (long ThrCod,char *LastSubject);
 
@@ -303,11 +302,16 @@ static void For_WriteLinkToAForum (For_ForumType_t ForumType,bool ShowNumOfPosts
 static void For_WriteLinkToForum (For_ForumType_t ForumType,Act_Action_t NextAct,const char *Icon,const char *ForumName,bool ShowNumOfPosts,
                                   unsigned Level,bool IsLastItemInLevel[1+For_FORUM_MAX_LEVELS]);
 static unsigned For_GetNumOfThreadsInForumNewerThan (For_ForumType_t ForumType,const char *Time);
-static unsigned For_GetNumOfUnreadPostsInThr (long ThrCod,unsigned NumPostsInThr);
 static unsigned For_GetNumOfPostsInThrNewerThan (long ThrCod,const char *Time);
 
 static void For_WriteFormForumPst (bool IsReply,long ThrCod,const char *Subject);
 
+static long For_GetForumLocation (For_ForumType_t ForumType);
+static void For_GetForumCounters (For_ForumType_t ForumType,
+                                  unsigned *NumThrs,unsigned *NumPsts);
+static void For_UpdateForumCountersOfThr (long ThrCod,int DiffNumThrs,int DiffNumPsts);
+static void For_RemoveForumCounters (For_ForumType_t ForumType,long Location);
+
 static void For_UpdateNumUsrsNotifiedByEMailAboutPost (long PstCod,unsigned NumUsrsToBeNotifiedByEMail);
 static void For_WriteNumberOfThrs (unsigned NumThrs,unsigned NumThrsWithNewPosts);
 static void For_WriteNumThrsAndPsts (unsigned NumThrs,unsigned NumThrsWithNewPosts,unsigned NumPosts);
@@ -482,6 +486,14 @@ static long For_InsertForumPst (long ThrCod,long UsrCod,
    /***** Free space used for query *****/
    free ((void *) Query);
 
+   /***** Update number of posts and writers in thread and forum *****/
+   DB_Query ("START TRANSACTION","can not start transaction");
+   Gbl.DB.OpenTransaction = true;
+   For_UpdateNumPstsAndWritersInThr (ThrCod);
+   For_UpdateForumCountersOfThr (ThrCod,0,1);
+   DB_Query ("COMMIT","can not commit transaction");
+   Gbl.DB.OpenTransaction = false;
+
    return PstCod;
   }
 
@@ -514,10 +526,20 @@ static bool For_RemoveForumPst (long PstCod,struct Image *Image)
    /***** Delete the post from the table of disabled forum posts *****/
    For_DeletePstFromDisabledPstTable (PstCod);
 
-   /***** Update the last post of the thread *****/
    if (!ThreadDeleted)
+     {
+      /***** Update the last post of the thread *****/
       For_UpdateThrLastPst (ThrCod,For_GetLastPstCod (ThrCod));
 
+      /***** Update number of posts and writers in thread and forum *****/
+      DB_Query ("START TRANSACTION","can not start transaction");
+      Gbl.DB.OpenTransaction = true;
+      For_UpdateNumPstsAndWritersInThr (ThrCod);
+      For_UpdateForumCountersOfThr (ThrCod,0,-1);
+      DB_Query ("COMMIT","can not commit transaction");
+      Gbl.DB.OpenTransaction = false;
+     }
+
    return ThreadDeleted;
   }
 
@@ -558,6 +580,7 @@ static unsigned For_NumPstsInThrWithPstCod (long PstCod,long *ThrCod)
 static long For_InsertForumThread (For_ForumType_t ForumType,long FirstPstCod)
   {
    char Query[512];
+   long ThrCod;
 
    /***** Insert new thread in the database *****/
    switch (ForumType)
@@ -600,7 +623,16 @@ static long For_InsertForumThread (For_ForumType_t ForumType,long FirstPstCod)
                   (unsigned) ForumType,Gbl.Forum.Crs.CrsCod,FirstPstCod,FirstPstCod);
          break;
      }
-   return DB_QueryINSERTandReturnCode (Query,"can not create a new thread in a forum");
+   DB_Query ("START TRANSACTION","can not start transaction");
+   Gbl.DB.OpenTransaction = true;
+   ThrCod = DB_QueryINSERTandReturnCode (Query,"can not create a new thread in a forum");
+
+   /***** Increment number of threads in forum *****/
+   For_UpdateForumCountersOfThr (ThrCod,1,0);
+   DB_Query ("COMMIT","can not commit transaction");
+   Gbl.DB.OpenTransaction = false;
+
+   return ThrCod;
   }
 
 /*****************************************************************************/
@@ -610,6 +642,11 @@ static long For_InsertForumThread (For_ForumType_t ForumType,long FirstPstCod)
 static void For_RemoveThreadOnly (long ThrCod)
   {
    char Query[512];
+   For_ForumType_t ForumType;
+   long Location;
+
+   /***** Get the forum this thread belongs to *****/
+   For_GetForumOfThr (ThrCod,&ForumType,&Location);
 
    /***** Indicate that this thread has not been read by anyone *****/
    For_DeleteThrFromReadThrs (ThrCod);
@@ -621,6 +658,10 @@ static void For_RemoveThreadOnly (long ThrCod)
    sprintf (Query,"DELETE FROM forum_thread WHERE ThrCod='%ld'",
             ThrCod);
    DB_QueryDELETE (Query,"can not remove a thread from a forum");
+
+   /***** Counters and read times of the forum must be computed again *****/
+   For_RemoveForumCounters (ForumType,Location);
+   For_RebuildForumReadTimes (ForumType,Location);
   }
 
 /*****************************************************************************/
@@ -711,6 +752,41 @@ For_ForumType_t For_GetForumTypeOfAPost (long PstCod)
    return ForumType;
   }
 
+/*****************************************************************************/
+/***************** Get the forum type and location of a thread ***************/
+/*****************************************************************************/
+
+static void For_GetForumOfThr (long ThrCod,For_ForumType_t *ForumType,long *Location)
+  {
+   char Query[128];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned UnsignedNum;
+
+   /***** Get forum type and location of a thread from database *****/
+   sprintf (Query,"SELECT ForumType,Location FROM forum_thread"
+                  " WHERE ThrCod='%ld'",
+            ThrCod);
+   if (DB_QuerySELECT (Query,&mysql_res,"can not get the forum of a thread") != 1)
+      Lay_ShowErrorAndExit ("Error when getting the forum of a thread.");
+
+   row = mysql_fetch_row (mysql_res);
+
+   /* Get forum type (row[0]) */
+   if (sscanf (row[0],"%u",&UnsignedNum) != 1)
+      Lay_ShowErrorAndExit ("Wrong type of forum.");
+   if (UnsignedNum >= For_NUM_TYPES_FORUM)
+      Lay_ShowErrorAndExit ("Wrong type of forum.");
+   *ForumType = (For_ForumType_t) UnsignedNum;
+
+   /* Get location (row[1]) */
+   if (sscanf (row[1],"%ld",Location) != 1)
+      Lay_ShowErrorAndExit ("Wrong location of forum.");
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
 /*****************************************************************************/
 /********* Modify the codes of the first and last posts of a thread **********/
 /*****************************************************************************/
@@ -773,87 +849,49 @@ static long For_GetLastPstCod (long ThrCod)
 // (even if any previous pages have been no read actually)
 
 static void For_UpdateThrReadTime (long ThrCod,time_t ReadTimeUTC)
-  {
-   char Query[256];
-
-   /***** Insert or replace pair ThrCod-UsrCod in forum_thr_read *****/
-   sprintf (Query,"REPLACE INTO forum_thr_read (ThrCod,UsrCod,ReadTime)"
-                  " VALUES ('%ld','%ld',FROM_UNIXTIME('%ld'))",
-            ThrCod,Gbl.Usrs.Me.UsrDat.UsrCod,(long) ReadTimeUTC);
-   DB_QueryREPLACE (Query,"can not update the status of reading of a thread of a forum");
-  }
-
-/*****************************************************************************/
-/**************** Get number of users that have read a thread ****************/
-/*****************************************************************************/
-
-static unsigned For_GetNumOfReadersOfThr (long ThrCod)
-  {
-   char Query[512];
-
-   /***** Get number of distinct readers of a thread from database *****/
-   sprintf (Query,"SELECT COUNT(*) FROM forum_thr_read WHERE ThrCod='%ld'",
-            ThrCod);
-   return (unsigned) DB_QueryCOUNT (Query,"can not get the number of readers of a thread of a forum");
-  }
-
-/*****************************************************************************/
-/********** Get number of users that have write posts in a thread ************/
-/*****************************************************************************/
-
-static unsigned For_GetNumOfWritersInThr (long ThrCod)
   {
    char Query[512];
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row;
-   unsigned NumWriters;
 
-   /***** Get number of distinct writers in a thread from database *****/
-   sprintf (Query,"SELECT COUNT(DISTINCT UsrCod) FROM forum_post"
-                  " WHERE ThrCod='%ld'",ThrCod);
-   DB_QuerySELECT (Query,&mysql_res,"can not get the number of writers in a thread of a forum");
-
-   /* Get row with number of writers */
-   row = mysql_fetch_row (mysql_res);
-
-   /* Get number of writers (row[0]) */
-   if (sscanf (row[0],"%u",&NumWriters) != 1)
-      Lay_ShowErrorAndExit ("Error when getting the number of writers in a thread of a forum.");
-
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
+   /***** Insert or update pair ThrCod-UsrCod in forum_thr_read *****/
+   sprintf (Query,"INSERT INTO forum_thr_read (ThrCod,UsrCod,ReadTime)"
+                  " VALUES ('%ld','%ld',FROM_UNIXTIME('%ld'))"
+                  " ON DUPLICATE KEY UPDATE ReadTime=VALUES(ReadTime)",
+            ThrCod,Gbl.Usrs.Me.UsrDat.UsrCod,(long) ReadTimeUTC);
+   if (DB_QueryINSERTandReturnNumRows (Query,"can not update the status of reading of a thread of a forum") == 1)
+     {
+      /***** It's the first time I read this thread ==> one more reader *****/
+      sprintf (Query,"UPDATE forum_thread SET NumReaders=NumReaders+1"
+                     " WHERE ThrCod='%ld'",
+               ThrCod);
+      DB_QueryUPDATE (Query,"can not update the number of readers of a thread of a forum");
+     }
 
-   return NumWriters;
+   /***** Update the last time I read any thread in this forum *****/
+   sprintf (Query,"INSERT INTO forum_read (UsrCod,ForumType,Location,ReadTime)"
+                  " SELECT '%ld',ForumType,Location,FROM_UNIXTIME('%ld')"
+                  " FROM forum_thread WHERE ThrCod='%ld'"
+                  " ON DUPLICATE KEY UPDATE ReadTime=GREATEST(ReadTime,VALUES(ReadTime))",
+            Gbl.Usrs.Me.UsrDat.UsrCod,(long) ReadTimeUTC,ThrCod);
+   DB_QueryINSERT (Query,"can not update the date of reading of a forum");
   }
 
 /*****************************************************************************/
-/********************** Get number of posts in a thread **********************/
+/********* Update number of posts and number of writers in a thread **********/
 /*****************************************************************************/
 
-static unsigned For_GetNumPstsInThr (long ThrCod)
+static void For_UpdateNumPstsAndWritersInThr (long ThrCod)
   {
    char Query[512];
 
-   /***** Get number of posts in a thread from database *****/
-   sprintf (Query,"SELECT COUNT(*) FROM forum_post"
-	          " WHERE ThrCod='%ld'",
-            ThrCod);
-   return (unsigned) DB_QueryCOUNT (Query,"can not get the number of posts in a thread of a forum");
-  }
-
-/*****************************************************************************/
-/************** Get whether there are posts of mine in a thread **************/
-/*****************************************************************************/
-
-static unsigned For_GetNumMyPstInThr (long ThrCod)
-  {
-   char Query[128];
-
-   /***** Get if I have write posts in a thread from database *****/
-   sprintf (Query,"SELECT COUNT(*) FROM forum_post"
-                  " WHERE ThrCod='%ld' AND UsrCod='%ld'",
-            ThrCod,Gbl.Usrs.Me.UsrDat.UsrCod);
-   return (unsigned) DB_QueryCOUNT (Query,"can not check if you have written post in a thead of a forum");
+   /***** Count again posts and distinct writers in a thread *****/
+   sprintf (Query,"UPDATE forum_thread SET"
+                  " NumPsts=(SELECT COUNT(*) FROM forum_post"
+                  " WHERE ThrCod='%ld'),"
+                  "NumWriters=(SELECT COUNT(DISTINCT UsrCod) FROM forum_post"
+                  " WHERE ThrCod='%ld')"
+                  " WHERE ThrCod='%ld'",
+            ThrCod,ThrCod,ThrCod);
+   DB_QueryUPDATE (Query,"can not update the number of posts in a thread of a forum");
   }
 
 /*****************************************************************************/
@@ -922,12 +960,53 @@ void For_DeleteThrFromReadThrs (long ThrCod)
 
 void For_RemoveUsrFromReadThrs (long UsrCod)
   {
-   char Query[128];
+   char Query[512];
+
+   /***** This user is no longer a reader of the threads he/she read *****/
+   sprintf (Query,"UPDATE forum_thread,forum_thr_read"
+                  " SET forum_thread.NumReaders=forum_thread.NumReaders-1"
+                  " WHERE forum_thr_read.UsrCod='%ld'"
+                  " AND forum_thr_read.ThrCod=forum_thread.ThrCod",
+            UsrCod);
+   DB_QueryUPDATE (Query,"can not update the number of readers of threads of a forum");
 
    /***** Delete pairs ThrCod-UsrCod in forum_thr_read for a user *****/
    sprintf (Query,"DELETE FROM forum_thr_read WHERE UsrCod='%ld'",
             UsrCod);
    DB_QueryDELETE (Query,"can not remove the status of reading by a user of all the threads of a forum");
+
+   /***** Delete the last times this user read each forum *****/
+   sprintf (Query,"DELETE FROM forum_read WHERE UsrCod='%ld'",
+            UsrCod);
+   DB_QueryDELETE (Query,"can not remove the dates of reading of forums by a user");
+  }
+
+/*****************************************************************************/
+/******* Rebuild the last time each user read any thread in a forum **********/
+/*****************************************************************************/
+// Called when threads are removed from or moved to a forum
+
+static void For_RebuildForumReadTimes (For_ForumType_t ForumType,long Location)
+  {
+   char Query[1024];
+
+   /***** Remove the old read times of this forum *****/
+   sprintf (Query,"DELETE FROM forum_read"
+                  " WHERE ForumType='%u' AND Location='%ld'",
+            (unsigned) ForumType,Location);
+   DB_QueryDELETE (Query,"can not remove the dates of reading of a forum");
+
+   /***** Get the newest read time of each user from the threads of this forum *****/
+   sprintf (Query,"INSERT INTO forum_read (UsrCod,ForumType,Location,ReadTime)"
+                  " SELECT forum_thr_read.UsrCod,'%u','%ld',MAX(forum_thr_read.ReadTime)"
+                  " FROM forum_thread,forum_thr_read"
+                  " WHERE forum_thread.ForumType='%u'"
+                  " AND forum_thread.Location='%ld'"
+                  " AND forum_thread.ThrCod=forum_thr_read.ThrCod"
+                  " GROUP BY forum_thr_read.UsrCod",
+            (unsigned) ForumType,Location,
+            (unsigned) ForumType,Location);
+   DB_QueryINSERT (Query,"can not update the dates of reading of a forum");
   }
 
 /*****************************************************************************/
@@ -2332,46 +2411,17 @@ static void For_WriteLinkToForum (For_ForumType_t ForumType,Act_Action_t NextAct
 
 unsigned For_GetNumThrsWithNewPstsInForum (For_ForumType_t ForumType,unsigned NumThreads)
   {
-   char SubQuery[256];
-   char Query[2048];
+   char Query[512];
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
    unsigned long NumRows;
    unsigned NumThrsWithNewPosts = NumThreads;	// By default, all the threads are new to me
 
    /***** Get last time I read this forum from database *****/
-   switch (ForumType)
-     {
-      case For_FORUM_INSTIT_USRS:
-      case For_FORUM_INSTIT_TCHS:
-         sprintf (SubQuery," AND forum_thread.Location='%ld'",
-                  Gbl.Forum.Ins.InsCod);
-         break;
-      case For_FORUM_CENTRE_USRS:
-      case For_FORUM_CENTRE_TCHS:
-         sprintf (SubQuery," AND forum_thread.Location='%ld'",
-                  Gbl.Forum.Ctr.CtrCod);
-         break;
-      case For_FORUM_DEGREE_USRS:
-      case For_FORUM_DEGREE_TCHS:
-         sprintf (SubQuery," AND forum_thread.Location='%ld'",
-                  Gbl.Forum.Deg.DegCod);
-         break;
-      case For_FORUM_COURSE_USRS:
-      case For_FORUM_COURSE_TCHS:
-         sprintf (SubQuery," AND forum_thread.Location='%ld'",
-                  Gbl.Forum.Crs.CrsCod);
-         break;
-      default:
-         SubQuery[0] = '\0';
-         break;
-     }
-   sprintf (Query,"SELECT MAX(forum_thr_read.ReadTime)"
-	          " FROM forum_thr_read,forum_thread"
-                  " WHERE forum_thr_read.UsrCod='%ld'"
-                  " AND forum_thr_read.ThrCod=forum_thread.ThrCod"
-                  " AND forum_thread.ForumType='%u'%s",
-                  Gbl.Usrs.Me.UsrDat.UsrCod,(unsigned) ForumType,SubQuery);
+   sprintf (Query,"SELECT ReadTime FROM forum_read"
+                  " WHERE UsrCod='%ld' AND ForumType='%u' AND Location='%ld'",
+            Gbl.Usrs.Me.UsrDat.UsrCod,
+            (unsigned) ForumType,For_GetForumLocation (ForumType));
    NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get the date of reading of a forum");
 
    if (NumRows)
@@ -2432,38 +2482,6 @@ static unsigned For_GetNumOfThreadsInForumNewerThan (For_ForumType_t ForumType,c
    return (unsigned) DB_QueryCOUNT (Query,"can not check if there are new posts in a forum");
   }
 
-/*****************************************************************************/
-/** Get number of unread posts in a thread since my last read of that thread */
-/*****************************************************************************/
-
-static unsigned For_GetNumOfUnreadPostsInThr (long ThrCod,unsigned NumPostsInThr)
-  {
-   char Query[2048];
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row;
-   unsigned long NumRows;
-   unsigned NumUnreadPosts = NumPostsInThr;	// By default, all the posts are unread by me
-
-   /***** Get last time I read this thread from database *****/
-   sprintf (Query,"SELECT ReadTime FROM forum_thr_read"
-                  " WHERE ThrCod='%ld' AND UsrCod='%ld'",
-            ThrCod,Gbl.Usrs.Me.UsrDat.UsrCod);
-   NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get the date of reading of a thread");
-
-   /***** Get if last time I read this thread exists in database *****/
-   if (NumRows)
-     {
-      /***** Get the number of posts in thread with a modify time > newest read time for me (row[0]) *****/
-      row = mysql_fetch_row (mysql_res);
-      NumUnreadPosts = For_GetNumOfPostsInThrNewerThan (ThrCod,row[0]);
-     }
-
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
-
-   return NumUnreadPosts;
-  }
-
 /*****************************************************************************/
 /**** Get number of posts in thread with a modify time > a specified time ****/
 /*****************************************************************************/
@@ -3070,31 +3088,12 @@ unsigned For_GetNumTotalThrsInForumsOfType (For_ForumType_t ForumType,
 
 unsigned For_GetNumThrsInForum (For_ForumType_t ForumType)
   {
-   char SubQuery[256];
-   char Query[1024];
+   unsigned NumThrs;
+   unsigned NumPsts;
 
-   /***** Get number of threads in a forum from database *****/
-   switch (ForumType)
-     {
-      case For_FORUM_INSTIT_USRS:	case For_FORUM_INSTIT_TCHS:
-         sprintf (SubQuery," AND Location='%ld'",Gbl.Forum.Ins.InsCod);
-         break;
-      case For_FORUM_CENTRE_USRS:	case For_FORUM_CENTRE_TCHS:
-         sprintf (SubQuery," AND Location='%ld'",Gbl.Forum.Ctr.CtrCod);
-         break;
-      case For_FORUM_DEGREE_USRS:	case For_FORUM_DEGREE_TCHS:
-         sprintf (SubQuery," AND Location='%ld'",Gbl.Forum.Deg.DegCod);
-         break;
-      case For_FORUM_COURSE_USRS:	case For_FORUM_COURSE_TCHS:
-         sprintf (SubQuery," AND Location='%ld'",Gbl.Forum.Crs.CrsCod);
-         break;
-      default:
-         SubQuery[0] = '\0';
-         break;
-     }
-   sprintf (Query,"SELECT COUNT(*) FROM forum_thread WHERE ForumType='%u'%s",
-            (unsigned) ForumType,SubQuery);
-   return (unsigned) DB_QueryCOUNT (Query,"can not get number of threads in a forum");
+   /***** Get number of threads in a forum from its counters *****/
+   For_GetForumCounters (ForumType,&NumThrs,&NumPsts);
+   return NumThrs;
   }
 
 /*****************************************************************************/
@@ -3303,32 +3302,121 @@ unsigned For_GetNumTotalPstsInForumsOfType (For_ForumType_t ForumType,
 
 unsigned For_GetNumPstsInForum (For_ForumType_t ForumType)
   {
-   char SubQuery[256];
-   char Query[1024];
+   unsigned NumThrs;
+   unsigned NumPsts;
+
+   /***** Get number of posts in a forum from its counters *****/
+   For_GetForumCounters (ForumType,&NumThrs,&NumPsts);
+   return NumPsts;
+  }
 
-   /***** Get number of posts in a forum from database *****/
+/*****************************************************************************/
+/******************** Get the location of a forum of a type ******************/
+/*****************************************************************************/
+
+static long For_GetForumLocation (For_ForumType_t ForumType)
+  {
    switch (ForumType)
      {
       case For_FORUM_INSTIT_USRS:	case For_FORUM_INSTIT_TCHS:
-         sprintf (SubQuery," AND forum_thread.Location='%ld'",Gbl.Forum.Ins.InsCod);
-         break;
+         return Gbl.Forum.Ins.InsCod;
       case For_FORUM_CENTRE_USRS:	case For_FORUM_CENTRE_TCHS:
-         sprintf (SubQuery," AND forum_thread.Location='%ld'",Gbl.Forum.Ins.InsCod);
-         break;
+         return Gbl.Forum.Ctr.CtrCod;
       case For_FORUM_DEGREE_USRS:	case For_FORUM_DEGREE_TCHS:
-         sprintf (SubQuery," AND forum_thread.Location='%ld'",Gbl.Forum.Deg.DegCod);
-         break;
+         return Gbl.Forum.Deg.DegCod;
       case For_FORUM_COURSE_USRS:	case For_FORUM_COURSE_TCHS:
-         sprintf (SubQuery," AND forum_thread.Location='%ld'",Gbl.Forum.Crs.CrsCod);
-         break;
+         return Gbl.Forum.Crs.CrsCod;
       default:
-         SubQuery[0] = '\0';
-         break;
+         return -1L;
+     }
+  }
+
+/*****************************************************************************/
+/************** Get number of threads and posts in a forum *******************/
+/*****************************************************************************/
+// If the counters of the forum are not stored, compute and store them.
+// The counters are computed and stored by a single INSERT ... SELECT,
+// which locks the threads of the forum while counting them,
+// and changes in threads are committed together with changes in counters,
+// so a concurrent new thread or post is never counted twice or lost
+
+static void For_GetForumCounters (For_ForumType_t ForumType,
+                                  unsigned *NumThrs,unsigned *NumPsts)
+  {
+   char Query[512];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   long Location = For_GetForumLocation (ForumType);
+
+   /***** Get counters of a forum from database *****/
+   sprintf (Query,"SELECT NumThrs,NumPsts FROM forum_counters"
+                  " WHERE ForumType='%u' AND Location='%ld'",
+            (unsigned) ForumType,Location);
+   if (!DB_QuerySELECT (Query,&mysql_res,"can not get the number of threads and posts in a forum"))
+     {
+      DB_FreeMySQLResult (&mysql_res);
+
+      /***** Count threads and posts of the forum and store them *****/
+      sprintf (Query,"INSERT IGNORE INTO forum_counters"
+                     " (ForumType,Location,NumThrs,NumPsts)"
+                     " SELECT '%u','%ld',COUNT(*),COALESCE(SUM(NumPsts),0)"
+                     " FROM forum_thread"
+                     " WHERE ForumType='%u' AND Location='%ld'",
+               (unsigned) ForumType,Location,
+               (unsigned) ForumType,Location);
+      DB_QueryINSERT (Query,"can not store the number of threads and posts in a forum");
+
+      /***** Get counters of a forum from database again *****/
+      sprintf (Query,"SELECT NumThrs,NumPsts FROM forum_counters"
+                     " WHERE ForumType='%u' AND Location='%ld'",
+               (unsigned) ForumType,Location);
+      if (!DB_QuerySELECT (Query,&mysql_res,"can not get the number of threads and posts in a forum"))
+         Lay_ShowErrorAndExit ("Error when getting the number of threads and posts in a forum.");
      }
-   sprintf (Query,"SELECT COUNT(*) FROM forum_thread,forum_post "
-                  " WHERE forum_thread.ForumType='%u'%s AND forum_thread.ThrCod=forum_post.ThrCod",
-            (unsigned) ForumType,SubQuery);
-   return (unsigned) DB_QueryCOUNT (Query,"can not get the number of posts in a forum");
+
+   row = mysql_fetch_row (mysql_res);
+   if (sscanf (row[0],"%u",NumThrs) != 1)
+      Lay_ShowErrorAndExit ("Error when getting the number of threads in a forum.");
+   if (sscanf (row[1],"%u",NumPsts) != 1)
+      Lay_ShowErrorAndExit ("Error when getting the number of posts in a forum.");
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/*********** Update the counters of the forum a thread belongs to ************/
+/*****************************************************************************/
+// If the counters of the forum are not stored, nothing is updated.
+// Must be called inside the same transaction that changed the thread
+
+static void For_UpdateForumCountersOfThr (long ThrCod,int DiffNumThrs,int DiffNumPsts)
+  {
+   char Query[1024];
+
+   /***** Add differences to the counters of the forum of a thread *****/
+   sprintf (Query,"UPDATE forum_counters,forum_thread"
+                  " SET forum_counters.NumThrs=forum_counters.NumThrs+(%d),"
+                  "forum_counters.NumPsts=forum_counters.NumPsts+(%d)"
+                  " WHERE forum_thread.ThrCod='%ld'"
+                  " AND forum_thread.ForumType=forum_counters.ForumType"
+                  " AND forum_thread.Location=forum_counters.Location",
+            DiffNumThrs,DiffNumPsts,ThrCod);
+   DB_QueryUPDATE (Query,"can not update the number of threads and posts in a forum");
+  }
+
+/*****************************************************************************/
+/*********************** Remove the counters of a forum **********************/
+/*****************************************************************************/
+// They will be computed again the next time they are needed
+
+static void For_RemoveForumCounters (For_ForumType_t ForumType,long Location)
+  {
+   char Query[256];
+
+   /***** Remove counters of a forum *****/
+   sprintf (Query,"DELETE FROM forum_counters"
+                  " WHERE ForumType='%u' AND Location='%ld'",
+            (unsigned) ForumType,Location);
+   DB_QueryDELETE (Query,"can not remove the number of threads and posts in a forum");
   }
 
 /*****************************************************************************/
@@ -3539,16 +3627,32 @@ void For_GetThrData (struct ForumThread *Thr)
    MYSQL_ROW row;
    unsigned long NumRows;
    For_ForumOrderType_t Order;
+   char ReadTime[4+1+2+1+2+1+2+1+2+1+2+1];	// YYYY-MM-DD HH:MM:SS
 
    /***** Get data of a thread from database *****/
    sprintf (Query,"SELECT m0.PstCod,m1.PstCod,m0.UsrCod,m1.UsrCod,"
                   "UNIX_TIMESTAMP(m0.CreatTime),"
                   "UNIX_TIMESTAMP(m1.CreatTime),"
-                  "m0.Subject"
+                  "m0.Subject,"
+                  "(SELECT COUNT(*) FROM forum_disabled_post"
+                  " WHERE forum_disabled_post.PstCod=m0.PstCod),"
+                  "(SELECT COUNT(*) FROM forum_disabled_post"
+                  " WHERE forum_disabled_post.PstCod=m1.PstCod),"
+                  "forum_thread.NumPsts,"
+                  "forum_thread.NumWriters,"
+                  "forum_thread.NumReaders,"
+                  "(SELECT COUNT(*) FROM forum_post"
+                  " WHERE forum_post.ThrCod=forum_thread.ThrCod"
+                  " AND forum_post.UsrCod='%ld'),"
+                  "(SELECT ReadTime FROM forum_thr_read"
+                  " WHERE forum_thr_read.ThrCod=forum_thread.ThrCod"
+                  " AND forum_thr_read.UsrCod='%ld')"
                   " FROM forum_thread,forum_post AS m0,forum_post AS m1"
                   " WHERE forum_thread.ThrCod='%ld'"
                   " AND forum_thread.FirstPstCod=m0.PstCod"
                   " AND forum_thread.LastPstCod=m1.PstCod",
+            Gbl.Usrs.Me.UsrDat.UsrCod,
+            Gbl.Usrs.Me.UsrDat.UsrCod,
             Thr->ThrCod);
    NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get data of a thread of a forum");
 
@@ -3583,29 +3687,43 @@ void For_GetThrData (struct ForumThread *Thr)
    if (!Thr->Subject[0])
       sprintf (Thr->Subject,"[%s]",Txt_no_subject);
 
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
-
-   /***** Get if first or last message are enabled *****/
+   /***** Get if first or last message are enabled (row[7], row[8]) *****/
+   // A post is enabled if it does not appear in table of disabled posts
    for (Order = For_FIRST_MSG;
 	Order <= For_LAST_MSG;
 	Order++)
-      Thr->Enabled[Order] = For_GetIfPstIsEnabled (Thr->PstCod[Order]);
+      Thr->Enabled[Order] = !strcmp (row[7 + Order],"0");
 
-   /***** Get number of posts in this thread *****/
-   Thr->NumPosts = For_GetNumPstsInThr (Thr->ThrCod);
+   /***** Get number of posts in this thread (row[9]) *****/
+   if (sscanf (row[9],"%u",&(Thr->NumPosts)) != 1)
+      Lay_ShowErrorAndExit ("Error when getting the number of posts in a thread of a forum.");
 
-   /***** Get number of unread (by me) posts in this thread *****/
-   Thr->NumUnreadPosts = For_GetNumOfUnreadPostsInThr (Thr->ThrCod,Thr->NumPosts);
+   /***** Get number of users who have write posts in this thread (row[10]) *****/
+   if (sscanf (row[10],"%u",&(Thr->NumWriters)) != 1)
+      Lay_ShowErrorAndExit ("Error when getting the number of writers in a thread of a forum.");
 
-   /***** Get number of posts that I have written in this thread *****/
-   Thr->NumMyPosts = For_GetNumMyPstInThr (Thr->ThrCod);
+   /***** Get number of users who have read this thread (row[11]) *****/
+   if (sscanf (row[11],"%u",&(Thr->NumReaders)) != 1)
+      Lay_ShowErrorAndExit ("Error when getting the number of readers of a thread of a forum.");
 
-   /***** Get number of users who have write posts in this thread *****/
-   Thr->NumWriters = For_GetNumOfWritersInThr (Thr->ThrCod);
+   /***** Get number of posts that I have written in this thread (row[12]) *****/
+   if (sscanf (row[12],"%u",&(Thr->NumMyPosts)) != 1)
+      Lay_ShowErrorAndExit ("Error when getting the number of my posts in a thread of a forum.");
 
-   /***** Get number of users who have read this thread *****/
-   Thr->NumReaders = For_GetNumOfReadersOfThr (Thr->ThrCod);
+   /***** Get last time I read this thread (row[13]) *****/
+   ReadTime[0] = '\0';
+   if (row[13])	// NULL if I have never read this thread
+     {
+      strncpy (ReadTime,row[13],sizeof (ReadTime) - 1);
+      ReadTime[sizeof (ReadTime) - 1] = '\0';
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Get number of unread (by me) posts in this thread *****/
+   Thr->NumUnreadPosts = ReadTime[0] ? For_GetNumOfPostsInThrNewerThan (Thr->ThrCod,ReadTime) :
+	                               Thr->NumPosts;	// By default, all the posts are unread by me
   }
 
 /*****************************************************************************/
@@ -4340,6 +4458,11 @@ bool For_CheckIfThrBelongsToForum (long ThrCod,For_ForumType_t ForumType)
 void For_MoveThrToCurrentForum (long ThrCod)
   {
    char Query[512];
+   For_ForumType_t OldForumType;
+   long OldLocation;
+
+   /***** Get the forum this thread belongs to before moving it *****/
+   For_GetForumOfThr (ThrCod,&OldForumType,&OldLocation);
 
    /***** Move a thread to current forum *****/
    switch (Gbl.Forum.ForumType)
@@ -4367,6 +4490,12 @@ void For_MoveThrToCurrentForum (long ThrCod)
          break;
      }
    DB_QueryUPDATE (Query,"can not move a thread to current forum");
+
+   /***** Counters and read times of both forums must be computed again *****/
+   For_RemoveForumCounters (OldForumType,OldLocation);
+   For_RebuildForumReadTimes (OldForumType,OldLocation);
+   For_RemoveForumCounters (Gbl.Forum.ForumType,For_GetForumLocation (Gbl.Forum.ForumType));
+   For_RebuildForumReadTimes (Gbl.Forum.ForumType,For_GetForumLocation (Gbl.Forum.ForumType));
   }
 
 /*****************************************************************************/
@@ -4504,4 +4633,22 @@ void For_RemoveForums (Sco_Scope_t Scope,long Cod)
             ForumType[Scope].Tchs,
             Cod);
    DB_QueryDELETE (Query,"can not remove threads in forums");
+
+   /***** Remove counters of forums *****/
+   sprintf (Query,"DELETE FROM forum_counters"
+                  " WHERE (ForumType='%u' OR ForumType='%u')"
+                  " AND Location='%ld'",
+            ForumType[Scope].Usrs,
+            ForumType[Scope].Tchs,
+            Cod);
+   DB_QueryDELETE (Query,"can not remove the number of threads and posts in forums");
+
+   /***** Remove read times of forums *****/
+   sprintf (Query,"DELETE FROM forum_read"
+                  " WHERE (ForumType='%u' OR ForumType='%u')"
+                  " AND Location='%ld'",
+            ForumType[Scope].Usrs,
+            ForumType[Scope].Tchs,
+            Cod);
+   DB_QueryDELETE (Query,"can not remove the dates of reading of forums");
   }
@@ -80,7 +80,6 @@ void Gbl_InitializeGlobals (void)
   {
    extern const char *The_ThemeId[The_NUM_THEMES];
    extern const char *Ico_IconSetId[Ico_NUM_ICON_SETS];
-   extern const unsigned Txt_Current_CGI_SWAD_Language;
    Rol_Role_t Role;
    Txt_Language_t Lan;
 
@@ -125,10 +124,12 @@ void Gbl_InitializeGlobals (void)
 
    Gbl.DB.DatabaseIsOpen = false;
    Gbl.DB.LockedTables = false;
+   Gbl.DB.OpenTransaction = false;
 
    Gbl.HiddenParamsInsertedIntoDB = false;
 
-   Gbl.Prefs.Language = Txt_Current_CGI_SWAD_Language;
+   Gbl.Prefs.Language = Pre_GetLanguageFromCGIName ();
+   Pre_SetLanguageOfTexts (Gbl.Prefs.Language);
    Gbl.Prefs.FirstDayOfWeek = Cal_FIRST_DAY_OF_WEEK_DEFAULT;	// Default first day of week
    Gbl.Prefs.Menu = Mnu_MENU_DEFAULT;		// Default menu
    Gbl.Prefs.Theme = The_THEME_DEFAULT;		// Default theme
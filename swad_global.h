@@ -130,6 +130,7 @@ struct Globals
      {
       bool DatabaseIsOpen;
       bool LockedTables;
+      bool OpenTransaction;
      } DB;
 
    bool HiddenParamsInsertedIntoDB;	// If parameters are inserted in the database in this execution
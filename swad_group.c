@@ -36,6 +36,7 @@
 #include "swad_group.h"
 #include "swad_notification.h"
 #include "swad_parameter.h"
+#include "swad_timetable.h"
 
 /*****************************************************************************/
 /*************************** Internal constants ******************************/
@@ -1054,6 +1055,9 @@ void Grp_RemUsrFromAllGrpsInCrs (struct UsrData *UsrDat,struct Course *Crs,Cns_Q
             UsrDat->UsrCod,Crs->CrsCod);
    DB_QueryDELETE (Query,"can not remove a user from all groups of a course");
 
+   /***** Invalidate cached timetables of the course and the user *****/
+   TT_InvalidateCachedTimeTables (Crs->CrsCod,UsrDat->UsrCod);
+
    /***** Write message to show the change made *****/
    if (QuietOrVerbose == Cns_VERBOSE)
      {
@@ -1077,6 +1081,9 @@ void Grp_RemUsrFromAllGrps (struct UsrData *UsrDat,Cns_QuietOrVerbose_t QuietOrV
             UsrDat->UsrCod);
    DB_QueryDELETE (Query,"can not remove a user from the groups he/she belongs to");
 
+   /***** Invalidate cached timetables of all courses and the user *****/
+   TT_InvalidateCachedTimeTables (-1L,UsrDat->UsrCod);
+
    /***** Write message to show the change made *****/
    if (QuietOrVerbose == Cns_VERBOSE)
      {
@@ -1099,6 +1106,9 @@ static void Grp_RemoveUsrFromGroup (long UsrCod,long GrpCod)
                   " WHERE GrpCod='%ld' AND UsrCod='%ld'",
             GrpCod,UsrCod);
    DB_QueryDELETE (Query,"can not remove a user from a group");
+
+   /***** Invalidate cached timetables of the course and the user *****/
+   TT_InvalidateCachedTimeTables (Gbl.CurrentCrs.Crs.CrsCod,UsrCod);
   }
 
 /*****************************************************************************/
@@ -1114,6 +1124,9 @@ static void Grp_AddUsrToGroup (struct UsrData *UsrDat,long GrpCod)
                   " VALUES ('%ld','%ld')",
             GrpCod,UsrDat->UsrCod);
    DB_QueryINSERT (Query,"can not add a user to a group");
+
+   /***** Invalidate cached timetables of the course and the user *****/
+   TT_InvalidateCachedTimeTables (Gbl.CurrentCrs.Crs.CrsCod,UsrDat->UsrCod);
   }
 
 /*****************************************************************************/
@@ -3425,6 +3438,9 @@ static void Grp_RemoveGroupTypeCompletely (void)
             Gbl.CurrentCrs.Grps.GrpTyp.GrpTypCod);
    DB_QueryDELETE (Query,"can not remove a type of group");
 
+   /***** Invalidate cached timetables of the course and all its users *****/
+   TT_InvalidateCachedTimeTables (Gbl.CurrentCrs.Crs.CrsCod,-1L);
+
    /***** Write message to show the change made *****/
    sprintf (Gbl.Message,Txt_Type_of_group_X_removed,
             Gbl.CurrentCrs.Grps.GrpTyp.GrpTypName);
@@ -3475,6 +3491,9 @@ static void Grp_RemoveGroupCompletely (void)
             Gbl.CurrentCrs.Grps.GrpCod);
    DB_QueryDELETE (Query,"can not remove a group");
 
+   /***** Invalidate cached timetables of the course and all its users *****/
+   TT_InvalidateCachedTimeTables (Gbl.CurrentCrs.Crs.CrsCod,-1L);
+
    /***** Write message to show the change made *****/
    sprintf (Gbl.Message,Txt_Group_X_removed,
             GrpDat.GrpName);
@@ -3654,6 +3673,9 @@ void Grp_ChangeGroupType (void)
                NewGrpTypCod,Gbl.CurrentCrs.Grps.GrpCod);
       DB_QueryUPDATE (Query,"can not update the type of a group");
 
+      /* Invalidate cached timetables of the course and all its users */
+      TT_InvalidateCachedTimeTables (Gbl.CurrentCrs.Crs.CrsCod,-1L);
+
       /***** Write message to show the change made *****/
       sprintf (Gbl.Message,Txt_The_type_of_group_of_the_group_X_has_changed,
                GrpDat.GrpName);
@@ -3950,6 +3972,9 @@ void Grp_RenameGroupType (void)
                      Gbl.CurrentCrs.Grps.GrpTyp.GrpTypCod);
             DB_QueryUPDATE (Query,"can not update the type of a group");
 
+            /* Invalidate cached timetables of the course and all its users */
+            TT_InvalidateCachedTimeTables (Gbl.CurrentCrs.Crs.CrsCod,-1L);
+
             /***** Write message to show the change made *****/
             sprintf (Gbl.Message,Txt_The_type_of_group_X_has_been_renamed_as_Y,
                      Gbl.CurrentCrs.Grps.GrpTyp.GrpTypName,NewNameGrpTyp);
@@ -4021,6 +4046,9 @@ void Grp_RenameGroup (void)
                      NewNameGrp,Gbl.CurrentCrs.Grps.GrpCod);
             DB_QueryUPDATE (Query,"can not update the name of a group");
 
+            /* Invalidate cached timetables of the course and all its users */
+            TT_InvalidateCachedTimeTables (Gbl.CurrentCrs.Crs.CrsCod,-1L);
+
             /***** Write message to show the change made *****/
             sprintf (Gbl.Message,Txt_The_group_X_has_been_renamed_as_Y,
                      GrpDat.GrpName,NewNameGrp);
@@ -28,12 +28,15 @@
 #include <limits.h>		// For maximum values
 #include <linux/limits.h>	// For PATH_MAX, NAME_MAX
 #include <linux/stddef.h>	// For NULL
+#include <stdio.h>		// For rename
 #include <stdlib.h>		// For getenv, etc
 #include <stdsoap2.h>		// For SOAP_OK and soap functions
 #include <string.h>		// For string functions
+#include <sys/wait.h>		// For the macros WIFEXITED and WEXITSTATUS
 #include <unistd.h>		// For unlink
 
 #include "swad_action.h"
+#include "swad_cryptography.h"
 #include "swad_database.h"
 #include "swad_global.h"
 #include "swad_info.h"
@@ -311,6 +314,14 @@ static bool Inf_CheckAndShowPlainTxt (void);
 
 static bool Inf_CheckRichTxt (long CrsCod,Inf_InfoType_t InfoType);
 static bool Inf_CheckAndShowRichTxt (void);
+static void Inf_BuildPathRichTxtHTML (long CrsCod,Inf_InfoType_t InfoType,char *PathFile);
+static void Inf_BuildHeadRichTxtHTML (const char *TxtMD,
+                                      char HeadHTML[4+Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+5+1]);
+static bool Inf_WriteRichTxtHTMLFromCache (long CrsCod,Inf_InfoType_t InfoType,
+                                           const char *TxtMD);
+static bool Inf_ConvertRichTxtToHTML (long CrsCod,Inf_InfoType_t InfoType,
+                                      const char *TxtMD);
+static void Inf_RemoveEscapesFromMarkdown (const char *TxtMDEscaped,char *TxtMD);
 
 /*****************************************************************************/
 /******** Show course info (theory, practices, bibliography, etc.) ***********/
@@ -1786,13 +1797,6 @@ static bool Inf_CheckAndShowRichTxt (void)
    extern const char *Txt_INFO_TITLE[Inf_NUM_INFO_TYPES];
    char TxtHTML[Cns_MAX_BYTES_LONG_TEXT+1];
    char TxtMD[Cns_MAX_BYTES_LONG_TEXT+1];
-   char PathFileMD[PATH_MAX+1];
-   char PathFileHTML[PATH_MAX+1];
-   FILE *FileMD;		// Temporary Markdown file
-   FILE *FileHTML;		// Temporary HTML file
-   char MathJaxURL[PATH_MAX];
-   char Command[512+PATH_MAX*3]; // Command to call the program of preprocessing of photos
-   int ReturnCode;
    bool ICanEdit = (Gbl.Usrs.Me.LoggedRole == Rol_TEACHER ||
                     Gbl.Usrs.Me.LoggedRole == Rol_SYS_ADM);
 
@@ -1813,71 +1817,208 @@ static bool Inf_CheckAndShowRichTxt (void)
 
       fprintf (Gbl.F.Out,"<div id=\"crs_info\" class=\"LEFT_MIDDLE\">");
 
-      /***** Store text into a temporary .md file in HTML output directory *****/
-      // TODO: change to another directory?
-      /* Create a unique name for the .md file */
-      sprintf (PathFileMD,"%s/%s/%s.md",
-	       Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_OUT,Gbl.UniqueNameEncrypted);
-      sprintf (PathFileHTML,"%s/%s/%s.md.html",	// Do not use only .html because that is the output temporary file
-	       Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_OUT,Gbl.UniqueNameEncrypted);
+      /***** Write HTML already converted from Markdown *****/
+      // Conversion is usually made when the text is saved.
+      // It is made here only if the HTML is missing or outdated
+      if (!Inf_WriteRichTxtHTMLFromCache (Gbl.CurrentCrs.Crs.CrsCod,Gbl.CurrentCrs.Info.Type,TxtMD))
+	{
+	 if (!Inf_ConvertRichTxtToHTML (Gbl.CurrentCrs.Crs.CrsCod,Gbl.CurrentCrs.Info.Type,TxtMD))
+	    Lay_ShowAlert (Lay_WARNING,"Error when converting from Markdown to HTML.");
+	 else if (!Inf_WriteRichTxtHTMLFromCache (Gbl.CurrentCrs.Crs.CrsCod,Gbl.CurrentCrs.Info.Type,TxtMD))
+	    Lay_ShowAlert (Lay_WARNING,"Can not open HTML file with course info.");
+	}
 
-      /* Open Markdown file for writing */
-      if ((FileMD = fopen (PathFileMD,"wb")) == NULL)
-	 Lay_ShowErrorAndExit ("Can not create temporary Markdown file.");
+      /***** End frame *****/
+      fprintf (Gbl.F.Out,"</div>");
+      Lay_EndRoundFrame ();
 
-      /* Write text into Markdown file */
-      fprintf (FileMD,"%s",TxtMD);
+      return true;
+     }
 
-      /* Close Markdown file */
-      fclose (FileMD);
+   return false;
+  }
 
-      /***** Convert from Markdown to HTML *****/
-#ifdef Cfg_MATHJAX_LOCAL
-      // Use the local copy of MathJax
-      sprintf (MathJaxURL,"=%s/MathJax/MathJax.js?config=TeX-AMS-MML_HTMLorMML",
-	       Cfg_URL_SWAD_PUBLIC);
-#else
-      // Use the MathJax Content Delivery Network (CDN)
-      MathJaxURL[0] = '\0';
-#endif
-      // --ascii uses only ascii characters in output
-      //         (uses numerical entities instead of UTF-8)
-      //         is mandatory in order to convert (with iconv) the UTF-8 output of pandoc to WINDOWS-1252
-      sprintf (Command,"iconv -f WINDOWS-1252 -t UTF-8 %s"
-	               " | "
-	               "pandoc --ascii --mathjax%s -f markdown -t html5"
-	               " | "
-	               "iconv -f UTF-8 -t WINDOWS-1252 -o %s",
-	       PathFileMD,
-	       MathJaxURL,
-	       PathFileHTML);
-      ReturnCode = system (Command);
-      if (ReturnCode == -1)
-	 Lay_ShowErrorAndExit ("Error when running command to convert from Markdown to HTML.");
-
-      /***** Remove Markdown file *****/
-      unlink (PathFileMD);
+/*****************************************************************************/
+/****** Build path inside a course to store rich text converted to HTML ******/
+/*****************************************************************************/
+
+static void Inf_BuildPathRichTxtHTML (long CrsCod,Inf_InfoType_t InfoType,char *PathFile)
+  {
+   sprintf (PathFile,"%s/%s/%ld/%s.md.html",
+	    Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_CRS,CrsCod,
+	    Inf_FileNamesForInfoType[InfoType]);
+  }
+
+/*****************************************************************************/
+/********* Build first line of the HTML file converted from Markdown *********/
+/*****************************************************************************/
+// The first line of the HTML file is a comment with the hash of the Markdown text,
+// in order to know if the HTML file corresponds to the current text
+
+static void Inf_BuildHeadRichTxtHTML (const char *TxtMD,
+                                      char HeadHTML[4+Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+5+1])
+  {
+   char HashMD[Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+1];
 
-      /***** Copy HTML file just created to HTML output *****/
-      /* Open temporary HTML file for reading */
-      if ((FileHTML = fopen (PathFileHTML,"rb")) == NULL)
-	 Lay_ShowErrorAndExit ("Can not open temporary HTML file.");
+   Cry_EncryptSHA256Base64 (TxtMD,HashMD);
+   sprintf (HeadHTML,"<!--%s-->\n",HashMD);
+  }
 
-      /* Copy from temporary HTML file to output file */
-      Fil_FastCopyOfOpenFiles (FileHTML,Gbl.F.Out);
+/*****************************************************************************/
+/****** Write to HTML output the rich text already converted to HTML *********/
+/*****************************************************************************/
+// Return false if the HTML file does not exist or is outdated
 
-      /* Close and remove temporary HTML file */
+static bool Inf_WriteRichTxtHTMLFromCache (long CrsCod,Inf_InfoType_t InfoType,
+                                           const char *TxtMD)
+  {
+   char PathFileHTML[PATH_MAX+1];
+   FILE *FileHTML;
+   char HeadHTML[4+Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+5+1];
+   char HeadHTMLFromFile[4+Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+5+1];
+
+   /***** Open HTML file *****/
+   Inf_BuildPathRichTxtHTML (CrsCod,InfoType,PathFileHTML);
+   if ((FileHTML = fopen (PathFileHTML,"rb")) == NULL)
+      return false;
+
+   /***** Check if the HTML file corresponds to the current Markdown text *****/
+   Inf_BuildHeadRichTxtHTML (TxtMD,HeadHTML);
+   if (!fgets (HeadHTMLFromFile,sizeof (HeadHTMLFromFile),FileHTML) ||
+       strcmp (HeadHTMLFromFile,HeadHTML))
+     {
       fclose (FileHTML);
-      unlink (PathFileHTML);
+      return false;
+     }
 
-      /***** End frame *****/
-      fprintf (Gbl.F.Out,"</div>");
-      Lay_EndRoundFrame ();
+   /***** Copy from HTML file to output file *****/
+   Fil_FastCopyOfOpenFiles (FileHTML,Gbl.F.Out);
+   fclose (FileHTML);
 
-      return true;
+   return true;
+  }
+
+/*****************************************************************************/
+/*************** Convert rich text from Markdown to HTML file ****************/
+/*****************************************************************************/
+// The HTML file is stored inside the course directory
+// and it is used every time the course info is shown.
+// Return false on error, keeping the old HTML file
+
+static bool Inf_ConvertRichTxtToHTML (long CrsCod,Inf_InfoType_t InfoType,
+                                      const char *TxtMD)
+  {
+   char PathFileMD[PATH_MAX+1];
+   char PathFileMDUTF8[PATH_MAX+1];
+   char PathFileHTMLUTF8[PATH_MAX+1];
+   char PathFileHTMLTmp[PATH_MAX+1];
+   char PathFileHTML[PATH_MAX+1];
+   FILE *FileMD;		// Temporary Markdown file
+   FILE *FileHTMLTmp;		// Temporary HTML file
+   char HeadHTML[4+Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+5+1];
+   char MathJaxURL[PATH_MAX];
+   char Command[512+PATH_MAX*7]; // Command to convert from Markdown to HTML
+   int ReturnCode;
+
+   /***** Store text into a temporary .md file in HTML output directory *****/
+   /* Create a unique name for the .md file */
+   sprintf (PathFileMD,"%s/%s/%s.md",
+	    Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_OUT,Gbl.UniqueNameEncrypted);
+   sprintf (PathFileMDUTF8,"%s/%s/%s.utf8.md",
+	    Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_OUT,Gbl.UniqueNameEncrypted);
+   sprintf (PathFileHTMLUTF8,"%s/%s/%s.utf8.md.html",
+	    Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_OUT,Gbl.UniqueNameEncrypted);
+   sprintf (PathFileHTMLTmp,"%s/%s/%s.md.html",	// Do not use only .html because that is the output temporary file
+	    Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_OUT,Gbl.UniqueNameEncrypted);
+
+   /* Open Markdown file for writing */
+   if ((FileMD = fopen (PathFileMD,"wb")) == NULL)
+      return false;
+
+   /* Write text into Markdown file */
+   fprintf (FileMD,"%s",TxtMD);
+
+   /* Close Markdown file */
+   fclose (FileMD);
+
+   /***** Write the hash of the Markdown text at the start of the HTML file *****/
+   if ((FileHTMLTmp = fopen (PathFileHTMLTmp,"wb")) == NULL)
+     {
+      unlink (PathFileMD);
+      return false;
      }
+   Inf_BuildHeadRichTxtHTML (TxtMD,HeadHTML);
+   fprintf (FileHTMLTmp,"%s",HeadHTML);
+   fclose (FileHTMLTmp);
 
-   return false;
+   /***** Convert from Markdown to HTML *****/
+#ifdef Cfg_MATHJAX_LOCAL
+   // Use the local copy of MathJax
+   sprintf (MathJaxURL,"=%s/MathJax/MathJax.js?config=TeX-AMS-MML_HTMLorMML",
+	    Cfg_URL_SWAD_PUBLIC);
+#else
+   // Use the MathJax Content Delivery Network (CDN)
+   MathJaxURL[0] = '\0';
+#endif
+   // --ascii uses only ascii characters in output
+   //         (uses numerical entities instead of UTF-8)
+   //         is mandatory in order to convert (with iconv) the UTF-8 output of pandoc to WINDOWS-1252
+   // The three steps are run one after another, and not in a pipe,
+   // so the exit status of the command is not 0 if any of them fails
+   sprintf (Command,"iconv -f WINDOWS-1252 -t UTF-8 %s > %s"
+		    " && "
+		    "pandoc --ascii --mathjax%s -f markdown -t html5 -o %s %s"
+		    " && "
+		    "iconv -f UTF-8 -t WINDOWS-1252 %s >> %s",
+	    PathFileMD,PathFileMDUTF8,
+	    MathJaxURL,PathFileHTMLUTF8,PathFileMDUTF8,
+	    PathFileHTMLUTF8,PathFileHTMLTmp);
+   ReturnCode = system (Command);
+
+   /***** Remove Markdown files and intermediate HTML file *****/
+   unlink (PathFileMD);
+   unlink (PathFileMDUTF8);
+   unlink (PathFileHTMLUTF8);
+
+   /***** On error, the old HTML file is kept *****/
+   if (ReturnCode == -1 ||
+       !WIFEXITED (ReturnCode) ||
+       WEXITSTATUS (ReturnCode))
+     {
+      unlink (PathFileHTMLTmp);
+      return false;
+     }
+
+   /***** Replace the old HTML file by the new one *****/
+   // rename is atomic, so a user showing the info never gets a partial file
+   Inf_BuildPathRichTxtHTML (CrsCod,InfoType,PathFileHTML);
+   if (rename (PathFileHTMLTmp,PathFileHTML))
+     {
+      unlink (PathFileHTMLTmp);
+      return false;
+     }
+
+   return true;
+  }
+
+/*****************************************************************************/
+/**************** Remove escape sequences from Markdown text *****************/
+/*****************************************************************************/
+// Markdown text got from form has quotes and inverted bars escaped
+// to be stored in database (\", \' and \\).
+// TxtMD must have space for the text got from form
+
+static void Inf_RemoveEscapesFromMarkdown (const char *TxtMDEscaped,char *TxtMD)
+  {
+   for (;
+	*TxtMDEscaped;
+	TxtMDEscaped++, TxtMD++)
+     {
+      if (*TxtMDEscaped == '\\' && *(TxtMDEscaped + 1))
+	 TxtMDEscaped++;
+      *TxtMD = *TxtMDEscaped;
+     }
+   *TxtMD = '\0';
   }
 
 /*****************************************************************************/
@@ -2085,6 +2226,7 @@ void Inf_RecAndChangeRichTxtInfo (void)
   {
    char Txt_HTMLFormat[Cns_MAX_BYTES_LONG_TEXT+1];
    char Txt_MarkdownFormat[Cns_MAX_BYTES_LONG_TEXT+1];
+   char TxtMD[Cns_MAX_BYTES_LONG_TEXT+1];
 
    /***** Set info type *****/
    Gbl.CurrentCrs.Info.Type  = Inf_AsignInfoType ();
@@ -2098,6 +2240,23 @@ void Inf_RecAndChangeRichTxtInfo (void)
    Str_ChangeFormat (Str_FROM_FORM,Str_TO_MARKDOWN,
                      Txt_MarkdownFormat,Cns_MAX_BYTES_LONG_TEXT,true);	// Store a copy in Markdown format
 
+   /***** Convert text from Markdown to HTML now,
+          so it is not converted every time it is shown *****/
+   // The conversion is made before storing the text,
+   // so if it fails, the old text and its HTML are kept
+   Inf_RemoveEscapesFromMarkdown (Txt_MarkdownFormat,TxtMD);
+   if (TxtMD[0])
+      if (!Inf_ConvertRichTxtToHTML (Gbl.CurrentCrs.Crs.CrsCod,Gbl.CurrentCrs.Info.Type,
+                                     TxtMD))
+	{
+	 Lay_ShowAlert (Lay_WARNING,"Error when converting from Markdown to HTML."
+	                            " The information has not been changed.");
+
+	 /***** Show the old info *****/
+	 Inf_ShowInfo ();
+	 return;
+	}
+
    /***** Update text of course info in database *****/
    Inf_SetInfoTxtIntoDB (Txt_HTMLFormat,Txt_MarkdownFormat);
 
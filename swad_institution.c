@@ -29,6 +29,7 @@
 #include <stdlib.h>		// For calloc
 #include <string.h>		// For string functions
 
+#include "swad_cache.h"
 #include "swad_config.h"
 #include "swad_constant.h"
 #include "swad_database.h"
@@ -629,22 +630,32 @@ static void Ins_PutIconsToPrintAndUpload (void)
 
 void Ins_ShowInssOfCurrentCty (void)
   {
+   char Variant[64];
+
    if (Gbl.CurrentCty.Cty.CtyCod > 0)
      {
       /***** Get parameter with the type of order in the list of institutions *****/
       Ins_GetParamInsOrderType ();
 
-      /***** Get list of institutions *****/
-      Ins_GetListInstitutions (Gbl.CurrentCty.Cty.CtyCod,Ins_GET_EXTRA_DATA);
-
       /***** Write menu to select country *****/
       Deg_WriteMenuAllCourses ();
 
-      /***** List institutions *****/
-      Ins_ListInstitutions ();
+      /***** List institutions from cache or from database *****/
+      sprintf (Variant,"%u_%ld",
+               (unsigned) Gbl.Inss.SelectedOrderType,Gbl.CurrentIns.Ins.InsCod);
+      if (Cac_StartFragment (Cac_INS_LIST,Gbl.CurrentCty.Cty.CtyCod,Variant))
+	{
+	 /***** Get list of institutions *****/
+	 Ins_GetListInstitutions (Gbl.CurrentCty.Cty.CtyCod,Ins_GET_EXTRA_DATA);
 
-      /***** Free list of institutions *****/
-      Ins_FreeListInstitutions ();
+	 /***** List institutions *****/
+	 Ins_ListInstitutions ();
+
+	 /***** Free list of institutions *****/
+	 Ins_FreeListInstitutions ();
+
+	 Cac_EndFragment ();
+	}
      }
   }
 
@@ -1596,6 +1607,9 @@ void Ins_RemoveInstitution (void)
                Ins.InsCod);
       DB_QueryDELETE (Query,"can not remove an institution");
 
+      /* Invalidate cached lists of institutions, centres and degrees */
+      Cac_InvalidateHierarchyLists ();
+
       /***** Write message to show the change made *****/
       sprintf (Gbl.Message,Txt_Institution_X_removed,
                Ins.FullName);
@@ -1740,6 +1754,9 @@ static void Ins_UpdateInsNameDB (long InsCod,const char *FieldName,const char *N
    sprintf (Query,"UPDATE institutions SET %s='%s' WHERE InsCod='%ld'",
 	    FieldName,NewInsName,InsCod);
    DB_QueryUPDATE (Query,"can not update the name of an institution");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
 
 /*****************************************************************************/
@@ -1818,6 +1835,9 @@ static void Ins_UpdateInsCtyDB (long InsCod,long CtyCod)
    sprintf (Query,"UPDATE institutions SET CtyCod='%ld' WHERE InsCod='%ld'",
             CtyCod,InsCod);
    DB_QueryUPDATE (Query,"can not update the country of an institution");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
 
 /*****************************************************************************/
@@ -1904,6 +1924,9 @@ static void Ins_UpdateInsWWWDB (long InsCod,const char NewWWW[Cns_MAX_LENGTH_WWW
    sprintf (Query,"UPDATE institutions SET WWW='%s' WHERE InsCod='%ld'",
 	    NewWWW,InsCod);
    DB_QueryUPDATE (Query,"can not update the web of an institution");
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
 
 /*****************************************************************************/
@@ -1940,6 +1963,9 @@ void Ins_ChangeInsStatus (void)
             (unsigned) Status,Ins->InsCod);
    DB_QueryUPDATE (Query,"can not update the status of an institution");
 
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
+
    Ins->Status = Status;
 
    /***** Write message to show the change made *****/
@@ -2285,6 +2311,9 @@ static void Ins_CreateInstitution (struct Instit *Ins,unsigned Status)
             Ins->ShrtName,Ins->FullName,Ins->WWW);
    Ins->InsCod = DB_QueryINSERTandReturnCode (Query,"can not create institution");
 
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
+
    /***** Write success message *****/
    sprintf (Gbl.Message,Txt_Created_new_institution_X,
             Ins->FullName);
@@ -30,12 +30,14 @@
 #include <string.h>		// For string functions
 
 #include "swad_action.h"
+#include "swad_cache.h"
 #include "swad_calendar.h"
 #include "swad_changelog.h"
 #include "swad_config.h"
 #include "swad_connected.h"
 #include "swad_database.h"
 #include "swad_exam.h"
+#include "swad_follow.h"
 #include "swad_global.h"
 #include "swad_logo.h"
 #include "swad_MFU.h"
@@ -43,6 +45,7 @@
 #include "swad_notification.h"
 #include "swad_parameter.h"
 #include "swad_preference.h"
+#include "swad_profiler.h"
 #include "swad_social.h"
 #include "swad_tab.h"
 #include "swad_theme.h"
@@ -78,7 +81,6 @@ static void Lay_WriteEndOfPage (void);
 
 static void Lay_WritePageTitle (void);
 
-static void Lay_WriteRedirectionToMyLanguage (void);
 static void Lay_WriteScripts (void);
 static void Lay_WriteScriptInit (void);
 static void Lay_WriteScriptParamsAJAX (void);
@@ -105,7 +107,6 @@ void Lay_WriteStartOfPage (void)
   {
    extern struct Act_Actions Act_Actions[Act_NUM_ACTIONS];
    extern const char *Txt_STR_LANG_ID[1+Txt_NUM_LANGUAGES];
-   extern const unsigned Txt_Current_CGI_SWAD_Language;
    extern const char *The_TabOnBgColors[The_NUM_THEMES];
    extern const char *Txt_NEW_YEAR_GREETING;
    const char *LayoutMainZone[Mnu_NUM_MENUS] =
@@ -218,13 +219,6 @@ void Lay_WriteStartOfPage (void)
 	                 " type=\"text/css\" />\n",
                Cfg_URL_SWAD_PUBLIC);
 
-   /* Redirect to correct language */
-   if ((Gbl.Action.Act == ActAutUsrInt ||
-        Gbl.Action.Act == ActAutUsrNew) &&					// Action is log in
-       Gbl.Usrs.Me.Logged &&							// I am just logged
-       Gbl.Usrs.Me.UsrDat.Prefs.Language != Txt_Current_CGI_SWAD_Language)	// My language != current language
-      Lay_WriteRedirectionToMyLanguage ();
-
    /* Write initial scripts depending on the action */
    Lay_WriteScripts ();
 
@@ -321,8 +315,7 @@ void Lay_WriteStartOfPage (void)
 
    /* Write new year greeting */
    if (Gbl.Action.Act == ActAutUsrInt ||
-       Gbl.Action.Act == ActAutUsrNew ||
-       Gbl.Action.Act == ActAutUsrChgLan)
+       Gbl.Action.Act == ActAutUsrNew)
       if (Gbl.Now.Date.Month == 1 &&
 	  Gbl.Now.Date.Day == 1)
         {
@@ -390,23 +383,6 @@ static void Lay_WritePageTitle (void)
    fprintf (Gbl.F.Out,"</title>\n");
   }
 
-/*****************************************************************************/
-/************* Write script and meta to redirect to my language **************/
-/*****************************************************************************/
-
-static void Lay_WriteRedirectionToMyLanguage (void)
-  {
-   extern struct Act_Actions Act_Actions[Act_NUM_ACTIONS];
-   extern const char *Txt_STR_LANG_ID[1+Txt_NUM_LANGUAGES];
-
-   fprintf (Gbl.F.Out,"<meta http-equiv=\"refresh\""
-	              " content=\"0; url='%s/%s?act=%ld&amp;ses=%s'\">",
-	    Cfg_URL_SWAD_CGI,
-	    Txt_STR_LANG_ID[Gbl.Usrs.Me.UsrDat.Prefs.Language],
-	    Act_Actions[ActAutUsrChgLan].ActCod,
-	    Gbl.Session.Id);
-  }
-
 /*****************************************************************************/
 /************ Write some scripts depending on the current action *************/
 /*****************************************************************************/
@@ -1342,6 +1318,19 @@ void Lay_ShowErrorAndExit (const char *Message)
       mysql_query (&Gbl.mysql,"UNLOCK TABLES");
      }
 
+   /***** Roll back transaction if started *****/
+   if (Gbl.DB.OpenTransaction)
+     {
+      Gbl.DB.OpenTransaction = false;
+      mysql_query (&Gbl.mysql,"ROLLBACK");
+     }
+
+   /***** Discard fragment of page being stored in cache *****/
+   Cac_AbortFragment ();
+
+   /***** The rest of the time is used to finish the page *****/
+   Pfl_StartPhase (Pfl_PHASE_PAGE);
+
    if (!Gbl.WebService.IsWebService)
      {
       /***** Write possible error message *****/
@@ -1358,6 +1347,7 @@ void Lay_ShowErrorAndExit (const char *Message)
           Compute time to generate page *****/
    if (!Gbl.Action.UsesAJAX)
       Sta_ComputeTimeToGeneratePage ();
+   Pfl_EndPhases ();
 
    if (Gbl.WebService.IsWebService)		// Serving a plugin request
      {
@@ -1499,12 +1489,22 @@ void Lay_RefreshNotifsAndConnected (void)
    // Sometimes, someone must do this work, so who best than processes that refresh via AJAX?
    if (!(Gbl.PID % 11))		// Do this only one of   11 times (  11 is prime)
       Ntf_SendPendingNotifByEMailToAllUsrs ();	// Send pending notifications by e-mail
+   else if (!(Gbl.PID % 17))	// Do this only one of   17 times (  17 is prime)
+      Brw_MergePendingFileViews ();		// Fold pending file views into views and counters
    else if (!(Gbl.PID % 1013))	// Do this only one of 1013 times (1013 is prime)
       Brw_RemoveExpiredExpandedFolders ();	// Remove old expanded folders (from all users)
    else if (!(Gbl.PID % 1019))	// Do this only one of 1019 times (1019 is prime)
       Pre_RemoveOldPrefsFromIP ();		// Remove old preferences from IP
    else if (!(Gbl.PID % 1021))	// Do this only one of 1021 times (1021 is prime)
       Sta_RemoveOldEntriesRecentLog ();		// Remove old entries in recent log table, it's a slow query
+   else if (!(Gbl.PID % 1031))	// Do this only one of 1031 times (1031 is prime)
+      Ntf_RebuildNumUnseenNtfs ();		// Check numbers of unseen notifications, it's a slow query
+   else if (!(Gbl.PID % 1033))	// Do this only one of 1033 times (1033 is prime)
+      Fol_RemoveOldUsrsToFollow ();		// Remove old pools of users to follow (from all users)
+   else if (!(Gbl.PID % 1039))	// Do this only one of 1039 times (1039 is prime)
+      Pfl_RemoveOldProfiles ();			// Remove old entries in profile log tables
+   else if (!(Gbl.PID % 1049))	// Do this only one of 1049 times (1049 is prime)
+      Cac_RemoveOldFragments ();		// Remove old fragments of pages from cache
 
    // Send, before the HTML, the refresh time
    fprintf (Gbl.F.Out,"%lu|",Gbl.Usrs.Connected.TimeToRefreshInMs);
@@ -28,6 +28,7 @@
 #include <string.h>		// For string functions
 
 #include "swad_action.h"
+#include "swad_cache.h"
 #include "swad_global.h"
 #include "swad_scope.h"
 #include "swad_theme.h"
@@ -386,7 +387,10 @@ void Log_ReceiveLogo (Sco_Scope_t Scope)
 	       (unsigned) (Cod % 100),
 	       (unsigned) Cod,
 	       (unsigned) Cod);
-      if (!Fil_EndReceptionOfFile (FileNameLogo,Param))
+      if (Fil_EndReceptionOfFile (FileNameLogo,Param))
+	 /* Invalidate cached lists of institutions, centres and degrees */
+	 Cac_InvalidateHierarchyLists ();
+      else
 	 Lay_ShowAlert (Lay_WARNING,"Error copying file.");
      }
   }
@@ -427,4 +431,7 @@ void Log_RemoveLogo (Sco_Scope_t Scope)
 	    (unsigned) Cod,
 	    (unsigned) Cod);
    Fil_RemoveTree (FileNameLogo);
+
+   /***** Invalidate cached lists of institutions, centres and degrees *****/
+   Cac_InvalidateHierarchyLists ();
   }
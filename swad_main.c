@@ -39,6 +39,7 @@
 #include "swad_MFU.h"
 #include "swad_parameter.h"
 #include "swad_preference.h"
+#include "swad_profiler.h"
 #include "swad_notification.h"
 
 /*****************************************************************************/
@@ -110,22 +111,23 @@ int main (int argc, char *argv[])
    DB_OpenDBConnection ();
 
    /***** Read parameters *****/
+   Pfl_StartPhase (Pfl_PHASE_PARAMS);
    if (Par_GetQueryString ())
      {
       Par_CreateListOfParams ();
       Par_GetMainParameters ();
       Deg_InitCurrentCourse ();
+      Pfl_StartPhase (Pfl_PHASE_SESSION);
 
       if (!Gbl.WebService.IsWebService)
 	{
 	 /***** Create file for HTML output *****/
 	 Fil_CreateFileForHTMLOutput ();
 
-	 /***** Remove old (expired) sessions *****/
-	 Ses_RemoveExpiredSessions ();
-
-	 /***** Remove old users from connected list *****/
-	 Con_RemoveOldConnected ();
+	 /***** Remove old (expired) sessions
+	        and old users from connected list *****/
+	 if (Ses_RemoveExpiredSessions ())
+	    Con_RemoveOldConnected ();
 
 	 /***** Get number of sessions *****/
 	 if (Act_Actions[Gbl.Action.Act].BrowserWindow == Act_THIS_WINDOW)
@@ -143,13 +145,16 @@ int main (int argc, char *argv[])
       MFU_UpdateMFUActions ();
 
       /***** Execute a function depending on the action *****/
+      Pfl_StartPhase (Pfl_PHASE_PRIORI);
       if (Act_Actions[Gbl.Action.Act].FunctionPriori != NULL)
 	 Act_Actions[Gbl.Action.Act].FunctionPriori ();
 
       /***** Start writing HTML output *****/
+      Pfl_StartPhase (Pfl_PHASE_PAGE);
       Lay_WriteStartOfPage ();
 
       /***** Make a processing or other depending on the action *****/
+      Pfl_StartPhase (Pfl_PHASE_POSTERIORI);
       if (Act_Actions[Gbl.Action.Act].FunctionPosteriori != NULL)
 	 Act_Actions[Gbl.Action.Act].FunctionPosteriori ();
      }
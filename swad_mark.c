@@ -68,22 +68,32 @@ const char *Mrk_HeadOrFootStr[2] =	// Names of columns in database, so don't cha
 
 #define Mrk_MAX_BYTES_IN_CELL_CONTENT	1024	// Cell of a table containing one or several user's IDs
 
+#define Mrk_NUM_BYTES_PER_CHUNK		4096	// Bytes copied at once from the file of marks
+
 /*****************************************************************************/
 /*************************** Internal prototypes *****************************/
 /*****************************************************************************/
 
-static void Mrk_GetNumRowsHeaderAndFooter (struct MarksProperties *Marks);
+static void Mrk_IndexFileOfMarks (long FilCod,const char *Path,
+                                  struct MarksProperties *Marks);
+static long Mrk_GetNumRowsHeaderAndFooter (struct MarksProperties *Marks);
 static void Mrk_ChangeNumRowsHeaderOrFooter (Brw_HeadOrFoot_t HeaderOrFooter);
 static bool Mrk_CheckIfCellContainsOnlyIDs (const char *CellContent);
 static bool Mrk_GetUsrMarks (FILE *FileUsrMarks,struct UsrData *UsrDat,
-                             const char *PathFileAllMarks,
+                             long FilCod,const char *PathFileAllMarks,
                              struct MarksProperties *Marks);
+static bool Mrk_GetUsrMarksScanningFile (FILE *FileUsrMarks,FILE *FileAllMarks,
+                                         struct UsrData *UsrDat,
+                                         struct MarksProperties *Marks);
+static bool Mrk_GetRowOfUsrFromDB (long FilCod,struct UsrData *UsrDat,
+                                   long *RowStart,long *RowEnd);
+static void Mrk_CopyPartOfFile (FILE *FileSrc,FILE *FileTgt,long Start,long End);
 
 /*****************************************************************************/
 /****************** Add a new entry of marks into database *******************/
 /*****************************************************************************/
 
-void Mrk_AddMarksToDB (long FilCod,struct MarksProperties *Marks)
+void Mrk_AddMarksToDB (long FilCod,const char *Path,struct MarksProperties *Marks)
   {
    char Query[256];
 
@@ -96,6 +106,110 @@ void Mrk_AddMarksToDB (long FilCod,struct MarksProperties *Marks)
 	    Marks->Header,
 	    Marks->Footer);
    DB_QueryINSERT (Query,"can not add properties of marks to database");
+
+   /***** Index the rows of the file of marks *****/
+   Mrk_IndexFileOfMarks (FilCod,Path,Marks);
+  }
+
+/*****************************************************************************/
+/************** Store the position of each row in a file of marks ************/
+/*****************************************************************************/
+// The position of the end of the header, the position of the start of the footer
+// and the position of the row of each user's ID are stored in database,
+// so the marks of a user can be got later without parsing the whole file
+
+static void Mrk_IndexFileOfMarks (long FilCod,const char *Path,
+                                  struct MarksProperties *Marks)
+  {
+   char Query[256+ID_MAX_LENGTH_USR_ID];
+   FILE *FileAllMarks;
+   unsigned Row;
+   char CellContent[Mrk_MAX_BYTES_IN_CELL_CONTENT+1];
+   const char *Ptr;
+   char UsrIDFromTable[ID_MAX_LENGTH_USR_ID+1];
+   long RowStart;
+   long RowEnd;
+
+   Marks->HeaderEnd =
+   Marks->FooterStart = -1L;
+
+   /***** Open HTML file with the table of marks *****/
+   if (!(FileAllMarks = fopen (Path,"rb")))
+      return;
+
+   /***** Get the end of the header *****/
+   /* Jump to table start */
+   Str_FindStrInFile (FileAllMarks,"<table",Str_NO_SKIP_HTML_COMMENTS);
+   Str_FindStrInFile (FileAllMarks,">",Str_NO_SKIP_HTML_COMMENTS);
+
+   /* Skip header */
+   for (Row = 1;
+	Row <= Marks->Header;
+	Row++)
+      Str_FindStrInFile (FileAllMarks,"</tr>",Str_NO_SKIP_HTML_COMMENTS);
+   Marks->HeaderEnd = ftell (FileAllMarks);
+
+   /***** Store the position of the row of each user's ID *****/
+   while (Str_FindStrInFile (FileAllMarks,"<tr",Str_NO_SKIP_HTML_COMMENTS))   // Go to the next row
+     {
+      RowStart = ftell (FileAllMarks) - 3;	// Position of "<tr"
+
+      // All user's IDs must be in the first column of the row
+      Str_GetCellFromHTMLTableSkipComments (FileAllMarks,CellContent,Mrk_MAX_BYTES_IN_CELL_CONTENT);
+
+      /* Go to the end of the row */
+      if (!Str_FindStrInFile (FileAllMarks,"</tr>",Str_NO_SKIP_HTML_COMMENTS))
+	 break;
+      RowEnd = ftell (FileAllMarks);
+
+      /* Get user's IDs */
+      Ptr = CellContent;
+      while (*Ptr)
+	{
+	 /* Find next string in text until comma or semicolon (leading and trailing spaces are removed) */
+	 Str_GetNextStringUntilSeparator (&Ptr,UsrIDFromTable,ID_MAX_LENGTH_USR_ID);
+
+	 // Users' IDs are always stored internally in capitals and without leading zeros
+	 Str_RemoveLeadingZeros (UsrIDFromTable);
+	 Str_ConvertToUpperText (UsrIDFromTable);
+
+	 if (ID_CheckIfUsrIDIsValid (UsrIDFromTable))
+	   {
+	    // If an ID appears in several rows, only the first one is stored
+	    sprintf (Query,"INSERT IGNORE INTO marks_rows"
+			   " (FilCod,UsrID,RowStart,RowEnd)"
+			   " VALUES ('%ld','%s','%ld','%ld')",
+		     FilCod,UsrIDFromTable,RowStart,RowEnd);
+	    DB_QueryINSERT (Query,"can not store row of marks");
+	   }
+	}
+     }
+
+   /***** Get the start of the footer *****/
+   rewind (FileAllMarks);
+   if (Str_FindStrInFile (FileAllMarks,"</table>",Str_NO_SKIP_HTML_COMMENTS))
+     {
+      Str_FindStrInFileBack (FileAllMarks,"</table>",Str_NO_SKIP_HTML_COMMENTS);
+      for (Row = 1;
+	   Row <= Marks->Footer;
+	   Row++)
+	 Str_FindStrInFileBack (FileAllMarks,"<tr",Str_NO_SKIP_HTML_COMMENTS);
+     }
+   else
+      fseek (FileAllMarks,0L,SEEK_END);
+   Marks->FooterStart = ftell (FileAllMarks);
+
+   /***** The file of marks is no longer needed. Close it. *****/
+   fclose (FileAllMarks);
+
+   /***** Store the limits of header and footer.
+          This must be the last step: the index is valid when they are set *****/
+   sprintf (Query,"UPDATE marks_properties"
+	          " SET HeaderEnd='%ld',FooterStart='%ld'"
+	          " WHERE FilCod='%ld'",
+	    Marks->HeaderEnd,Marks->FooterStart,
+	    FilCod);
+   DB_QueryUPDATE (Query,"can not update properties of marks");
   }
 
 /*****************************************************************************/
@@ -180,8 +294,9 @@ void Mrk_GetAndWriteNumRowsHeaderAndFooter (Brw_FileType_t FileType,
 /*****************************************************************************/
 /******** Get number of rows of header and of footer of a file of marks ******/
 /*****************************************************************************/
+// Returns the code of the file of marks, or -1 if it has no properties in database
 
-static void Mrk_GetNumRowsHeaderAndFooter (struct MarksProperties *Marks)
+static long Mrk_GetNumRowsHeaderAndFooter (struct MarksProperties *Marks)
   {
    extern const Brw_FileBrowser_t Brw_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
    long Cod = Brw_GetCodForFiles ();
@@ -189,9 +304,12 @@ static void Mrk_GetNumRowsHeaderAndFooter (struct MarksProperties *Marks)
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
    unsigned long NumRows;
+   long FilCod = -1L;
 
    /***** Get number of rows of header and footer from database *****/
-   sprintf (Query,"SELECT marks_properties.%s,marks_properties.%s"
+   sprintf (Query,"SELECT marks_properties.%s,marks_properties.%s,"
+	          "marks_properties.HeaderEnd,marks_properties.FooterStart,"
+	          "files.FilCod"
 	          " FROM files,marks_properties"
                   " WHERE files.FileBrowser='%u' AND files.Cod='%ld' AND files.Path='%s'"
                   " AND files.FilCod=marks_properties.FilCod",
@@ -215,15 +333,30 @@ static void Mrk_GetNumRowsHeaderAndFooter (struct MarksProperties *Marks)
       /* Footer (row[1]) */
       if (sscanf (row[1],"%u",&(Marks->Footer)) != 1)
          Lay_ShowErrorAndExit ("Wrong number of footer rows.");
+
+      /* End of header and start of footer (row[2], row[3]) */
+      if (sscanf (row[2],"%ld",&(Marks->HeaderEnd)) != 1)
+         Marks->HeaderEnd = -1L;
+      if (sscanf (row[3],"%ld",&(Marks->FooterStart)) != 1)
+         Marks->FooterStart = -1L;
+
+      /* File code (row[4]) */
+      FilCod = Str_ConvertStrCodToLongCod (row[4]);
      }
    else if (NumRows == 0)	// Unknown numbers of header and footer rows
+     {
       Marks->Header =
       Marks->Footer = 0;
+      Marks->HeaderEnd =
+      Marks->FooterStart = -1L;
+     }
    else	// Number of entries in database > 1
       Lay_ShowErrorAndExit ("Error when getting the number of rows in header and footer.");
 
    /***** Free structure that stores the query result *****/
    DB_FreeMySQLResult (&mysql_res);
+
+   return FilCod;
   }
 
 /*****************************************************************************/
@@ -256,6 +389,9 @@ static void Mrk_ChangeNumRowsHeaderOrFooter (Brw_HeadOrFoot_t HeaderOrFooter)
    long Cod;
    char Query[512+PATH_MAX];
    unsigned NumRows;
+   struct MarksProperties Marks;
+   long FilCod;
+   char PathFileAllMarks[PATH_MAX+1+PATH_MAX+1];
 
    /***** Get parameters related to file browser *****/
    Brw_GetParAndInitFileBrowser ();
@@ -276,6 +412,20 @@ static void Mrk_ChangeNumRowsHeaderOrFooter (Brw_HeadOrFoot_t HeaderOrFooter)
                Gbl.FileBrowser.Priv.FullPathInTree);
       DB_QueryUPDATE (Query,"can not update properties of marks");
 
+      /***** Index again the file of marks,
+             because the positions of header, footer and rows have changed *****/
+      if ((FilCod = Mrk_GetNumRowsHeaderAndFooter (&Marks)) > 0)
+	{
+	 sprintf (Query,"DELETE FROM marks_rows WHERE FilCod='%ld'",
+		  FilCod);
+	 DB_QueryDELETE (Query,"can not remove rows of marks");
+
+	 sprintf (PathFileAllMarks,"%s/%s",
+		  Gbl.FileBrowser.Priv.PathAboveRootFolder,
+		  Gbl.FileBrowser.Priv.FullPathInTree);
+	 Mrk_IndexFileOfMarks (FilCod,PathFileAllMarks,&Marks);
+	}
+
       /***** Write message of success *****/
       sprintf (Gbl.Message,Txt_The_number_of_rows_is_now_X,
                NumRows);
@@ -438,18 +588,14 @@ static bool Mrk_CheckIfCellContainsOnlyIDs (const char *CellContent)
 /*****************************************************************************/
 
 static bool Mrk_GetUsrMarks (FILE *FileUsrMarks,struct UsrData *UsrDat,
-                             const char *PathFileAllMarks,
+                             long FilCod,const char *PathFileAllMarks,
                              struct MarksProperties *Marks)
   {
    extern const char *Txt_THE_USER_X_is_not_found_in_the_file_of_marks;
-   unsigned Row;
-   char CellContent[Mrk_MAX_BYTES_IN_CELL_CONTENT+1];
-   const char *Ptr;
-   char UsrIDFromTable[ID_MAX_LENGTH_USR_ID+1];
    FILE *FileAllMarks;
-   unsigned NumID;
+   long RowStart;
+   long RowEnd;
    bool UsrIDFound;
-   bool EndOfTable;
 
    /***** Open HTML file with the table of marks *****/
    if (!(FileAllMarks = fopen (PathFileAllMarks,"rb")))
@@ -458,6 +604,54 @@ static bool Mrk_GetUsrMarks (FILE *FileUsrMarks,struct UsrData *UsrDat,
       return false;
      }
 
+   /***** Get the row of the user in the table of marks *****/
+   if (FilCod > 0 &&
+       Marks->HeaderEnd >= 0 && Marks->FooterStart >= 0)	// File of marks indexed in database
+     {
+      if ((UsrIDFound = Mrk_GetRowOfUsrFromDB (FilCod,UsrDat,&RowStart,&RowEnd)))
+	{
+	 /***** Write all until the header (included) *****/
+	 Mrk_CopyPartOfFile (FileAllMarks,FileUsrMarks,0L,Marks->HeaderEnd);
+
+	 /****** Write the row corresponding to the student *****/
+	 Mrk_CopyPartOfFile (FileAllMarks,FileUsrMarks,RowStart,RowEnd);
+
+	 /***** Write the footer and all until the end *****/
+	 fseek (FileAllMarks,Marks->FooterStart,SEEK_SET);
+	 Fil_FastCopyOfOpenFiles (FileAllMarks,FileUsrMarks);
+	}
+     }
+   else	// File of marks not indexed (uploaded before indexes existed)
+      UsrIDFound = Mrk_GetUsrMarksScanningFile (FileUsrMarks,FileAllMarks,UsrDat,Marks);
+
+   /***** The file of marks is no longer needed. Close it. *****/
+   fclose (FileAllMarks);
+
+   /***** User's ID not found in table *****/
+   if (!UsrIDFound)
+      sprintf (Gbl.Message,Txt_THE_USER_X_is_not_found_in_the_file_of_marks,
+	       UsrDat->FullName);
+   return UsrIDFound;
+  }
+
+/*****************************************************************************/
+/********* Get the marks of a user scanning the whole file of marks **********/
+/*****************************************************************************/
+// Used when the file of marks is not indexed in database
+// Returns true if any of the confirmed user's IDs is found in the file of marks
+
+static bool Mrk_GetUsrMarksScanningFile (FILE *FileUsrMarks,FILE *FileAllMarks,
+                                         struct UsrData *UsrDat,
+                                         struct MarksProperties *Marks)
+  {
+   unsigned Row;
+   char CellContent[Mrk_MAX_BYTES_IN_CELL_CONTENT+1];
+   const char *Ptr;
+   char UsrIDFromTable[ID_MAX_LENGTH_USR_ID+1];
+   unsigned NumID;
+   bool UsrIDFound;
+   bool EndOfTable;
+
    /***** Check if it exists a user's ID in the first column of the table of marks *****/
    /* Jump to table start */
    Str_FindStrInFile (FileAllMarks,"<table",Str_NO_SKIP_HTML_COMMENTS);
@@ -580,18 +774,82 @@ static bool Mrk_GetUsrMarks (FILE *FileUsrMarks,struct UsrData *UsrDat,
 	 Str_FindStrInFileBack (FileAllMarks,"</table>",Str_NO_SKIP_HTML_COMMENTS);
 	 Fil_FastCopyOfOpenFiles (FileAllMarks,FileUsrMarks);
 
-	 /***** The file of marks is no longer needed. Close it. *****/
-	 fclose (FileAllMarks);
-
 	 return true;
 	}
      }
 
-   /***** User's ID not found in table *****/
-   fclose (FileAllMarks);
-   sprintf (Gbl.Message,Txt_THE_USER_X_is_not_found_in_the_file_of_marks,
-	    UsrDat->FullName);
    return false;
+
+  }
+
+
+/*****************************************************************************/
+/********* Get the position of the row of a user in a file of marks **********/
+/*****************************************************************************/
+// Returns true if any of the confirmed user's IDs is found in the file of marks
+// If several IDs are found, the first row in file is returned
+
+static bool Mrk_GetRowOfUsrFromDB (long FilCod,struct UsrData *UsrDat,
+                                   long *RowStart,long *RowEnd)
+  {
+   char Query[256+ID_MAX_LENGTH_USR_ID];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumID;
+   long Start;
+   long End;
+   bool UsrIDFound = false;
+
+   for (NumID = 0;
+	NumID < UsrDat->IDs.Num;
+	NumID++)
+      if (UsrDat->IDs.List[NumID].Confirmed)
+	{
+	 sprintf (Query,"SELECT RowStart,RowEnd FROM marks_rows"
+			" WHERE FilCod='%ld' AND UsrID='%s'",
+		  FilCod,UsrDat->IDs.List[NumID].ID);
+	 if (DB_QuerySELECT (Query,&mysql_res,"can not get row of marks"))
+	   {
+	    row = mysql_fetch_row (mysql_res);
+
+	    /* Start and end of the row (row[0], row[1]) */
+	    if (sscanf (row[0],"%ld",&Start) == 1 &&
+		sscanf (row[1],"%ld",&End) == 1)
+	       if (!UsrIDFound || Start < *RowStart)
+		 {
+		  *RowStart = Start;
+		  *RowEnd = End;
+		  UsrIDFound = true;
+		 }
+	   }
+
+	 /***** Free structure that stores the query result *****/
+	 DB_FreeMySQLResult (&mysql_res);
+	}
+
+   return UsrIDFound;
+  }
+
+/*****************************************************************************/
+/************ Copy the bytes from Start to End of a file to another **********/
+/*****************************************************************************/
+
+static void Mrk_CopyPartOfFile (FILE *FileSrc,FILE *FileTgt,long Start,long End)
+  {
+   unsigned char Bytes[Mrk_NUM_BYTES_PER_CHUNK];
+   size_t NumBytesToRead;
+   size_t NumBytesRead;
+
+   fseek (FileSrc,Start,SEEK_SET);
+   while (Start < End)
+     {
+      NumBytesToRead = (End - Start < Mrk_NUM_BYTES_PER_CHUNK) ? (size_t) (End - Start) :
+	                                                          (size_t) Mrk_NUM_BYTES_PER_CHUNK;
+      if (!(NumBytesRead = fread ((void *) Bytes,sizeof (Bytes[0]),NumBytesToRead,FileSrc)))
+	 break;
+      fwrite ((void *) Bytes,sizeof (Bytes[0]),NumBytesRead,FileTgt);
+      Start += (long) NumBytesRead;
+     }
   }
 
 /*****************************************************************************/
@@ -607,6 +865,7 @@ void Mrk_ShowMyMarks (void)
    char PathPrivate[PATH_MAX+1];
    struct UsrData *UsrDat;
    bool UsrIsOK = true;
+   long FilCod;
 
    /***** Get parameters related to file browser *****/
    Brw_GetParAndInitFileBrowser ();
@@ -617,7 +876,7 @@ void Mrk_ShowMyMarks (void)
    sprintf (PathPrivate,"%s/%s",Gbl.FileBrowser.Priv.PathAboveRootFolder,Gbl.FileBrowser.Priv.FullPathInTree);
 
    /***** Get number of rows of header or footer *****/
-   Mrk_GetNumRowsHeaderAndFooter (&Marks);
+   FilCod = Mrk_GetNumRowsHeaderAndFooter (&Marks);
 
    /***** Set the student whose marks will be shown *****/
    if (Gbl.Usrs.Me.LoggedRole == Rol_STUDENT)	// If I am logged as student...
@@ -676,7 +935,7 @@ void Mrk_ShowMyMarks (void)
          Lay_ShowErrorAndExit ("Can not open file for my marks.");
 
       /***** Show my marks *****/
-      if (Mrk_GetUsrMarks (FileUsrMarks,UsrDat,PathPrivate,&Marks))
+      if (Mrk_GetUsrMarks (FileUsrMarks,UsrDat,FilCod,PathPrivate,&Marks))
         {
          fclose (FileUsrMarks);
          if ((FileUsrMarks = fopen (FileNameUsrMarks,"rb")) == NULL)
@@ -746,7 +1005,8 @@ void Mrk_GetNotifMyMarks (char *SummaryStr,char **ContentStr,
 
    /***** Get subject of message from database *****/
    sprintf (Query,"SELECT files.FileBrowser,files.Cod,files.Path,"
-	          "marks_properties.Header,marks_properties.Footer"
+	          "marks_properties.Header,marks_properties.Footer,"
+	          "marks_properties.HeaderEnd,marks_properties.FooterStart"
 	          " FROM files,marks_properties"
 	          " WHERE files.FilCod='%ld'"
 	          " AND files.FilCod=marks_properties.FilCod",
@@ -792,6 +1052,12 @@ void Mrk_GetNotifMyMarks (char *SummaryStr,char **ContentStr,
                if (sscanf (row[4],"%u",&(Marks.Footer)) != 1)
                   Lay_ShowErrorAndExit ("Wrong number of footer rows.");
 
+               /* End of header and start of footer (row[5], row[6]) */
+               if (sscanf (row[5],"%ld",&(Marks.HeaderEnd)) != 1)
+                  Marks.HeaderEnd = -1L;
+               if (sscanf (row[6],"%ld",&(Marks.FooterStart)) != 1)
+                  Marks.FooterStart = -1L;
+
                if (UsrDat.IDs.Num)
                  {
                   if (GrpCod > 0)
@@ -820,7 +1086,7 @@ void Mrk_GetNotifMyMarks (char *SummaryStr,char **ContentStr,
                   if ((FileUsrMarks = fopen (FileNameUsrMarks,"wb")))
                     {
                      /***** Get user's marks *****/
-                     if (Mrk_GetUsrMarks (FileUsrMarks,&UsrDat,PathMarks,&Marks))
+                     if (Mrk_GetUsrMarks (FileUsrMarks,&UsrDat,MrkCod,PathMarks,&Marks))
                        {
                         SizeOfMyMarks = ftell (FileUsrMarks);
                         fclose (FileUsrMarks);
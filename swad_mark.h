@@ -39,13 +39,15 @@ struct MarksProperties
   {
    unsigned Header;
    unsigned Footer;
+   long HeaderEnd;	// Position in file after the header (-1 if the file is not indexed)
+   long FooterStart;	// Position in file of the start of the footer (-1 if the file is not indexed)
   };
 
 /*****************************************************************************/
 /***************************** Public prototypes *****************************/
 /*****************************************************************************/
 
-void Mrk_AddMarksToDB (long FilCod,struct MarksProperties *Marks);
+void Mrk_AddMarksToDB (long FilCod,const char *Path,struct MarksProperties *Marks);
 void Mrk_GetAndWriteNumRowsHeaderAndFooter (Brw_FileType_t FileType,const char *PathInTree,const char *FileName);
 void Mrk_ChangeNumRowsHeader (void);
 void Mrk_ChangeNumRowsFooter (void);
@@ -35,6 +35,7 @@
 #include "swad_config.h"
 #include "swad_course.h"
 #include "swad_database.h"
+#include "swad_figure_cache.h"
 #include "swad_forum.h"
 #include "swad_global.h"
 #include "swad_group.h"
@@ -70,6 +71,15 @@ extern struct Globals Gbl;
 /******************************** Private types ******************************/
 /*****************************************************************************/
 
+struct Msg_Recipient
+  {
+   long UsrCod;
+   char FullName[(Usr_MAX_BYTES_NAME+1)*3];
+   bool HasBannedMe;
+   bool CreateNotif;
+   bool NotifyByEmail;
+  };
+
 /*****************************************************************************/
 /**************************** Internal prototypes ****************************/
 /*****************************************************************************/
@@ -115,7 +125,14 @@ static long Msg_InsertNewMsg (const char *Subject,const char *Content,
 
 static unsigned long Msg_DelSomeRecOrSntMsgsUsr (Msg_TypeOfMessages_t TypeOfMessages,long UsrCod,
                                                  long FilterCrsCod,const char *FilterFromToSubquery);
-static void Msg_InsertReceivedMsgIntoDB (long MsgCod,long UsrCod,bool NotifyByEmail);
+static unsigned Msg_GetRecipients (unsigned MaxRecipients,
+                                   struct Msg_Recipient *Recipients);
+static void Msg_InsertReceivedMsgsIntoDB (long MsgCod,
+                                          unsigned NumRecipients,
+                                          const struct Msg_Recipient *Recipients);
+static void Msg_StoreNotifyEventsToRecipients (long MsgCod,
+                                               unsigned NumRecipients,
+                                               const struct Msg_Recipient *Recipients);
 static void Msg_SetReceivedMsgAsReplied (long MsgCod);
 static void Msg_MoveReceivedMsgToDeleted (long MsgCod,long UsrCod);
 static void Msg_MoveSentMsgToDeleted (long MsgCod);
@@ -616,19 +633,18 @@ void Msg_RecMsgFromUsr (void)
    extern const char *Txt_There_have_been_X_errors_in_sending_the_message;
    char YN[1+1];
    bool IsReply;
-   bool RecipientHasBannedMe;
    bool Replied = false;
    long OriginalMsgCod = -1L;	// Initialized to avoid warning
-   const char *Ptr;
    unsigned NumRecipients;
+   unsigned NumRecipientsSelected;
+   unsigned NumRecipientsFound;
+   unsigned NumRecipient;
    unsigned NumRecipientsToBeNotifiedByEMail = 0;
-   struct UsrData UsrDstData;
+   struct Msg_Recipient *Recipients;
+   struct Msg_Recipient *Recipient;
    int NumErrors = 0;
    char *ListUsrsDst;
    long NewMsgCod = -1L;	// Initiliazed to avoid warning
-   bool MsgAlreadyInserted = false;
-   bool CreateNotif;
-   bool NotifyByEmail;
    char Content[Cns_MAX_BYTES_LONG_TEXT+1];
    struct Image Image;
    bool Error = false;
@@ -691,9 +707,6 @@ void Msg_RecMsgFromUsr (void)
       Lay_ShowErrorAndExit ("Not enough memory to store e-mail addresses of recipients.");
    ListUsrsDst[0] = '\0';
 
-   /***** Initialize structure with user's data *****/
-   Usr_UsrDataConstructor (&UsrDstData);
-
    /***** Initialize image *****/
    Img_ImageConstructor (&Image);
 
@@ -703,85 +716,82 @@ void Msg_RecMsgFromUsr (void)
    Image.Quality = Msg_IMAGE_SAVED_QUALITY;
    Img_GetImageFromForm (-1,&Image,NULL);
 
-   /***** Loop over the list Gbl.Usrs.Select.All, that holds the list of the
-	  recipients, creating a received message for each recipient *****/
-   Str_ChangeFormat (Str_FROM_FORM,Str_TO_RIGOROUS_HTML,
-                     Content,Cns_MAX_BYTES_LONG_TEXT,false);
-   Ptr = Gbl.Usrs.Select.All;
-   NumRecipients = 0;
+   /***** Get data of all the recipients in Gbl.Usrs.Select.All at once *****/
+   if ((Recipients = (struct Msg_Recipient *) malloc (NumRecipients * sizeof (struct Msg_Recipient))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store recipients.");
+   NumRecipientsSelected = NumRecipients;
+   NumRecipientsFound = Msg_GetRecipients (NumRecipientsSelected,Recipients);
+   if (NumRecipientsFound < NumRecipientsSelected)
+     {
+      Lay_ShowAlert (Lay_ERROR,Txt_Error_getting_data_from_a_recipient);
+      NumErrors = (int) (NumRecipientsSelected - NumRecipientsFound);
+     }
 
-   while (*Ptr)
+   /***** Check which recipients have banned me
+          and which ones must be notified *****/
+   for (NumRecipient = 0, NumRecipients = 0;
+	NumRecipient < NumRecipientsFound;
+	NumRecipient++)
      {
-      Par_GetNextStrUntilSeparParamMult (&Ptr,UsrDstData.EncryptedUsrCod,Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64);
-      Usr_GetUsrCodFromEncryptedUsrCod (&UsrDstData);
-      if (Usr_ChkUsrCodAndGetAllUsrDataFromUsrCod (&UsrDstData))		// Get recipient's data from the database
-        {
-         /***** Check if recipient has banned me *****/
-         RecipientHasBannedMe = Msg_CheckIfUsrIsBanned (Gbl.Usrs.Me.UsrDat.UsrCod,UsrDstData.UsrCod);
+      Recipient = &Recipients[NumRecipient];
+      if (Recipient->HasBannedMe)
+	{
+         /***** Show an alert indicating that the message has not been sent successfully *****/
+         sprintf (Gbl.Message,Txt_message_not_sent_to_X,Recipient->FullName);
+         Lay_ShowAlert (Lay_WARNING,Gbl.Message);
+	}
+      else
+	{
+         /***** If this recipient is the original sender of a message been replied, set Replied to true *****/
+         if (IsReply &&
+             Recipient->UsrCod == Gbl.Usrs.Other.UsrDat.UsrCod)
+            Replied = true;
 
-         if (RecipientHasBannedMe)
-           {
-            /***** Show an alert indicating that the message has not been sent successfully *****/
-            sprintf (Gbl.Message,Txt_message_not_sent_to_X,UsrDstData.FullName);
-            Lay_ShowAlert (Lay_WARNING,Gbl.Message);
-           }
-         else
-           {
-            /***** Create message *****/
-            if (!MsgAlreadyInserted)
-              {
-               // The message is inserted only once in the table of messages sent
-               NewMsgCod = Msg_InsertNewMsg (Gbl.Msg.Subject,Content,&Image);
-               MsgAlreadyInserted = true;
-              }
+         /***** Increment number of recipients *****/
+         if (Recipient->NotifyByEmail)
+            NumRecipientsToBeNotifiedByEMail++;
 
-            /***** If this recipient is the original sender of a message been replied, set Replied to true *****/
-            Replied = (IsReply &&
-        	       UsrDstData.UsrCod == Gbl.Usrs.Other.UsrDat.UsrCod);
-
-            /***** This received message must be notified by e-mail? *****/
-            CreateNotif = (UsrDstData.Prefs.NotifNtfEvents & (1 << Ntf_EVENT_MESSAGE));
-            NotifyByEmail = CreateNotif &&
-        	            (UsrDstData.UsrCod != Gbl.Usrs.Me.UsrDat.UsrCod) &&
-                            (UsrDstData.Prefs.EmailNtfEvents & (1 << Ntf_EVENT_MESSAGE));
-
-            /***** Create the received message for this recipient
-                   and ncrement number of new messages received by this recipient *****/
-            Msg_InsertReceivedMsgIntoDB (NewMsgCod,UsrDstData.UsrCod,NotifyByEmail);
-
-            /***** Create notification for this recipient.
-                   If this recipient wants to receive notifications by e-mail, activate the sending of a notification *****/
-            if (CreateNotif)
-               Ntf_StoreNotifyEventToOneUser (Ntf_EVENT_MESSAGE,&UsrDstData,NewMsgCod,
-                                              (Ntf_Status_t) (NotifyByEmail ? Ntf_STATUS_BIT_EMAIL :
-                                        	                              0));
-
-            /***** Show an alert indicating that the message has been sent successfully *****/
-            sprintf (Gbl.Message,NotifyByEmail ? Txt_message_sent_to_X_notified_by_e_mail :
-                                                 Txt_message_sent_to_X_not_notified_by_e_mail,
-                     UsrDstData.FullName);
-            Lay_ShowAlert (Lay_SUCCESS,Gbl.Message);
-
-            /***** Increment number of recipients *****/
-            if (NotifyByEmail)
-               NumRecipientsToBeNotifiedByEMail++;
-            NumRecipients++;
-           }
-        }
-      else
-        {
-         Lay_ShowAlert (Lay_ERROR,Txt_Error_getting_data_from_a_recipient);
-         NumErrors++;
-        }
+         /***** Move this recipient to the list of recipients to be sent the message *****/
+         Recipients[NumRecipients++] = *Recipient;
+	}
+     }
+
+   if (NumRecipients)
+     {
+      /***** Create message *****/
+      // The message is inserted only once in the table of messages sent
+      Str_ChangeFormat (Str_FROM_FORM,Str_TO_RIGOROUS_HTML,
+                        Content,Cns_MAX_BYTES_LONG_TEXT,false);
+      NewMsgCod = Msg_InsertNewMsg (Gbl.Msg.Subject,Content,&Image);
+
+      /***** Create the received message for all the recipients at once *****/
+      Msg_InsertReceivedMsgsIntoDB (NewMsgCod,NumRecipients,Recipients);
+
+      /***** Create notifications for all the recipients who want them.
+             If a recipient wants to receive notifications by e-mail,
+             activate the sending of a notification *****/
+      Msg_StoreNotifyEventsToRecipients (NewMsgCod,NumRecipients,Recipients);
+
+      /***** Show an alert for each recipient indicating that the message has been sent successfully *****/
+      for (NumRecipient = 0;
+	   NumRecipient < NumRecipients;
+	   NumRecipient++)
+	{
+	 Recipient = &Recipients[NumRecipient];
+         sprintf (Gbl.Message,Recipient->NotifyByEmail ? Txt_message_sent_to_X_notified_by_e_mail :
+                                                         Txt_message_sent_to_X_not_notified_by_e_mail,
+                  Recipient->FullName);
+         Lay_ShowAlert (Lay_SUCCESS,Gbl.Message);
+	}
      }
 
    /***** Free image *****/
    Img_ImageDestructor (&Image);
 
-   /***** Free memory used for user's data *****/
-   Usr_UsrDataDestructor (&UsrDstData);
-
    /***** Free memory *****/
+   /* Free memory used for list of recipients */
+   free ((void *) Recipients);
+
    /* Free memory used for list of recipients' names */
    free (ListUsrsDst);
 
@@ -1388,21 +1398,169 @@ void Msg_DelAllRecAndSntMsgsUsr (long UsrCod)
   }
 
 /*****************************************************************************/
-/**** Insert a message y su destinatario in the table of messages received ***/
+/******* Get data of all the recipients in Gbl.Usrs.Select.All at once *******/
 /*****************************************************************************/
+// Return the number of recipients found in database
 
-static void Msg_InsertReceivedMsgIntoDB (long MsgCod,long UsrCod,bool NotifyByEmail)
+static unsigned Msg_GetRecipients (unsigned MaxRecipients,
+                                   struct Msg_Recipient *Recipients)
   {
-   char Query[512];
+   char *Query;
+   size_t Length;
+   const char *Ptr;
+   char EncryptedUsrCod[Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+1];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned long NumRows;
+   unsigned NumRecipients = 0;
+   unsigned NotifyEventMask = (1 << Ntf_EVENT_MESSAGE);
+   struct UsrData UsrDat;
+   struct Msg_Recipient *Recipient;
 
-   /***** Insert message received in the database *****/
-   sprintf (Query,"INSERT INTO msg_rcv"
-	          " (MsgCod,UsrCod,Notified,Open,Replied,Expanded)"
-                  " VALUES ('%ld','%ld','%c','N','N','N')",
-            MsgCod,UsrCod,
-            NotifyByEmail ? 'Y' :
-        	            'N');
+   /***** Allocate space for query *****/
+   if ((Query = (char *) malloc (1024 + MaxRecipients * (Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+3))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store database query.");
+
+   /***** Get names and preferences of the recipients,
+          and whether they have banned me, from database *****/
+   Length = sprintf (Query,"SELECT UsrCod,FirstName,Surname1,Surname2,"
+	                   "NotifNtfEvents,EmailNtfEvents,"
+	                   "(SELECT COUNT(*) FROM msg_banned"
+	                   " WHERE msg_banned.FromUsrCod='%ld'"
+	                   " AND msg_banned.ToUsrCod=usr_data.UsrCod)"
+	                   " FROM usr_data"
+	                   " WHERE EncryptedUsrCod IN (''",
+                     Gbl.Usrs.Me.UsrDat.UsrCod);
+   Ptr = Gbl.Usrs.Select.All;
+   while (*Ptr)
+     {
+      Par_GetNextStrUntilSeparParamMult (&Ptr,EncryptedUsrCod,Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64);
+      Length += sprintf (&Query[Length],",'%s'",EncryptedUsrCod);
+     }
+   strcpy (&Query[Length],") ORDER BY Surname1,Surname2,FirstName,UsrCod");
+   NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get data of recipients");
+
+   /***** Free space used for query *****/
+   free ((void *) Query);
+
+   /***** Get data of each recipient *****/
+   for (NumRecipients = 0;
+	NumRecipients < (unsigned) NumRows &&
+	NumRecipients < MaxRecipients;
+	NumRecipients++)
+     {
+      row = mysql_fetch_row (mysql_res);
+      Recipient = &Recipients[NumRecipients];
+
+      /* Get user's code (row[0]) */
+      Recipient->UsrCod = Str_ConvertStrCodToLongCod (row[0]);
+
+      /* Get full name (row[1], row[2], row[3]) */
+      strncpy (UsrDat.FirstName,row[1],Usr_MAX_BYTES_NAME);
+      UsrDat.FirstName[Usr_MAX_BYTES_NAME] = '\0';
+      strncpy (UsrDat.Surname1 ,row[2],Usr_MAX_BYTES_NAME);
+      UsrDat.Surname1[Usr_MAX_BYTES_NAME] = '\0';
+      strncpy (UsrDat.Surname2 ,row[3],Usr_MAX_BYTES_NAME);
+      UsrDat.Surname2[Usr_MAX_BYTES_NAME] = '\0';
+      Usr_BuildFullName (&UsrDat);
+      strcpy (Recipient->FullName,UsrDat.FullName);
+
+      /* Get preferences about notifications (row[4], row[5]) */
+      if (sscanf (row[4],"%u",&UsrDat.Prefs.NotifNtfEvents) != 1)
+         UsrDat.Prefs.NotifNtfEvents = (unsigned) -1;	// 0xFF..FF
+      if (sscanf (row[5],"%u",&UsrDat.Prefs.EmailNtfEvents) != 1)
+         UsrDat.Prefs.EmailNtfEvents = 0;
+      if (UsrDat.Prefs.EmailNtfEvents >= (1 << Ntf_NUM_NOTIFY_EVENTS))	// Maximum binary value for NotifyEvents is 000...0011...11
+         UsrDat.Prefs.EmailNtfEvents = 0;
+
+      /* Get if this recipient has banned me (row[6]) */
+      Recipient->HasBannedMe = strcmp (row[6],"0");
+
+      /* This received message must be notified by e-mail? */
+      Recipient->CreateNotif = (UsrDat.Prefs.NotifNtfEvents & NotifyEventMask);
+      Recipient->NotifyByEmail = Recipient->CreateNotif &&
+                                 (Recipient->UsrCod != Gbl.Usrs.Me.UsrDat.UsrCod) &&
+                                 (UsrDat.Prefs.EmailNtfEvents & NotifyEventMask);
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   return NumRecipients;
+  }
+
+/*****************************************************************************/
+/*** Insert a message and its recipients in the table of messages received ***/
+/*****************************************************************************/
+
+static void Msg_InsertReceivedMsgsIntoDB (long MsgCod,
+                                          unsigned NumRecipients,
+                                          const struct Msg_Recipient *Recipients)
+  {
+   char *Query;
+   size_t Length;
+   unsigned NumRecipient;
+
+   /***** Allocate space for query *****/
+   if ((Query = (char *) malloc (256 + NumRecipients * 64)) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store database query.");
+
+   /***** Insert messages received in the database *****/
+   Length = sprintf (Query,"INSERT INTO msg_rcv"
+	                   " (MsgCod,UsrCod,Notified,Open,Replied,Expanded)"
+                           " VALUES ");
+   for (NumRecipient = 0;
+	NumRecipient < NumRecipients;
+	NumRecipient++)
+      Length += sprintf (&Query[Length],"%s('%ld','%ld','%c','N','N','N')",
+                         NumRecipient ? "," :
+                                        "",
+                         MsgCod,Recipients[NumRecipient].UsrCod,
+                         Recipients[NumRecipient].NotifyByEmail ? 'Y' :
+        	                                                  'N');
    DB_QueryINSERT (Query,"can not create received message");
+
+   /***** Free space used for query *****/
+   free ((void *) Query);
+  }
+
+/*****************************************************************************/
+/********** Create notifications of a new message to its recipients **********/
+/*****************************************************************************/
+
+static void Msg_StoreNotifyEventsToRecipients (long MsgCod,
+                                               unsigned NumRecipients,
+                                               const struct Msg_Recipient *Recipients)
+  {
+   long *LstUsrCods;
+   Ntf_Status_t *LstStatus;
+   unsigned NumRecipient;
+   unsigned NumUsrsToNotify = 0;
+
+   /***** Allocate lists of users to be notified *****/
+   if ((LstUsrCods = (long *) malloc (NumRecipients * sizeof (long))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store list of users.");
+   if ((LstStatus = (Ntf_Status_t *) malloc (NumRecipients * sizeof (Ntf_Status_t))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store list of users.");
+
+   /***** Get the recipients who want to be notified *****/
+   for (NumRecipient = 0;
+	NumRecipient < NumRecipients;
+	NumRecipient++)
+      if (Recipients[NumRecipient].CreateNotif)
+	{
+	 LstUsrCods[NumUsrsToNotify] = Recipients[NumRecipient].UsrCod;
+	 LstStatus[NumUsrsToNotify] = (Ntf_Status_t) (Recipients[NumRecipient].NotifyByEmail ? Ntf_STATUS_BIT_EMAIL :
+	                                                                                        0);
+	 NumUsrsToNotify++;
+	}
+
+   /***** Store notifications for all of them at once *****/
+   Ntf_StoreNotifyEventToUsrs (Ntf_EVENT_MESSAGE,NumUsrsToNotify,LstUsrCods,LstStatus,MsgCod);
+
+   /***** Free lists of users *****/
+   free ((void *) LstStatus);
+   free ((void *) LstUsrCods);
   }
 
 /*****************************************************************************/
@@ -1977,6 +2135,16 @@ unsigned Msg_GetNumMsgsSent (Sco_Scope_t Scope,Msg_Status_t MsgStatus)
   {
    const char *Table = "msg_snt";
    char Query[1024];
+   FigCch_Figure_t Figure;
+   long Cod;
+   unsigned NumMsgs;
+
+   /***** Get the number of messages sent from cache *****/
+   Figure = (MsgStatus == Msg_STATUS_DELETED) ? FigCch_NUM_MSGS_SENT_DELETED :
+	                                        FigCch_NUM_MSGS_SENT;
+   Cod = Sco_GetCodOfScope (Scope);
+   if (FigCch_GetFigureFromCache (Figure,Scope,Cod,&NumMsgs))
+      return NumMsgs;
 
    /***** Get the number of messages sent from this location
           (all the platform, current degree or current course) from database *****/
@@ -2049,7 +2217,12 @@ unsigned Msg_GetNumMsgsSent (Sco_Scope_t Scope,Msg_Status_t MsgStatus)
 	 Lay_ShowErrorAndExit ("Wrong scope.");
 	 break;
      }
-   return (unsigned) DB_QueryCOUNT (Query,"can not get number of sent messages");
+   NumMsgs = (unsigned) DB_QueryCOUNT (Query,"can not get number of sent messages");
+
+   /***** Update the number of messages sent in cache *****/
+   FigCch_UpdateFigureIntoCache (Figure,Scope,Cod,NumMsgs);
+
+   return NumMsgs;
   }
 
 /*****************************************************************************/
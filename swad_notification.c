@@ -274,9 +274,14 @@ static void Ntf_UpdateNumNotifSent (long DegCod,long CrsCod,
                                     Ntf_NotifyEvent_t NotifyEvent,
                                     unsigned NumEvents,unsigned NumMails);
 
+static void Ntf_GetLocationOfNotifyEvent (Ntf_NotifyEvent_t NotifyEvent,
+                                          long *InsCod,long *CtrCod,
+                                          long *DegCod,long *CrsCod);
+
 static void Ntf_GetParamsNotifyEvents (void);
-static unsigned Ntf_GetNumberOfAllMyUnseenNtfs (void);
-static unsigned Ntf_GetNumberOfMyNewUnseenNtfs (void);
+static void Ntf_GetMyNumUnseenNtfs (unsigned *NumUnseenNtfs,unsigned *NumNewNtfs);
+static bool Ntf_GetMyStoredNumUnseenNtfs (unsigned *NumUnseenNtfs,unsigned *NumNewNtfs);
+static void Ntf_RemoveNumUnseenNtfsOfUsrsNotified (const char *NotifCondition);
 
 /*****************************************************************************/
 /*************************** Show my notifications ***************************/
@@ -954,6 +959,9 @@ void Ntf_MarkNotifAsSeen (Ntf_NotifyEvent_t NotifyEvent,long Cod,long CrsCod,lon
                   (unsigned) Ntf_STATUS_BIT_READ,
                   ToUsrCod,(unsigned) NotifyEvent);
       DB_QueryUPDATE (Query,"can not set notification(s) as seen");
+
+      /***** Number of unseen notifications of the user must be computed again *****/
+      Ntf_RemoveNumUnseenNtfsOfUsr (ToUsrCod);
      }
   }
 
@@ -964,6 +972,7 @@ void Ntf_MarkNotifAsSeen (Ntf_NotifyEvent_t NotifyEvent,long Cod,long CrsCod,lon
 void Ntf_MarkNotifAsRemoved (Ntf_NotifyEvent_t NotifyEvent,long Cod)
   {
    char Query[512];
+   char NotifCondition[128];
 
    /***** Set notification as removed *****/
    sprintf (Query,"UPDATE notif SET Status=(Status | %u)"
@@ -971,6 +980,11 @@ void Ntf_MarkNotifAsRemoved (Ntf_NotifyEvent_t NotifyEvent,long Cod)
             (unsigned) Ntf_STATUS_BIT_REMOVED,
             (unsigned) NotifyEvent,Cod);
    DB_QueryUPDATE (Query,"can not set notification(s) as removed");
+
+   /***** Number of unseen notifications of affected users must be computed again *****/
+   sprintf (NotifCondition,"NotifyEvent='%u' AND Cod='%ld'",
+            (unsigned) NotifyEvent,Cod);
+   Ntf_RemoveNumUnseenNtfsOfUsrsNotified (NotifCondition);
   }
 
 /*****************************************************************************/
@@ -993,6 +1007,9 @@ void Ntf_MarkNotifToOneUsrAsRemoved (Ntf_NotifyEvent_t NotifyEvent,long Cod,long
 	       (unsigned) Ntf_STATUS_BIT_REMOVED,
 	       ToUsrCod,(unsigned) NotifyEvent,Gbl.CurrentCrs.Crs.CrsCod);
    DB_QueryUPDATE (Query,"can not set notification(s) as removed");
+
+   /***** Number of unseen notifications of the user must be computed again *****/
+   Ntf_RemoveNumUnseenNtfsOfUsr (ToUsrCod);
   }
 
 /*****************************************************************************/
@@ -1006,20 +1023,30 @@ void Ntf_MarkNotifToOneUsrAsRemoved (Ntf_NotifyEvent_t NotifyEvent,long Cod,long
 void Ntf_MarkNotifInCrsAsRemoved (long CrsCod,long ToUsrCod)
   {
    char Query[512];
+   char NotifCondition[128];
 
    /***** Set all notifications from the course as removed,
           except notifications about new messages *****/
    if (ToUsrCod > 0)	// If the user code is specified
+     {
       sprintf (Query,"UPDATE notif SET Status=(Status | %u)"
 		     " WHERE ToUsrCod='%ld' AND CrsCod='%ld' AND NotifyEvent<>'%u'",
 	       (unsigned) Ntf_STATUS_BIT_REMOVED,
 	       ToUsrCod,CrsCod,(unsigned) Ntf_EVENT_MESSAGE);
+      DB_QueryUPDATE (Query,"can not set notification(s) as removed");
+      Ntf_RemoveNumUnseenNtfsOfUsr (ToUsrCod);
+     }
    else
+     {
       sprintf (Query,"UPDATE notif SET Status=(Status | %u)"
 		     " WHERE CrsCod='%ld' AND NotifyEvent<>'%u'",
 	       (unsigned) Ntf_STATUS_BIT_REMOVED,
 	       CrsCod,(unsigned) Ntf_EVENT_MESSAGE);
-   DB_QueryUPDATE (Query,"can not set notification(s) as removed");
+      DB_QueryUPDATE (Query,"can not set notification(s) as removed");
+      sprintf (NotifCondition,"CrsCod='%ld' AND NotifyEvent<>'%u'",
+	       CrsCod,(unsigned) Ntf_EVENT_MESSAGE);
+      Ntf_RemoveNumUnseenNtfsOfUsrsNotified (NotifCondition);
+     }
   }
 
 /*****************************************************************************/
@@ -1086,7 +1113,8 @@ void Ntf_MarkNotifChildrenOfFolderAsRemoved (const char *Path)
    extern const Brw_FileBrowser_t Brw_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
    Brw_FileBrowser_t FileBrowser = Brw_FileBrowserForDB_files[Gbl.FileBrowser.Type];
    long Cod = Brw_GetCodForFiles ();
-   char Query[512];
+   char Query[512+PATH_MAX];
+   char NotifCondition[256+PATH_MAX];
    Ntf_NotifyEvent_t NotifyEvent;
 
    switch (FileBrowser)
@@ -1121,16 +1149,19 @@ void Ntf_MarkNotifChildrenOfFolderAsRemoved (const char *Path)
 	    default:
 	       return;
 	   }
-	 sprintf (Query,"UPDATE notif SET Status=(Status | %u)"
-	                " WHERE NotifyEvent='%u' AND Cod IN"
-	                " (SELECT FilCod FROM files"
-			" WHERE FileBrowser='%u' AND Cod='%ld'"
-			" AND Path LIKE '%s/%%')",
-	          (unsigned) Ntf_STATUS_BIT_REMOVED,
+	 sprintf (NotifCondition,"NotifyEvent='%u' AND Cod IN"
+	                         " (SELECT FilCod FROM files"
+			         " WHERE FileBrowser='%u' AND Cod='%ld'"
+			         " AND Path LIKE '%s/%%')",
 	          (unsigned) NotifyEvent,
 	          (unsigned) FileBrowser,Cod,
 	          Path);
+	 sprintf (Query,"UPDATE notif SET Status=(Status | %u)"
+	                " WHERE %s",
+	          (unsigned) Ntf_STATUS_BIT_REMOVED,
+	          NotifCondition);
          DB_QueryUPDATE (Query,"can not set notification(s) as removed");
+	 Ntf_RemoveNumUnseenNtfsOfUsrsNotified (NotifCondition);
          break;
       default:
 	 break;
@@ -1144,13 +1175,12 @@ void Ntf_MarkNotifChildrenOfFolderAsRemoved (const char *Path)
 void Ntf_MarkNotifFilesInGroupAsRemoved (long GrpCod)
   {
    char Query[512];
+   char NotifCondition[256];
 
    /***** Set notifications as removed *****/
-   sprintf (Query,"UPDATE notif SET Status=(Status | %u)"
-                  " WHERE NotifyEvent IN ('%u','%u','%u','%u') AND Cod IN"
-                  " (SELECT FilCod FROM files"
-                  " WHERE FileBrowser IN ('%u','%u','%u','%u') AND Cod='%ld')",
-            (unsigned) Ntf_STATUS_BIT_REMOVED,
+   sprintf (NotifCondition,"NotifyEvent IN ('%u','%u','%u','%u') AND Cod IN"
+                           " (SELECT FilCod FROM files"
+                           " WHERE FileBrowser IN ('%u','%u','%u','%u') AND Cod='%ld')",
             (unsigned) Ntf_EVENT_DOCUMENT_FILE,
             (unsigned) Ntf_EVENT_TEACHERS_FILE,
             (unsigned) Ntf_EVENT_SHARED_FILE,
@@ -1160,7 +1190,14 @@ void Ntf_MarkNotifFilesInGroupAsRemoved (long GrpCod)
             (unsigned) Brw_ADMI_SHARE_GRP,
             (unsigned) Brw_ADMI_MARKS_GRP,
             GrpCod);
+   sprintf (Query,"UPDATE notif SET Status=(Status | %u)"
+                  " WHERE %s",
+            (unsigned) Ntf_STATUS_BIT_REMOVED,
+            NotifCondition);
    DB_QueryUPDATE (Query,"can not set notification(s) as removed");
+
+   /***** Number of unseen notifications of affected users must be computed again *****/
+   Ntf_RemoveNumUnseenNtfsOfUsrsNotified (NotifCondition);
   }
 
 /*****************************************************************************/
@@ -1172,16 +1209,17 @@ void Ntf_MarkNotifFilesInGroupAsRemoved (long GrpCod)
 unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
   {
    extern const char *Sco_ScopeDB[Sco_NUM_SCOPES];
-   char Query[1024];
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row;
-   unsigned long NumRow;
-   unsigned long NumRows;
-   struct UsrData UsrDat;
-   unsigned NumUsrsToBeNotifiedByEMail = 0;
+   char SubQuery[1024];
+   char Query[2048];
+   char NotifCondition[128];
+   long InsCod;
+   long CtrCod;
+   long DegCod;
+   long CrsCod;
+   unsigned NumUsrsToBeNotifiedByEMail;
    unsigned NotifyEventMask = (1 << NotifyEvent);
 
-   /***** Get users who want to be notified from database ******/
+   /***** Build subquery to get users to be notified ******/
    switch (NotifyEvent)
      {
       case Ntf_EVENT_UNKNOWN:	// This function should not be called in this case
@@ -1195,14 +1233,14 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
             case Brw_ADMI_DOCUM_CRS:
             case Brw_ADMI_SHARE_CRS:
             case Brw_ADMI_MARKS_CRS:	// Notify all users in course except me
-               sprintf (Query,"SELECT UsrCod FROM crs_usr"
+               sprintf (SubQuery,"SELECT UsrCod FROM crs_usr"
                               " WHERE CrsCod='%ld'"
                               " AND UsrCod<>'%ld'",
                         Gbl.CurrentCrs.Crs.CrsCod,
                         Gbl.Usrs.Me.UsrDat.UsrCod);
                break;
             case Brw_ADMI_TEACH_CRS:	// Notify all teachers in course except me
-               sprintf (Query,"SELECT UsrCod FROM crs_usr"
+               sprintf (SubQuery,"SELECT UsrCod FROM crs_usr"
                               " WHERE CrsCod='%ld'"
                               " AND UsrCod<>'%ld'"
                               " AND Role='%u'",	// Notify teachers only
@@ -1213,14 +1251,14 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
             case Brw_ADMI_DOCUM_GRP:
             case Brw_ADMI_SHARE_GRP:
             case Brw_ADMI_MARKS_GRP:	// Notify all users in group except me
-               sprintf (Query,"SELECT UsrCod FROM crs_grp_usr"
+               sprintf (SubQuery,"SELECT UsrCod FROM crs_grp_usr"
                               " WHERE crs_grp_usr.GrpCod='%ld'"
                               " AND crs_grp_usr.UsrCod<>'%ld'",
                         Gbl.CurrentCrs.Grps.GrpCod,
                         Gbl.Usrs.Me.UsrDat.UsrCod);
                break;
             case Brw_ADMI_TEACH_GRP:	// Notify all teachers in group except me
-               sprintf (Query,"SELECT crs_grp_usr.UsrCod"
+               sprintf (SubQuery,"SELECT crs_grp_usr.UsrCod"
         	              " FROM crs_grp_usr,crs_grp,crs_usr"
                               " WHERE crs_grp_usr.GrpCod='%ld'"
                               " AND crs_grp_usr.UsrCod<>'%ld'"
@@ -1239,7 +1277,7 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
          // 1. If the assignment is available for the whole course ==> get all users enrolled in the course except me
          // 2. If the assignment is available only for some groups ==> get all users who belong to any of the groups except me
          // Cases 1 and 2 are mutually exclusive, so the union returns the case 1 or 2
-         sprintf (Query,"(SELECT crs_usr.UsrCod"
+         sprintf (SubQuery,"(SELECT crs_usr.UsrCod"
                         " FROM assignments,crs_usr"
                         " WHERE assignments.AsgCod='%ld'"
                         " AND assignments.AsgCod NOT IN"
@@ -1257,7 +1295,7 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
          break;
       case Ntf_EVENT_EXAM_ANNOUNCEMENT:
       case Ntf_EVENT_NOTICE:
-         sprintf (Query,"SELECT UsrCod FROM crs_usr"
+         sprintf (SubQuery,"SELECT UsrCod FROM crs_usr"
                         " WHERE CrsCod='%ld' AND UsrCod<>'%ld'",
                   Gbl.CurrentCrs.Crs.CrsCod,
                   Gbl.Usrs.Me.UsrDat.UsrCod);
@@ -1268,7 +1306,7 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
       case Ntf_EVENT_ENROLLMENT_REQUEST:
 	 if (Gbl.CurrentCrs.Crs.NumTchs)
 	    // If this course has teachers ==> send notification to teachers
-	    sprintf (Query,"SELECT UsrCod FROM crs_usr"
+	    sprintf (SubQuery,"SELECT UsrCod FROM crs_usr"
 			   " WHERE CrsCod='%ld'"
 			   " AND UsrCod<>'%ld'"
 			   " AND Role='%u'",	// Notify teachers only
@@ -1280,7 +1318,7 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
 	    // and I want to be a teacher (checked before calling this function
 	    // to not send requests to be a student to admins)
 	    // ==> send notification to administrators or superusers
-	    sprintf (Query,"SELECT UsrCod FROM admin"
+	    sprintf (SubQuery,"SELECT UsrCod FROM admin"
 	 		   " WHERE (Scope='%s'"
 	 		   " OR (Scope='%s' AND Cod='%ld')"
 	 		   " OR (Scope='%s' AND Cod='%ld')"
@@ -1294,7 +1332,7 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
          break;
       case Ntf_EVENT_TIMELINE_COMMENT:	// New comment to one of my social notes or comments
          // Cod is the code of the social publishing
-	 sprintf (Query,"SELECT DISTINCT(PublisherCod) FROM social_pubs"
+	 sprintf (SubQuery,"SELECT DISTINCT(PublisherCod) FROM social_pubs"
                         " WHERE NotCod = (SELECT NotCod FROM social_pubs"
                         " WHERE PubCod='%ld')"
                         " AND PublisherCod<>'%ld'",
@@ -1311,13 +1349,13 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
 	 switch (For_GetForumTypeOfAPost (Cod))
 	   {
 	    case For_FORUM_COURSE_USRS:
-	       sprintf (Query,"SELECT UsrCod FROM crs_usr"
+	       sprintf (SubQuery,"SELECT UsrCod FROM crs_usr"
 			      " WHERE CrsCod='%ld' AND UsrCod<>'%ld'",
 			Gbl.CurrentCrs.Crs.CrsCod,
 			Gbl.Usrs.Me.UsrDat.UsrCod);
 	       break;
 	    case For_FORUM_COURSE_TCHS:
-	       sprintf (Query,"SELECT UsrCod FROM crs_usr"
+	       sprintf (SubQuery,"SELECT UsrCod FROM crs_usr"
 			      " WHERE CrsCod='%ld' AND Role='%u' AND UsrCod<>'%ld'",
 			Gbl.CurrentCrs.Crs.CrsCod,
 			(unsigned) Rol_TEACHER,
@@ -1328,7 +1366,7 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
 	   }
          break;
       case Ntf_EVENT_FORUM_REPLY:
-         sprintf (Query,"SELECT DISTINCT(UsrCod) FROM forum_post"
+         sprintf (SubQuery,"SELECT DISTINCT(UsrCod) FROM forum_post"
                         " WHERE ThrCod = (SELECT ThrCod FROM forum_post"
                         " WHERE PstCod='%ld')"
                         " AND UsrCod<>'%ld'",
@@ -1340,7 +1378,7 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
          // 1. If the survey is available for the whole course ==> get users enrolled in the course whose role is available in survey, except me
          // 2. If the survey is available only for some groups ==> get users who belong to any of the groups and whose role is available in survey, except me
          // Cases 1 and 2 are mutually exclusive, so the union returns the case 1 or 2
-         sprintf (Query,"(SELECT crs_usr.UsrCod"
+         sprintf (SubQuery,"(SELECT crs_usr.UsrCod"
                         " FROM surveys,crs_usr"
                         " WHERE surveys.SvyCod='%ld'"
                         " AND surveys.SvyCod NOT IN"
@@ -1368,42 +1406,60 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
          break;
      }
 
-   if ((NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get users to be notified"))) // Users found
-     {
-      /***** Initialize structure with user's data *****/
-      Usr_UsrDataConstructor (&UsrDat);
-
-      /***** Notify the users one by one *****/
-      for (NumRow = 0;
-	   NumRow < NumRows;
-	   NumRow++)
-	{
-         /* Get next user */
-         row = mysql_fetch_row (mysql_res);
-
-         /* Get user code */
-         UsrDat.UsrCod = Str_ConvertStrCodToLongCod (row[0]);
-
-	 if (Usr_ChkUsrCodAndGetAllUsrDataFromUsrCod (&UsrDat))		// Get user's data from the database
-            if ((UsrDat.Prefs.NotifNtfEvents & NotifyEventMask))	// Create notification
-              {
-	       if ((UsrDat.Prefs.EmailNtfEvents & NotifyEventMask))	// Send notification by email
-		 {
-		  Ntf_StoreNotifyEventToOneUser (NotifyEvent,&UsrDat,Cod,
-						 (Ntf_Status_t) Ntf_STATUS_BIT_EMAIL);
-		  NumUsrsToBeNotifiedByEMail++;
-		 }
-	       else							// Don't send notification by email
-		  Ntf_StoreNotifyEventToOneUser (NotifyEvent,&UsrDat,Cod,(Ntf_Status_t) 0);
-              }
-        }
+   /***** Get location of the event *****/
+   Ntf_GetLocationOfNotifyEvent (NotifyEvent,&InsCod,&CtrCod,&DegCod,&CrsCod);
 
-      /***** Free memory used for user's data *****/
-      Usr_UsrDataDestructor (&UsrDat);
-     }
+   /***** Store notify event for all the users to be notified at once *****/
+   // Preferences of users are checked in the query, not one by one:
+   // - First, notifications to be sent also by email
+   // - Second, notifications not to be sent by email
+   sprintf (Query,"INSERT INTO notif (NotifyEvent,ToUsrCod,FromUsrCod,"
+	          "InsCod,CtrCod,DegCod,CrsCod,"
+	          "Cod,TimeNotif,Status)"
+                  " SELECT '%u',usr_data.UsrCod,'%ld',"
+                  "'%ld','%ld','%ld','%ld',"
+                  "'%ld',NOW(),'%u'"
+                  " FROM usr_data"
+                  " WHERE usr_data.UsrCod IN"
+                  " (SELECT * FROM (%s) AS usrs_to_notify)"
+                  " AND (usr_data.NotifNtfEvents & %u)<>0"
+                  " AND (usr_data.EmailNtfEvents & %u)<>0"
+                  " AND usr_data.EmailNtfEvents<'%u'",
+            (unsigned) NotifyEvent,Gbl.Usrs.Me.UsrDat.UsrCod,
+            InsCod,CtrCod,DegCod,CrsCod,
+            Cod,(unsigned) Ntf_STATUS_BIT_EMAIL,
+            SubQuery,
+            NotifyEventMask,
+            NotifyEventMask,
+            (1 << Ntf_NUM_NOTIFY_EVENTS));
+   NumUsrsToBeNotifiedByEMail = (unsigned) DB_QueryINSERTandReturnNumRows (Query,"can not create new notification events");
 
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
+   sprintf (Query,"INSERT INTO notif (NotifyEvent,ToUsrCod,FromUsrCod,"
+	          "InsCod,CtrCod,DegCod,CrsCod,"
+	          "Cod,TimeNotif,Status)"
+                  " SELECT '%u',usr_data.UsrCod,'%ld',"
+                  "'%ld','%ld','%ld','%ld',"
+                  "'%ld',NOW(),'0'"
+                  " FROM usr_data"
+                  " WHERE usr_data.UsrCod IN"
+                  " (SELECT * FROM (%s) AS usrs_to_notify)"
+                  " AND (usr_data.NotifNtfEvents & %u)<>0"
+                  " AND ((usr_data.EmailNtfEvents & %u)=0"
+                  " OR usr_data.EmailNtfEvents>='%u')",
+            (unsigned) NotifyEvent,Gbl.Usrs.Me.UsrDat.UsrCod,
+            InsCod,CtrCod,DegCod,CrsCod,
+            Cod,
+            SubQuery,
+            NotifyEventMask,
+            NotifyEventMask,
+            (1 << Ntf_NUM_NOTIFY_EVENTS));
+   DB_QueryINSERT (Query,"can not create new notification events");
+
+   /***** Number of unseen notifications of users notified
+          about this event must be computed again *****/
+   sprintf (NotifCondition,"NotifyEvent='%u' AND Cod='%ld'",
+            (unsigned) NotifyEvent,Cod);
+   Ntf_RemoveNumUnseenNtfsOfUsrsNotified (NotifCondition);
 
    return NumUsrsToBeNotifiedByEMail;
   }
@@ -1421,25 +1477,9 @@ void Ntf_StoreNotifyEventToOneUser (Ntf_NotifyEvent_t NotifyEvent,
    long CtrCod;
    long DegCod;
    long CrsCod;
-   // long GrpCod;
 
-   if (NotifyEvent == Ntf_EVENT_FORUM_POST_COURSE ||
-       NotifyEvent == Ntf_EVENT_FORUM_REPLY)
-     {
-      InsCod = Gbl.Forum.Ins.InsCod;
-      CtrCod = Gbl.Forum.Ctr.CtrCod;
-      DegCod = Gbl.Forum.Deg.DegCod;
-      CrsCod = Gbl.Forum.Crs.CrsCod;
-      // GrpCod = -1L;	// There are no forums for a group
-     }
-   else
-     {
-      InsCod = Gbl.CurrentIns.Ins.InsCod;
-      CtrCod = Gbl.CurrentCtr.Ctr.CtrCod;
-      DegCod = Gbl.CurrentDeg.Deg.DegCod;
-      CrsCod = Gbl.CurrentCrs.Crs.CrsCod;
-      // GrpCod = Gbl.CurrentCrs.Grps.GrpCod;
-     }
+   /***** Get location of the event *****/
+   Ntf_GetLocationOfNotifyEvent (NotifyEvent,&InsCod,&CtrCod,&DegCod,&CrsCod);
 
    /***** Store notify event *****/
    sprintf (Query,"INSERT INTO notif (NotifyEvent,ToUsrCod,FromUsrCod,"
@@ -1452,6 +1492,99 @@ void Ntf_StoreNotifyEventToOneUser (Ntf_NotifyEvent_t NotifyEvent,
             InsCod,CtrCod,DegCod,CrsCod,
             Cod,(unsigned) Status);
    DB_QueryINSERT (Query,"can not create new notification event");
+
+   /***** Number of unseen notifications of the user must be computed again *****/
+   Ntf_RemoveNumUnseenNtfsOfUsr (UsrDat->UsrCod);
+  }
+
+/*****************************************************************************/
+/************ Store a notify event to several users into database ************/
+/*****************************************************************************/
+// All the notifications are inserted in one query,
+// and the numbers of unseen notifications are removed in another one.
+// Pending e-mails will be sent later by Ntf_SendPendingNotifByEMailToAllUsrs
+
+void Ntf_StoreNotifyEventToUsrs (Ntf_NotifyEvent_t NotifyEvent,
+                                 unsigned NumUsrs,const long *LstUsrCods,
+                                 const Ntf_Status_t *LstStatus,long Cod)
+  {
+   char *Query;
+   size_t Length;
+   unsigned NumUsr;
+   long InsCod;
+   long CtrCod;
+   long DegCod;
+   long CrsCod;
+
+   if (!NumUsrs)
+      return;
+
+   /***** Get location of the event *****/
+   Ntf_GetLocationOfNotifyEvent (NotifyEvent,&InsCod,&CtrCod,&DegCod,&CrsCod);
+
+   /***** Allocate space for query *****/
+   if ((Query = (char *) malloc (256 + NumUsrs * 256)) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store database query.");
+
+   /***** Store notify event for all the users at once *****/
+   Length = sprintf (Query,"INSERT INTO notif (NotifyEvent,ToUsrCod,FromUsrCod,"
+	                   "InsCod,CtrCod,DegCod,CrsCod,"
+	                   "Cod,TimeNotif,Status)"
+                           " VALUES ");
+   for (NumUsr = 0;
+	NumUsr < NumUsrs;
+	NumUsr++)
+      Length += sprintf (&Query[Length],"%s('%u','%ld','%ld',"
+                                        "'%ld','%ld','%ld','%ld',"
+                                        "'%ld',NOW(),'%u')",
+                         NumUsr ? "," :
+                                  "",
+                         (unsigned) NotifyEvent,LstUsrCods[NumUsr],Gbl.Usrs.Me.UsrDat.UsrCod,
+                         InsCod,CtrCod,DegCod,CrsCod,
+                         Cod,(unsigned) LstStatus[NumUsr]);
+   DB_QueryINSERT (Query,"can not create new notification events");
+
+   /***** Number of unseen notifications of the users must be computed again *****/
+   Length = sprintf (Query,"DELETE FROM notif_unseen WHERE UsrCod IN (");
+   for (NumUsr = 0;
+	NumUsr < NumUsrs;
+	NumUsr++)
+      Length += sprintf (&Query[Length],"%s'%ld'",
+                         NumUsr ? "," :
+                                  "",
+                         LstUsrCods[NumUsr]);
+   strcpy (&Query[Length],")");
+   DB_QueryDELETE (Query,"can not remove number of unseen notifications");
+
+   /***** Free space used for query *****/
+   free ((void *) Query);
+  }
+
+/*****************************************************************************/
+/************ Get institution, centre, degree and course where ***************/
+/************ a notify event happened                          ***************/
+/*****************************************************************************/
+
+static void Ntf_GetLocationOfNotifyEvent (Ntf_NotifyEvent_t NotifyEvent,
+                                          long *InsCod,long *CtrCod,
+                                          long *DegCod,long *CrsCod)
+  {
+   if (NotifyEvent == Ntf_EVENT_FORUM_POST_COURSE ||
+       NotifyEvent == Ntf_EVENT_FORUM_REPLY)
+     {
+      *InsCod = Gbl.Forum.Ins.InsCod;
+      *CtrCod = Gbl.Forum.Ctr.CtrCod;
+      *DegCod = Gbl.Forum.Deg.DegCod;
+      *CrsCod = Gbl.Forum.Crs.CrsCod;
+      // There are no forums for a group
+     }
+   else
+     {
+      *InsCod = Gbl.CurrentIns.Ins.InsCod;
+      *CtrCod = Gbl.CurrentCtr.Ctr.CtrCod;
+      *DegCod = Gbl.CurrentDeg.Deg.DegCod;
+      *CrsCod = Gbl.CurrentCrs.Crs.CrsCod;
+     }
   }
 
 /*****************************************************************************/
@@ -1467,6 +1600,9 @@ static void Ntf_UpdateMyLastAccessToNotifications (void)
 	          " WHERE UsrCod='%ld'",
             Gbl.Usrs.Me.UsrDat.UsrCod);
    DB_QueryUPDATE (Query,"can not update last access to notifications");
+
+   /***** My number of new notifications must be computed again *****/
+   Ntf_RemoveNumUnseenNtfsOfUsr (Gbl.Usrs.Me.UsrDat.UsrCod);
   }
 
 /*****************************************************************************/
@@ -1476,6 +1612,7 @@ static void Ntf_UpdateMyLastAccessToNotifications (void)
 void Ntf_SendPendingNotifByEMailToAllUsrs (void)
   {
    char Query[512];
+   char NotifCondition[128];
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
    unsigned long NumRow,NumRows;
@@ -1528,10 +1665,24 @@ void Ntf_SendPendingNotifByEMailToAllUsrs (void)
    DB_FreeMySQLResult (&mysql_res);
 
    /***** Delete old notifications ******/
-   sprintf (Query,"DELETE LOW_PRIORITY FROM notif"
-                  " WHERE TimeNotif<FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')",
+   // The old notifications are marked as removed before invalidating
+   // the numbers of unseen notifications of their users,
+   // so they are locked until they are deleted
+   sprintf (NotifCondition,"TimeNotif<FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')",
             Cfg_TIME_TO_DELETE_OLD_NOTIF);
+   DB_Query ("START TRANSACTION","can not start transaction");
+   Gbl.DB.OpenTransaction = true;
+   sprintf (Query,"UPDATE notif SET Status=(Status | %u)"
+                  " WHERE %s",
+            (unsigned) Ntf_STATUS_BIT_REMOVED,
+            NotifCondition);
+   DB_QueryUPDATE (Query,"can not set notification(s) as removed");
+   Ntf_RemoveNumUnseenNtfsOfUsrsNotified (NotifCondition);
+   sprintf (Query,"DELETE LOW_PRIORITY FROM notif WHERE %s",
+            NotifCondition);
    DB_QueryDELETE (Query,"can not remove old notifications");
+   DB_Query ("COMMIT","can not commit transaction");
+   Gbl.DB.OpenTransaction = false;
   }
 
 /*****************************************************************************/
@@ -1861,6 +2012,9 @@ void Ntf_MarkAllNotifAsSeen (void)
 	    Gbl.Usrs.Me.UsrDat.UsrCod);
    DB_QueryUPDATE (Query,"can not set notification(s) as seen");
 
+   /***** My number of unseen notifications must be computed again *****/
+   Ntf_RemoveNumUnseenNtfsOfUsr (Gbl.Usrs.Me.UsrDat.UsrCod);
+
    /***** Show my notifications again *****/
    Ntf_ShowMyNotifications ();
   }
@@ -2011,11 +2165,10 @@ void Ntf_WriteNumberOfNewNtfs (void)
    extern const char *Txt_NOTIF_new_SINGULAR;
    extern const char *Txt_NOTIF_new_PLURAL;
    unsigned NumUnseenNtfs;
-   unsigned NumNewNtfs = 0;
+   unsigned NumNewNtfs;
 
    /***** Get my number of unseen notifications *****/
-   if ((NumUnseenNtfs = Ntf_GetNumberOfAllMyUnseenNtfs ()))
-      NumNewNtfs = Ntf_GetNumberOfMyNewUnseenNtfs ();
+   Ntf_GetMyNumUnseenNtfs (&NumUnseenNtfs,&NumNewNtfs);
 
    /***** Start form *****/
    Act_FormStartId (ActSeeNewNtf,"form_ntf");
@@ -2047,36 +2200,139 @@ void Ntf_WriteNumberOfNewNtfs (void)
   }
 
 /*****************************************************************************/
-/************* Get the number of (all) my unseen notifications ***************/
+/*********** Get my number of unseen and new unseen notifications ************/
 /*****************************************************************************/
+// The numbers are read from the table of counters.
+// Any change in the notifications of a user removes the user's counters,
+// so, if my counters are not in the table, they are computed and stored
 
-static unsigned Ntf_GetNumberOfAllMyUnseenNtfs (void)
+static void Ntf_GetMyNumUnseenNtfs (unsigned *NumUnseenNtfs,unsigned *NumNewNtfs)
   {
    char Query[512];
 
-   /***** Get number of places with a name from database *****/
-   sprintf (Query,"SELECT COUNT(*) FROM notif"
-                  " WHERE ToUsrCod='%ld' AND (Status & %u)=0",
-            Gbl.Usrs.Me.UsrDat.UsrCod,(unsigned) (Ntf_STATUS_BIT_READ | Ntf_STATUS_BIT_REMOVED));
-   return DB_QueryCOUNT (Query,"can not get number of unseen notifications");
+   /***** Get my counters from database *****/
+   if (!Ntf_GetMyStoredNumUnseenNtfs (NumUnseenNtfs,NumNewNtfs))
+     {
+      /***** Compute my counters and store them in one transaction *****/
+      // INSERT ... SELECT locks the notifications it reads,
+      // so a concurrent change in my notifications waits until
+      // my counters are stored, and then removes them again
+      DB_Query ("START TRANSACTION","can not start transaction");
+      Gbl.DB.OpenTransaction = true;
+      sprintf (Query,"REPLACE INTO notif_unseen (UsrCod,NumUnseen,NumNew)"
+                     " SELECT '%ld',COUNT(*),"
+                     "COALESCE(SUM(TimeNotif>"
+                     "(SELECT LastAccNotif FROM usr_last WHERE UsrCod='%ld')),0)"
+                     " FROM notif"
+                     " WHERE ToUsrCod='%ld' AND (Status & %u)=0",
+	       Gbl.Usrs.Me.UsrDat.UsrCod,
+	       Gbl.Usrs.Me.UsrDat.UsrCod,
+	       Gbl.Usrs.Me.UsrDat.UsrCod,
+	       (unsigned) (Ntf_STATUS_BIT_READ | Ntf_STATUS_BIT_REMOVED));
+      DB_QueryREPLACE (Query,"can not store number of unseen notifications");
+      if (!Ntf_GetMyStoredNumUnseenNtfs (NumUnseenNtfs,NumNewNtfs))
+	 *NumUnseenNtfs = *NumNewNtfs = 0;
+      DB_Query ("COMMIT","can not commit transaction");
+      Gbl.DB.OpenTransaction = false;
+     }
   }
 
 /*****************************************************************************/
-/************** Get the number of my new unseen notifications ****************/
+/******** Get my number of unseen and new unseen notifications stored ********/
+/******** in the table of counters                                    ********/
 /*****************************************************************************/
+// Return true if my counters are found
 
-static unsigned Ntf_GetNumberOfMyNewUnseenNtfs (void)
+static bool Ntf_GetMyStoredNumUnseenNtfs (unsigned *NumUnseenNtfs,unsigned *NumNewNtfs)
   {
-   char Query[256];
+   char Query[128];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   bool Found = false;
+
+   /***** Get my counters from database *****/
+   sprintf (Query,"SELECT NumUnseen,NumNew FROM notif_unseen"
+                  " WHERE UsrCod='%ld'",
+            Gbl.Usrs.Me.UsrDat.UsrCod);
+   if (DB_QuerySELECT (Query,&mysql_res,"can not get number of unseen notifications"))
+     {
+      row = mysql_fetch_row (mysql_res);
+      Found = (sscanf (row[0],"%u",NumUnseenNtfs) == 1 &&
+               sscanf (row[1],"%u",NumNewNtfs   ) == 1);
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   return Found;
+  }
+
+/*****************************************************************************/
+/************ Remove the number of unseen notifications of a user ************/
+/*****************************************************************************/
+// It must be called after the notifications of the user are changed.
+// It will be computed again when needed
+
+void Ntf_RemoveNumUnseenNtfsOfUsr (long ToUsrCod)
+  {
+   char Query[128];
+
+   sprintf (Query,"DELETE FROM notif_unseen WHERE UsrCod='%ld'",
+            ToUsrCod);
+   DB_QueryDELETE (Query,"can not remove number of unseen notifications");
+  }
+
+/*****************************************************************************/
+/******* Remove the number of unseen notifications of the users having *******/
+/******* notifications that match a condition                          *******/
+/*****************************************************************************/
+// It must be called after the notifications are changed,
+// and in the same transaction if they are going to be deleted.
+// The numbers will be computed again when needed
+
+static void Ntf_RemoveNumUnseenNtfsOfUsrsNotified (const char *NotifCondition)
+  {
+   char *Query;
+
+   /***** Allocate space for query *****/
+   if ((Query = (char *) malloc (128 + strlen (NotifCondition))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store database query.");
+
+   /***** Remove counters of users notified *****/
+   sprintf (Query,"DELETE FROM notif_unseen WHERE UsrCod IN"
+	          " (SELECT DISTINCT ToUsrCod FROM notif WHERE %s)",
+            NotifCondition);
+   DB_QueryDELETE (Query,"can not remove number of unseen notifications");
+
+   /***** Free space used for query *****/
+   free ((void *) Query);
+  }
 
-   /***** Get number of places with a name from database *****/
-   sprintf (Query,"SELECT COUNT(*) FROM notif"
-                  " WHERE ToUsrCod='%ld' AND (Status & %u)=0"
-                  " AND TimeNotif>FROM_UNIXTIME('%ld')",
-            Gbl.Usrs.Me.UsrDat.UsrCod,
-            (unsigned) (Ntf_STATUS_BIT_READ | Ntf_STATUS_BIT_REMOVED),
-            Gbl.Usrs.Me.UsrLast.LastAccNotif);
-   return DB_QueryCOUNT (Query,"can not get number of unseen notifications");
+/*****************************************************************************/
+/******* Check the numbers of unseen notifications of all the users, *********/
+/******* rebuilding them from the table of notifications             *********/
+/*****************************************************************************/
+// This is a slow query, so it should be called only from time to time.
+// The counters of all the users who have them are recomputed
+// in one statement, so they are stored atomically,
+// and users with no unseen notifications keep their counters set to 0
+
+void Ntf_RebuildNumUnseenNtfs (void)
+  {
+   char Query[1024];
+
+   sprintf (Query,"REPLACE INTO notif_unseen (UsrCod,NumUnseen,NumNew)"
+                  " SELECT notif_unseen.UsrCod,COUNT(notif.ToUsrCod),"
+                  "COALESCE(SUM(notif.TimeNotif>usr_last.LastAccNotif),0)"
+                  " FROM notif_unseen"
+                  " LEFT JOIN notif"
+                  " ON notif.ToUsrCod=notif_unseen.UsrCod"
+                  " AND (notif.Status & %u)=0"
+                  " LEFT JOIN usr_last"
+                  " ON usr_last.UsrCod=notif_unseen.UsrCod"
+                  " GROUP BY notif_unseen.UsrCod",
+            (unsigned) (Ntf_STATUS_BIT_READ | Ntf_STATUS_BIT_REMOVED));
+   DB_QueryREPLACE (Query,"can not rebuild number of unseen notifications");
   }
 
 /*****************************************************************************/
@@ -2092,4 +2348,7 @@ void Ntf_RemoveUsrNtfs (long ToUsrCod)
 	          " WHERE ToUsrCod='%ld'",
             ToUsrCod);
    DB_QueryDELETE (Query,"can not remove notifications of a user");
+
+   /***** Delete number of unseen notifications of a user ******/
+   Ntf_RemoveNumUnseenNtfsOfUsr (ToUsrCod);
   }
@@ -122,6 +122,9 @@ unsigned Ntf_StoreNotifyEventsToAllUsrs (Ntf_NotifyEvent_t NotifyEvent,long Cod)
 void Ntf_StoreNotifyEventToOneUser (Ntf_NotifyEvent_t NotifyEvent,
                                     struct UsrData *UsrDat,
                                     long Cod,Ntf_Status_t Status);
+void Ntf_StoreNotifyEventToUsrs (Ntf_NotifyEvent_t NotifyEvent,
+                                 unsigned NumUsrs,const long *LstUsrCods,
+                                 const Ntf_Status_t *LstStatus,long Cod);
 void Ntf_SendPendingNotifByEMailToAllUsrs (void);
 Ntf_NotifyEvent_t Ntf_GetNotifyEventFromDB (const char *Str);
 void Ntf_ShowAlertNumUsrsToBeNotifiedByEMail (unsigned NumUsrsToBeNotifiedByEMail);
@@ -130,6 +133,8 @@ void Ntf_PutFormChangeNotifSentByEMail (void);
 void Ntf_ChangeNotifyEvents (void);
 
 void Ntf_WriteNumberOfNewNtfs (void);
+void Ntf_RemoveNumUnseenNtfsOfUsr (long ToUsrCod);
+void Ntf_RebuildNumUnseenNtfs (void);
 void Ntf_RemoveUsrNtfs (long ToUsrCod);
 
 #endif
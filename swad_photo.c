@@ -61,6 +61,20 @@ extern struct Globals Gbl;
 /***************************** Private constants *****************************/
 /*****************************************************************************/
 
+// Besides the photo at real size, smaller copies are published
+// in order to not send the big photo when it is shown small
+#define Pho_NUM_SMALL_SIZES 2
+static const struct
+  {
+   unsigned Width;
+   unsigned Height;
+  } Pho_SmallSizes[Pho_NUM_SMALL_SIZES] =
+  {
+   { 42, 56},	// Lists of users
+   { 93,124},	// Class photos
+  };
+#define Pho_QUALITY_SMALL_SIZES 85
+
 const char *Pho_StrAvgPhotoDirs[Pho_NUM_AVERAGE_PHOTO_TYPES] =
   {
    Cfg_FOLDER_DEGREE_PHOTO_MEDIAN,
@@ -96,6 +110,10 @@ static bool Pho_ReceivePhotoAndDetectFaces (bool ItsMe,const struct UsrData *Usr
 static void Pho_UpdatePhoto1 (struct UsrData *UsrDat);
 static void Pho_UpdatePhoto2 (void);
 static void Pho_ClearPhotoName (long UsrCod);
+static void Pho_PublishPhoto (const struct UsrData *UsrDat);
+static void Pho_UnpublishPhoto (const char *Photo);
+static void Pho_BuildURLToPhotoOfSize (const char *PhotoURL,const char *ClassPhoto,
+                                       char *PhotoURLOfSize);
 
 static long Pho_GetDegWithAvgPhotoLeastRecentlyUpdated (void);
 static long Pho_GetTimeAvgPhotoWasComputed (long DegCod);
@@ -963,33 +981,13 @@ bool Pho_ShowUsrPhotoIsAllowed (const struct UsrData *UsrDat,char *PhotoURL)
 // Returns false if photo does not exist
 // Returns true if link is created successfully
 
+// The photo was published when it was updated,
+// so the file system is not accessed here
+
 bool Pho_BuildLinkToPhoto (const struct UsrData *UsrDat,char *PhotoURL)
   {
-   char PathPublPhoto[PATH_MAX+1];
-   char PathPrivPhoto[PATH_MAX+1];
-
    if (UsrDat->Photo[0])
      {
-      /***** Make path to public photo *****/
-      sprintf (PathPublPhoto,"%s/%s/%s.jpg",
-               Cfg_PATH_SWAD_PUBLIC,Cfg_FOLDER_PHOTO,UsrDat->Photo);
-
-      /***** Make path to private photo from public directory *****/
-      sprintf (PathPrivPhoto,"%s/%s/%02u/%ld.jpg",
-               Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_PHOTO,
-               (unsigned) (UsrDat->UsrCod % 100),UsrDat->UsrCod);
-
-      /***** Create a symbolic link to the private photo, if not exists *****/
-      if (!Fil_CheckIfPathExists (PathPublPhoto))
-         if (symlink (PathPrivPhoto,PathPublPhoto) != 0)
-           {
-            sprintf (Gbl.Message,"symlink (%s,%s)",
-                     PathPrivPhoto,PathPublPhoto);
-            Lay_ShowAlert (Lay_WARNING,Gbl.Message);
-            Lay_ShowErrorAndExit ("Can not create public link"
-                                 " to access to user's private photo");
-           }
-
       /***** Create the public URL of the photo *****/
       sprintf (PhotoURL,"%s/%s/%s.jpg",
                Cfg_URL_SWAD_PUBLIC,Cfg_FOLDER_PHOTO,UsrDat->Photo);
@@ -1027,7 +1025,6 @@ bool Pho_CheckIfPrivPhotoExists (long UsrCod,char *PathPrivRelPhoto)
 bool Pho_RemovePhoto (struct UsrData *UsrDat)
   {
    char PathPrivRelPhoto[PATH_MAX+1];
-   char PathPublPhoto[PATH_MAX+1];
    unsigned NumErrors = 0;
 
    if (UsrDat->Photo[0])
@@ -1035,15 +1032,8 @@ bool Pho_RemovePhoto (struct UsrData *UsrDat)
       /***** Clear photo name in database *****/
       Pho_ClearPhotoName (UsrDat->UsrCod);
 
-      /***** Remove public link *****/
-      sprintf (PathPublPhoto,"%s/%s/%s.jpg",
-               Cfg_PATH_SWAD_PUBLIC,Cfg_FOLDER_PHOTO,UsrDat->Photo);
-      if (Fil_CheckIfPathExists (PathPublPhoto))	// Public link exists
-         if (unlink (PathPublPhoto))			// Remove public link
-           {
-            Lay_ShowAlert (Lay_ERROR,"Error removing public link to photo.");
-            NumErrors++;
-           }
+      /***** Remove public copies of the photo *****/
+      Pho_UnpublishPhoto (UsrDat->Photo);
 
       /***** Remove photo *****/
       sprintf (PathPrivRelPhoto,"%s/%s/%02u/%ld.jpg",
@@ -1098,7 +1088,6 @@ static void Pho_ClearPhotoName (long UsrCod)
 void Pho_UpdatePhotoName (struct UsrData *UsrDat)
   {
    char Query[512];
-   char PathPublPhoto[PATH_MAX+1];
 
    /***** Update photo name in database *****/
    sprintf (Query,"UPDATE usr_data SET Photo='%s'"
@@ -1106,13 +1095,88 @@ void Pho_UpdatePhotoName (struct UsrData *UsrDat)
             Gbl.UniqueNameEncrypted,UsrDat->UsrCod);
    DB_QueryUPDATE (Query,"can not update the name of a user's photo");
 
-   /***** Remove the old symbolic link to photo *****/
-   sprintf (PathPublPhoto,"%s/%s/%s.jpg",
-            Cfg_PATH_SWAD_PUBLIC,Cfg_FOLDER_PHOTO,UsrDat->Photo);
-   unlink (PathPublPhoto);                // Remove public link
+   /***** Remove the old public copies of the photo *****/
+   if (UsrDat->Photo[0])
+      Pho_UnpublishPhoto (UsrDat->Photo);
 
    /***** Update photo name in user's data *****/
    strcpy (UsrDat->Photo,Gbl.UniqueNameEncrypted);
+
+   /***** Publish the new photo *****/
+   Pho_PublishPhoto (UsrDat);
+  }
+
+/*****************************************************************************/
+/************ Copy the private photo of a user to public directory ***********/
+/*****************************************************************************/
+// A new name is used each time the photo changes,
+// so public copies never change and can be cached by browsers
+
+static void Pho_PublishPhoto (const struct UsrData *UsrDat)
+  {
+   char PathPrivPhoto[PATH_MAX+1];
+   char PathPublPhoto[PATH_MAX+1];
+   char Command[1024+PATH_MAX*2];
+   unsigned NumSize;
+   int ReturnCode;
+
+   /***** Make path to private photo *****/
+   sprintf (PathPrivPhoto,"%s/%s/%02u/%ld.jpg",
+            Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_PHOTO,
+            (unsigned) (UsrDat->UsrCod % 100),UsrDat->UsrCod);
+
+   /***** Copy photo at real size *****/
+   sprintf (PathPublPhoto,"%s/%s/%s.jpg",
+            Cfg_PATH_SWAD_PUBLIC,Cfg_FOLDER_PHOTO,UsrDat->Photo);
+   Fil_FastCopyOfFiles (PathPrivPhoto,PathPublPhoto);
+
+   /***** Create smaller copies *****/
+   for (NumSize = 0;
+	NumSize < Pho_NUM_SMALL_SIZES;
+	NumSize++)
+     {
+      sprintf (PathPublPhoto,"%s/%s/%s_%ux%u.jpg",
+               Cfg_PATH_SWAD_PUBLIC,Cfg_FOLDER_PHOTO,UsrDat->Photo,
+               Pho_SmallSizes[NumSize].Width,
+               Pho_SmallSizes[NumSize].Height);
+      sprintf (Command,"convert %s -resize '%ux%u' -quality %u %s",
+               PathPrivPhoto,
+               Pho_SmallSizes[NumSize].Width,
+               Pho_SmallSizes[NumSize].Height,
+               Pho_QUALITY_SMALL_SIZES,
+               PathPublPhoto);
+      ReturnCode = system (Command);
+      if (ReturnCode == -1 || WEXITSTATUS(ReturnCode) != 0)
+	 // The photo could not be resized ==> use the photo at real size
+	 Fil_FastCopyOfFiles (PathPrivPhoto,PathPublPhoto);
+     }
+  }
+
+/*****************************************************************************/
+/*************** Remove the public copies of a user's photo ******************/
+/*****************************************************************************/
+
+static void Pho_UnpublishPhoto (const char *Photo)
+  {
+   char PathPublPhoto[PATH_MAX+1];
+   unsigned NumSize;
+
+   /***** Remove photo at real size *****/
+   sprintf (PathPublPhoto,"%s/%s/%s.jpg",
+            Cfg_PATH_SWAD_PUBLIC,Cfg_FOLDER_PHOTO,Photo);
+   unlink (PathPublPhoto);
+
+   /***** Remove smaller copies *****/
+   for (NumSize = 0;
+	NumSize < Pho_NUM_SMALL_SIZES;
+	NumSize++)
+     {
+      sprintf (PathPublPhoto,"%s/%s/%s_%ux%u.jpg",
+               Cfg_PATH_SWAD_PUBLIC,Cfg_FOLDER_PHOTO,Photo,
+               Pho_SmallSizes[NumSize].Width,
+               Pho_SmallSizes[NumSize].Height);
+      unlink (PathPublPhoto);
+     }
   }
 
 /*****************************************************************************/
@@ -1134,7 +1198,7 @@ void Pho_ShowUsrPhoto (const struct UsrData *UsrDat,const char *PhotoURL,
                       Zoom == Pho_ZOOM &&						// Make zoom
                       Act_Actions[Gbl.Action.Act].BrowserWindow == Act_THIS_WINDOW;	// Only in main window
    char IdCaption[Act_MAX_LENGTH_ID];
-
+   char PhotoURLOfSize[PATH_MAX+1];
 
    /***** Start form to go to public profile *****/
    if (PutLinkToPublicProfile)
@@ -1182,7 +1246,10 @@ void Pho_ShowUsrPhoto (const struct UsrData *UsrDat,const char *PhotoURL,
       if (PhotoURL[0])
 	 PhotoExists = true;
    if (PhotoExists)
-      fprintf (Gbl.F.Out,"%s",PhotoURL);
+     {
+      Pho_BuildURLToPhotoOfSize (PhotoURL,ClassPhoto,PhotoURLOfSize);
+      fprintf (Gbl.F.Out,"%s",PhotoURLOfSize);
+     }
    else
       fprintf (Gbl.F.Out,"%s/usr_bl.jpg",Gbl.Prefs.IconsURL);
    fprintf (Gbl.F.Out,"\" alt=\"%s\" title=\"%s\""
@@ -1206,6 +1273,40 @@ void Pho_ShowUsrPhoto (const struct UsrData *UsrDat,const char *PhotoURL,
      }
   }
 
+/*****************************************************************************/
+/********* Build the URL of the smallest copy of a photo fitting a class *****/
+/*****************************************************************************/
+// ClassPhoto is like "PHOTO45x60"
+
+static void Pho_BuildURLToPhotoOfSize (const char *PhotoURL,const char *ClassPhoto,
+                                       char *PhotoURLOfSize)
+  {
+   unsigned Width;
+   unsigned Height;
+   unsigned NumSize;
+   size_t LengthURLWithoutExtension;
+
+   if (sscanf (ClassPhoto,"PHOTO%ux%u",&Width,&Height) == 2 &&
+       Str_FileIs (PhotoURL,"jpg"))
+      for (NumSize = 0;
+	   NumSize < Pho_NUM_SMALL_SIZES;
+	   NumSize++)
+	 if (Width  <= Pho_SmallSizes[NumSize].Width &&
+	     Height <= Pho_SmallSizes[NumSize].Height)
+	   {
+	    LengthURLWithoutExtension = strlen (PhotoURL) - strlen (".jpg");
+	    memcpy (PhotoURLOfSize,PhotoURL,LengthURLWithoutExtension);
+	    PhotoURLOfSize[LengthURLWithoutExtension] = '\0';
+	    sprintf (PhotoURLOfSize + LengthURLWithoutExtension,"_%ux%u.jpg",
+	             Pho_SmallSizes[NumSize].Width,
+	             Pho_SmallSizes[NumSize].Height);
+	    return;
+	   }
+
+   /***** Photo at real size *****/
+   strcpy (PhotoURLOfSize,PhotoURL);
+  }
+
 /*****************************************************************************/
 /************************** Change photo visibility **************************/
 /*****************************************************************************/
@@ -1638,7 +1739,10 @@ void Pho_ShowOrPrintPhotoDegree (Pho_AvgPhotoSeeOrPrint_t SeeOrPrint)
       fprintf (Gbl.F.Out,"</table>");
 
       /***** Link to computation of average photos *****/
-      Pho_PutLinkToCalculateDegreeStats ();
+      // Average photos are computed periodically by swad_average_photos,
+      // so only a system administrator can force the computation here
+      if (Gbl.Usrs.Me.LoggedRole == Rol_SYS_ADM)
+         Pho_PutLinkToCalculateDegreeStats ();
      }
 
    /***** Get maximum number of students
@@ -28,7 +28,8 @@
 #include <linux/stddef.h>	// For NULL
 #include <stdbool.h>		// For boolean type
 #include <stdio.h>		// For fprintf, etc.
-#include <string.h>
+#include <stdlib.h>		// For getenv
+#include <string.h>		// For string functions
 
 #include "swad_calendar.h"
 #include "swad_config.h"
@@ -316,6 +317,9 @@ void Pre_ChangeLanguage (void)
    /***** Get param language *****/
    Gbl.Prefs.Language = Pre_GetParamLanguage ();
 
+   /***** Show texts in the new language *****/
+   Pre_SetLanguageOfTexts (Gbl.Prefs.Language);
+
    /***** Store language in database *****/
    /*
    sprintf (Gbl.Message,"Txt_STR_LANG_ID[Gbl.Prefs.Language] = %s",Txt_STR_LANG_ID[Gbl.Prefs.Language]);
@@ -357,7 +361,6 @@ void Pre_UpdateMyLanguageToCurrentLanguage (void)
 
 Txt_Language_t Pre_GetParamLanguage (void)
   {
-   extern const unsigned Txt_Current_CGI_SWAD_Language;
    char UnsignedStr[10+1];
    unsigned UnsignedNum;
 
@@ -367,7 +370,66 @@ Txt_Language_t Pre_GetParamLanguage (void)
 	  UnsignedNum <= Txt_NUM_LANGUAGES)
          return (Txt_Language_t) UnsignedNum;
 
-   return Txt_Current_CGI_SWAD_Language;
+   return Gbl.Prefs.Language;
+  }
+
+/*****************************************************************************/
+/************ Get language from the name used to call this CGI ***************/
+/*****************************************************************************/
+// The same binary is called with one name for each language,
+// ended in the language code (.../ca, .../swad_ca... .../pt, .../swad_pt)
+
+Txt_Language_t Pre_GetLanguageFromCGIName (void)
+  {
+   extern const char *Txt_STR_LANG_ID[1+Txt_NUM_LANGUAGES];
+   const char *ScriptName;
+   size_t Length;
+   Txt_Language_t Lan;
+
+   if ((ScriptName = getenv ("SCRIPT_NAME")))
+      if ((Length = strlen (ScriptName)) >= 3)
+	 if (ScriptName[Length - 3] == '/' ||
+	     ScriptName[Length - 3] == '_')
+	    for (Lan = (Txt_Language_t) 1;
+		 Lan <= Txt_NUM_LANGUAGES;
+		 Lan++)
+	       if (!strcmp (&ScriptName[Length - 2],Txt_STR_LANG_ID[Lan]))
+		  return Lan;
+
+   return Cfg_DEFAULT_LANGUAGE;
+  }
+
+/*****************************************************************************/
+/********************** Set the language of the texts ************************/
+/*****************************************************************************/
+// Texts are compiled in swad_text.o in only one language.
+// To use another language, texts are replaced by those in that language,
+// using the tables generated by swad_text_tables.sh
+
+void Pre_SetLanguageOfTexts (Txt_Language_t Language)
+  {
+   extern const unsigned Txt_Current_CGI_SWAD_Language;	// Language of texts in swad_text.o
+   extern const struct Txt_Table Txt_Tables[];
+   extern const unsigned Txt_NumTables;
+   static Txt_Language_t LanguageOfTexts = Txt_LANGUAGE_UNKNOWN;
+   unsigned NumTable;
+
+   if (LanguageOfTexts == Txt_LANGUAGE_UNKNOWN)
+      LanguageOfTexts = (Txt_Language_t) Txt_Current_CGI_SWAD_Language;
+
+   if (Language == Txt_LANGUAGE_UNKNOWN ||
+       Language == LanguageOfTexts)	// Nothing to do
+      return;
+
+   /***** Replace all the texts by those in the new language *****/
+   for (NumTable = 0;
+	NumTable < Txt_NumTables;
+	NumTable++)
+      memcpy (Txt_Tables[NumTable].Text,
+	      Txt_Tables[NumTable].Lang[Language],
+	      Txt_Tables[NumTable].Size);
+
+   LanguageOfTexts = Language;
   }
 
 /*****************************************************************************/
@@ -51,6 +51,8 @@ void Pre_AskChangeLanguage (void);
 void Pre_ChangeLanguage (void);
 void Pre_UpdateMyLanguageToCurrentLanguage (void);
 Txt_Language_t Pre_GetParamLanguage (void);
+Txt_Language_t Pre_GetLanguageFromCGIName (void);
+void Pre_SetLanguageOfTexts (Txt_Language_t Language);
 
 void Pre_ChangeSideCols (void);
 void Pre_HideLeftCol (void);
@@ -1093,22 +1093,6 @@ void Prf_IncrementNumClicksUsr (long UsrCod)
    DB_QueryINSERT (Query,"can not increment user's clicks");
   }
 
-/*****************************************************************************/
-/************** Increment number of file views sent by a user ****************/
-/*****************************************************************************/
-
-void Prf_IncrementNumFileViewsUsr (long UsrCod)
-  {
-   char Query[256];
-
-   /***** Increment number of file views *****/
-   // If NumFileViews < 0 ==> not yet calculated, so do nothing
-   sprintf (Query,"UPDATE IGNORE usr_figures SET NumFileViews=NumFileViews+1"
-	          " WHERE UsrCod='%ld' AND NumFileViews>=0",
-	    UsrCod);
-   DB_QueryINSERT (Query,"can not increment user's file views");
-  }
-
 /*****************************************************************************/
 /************* Increment number of forum posts sent by a user ****************/
 /*****************************************************************************/
@@ -0,0 +1,349 @@
+// swad_profiler.c: timing of the phases and database queries of each action
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2016 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <stdbool.h>		// For boolean type
+#include <stdio.h>		// For sprintf
+#include <string.h>		// For string functions
+#include <sys/time.h>		// For gettimeofday
+
+#include "swad_config.h"
+#include "swad_database.h"
+#include "swad_global.h"
+#include "swad_profiler.h"
+#include "swad_string.h"
+
+/*****************************************************************************/
+/************** External global variables from others modules ****************/
+/*****************************************************************************/
+
+extern struct Globals Gbl;
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define Pfl_SECONDS_IN_PROFILE_LOG ((time_t)(Cfg_DAYS_IN_PROFILE_LOG*24UL*60UL*60UL))
+
+#define Pfl_MAX_SLOW_QUERIES		  5	// Only the slowest queries of each access are stored
+#define Pfl_MAX_LENGTH_SITE		255
+#define Pfl_MAX_LENGTH_QUERY		1024
+
+/*****************************************************************************/
+/****************************** Private types ********************************/
+/*****************************************************************************/
+
+struct Pfl_Query
+  {
+   char Site[Pfl_MAX_LENGTH_SITE+1];	// Error message of the query, it identifies where the query is made
+   char Query[Pfl_MAX_LENGTH_QUERY+1];	// Query with literals replaced by ?
+   unsigned long NumRows;
+   long Time;				// In microseconds
+  };
+
+/*****************************************************************************/
+/***************************** Private variables *****************************/
+/*****************************************************************************/
+
+static struct
+  {
+   bool Stored;				// Profile already stored in database
+   bool PhaseStarted;
+   Pfl_Phase_t CurrentPhase;
+   struct timeval tvStartPhase;
+   long TimePhase[Pfl_NUM_PHASES];	// In microseconds
+   struct timeval tvStartQuery;
+   unsigned NumQueries;
+   long TimeQueries;			// In microseconds
+   unsigned NumSlowQueries;
+   struct Pfl_Query SlowQueries[Pfl_MAX_SLOW_QUERIES];	// Sorted from slowest to fastest
+  } Pfl_Profile;	// All fields are initialized to zero/false
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static long Pfl_GetElapsedTime (const struct timeval *tvStart,struct timeval *tvEnd);
+static void Pfl_NormalizeQuery (const char *Query,char *Normalized);
+
+/*****************************************************************************/
+/************** Get microseconds from a time to current time *****************/
+/*****************************************************************************/
+
+static long Pfl_GetElapsedTime (const struct timeval *tvStart,struct timeval *tvEnd)
+  {
+   if (gettimeofday (tvEnd,NULL))
+     {
+      // Error in gettimeofday
+      *tvEnd = *tvStart;
+      return 0L;
+     }
+
+   return (tvEnd->tv_sec  - tvStart->tv_sec) * 1000000L +
+           tvEnd->tv_usec - tvStart->tv_usec;
+  }
+
+/*****************************************************************************/
+/************************ Start a phase of the action ************************/
+/*****************************************************************************/
+// The time since the start of the previous phase is added to that phase
+
+void Pfl_StartPhase (Pfl_Phase_t Phase)
+  {
+   struct timeval tvNow;
+
+   if (Pfl_Profile.PhaseStarted)
+      Pfl_Profile.TimePhase[Pfl_Profile.CurrentPhase] += Pfl_GetElapsedTime (&Pfl_Profile.tvStartPhase,&tvNow);
+   else if (gettimeofday (&tvNow,NULL))
+      return;
+
+   Pfl_Profile.PhaseStarted = true;
+   Pfl_Profile.CurrentPhase = Phase;
+   Pfl_Profile.tvStartPhase = tvNow;
+  }
+
+/*****************************************************************************/
+/********************* End the current phase of the action *******************/
+/*****************************************************************************/
+
+void Pfl_EndPhases (void)
+  {
+   struct timeval tvNow;
+
+   if (Pfl_Profile.PhaseStarted)
+     {
+      Pfl_Profile.TimePhase[Pfl_Profile.CurrentPhase] += Pfl_GetElapsedTime (&Pfl_Profile.tvStartPhase,&tvNow);
+      Pfl_Profile.PhaseStarted = false;
+     }
+  }
+
+/*****************************************************************************/
+/*************************** Start a database query **************************/
+/*****************************************************************************/
+
+void Pfl_StartQuery (void)
+  {
+   gettimeofday (&Pfl_Profile.tvStartQuery,NULL);
+  }
+
+/*****************************************************************************/
+/**************************** End a database query ***************************/
+/*****************************************************************************/
+// Site is the error message passed to the query,
+// used to know where in the code the query is made
+
+void Pfl_EndQuery (const char *Query,const char *Site,unsigned long NumRows)
+  {
+   struct timeval tvNow;
+   long Time;
+   unsigned NumQry;
+
+   /***** Queries made to store the profile are not profiled *****/
+   if (Pfl_Profile.Stored)
+      return;
+
+   /***** Update totals *****/
+   Time = Pfl_GetElapsedTime (&Pfl_Profile.tvStartQuery,&tvNow);
+   Pfl_Profile.NumQueries++;
+   Pfl_Profile.TimeQueries += Time;
+
+   /***** Insert query in the list of slowest queries *****/
+   // Find position from the end, moving faster queries one position down
+   NumQry = Pfl_Profile.NumSlowQueries;
+   if (NumQry == Pfl_MAX_SLOW_QUERIES)		// List is full
+     {
+      if (Time <= Pfl_Profile.SlowQueries[Pfl_MAX_SLOW_QUERIES - 1].Time)
+	 return;				// Faster than all the queries in list
+      NumQry--;					// The fastest query is dropped
+     }
+   else
+      Pfl_Profile.NumSlowQueries++;
+   for (;
+	NumQry > 0 && Time > Pfl_Profile.SlowQueries[NumQry - 1].Time;
+	NumQry--)
+      Pfl_Profile.SlowQueries[NumQry] = Pfl_Profile.SlowQueries[NumQry - 1];
+
+   strncpy (Pfl_Profile.SlowQueries[NumQry].Site,Site,Pfl_MAX_LENGTH_SITE);
+   Pfl_Profile.SlowQueries[NumQry].Site[Pfl_MAX_LENGTH_SITE] = '\0';
+   Pfl_NormalizeQuery (Query,Pfl_Profile.SlowQueries[NumQry].Query);
+   Pfl_Profile.SlowQueries[NumQry].NumRows = NumRows;
+   Pfl_Profile.SlowQueries[NumQry].Time = Time;
+  }
+
+/*****************************************************************************/
+/********************** Replace literals in a query by ? *********************/
+/*****************************************************************************/
+// Queries which differ only in codes or strings are normalized to the same text,
+// and lists of values like ('1','2','3') are reduced to (?).
+// Normalized has no ' " or \ so it can be inserted into a query directly.
+// Normalized must have space for Pfl_MAX_LENGTH_QUERY + 1 chars
+
+static void Pfl_NormalizeQuery (const char *Query,char *Normalized)
+  {
+   const char *Ptr = Query;
+   size_t Length = 0;
+   char Quote;
+   bool Literal;
+
+   while (*Ptr && Length < Pfl_MAX_LENGTH_QUERY)
+     {
+      Literal = false;
+      if (*Ptr == '\'' || *Ptr == '"')		// Start of a string literal
+	{
+	 Quote = *Ptr++;
+	 while (*Ptr)
+	    if (*Ptr == '\\' && Ptr[1])		// Escaped char
+	       Ptr += 2;
+	    else if (*Ptr == Quote)
+	      {
+	       Ptr++;
+	       if (*Ptr != Quote)		// Not a doubled quote
+		  break;
+	       Ptr++;
+	      }
+	    else
+	       Ptr++;
+	 Literal = true;
+	}
+      else if (*Ptr >= '0' && *Ptr <= '9' &&
+	       !(Length &&
+	         (Normalized[Length - 1] == '_' ||
+	          (Normalized[Length - 1] >= '0' && Normalized[Length - 1] <= '9') ||
+	          (Normalized[Length - 1] >= 'A' && Normalized[Length - 1] <= 'Z') ||
+	          (Normalized[Length - 1] >= 'a' && Normalized[Length - 1] <= 'z'))))	// Number not in a name
+	{
+	 while ((*Ptr >= '0' && *Ptr <= '9') || *Ptr == '.')
+	    Ptr++;
+	 Literal = true;
+	}
+      else if (*Ptr == ' ' || *Ptr == '\t' || *Ptr == '\n' || *Ptr == '\r')
+	{
+	 while (*Ptr == ' ' || *Ptr == '\t' || *Ptr == '\n' || *Ptr == '\r')
+	    Ptr++;
+	 Normalized[Length++] = ' ';
+	}
+      else if (*Ptr == '\\')
+	 Ptr++;
+      else
+	 Normalized[Length++] = *Ptr++;
+
+      if (Literal)
+	{
+	 if (Length >= 2 &&
+	     Normalized[Length - 2] == '?' &&
+	     Normalized[Length - 1] == ',')	// A list of literals
+	    Length--;				// Remove the comma and keep only one ?
+	 else
+	    Normalized[Length++] = '?';
+	}
+     }
+   Normalized[Length] = '\0';
+  }
+
+/*****************************************************************************/
+/****************** Store profile of current access in database **************/
+/*****************************************************************************/
+// Only one of each Cfg_PROFILE_ONE_OF_N_ACCESSES accesses is stored
+
+void Pfl_StoreProfile (long LogCod,long ActCod)
+  {
+   char Query[512+Pfl_MAX_SLOW_QUERIES*(64+Pfl_MAX_LENGTH_SITE*5+Pfl_MAX_LENGTH_QUERY)];
+   unsigned NumQry;
+
+   if (Cfg_PROFILE_ONE_OF_N_ACCESSES == 0 ||
+       LogCod % Cfg_PROFILE_ONE_OF_N_ACCESSES)
+      return;
+
+   /***** Queries made from now on are not profiled *****/
+   Pfl_EndPhases ();
+   Pfl_Profile.Stored = true;
+
+   /***** Store time of each phase *****/
+   sprintf (Query,"INSERT INTO log_prof"
+	          " (LogCod,ActCod,ClickTime,"
+	          "TimeParams,TimeSession,TimePriori,TimePosteriori,TimePage,"
+	          "TimeSend,NumQueries,TimeQueries)"
+                  " VALUES"
+                  " ('%ld','%ld',NOW(),"
+                  "'%ld','%ld','%ld','%ld','%ld',"
+                  "'%ld','%u','%ld')",
+            LogCod,ActCod,
+            Pfl_Profile.TimePhase[Pfl_PHASE_PARAMS],
+            Pfl_Profile.TimePhase[Pfl_PHASE_SESSION],
+            Pfl_Profile.TimePhase[Pfl_PHASE_PRIORI],
+            Pfl_Profile.TimePhase[Pfl_PHASE_POSTERIORI],
+            Pfl_Profile.TimePhase[Pfl_PHASE_PAGE],
+            Gbl.TimeSendInMicroseconds,
+            Pfl_Profile.NumQueries,
+            Pfl_Profile.TimeQueries);
+   DB_QueryINSERT (Query,"can not store profile of access");
+
+   /***** Store slowest queries *****/
+   if (Pfl_Profile.NumSlowQueries)
+     {
+      strcpy (Query,"INSERT INTO log_prof_queries"
+	            " (LogCod,ActCod,QryInd,Site,Query,NumRows,Time)"
+                    " VALUES ");
+      for (NumQry = 0;
+	   NumQry < Pfl_Profile.NumSlowQueries;
+	   NumQry++)
+	{
+	 sprintf (Query + strlen (Query),"%s('%ld','%ld','%u','",
+	          NumQry ? "," :
+	        	   "",
+	          LogCod,ActCod,NumQry);
+	 Str_AddStrToQuery (Query,Pfl_Profile.SlowQueries[NumQry].Site,sizeof (Query));
+	 sprintf (Query + strlen (Query),"','%s','%lu','%ld')",
+	          Pfl_Profile.SlowQueries[NumQry].Query,
+	          Pfl_Profile.SlowQueries[NumQry].NumRows,
+	          Pfl_Profile.SlowQueries[NumQry].Time);
+	}
+      DB_QueryINSERT (Query,"can not store slowest queries of access");
+     }
+  }
+
+/*****************************************************************************/
+/****************** Remove old entries in profile log tables *****************/
+/*****************************************************************************/
+
+void Pfl_RemoveOldProfiles (void)
+  {
+   char Query[512];
+
+   /***** Remove slowest queries of old accesses *****/
+   sprintf (Query,"DELETE LOW_PRIORITY FROM log_prof_queries"
+	          " USING log_prof,log_prof_queries"
+                  " WHERE log_prof.ClickTime<FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')"
+                  " AND log_prof.LogCod=log_prof_queries.LogCod",
+            (unsigned long) Pfl_SECONDS_IN_PROFILE_LOG);
+   DB_QueryDELETE (Query,"can not remove old entries from profile log");
+
+   /***** Remove old accesses *****/
+   sprintf (Query,"DELETE LOW_PRIORITY FROM log_prof"
+                  " WHERE ClickTime<FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')",
+            (unsigned long) Pfl_SECONDS_IN_PROFILE_LOG);
+   DB_QueryDELETE (Query,"can not remove old entries from profile log");
+  }
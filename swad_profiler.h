@@ -0,0 +1,55 @@
+// swad_profiler.h: timing of the phases and database queries of each action
+
+#ifndef _SWAD_PFL
+#define _SWAD_PFL
+/*
+    SWAD (Shared Workspace At a Distance in Spanish),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2016 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/************************** Public types and constants ***********************/
+/*****************************************************************************/
+
+// Phases in the execution of an action
+// Don't change the numbers, they are the columns in database
+#define Pfl_NUM_PHASES 5
+typedef enum
+  {
+   Pfl_PHASE_PARAMS	= 0,	// Read parameters
+   Pfl_PHASE_SESSION	= 1,	// Check session and get user's data
+   Pfl_PHASE_PRIORI	= 2,	// Function executed before writing the page
+   Pfl_PHASE_POSTERIORI	= 3,	// Function that writes the main content of the page
+   Pfl_PHASE_PAGE	= 4,	// Write start and end of page
+  } Pfl_Phase_t;
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+void Pfl_StartPhase (Pfl_Phase_t Phase);
+void Pfl_EndPhases (void);
+
+void Pfl_StartQuery (void);
+void Pfl_EndQuery (const char *Query,const char *Site,unsigned long NumRows);
+
+void Pfl_StoreProfile (long LogCod,long ActCod);
+void Pfl_RemoveOldProfiles (void);
+
+#endif
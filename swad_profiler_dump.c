@@ -0,0 +1,244 @@
+// swad_profiler_dump.c
+// Created on: 28/11/2016
+// Show, for each action, the percentiles 50, 95 and 99 of the time spent
+// in each phase, and the database queries that take more time,
+// from the profiles stored by SWAD in tables log_prof and log_prof_queries.
+// Usage: swad_profiler_dump [number of days (default 1)] [action code]
+// Compile with: gcc -Wall -O1 swad_profiler_dump.c -o swad_profiler_dump -lmysqlclient -L/usr/lib64/mysql
+
+#include <mysql/mysql.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DATABASE_HOST		"swad.ugr.es"
+#define DATABASE_USER		"swad"
+#define DATABASE_PASSWORD	"********"
+#define DATABASE_DBNAME		"swad"
+
+#define DEFAULT_DAYS		1
+
+#define MAX_SLOW_QUERY_SITES	20
+
+/* Columns of log_prof shown, in the same order as Pfl_Phase_t, and then the totals */
+#define NUM_COLUMNS		8
+const char *Columns[NUM_COLUMNS] =
+  {
+   "TimeParams",	// Pfl_PHASE_PARAMS
+   "TimeSession",	// Pfl_PHASE_SESSION
+   "TimePriori",	// Pfl_PHASE_PRIORI
+   "TimePosteriori",	// Pfl_PHASE_POSTERIORI
+   "TimePage",		// Pfl_PHASE_PAGE
+   "TimeSend",
+   "TimeQueries",
+   "NumQueries",
+  };
+#define COLUMN_NUM_QUERIES	7
+
+MYSQL mysql;
+
+void ExecuteQuery (const char *Query)
+  {
+   if (mysql_query (&mysql,Query))
+     {
+      fprintf (stderr,"%s\n",mysql_error (&mysql));
+      exit (3);
+     }
+  }
+
+MYSQL_RES *ExecuteSelect (const char *Query)
+  {
+   MYSQL_RES *mysql_res;
+
+   ExecuteQuery (Query);
+   if ((mysql_res = mysql_store_result (&mysql)) == NULL)
+     {
+      fprintf (stderr,"%s\n",mysql_error (&mysql));
+      exit (4);
+     }
+   return mysql_res;
+  }
+
+int CompareLongs (const void *A,const void *B)
+  {
+   long a = *((const long *) A);
+   long b = *((const long *) B);
+
+   return (a > b) - (a < b);
+  }
+
+/* Get a percentile from a sorted list of values */
+long Percentile (const long *Values,unsigned long NumValues,unsigned Percent)
+  {
+   unsigned long Index = (NumValues * Percent + 99UL) / 100UL;	// Nearest rank
+
+   return Values[Index ? Index - 1 :
+	                 0];
+  }
+
+/* Print percentiles of the accesses to one action.
+   Values[Col] holds NumValues values of each column */
+void PrintAction (long ActCod,long *Values[NUM_COLUMNS],unsigned long NumValues)
+  {
+   unsigned Col;
+
+   printf ("%ld\t%lu",ActCod,NumValues);
+   for (Col = 0;
+	Col < NUM_COLUMNS;
+	Col++)
+     {
+      qsort (Values[Col],NumValues,sizeof (long),CompareLongs);
+      if (Col == COLUMN_NUM_QUERIES)
+	 printf ("\t%ld/%ld/%ld",
+		 Percentile (Values[Col],NumValues,50),
+		 Percentile (Values[Col],NumValues,95),
+		 Percentile (Values[Col],NumValues,99));
+      else	// Microseconds shown as milliseconds
+	 printf ("\t%.1f/%.1f/%.1f",
+		 (double) Percentile (Values[Col],NumValues,50) / 1000.0,
+		 (double) Percentile (Values[Col],NumValues,95) / 1000.0,
+		 (double) Percentile (Values[Col],NumValues,99) / 1000.0);
+     }
+   printf ("\n");
+  }
+
+int main (int argc, char **argv)
+  {
+   unsigned Days = DEFAULT_DAYS;
+   long OnlyActCod = -1L;
+   char StrActCod[64];
+   char Query[2048];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned long NumRows;
+   unsigned long NumRow;
+   unsigned long NumValues;
+   long *Values[NUM_COLUMNS];
+   long ActCod;
+   long PrevActCod = -1L;
+   unsigned Col;
+
+   if (argc > 1)
+      if (sscanf (argv[1],"%u",&Days) != 1 || Days == 0)
+	{
+	 fprintf (stderr,"Usage: %s [number of days] [action code]\n",argv[0]);
+	 return 1;
+	}
+   if (argc > 2)
+      if (sscanf (argv[2],"%ld",&OnlyActCod) != 1)
+	{
+	 fprintf (stderr,"Usage: %s [number of days] [action code]\n",argv[0]);
+	 return 1;
+	}
+   if (OnlyActCod >= 0)
+      sprintf (StrActCod," AND log_prof.ActCod='%ld'",OnlyActCod);
+   else
+      StrActCod[0] = '\0';
+
+   /***** Connect to database *****/
+   mysql_init (&mysql);
+   if (!mysql_real_connect (&mysql,DATABASE_HOST,DATABASE_USER,DATABASE_PASSWORD,DATABASE_DBNAME,0,NULL,0))
+     {
+      fprintf (stderr,"%s\n",mysql_error (&mysql));
+      return 2;
+     }
+
+   /***** Get profiles of the accesses, grouped by action *****/
+   sprintf (Query,"SELECT ActCod,"
+		  "TimeParams,TimeSession,TimePriori,TimePosteriori,TimePage,"
+		  "TimeSend,TimeQueries,NumQueries"
+		  " FROM log_prof"
+		  " WHERE ClickTime>FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')%s"
+		  " ORDER BY ActCod",
+	    (unsigned long) Days * 24UL * 60UL * 60UL,StrActCod);
+   mysql_res = ExecuteSelect (Query);
+   NumRows = (unsigned long) mysql_num_rows (mysql_res);
+
+   /***** Allocate space for the values of all the accesses *****/
+   for (Col = 0;
+	Col < NUM_COLUMNS;
+	Col++)
+      if ((Values[Col] = malloc ((NumRows ? NumRows :
+	                                    1) * sizeof (long))) == NULL)
+	{
+	 fprintf (stderr,"Not enough memory.\n");
+	 return 5;
+	}
+
+   /***** Print percentiles 50/95/99 of each action *****/
+   printf ("Accesses profiled in the last %u day(s): %lu\n"
+	   "Times in ms, shown as p50/p95/p99\n"
+	   "ActCod\tAccesses",
+	   Days,NumRows);
+   for (Col = 0;
+	Col < NUM_COLUMNS;
+	Col++)
+      printf ("\t%s",Columns[Col]);
+   printf ("\n");
+
+   for (NumRow = 0, NumValues = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get action code (row[0]) */
+      ActCod = strtol (row[0],NULL,10);
+      if (NumValues && ActCod != PrevActCod)
+	{
+	 PrintAction (PrevActCod,Values,NumValues);
+	 NumValues = 0;
+	}
+      PrevActCod = ActCod;
+
+      /* Get values of columns (row[1]...) */
+      for (Col = 0;
+	   Col < NUM_COLUMNS;
+	   Col++)
+	 Values[Col][NumValues] = strtol (row[Col + 1],NULL,10);
+      NumValues++;
+     }
+   if (NumValues)
+      PrintAction (PrevActCod,Values,NumValues);
+   mysql_free_result (mysql_res);
+
+   for (Col = 0;
+	Col < NUM_COLUMNS;
+	Col++)
+      free ((void *) Values[Col]);
+
+   /***** Print queries that take more time *****/
+   sprintf (Query,"SELECT log_prof_queries.Site,log_prof_queries.Query,"
+		  "COUNT(*),SUM(log_prof_queries.Time),"
+		  "AVG(log_prof_queries.Time),MAX(log_prof_queries.Time),"
+		  "AVG(log_prof_queries.NumRows)"
+		  " FROM log_prof,log_prof_queries"
+		  " WHERE log_prof.ClickTime>FROM_UNIXTIME(UNIX_TIMESTAMP()-'%lu')%s"
+		  " AND log_prof.LogCod=log_prof_queries.LogCod"
+		  " GROUP BY log_prof_queries.Site,log_prof_queries.Query"
+		  " ORDER BY SUM(log_prof_queries.Time) DESC"
+		  " LIMIT %u",
+	    (unsigned long) Days * 24UL * 60UL * 60UL,StrActCod,
+	    MAX_SLOW_QUERY_SITES);
+   mysql_res = ExecuteSelect (Query);
+   NumRows = (unsigned long) mysql_num_rows (mysql_res);
+
+   printf ("\nSlowest queries (total/average/maximum time in ms)\n"
+	   "Times\tTotal\tAverage\tMaximum\tRows\tSite\tQuery\n");
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+      printf ("%s\t%.1f\t%.1f\t%.1f\t%s\t%s\t%s\n",
+	      row[2],
+	      strtod (row[3],NULL) / 1000.0,
+	      strtod (row[4],NULL) / 1000.0,
+	      strtod (row[5],NULL) / 1000.0,
+	      row[6],row[0],row[1]);
+     }
+   mysql_free_result (mysql_res);
+
+   mysql_close (&mysql);
+   return 0;
+  }
@@ -64,6 +64,31 @@ extern struct Globals Gbl;
 
 #define Rec_SHOW_OFFICE_HOURS_DEFAULT	true
 
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+struct Rec_StdInCrs
+  {
+   char EncryptedUsrCod[Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+1];
+   long UsrCod;
+   bool Accepted;
+  };
+
+struct Rec_CrsRecordText
+  {
+   long UsrCod;
+   long FieldCod;
+   const char *Txt;	// Points to a row of the result of the query
+  };
+
+struct Rec_CrsRecordTexts
+  {
+   MYSQL_RES *mysql_res;	// Holds the texts of all the fields
+   unsigned Num;
+   struct Rec_CrsRecordText *Lst;
+  };
+
 /*****************************************************************************/
 /***************************** Private prototypes ****************************/
 /*****************************************************************************/
@@ -73,6 +98,8 @@ static void Rec_GetFieldByCod (long FieldCod,char *Name,unsigned *NumLines,Rec_V
 
 static void Rec_ShowRecordOneStdCrs (void);
 static void Rec_ListRecordsStds (Rec_RecordViewType_t TypeOfView);
+static unsigned Rec_GetSelectedStdsInCrs (unsigned MaxStds,struct Rec_StdInCrs *Stds);
+static int Rec_CompareStdsInCrs (const void *p1,const void *p2);
 static void Rec_ShowRecordOneTchCrs (void);
 
 static void Rec_ShowLinkToPrintPreviewOfRecords (void);
@@ -80,7 +107,14 @@ static void Rec_GetParamRecordsPerPage (void);
 static void Rec_WriteFormShowOfficeHours (bool ShowOfficeHours,const char *ListUsrCods);
 static bool Rec_GetParamShowOfficeHours (void);
 static void Rec_ShowCrsRecord (Rec_RecordViewType_t TypeOfView,struct UsrData *UsrDat,
+                               const struct Rec_CrsRecordTexts *Texts,
                                const char *Anchor);
+static void Rec_GetCrsRecordTexts (struct Rec_CrsRecordTexts *Texts,
+                                   unsigned NumUsrs,const long *LstUsrCods);
+static const char *Rec_GetCrsRecordText (const struct Rec_CrsRecordTexts *Texts,
+                                         long UsrCod,long FieldCod);
+static int Rec_CompareCrsRecordTexts (const void *p1,const void *p2);
+static void Rec_FreeCrsRecordTexts (struct Rec_CrsRecordTexts *Texts);
 static void Rec_ShowMyCrsRecordUpdated (void);
 
 static void Rec_PutIconsCommands (void);
@@ -1069,10 +1103,10 @@ static void Rec_ShowRecordOneStdCrs (void)
      {
       if (Gbl.Usrs.Me.LoggedRole == Rol_TEACHER ||
 	  Gbl.Usrs.Me.LoggedRole == Rol_SYS_ADM)
-	 Rec_ShowCrsRecord (Rec_RECORD_LIST,&Gbl.Usrs.Other.UsrDat,NULL);
+	 Rec_ShowCrsRecord (Rec_RECORD_LIST,&Gbl.Usrs.Other.UsrDat,NULL,NULL);
       else if (Gbl.Usrs.Me.LoggedRole == Rol_STUDENT &&
 	       Gbl.Usrs.Me.UsrDat.UsrCod == Gbl.Usrs.Other.UsrDat.UsrCod)	// It's me
-	 Rec_ShowCrsRecord (Rec_FORM_MY_COURSE_RECORD_AS_STUDENT,&Gbl.Usrs.Other.UsrDat,NULL);
+	 Rec_ShowCrsRecord (Rec_FORM_MY_COURSE_RECORD_AS_STUDENT,&Gbl.Usrs.Other.UsrDat,NULL,NULL);
      }
 
    /* Free list of fields of records */
@@ -1097,6 +1131,14 @@ static void Rec_ListRecordsStds (Rec_RecordViewType_t TypeOfView)
   {
    extern const char *Txt_You_must_select_one_ore_more_students;
    unsigned NumUsr = 0;
+   unsigned NumStdsSelected;
+   unsigned NumStds;
+   unsigned NumStd;
+   struct Rec_StdInCrs *Stds;
+   long *LstUsrCods;
+   struct Usr_PrefetchedUsrsData UsrsData;
+   struct Rec_CrsRecordTexts Texts;
+   const struct Rec_StdInCrs *Std;
    const char *Ptr;
    char Anchor[32];
    struct UsrData UsrDat;
@@ -1112,7 +1154,7 @@ static void Rec_ListRecordsStds (Rec_RecordViewType_t TypeOfView)
    Usr_GetListsSelectedUsrsCods ();
 
    /* Check the number of students to show */
-   if (!Usr_CountNumUsrsInListOfSelectedUsrs ())	// If no students selected...
+   if (!(NumStdsSelected = Usr_CountNumUsrsInListOfSelectedUsrs ()))	// If no students selected...
      {						// ...write warning notice
       Lay_ShowAlert (Lay_WARNING,Txt_You_must_select_one_ore_more_students);
       Usr_SeeStudents ();			// ...show again the form
@@ -1138,58 +1180,86 @@ static void Rec_ListRecordsStds (Rec_RecordViewType_t TypeOfView)
       fprintf (Gbl.F.Out,"</div>");
      }
 
+   /***** Get the selected users who belong to the current course *****/
+   if ((Stds = (struct Rec_StdInCrs *) malloc (NumStdsSelected * sizeof (struct Rec_StdInCrs))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store list of users.");
+   NumStds = Rec_GetSelectedStdsInCrs (NumStdsSelected,Stds);
+
+   /***** Get the data of all those users
+          and the texts of the fields of their records at once *****/
+   Texts.mysql_res = NULL;
+   Texts.Num = 0;
+   Texts.Lst = NULL;
+   if ((LstUsrCods = (long *) malloc ((NumStds ? NumStds :
+	                                         1) * sizeof (long))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store list of users.");
+   for (NumStd = 0;
+	NumStd < NumStds;
+	NumStd++)
+      LstUsrCods[NumStd] = Stds[NumStd].UsrCod;
+   Usr_PrefetchAllUsrDataOfUsrs (&UsrsData,NumStds,LstUsrCods);
+   if (NumStds && Gbl.CurrentCrs.Records.LstFields.Num)	// There are fields in the record
+      Rec_GetCrsRecordTexts (&Texts,NumStds,LstUsrCods);
+   free ((void *) LstUsrCods);
+
    /***** Initialize structure with user's data *****/
    Usr_UsrDataConstructor (&UsrDat);
 
-   /***** List the records *****/
+   /***** List the records in the order in which they were selected *****/
    Ptr = Gbl.Usrs.Select.All;
    while (*Ptr)
      {
       Par_GetNextStrUntilSeparParamMult (&Ptr,UsrDat.EncryptedUsrCod,Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64);
-      Usr_GetUsrCodFromEncryptedUsrCod (&UsrDat);
-      if (Usr_ChkUsrCodAndGetAllUsrDataFromUsrCod (&UsrDat))                // Get from the database the data of the student
-         if (Usr_CheckIfUsrBelongsToCrs (UsrDat.UsrCod,
-                                         Gbl.CurrentCrs.Crs.CrsCod,
-                                         false))
-           {
-            /* Check if this student has accepted
-               his/her inscription in the current course */
-            UsrDat.Accepted = Usr_CheckIfUsrBelongsToCrs (UsrDat.UsrCod,
-                                                          Gbl.CurrentCrs.Crs.CrsCod,
-                                                          true);
-
-            /* Start records of this student */
-            sprintf (Anchor,"record_%u",NumUsr);
-            fprintf (Gbl.F.Out,"<section id=\"%s\""
-        	               " class=\"CENTER_MIDDLE\""
-        	               " style=\"margin-bottom:12px;",
-        	     Anchor);
-            if (Gbl.Action.Act == ActPrnRecSevStd &&
-                NumUsr != 0 &&
-                (NumUsr % Gbl.Usrs.Listing.RecsPerPag) == 0)
-               fprintf (Gbl.F.Out,"page-break-before:always;");
-            fprintf (Gbl.F.Out,"\">");
-
-            /* Common record */
-            Rec_ShowSharedUsrRecord (TypeOfView,&UsrDat);
-
-            /* Record of the student in the course */
-            if (Gbl.CurrentCrs.Records.LstFields.Num)	// There are fields in the record
-	       if ( Gbl.Usrs.Me.LoggedRole == Rol_TEACHER ||
-		    Gbl.Usrs.Me.LoggedRole == Rol_SYS_ADM ||
-		   (Gbl.Usrs.Me.LoggedRole == Rol_STUDENT &&		// I am student in this course...
-		    Gbl.Usrs.Me.UsrDat.UsrCod == UsrDat.UsrCod))	// ...and it's me
-		  Rec_ShowCrsRecord (TypeOfView,&UsrDat,Anchor);
-
-            fprintf (Gbl.F.Out,"</section>");
-
-            NumUsr++;
-           }
+      if ((Std = bsearch (UsrDat.EncryptedUsrCod,Stds,NumStds,sizeof (struct Rec_StdInCrs),
+                          Rec_CompareStdsInCrs)))	// The student belongs to the current course
+        {
+         /* Get the data of the student */
+         UsrDat.UsrCod = Std->UsrCod;
+         Usr_GetAllUsrDataFromPrefetched (&UsrsData,&UsrDat);
+
+         /* Check if this student has accepted
+            his/her inscription in the current course */
+         UsrDat.Accepted = Std->Accepted;
+
+         /* Start records of this student */
+         sprintf (Anchor,"record_%u",NumUsr);
+         fprintf (Gbl.F.Out,"<section id=\"%s\""
+                            " class=\"CENTER_MIDDLE\""
+                            " style=\"margin-bottom:12px;",
+                  Anchor);
+         if (Gbl.Action.Act == ActPrnRecSevStd &&
+             NumUsr != 0 &&
+             (NumUsr % Gbl.Usrs.Listing.RecsPerPag) == 0)
+            fprintf (Gbl.F.Out,"page-break-before:always;");
+         fprintf (Gbl.F.Out,"\">");
+
+         /* Common record */
+         Rec_ShowSharedUsrRecord (TypeOfView,&UsrDat);
+
+         /* Record of the student in the course */
+         if (Gbl.CurrentCrs.Records.LstFields.Num)	// There are fields in the record
+	    if ( Gbl.Usrs.Me.LoggedRole == Rol_TEACHER ||
+		 Gbl.Usrs.Me.LoggedRole == Rol_SYS_ADM ||
+		(Gbl.Usrs.Me.LoggedRole == Rol_STUDENT &&		// I am student in this course...
+		 Gbl.Usrs.Me.UsrDat.UsrCod == UsrDat.UsrCod))	// ...and it's me
+	       Rec_ShowCrsRecord (TypeOfView,&UsrDat,&Texts,Anchor);
+
+         fprintf (Gbl.F.Out,"</section>");
+
+         NumUsr++;
+        }
      }
 
    /***** Free memory used for user's data *****/
    Usr_UsrDataDestructor (&UsrDat);
 
+   /***** Free the data of the users and the texts of the fields of the records *****/
+   Usr_FreePrefetchedUsrsData (&UsrsData);
+   Rec_FreeCrsRecordTexts (&Texts);
+
+   /***** Free list of students *****/
+   free ((void *) Stds);
+
    /***** Free list of fields of records *****/
    // if (Gbl.Usrs.Listing.RecsUsrs == Rec_RECORD_USERS_STUDENTS)
       Rec_FreeListFields ();
@@ -1198,6 +1268,80 @@ static void Rec_ListRecordsStds (Rec_RecordViewType_t TypeOfView)
    Usr_FreeListsSelectedUsrsCods ();
   }
 
+/*****************************************************************************/
+/********* Get the selected users who belong to the current course ***********/
+/*****************************************************************************/
+// Return the number of users got, sorted by encrypted user's code
+
+static unsigned Rec_GetSelectedStdsInCrs (unsigned MaxStds,struct Rec_StdInCrs *Stds)
+  {
+   char *Query;
+   size_t Length;
+   const char *Ptr;
+   char EncryptedUsrCod[Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+1];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned long NumRows;
+   unsigned NumStds;
+
+   /***** Allocate space for query *****/
+   if ((Query = (char *) malloc (512 + MaxStds * (Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64+3))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store database query.");
+
+   /***** Get users' codes and if they have accepted
+          their enrollment in the current course from database *****/
+   Length = sprintf (Query,"SELECT usr_data.EncryptedUsrCod,usr_data.UsrCod,crs_usr.Accepted"
+	                   " FROM usr_data,crs_usr"
+	                   " WHERE usr_data.EncryptedUsrCod IN (''");
+   Ptr = Gbl.Usrs.Select.All;
+   while (*Ptr)
+     {
+      Par_GetNextStrUntilSeparParamMult (&Ptr,EncryptedUsrCod,Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64);
+      Length += sprintf (&Query[Length],",'%s'",EncryptedUsrCod);
+     }
+   sprintf (&Query[Length],")"
+	                   " AND crs_usr.CrsCod='%ld'"
+	                   " AND crs_usr.UsrCod=usr_data.UsrCod",
+	    Gbl.CurrentCrs.Crs.CrsCod);
+   NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get users in course");
+
+   /***** Free space used for query *****/
+   free ((void *) Query);
+
+   /***** Get the users *****/
+   for (NumStds = 0;
+	NumStds < (unsigned) NumRows &&
+	NumStds < MaxStds;
+	NumStds++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get encrypted user's code (row[0]) */
+      strncpy (Stds[NumStds].EncryptedUsrCod,row[0],Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64);
+      Stds[NumStds].EncryptedUsrCod[Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64] = '\0';
+
+      /* Get user's code (row[1]) */
+      Stds[NumStds].UsrCod = Str_ConvertStrCodToLongCod (row[1]);
+
+      /* Get if user has accepted enrollment (row[2]) */
+      Stds[NumStds].Accepted = (row[2][0] == 'Y');
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Sort users by encrypted code in order to search them quickly *****/
+   qsort (Stds,NumStds,sizeof (struct Rec_StdInCrs),Rec_CompareStdsInCrs);
+
+   return NumStds;
+  }
+
+static int Rec_CompareStdsInCrs (const void *p1,const void *p2)
+  {
+   // The first member of struct Rec_StdInCrs is the encrypted user's code
+   return strcmp ((const char *) p1,(const char *) p2);
+  }
+
 /*****************************************************************************/
 /********** Get user's data and draw record of one unique teacher ************/
 /*****************************************************************************/
@@ -1539,6 +1683,7 @@ void Rec_UpdateAndShowOtherCrsRecord (void)
 // Show form or only data depending on TypeOfView
 
 static void Rec_ShowCrsRecord (Rec_RecordViewType_t TypeOfView,struct UsrData *UsrDat,
+                               const struct Rec_CrsRecordTexts *Texts,
                                const char *Anchor)
   {
    extern const char *The_ClassForm[The_NUM_THEMES];
@@ -1551,10 +1696,9 @@ static void Rec_ShowCrsRecord (Rec_RecordViewType_t TypeOfView,struct UsrData *U
    bool ItsMe;
    bool DataForm = false;
    unsigned NumField;
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row = NULL; // Initialized to avoid warning
+   struct Rec_CrsRecordTexts TextsOfThisUsr;
+   const char *Txt;
    bool ShowField;
-   bool ThisFieldHasText;
    bool ICanEdit;
    char Text[Cns_MAX_BYTES_TEXT+1];
 
@@ -1611,6 +1755,13 @@ static void Rec_ShowCrsRecord (Rec_RecordViewType_t TypeOfView,struct UsrData *U
 
    Col2Width = Rec_RECORD_WIDTH - 10 * 2 - Col1Width;
 
+   /***** If texts of the fields are not got yet, get them for this user *****/
+   if (!Texts)
+     {
+      Rec_GetCrsRecordTexts (&TextsOfThisUsr,1,&UsrDat->UsrCod);
+      Texts = &TextsOfThisUsr;
+     }
+
    /***** Start frame *****/
    sprintf (StrRecordWidth,"%upx",Rec_RECORD_WIDTH);
    Lay_StartRoundFrameTable (StrRecordWidth,2,NULL);
@@ -1665,13 +1816,8 @@ static void Rec_ShowCrsRecord (Rec_RecordViewType_t TypeOfView,struct UsrData *U
          fprintf (Gbl.F.Out,"</td>");
 
          /***** Get the text of the field *****/
-         if (Rec_GetFieldFromCrsRecord (UsrDat->UsrCod,Gbl.CurrentCrs.Records.LstFields.Lst[NumField].FieldCod,&mysql_res))
-           {
-            ThisFieldHasText = true;
-            row = mysql_fetch_row (mysql_res);
-           }
-         else
-            ThisFieldHasText = false;
+         Txt = Rec_GetCrsRecordText (Texts,UsrDat->UsrCod,
+                                     Gbl.CurrentCrs.Records.LstFields.Lst[NumField].FieldCod);
 
          /***** Write form, text, or nothing depending on
                 the user's role and the visibility of the field *****/
@@ -1684,15 +1830,16 @@ static void Rec_ShowCrsRecord (Rec_RecordViewType_t TypeOfView,struct UsrData *U
         	               " style=\"width:450px;\">",
                      Gbl.CurrentCrs.Records.LstFields.Lst[NumField].FieldCod,
                      Gbl.CurrentCrs.Records.LstFields.Lst[NumField].NumLines);
-            if (ThisFieldHasText)
-               fprintf (Gbl.F.Out,"%s",row[0]);
+            if (Txt)
+               fprintf (Gbl.F.Out,"%s",Txt);
             fprintf (Gbl.F.Out,"</textarea>");
            }
          else		// Show without form
            {
-            if (ThisFieldHasText)
+            if (Txt)
               {
-               strcpy (Text,row[0]);
+               strncpy (Text,Txt,Cns_MAX_BYTES_TEXT);
+               Text[Cns_MAX_BYTES_TEXT] = '\0';
                Str_ChangeFormat (Str_FROM_HTML,Str_TO_RIGOROUS_HTML,
                                  Text,Cns_MAX_BYTES_TEXT,false);
                fprintf (Gbl.F.Out,"%s",Text);
@@ -1702,12 +1849,13 @@ static void Rec_ShowCrsRecord (Rec_RecordViewType_t TypeOfView,struct UsrData *U
            }
          fprintf (Gbl.F.Out,"</td>"
                             "</tr>");
-
-         /***** Free structure that stores the query result *****/
-         DB_FreeMySQLResult (&mysql_res);
         }
      }
 
+   /***** Free the texts got for this user *****/
+   if (Texts == &TextsOfThisUsr)
+      Rec_FreeCrsRecordTexts (&TextsOfThisUsr);
+
    /***** Button to save changes and end frame *****/
    if (DataForm)
      {
@@ -1718,6 +1866,119 @@ static void Rec_ShowCrsRecord (Rec_RecordViewType_t TypeOfView,struct UsrData *U
       Lay_EndRoundFrameTable ();
   }
 
+/*****************************************************************************/
+/****** Get the texts of all the fields of the records of several users ******/
+/*****************************************************************************/
+// The texts remain in the result of the query until Rec_FreeCrsRecordTexts
+
+static void Rec_GetCrsRecordTexts (struct Rec_CrsRecordTexts *Texts,
+                                   unsigned NumUsrs,const long *LstUsrCods)
+  {
+   char *Query;
+   size_t Length;
+   unsigned NumUsr;
+   MYSQL_ROW row;
+   unsigned NumText;
+
+   /***** Allocate space for query *****/
+   if ((Query = (char *) malloc (512 + NumUsrs * (1+1+10+1))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store database query.");
+
+   /***** Get the texts of the fields of the records in current course from database *****/
+   Length = sprintf (Query,"SELECT crs_records.UsrCod,crs_records.FieldCod,crs_records.Txt"
+	                   " FROM crs_record_fields,crs_records"
+	                   " WHERE crs_record_fields.CrsCod='%ld'"
+	                   " AND crs_record_fields.FieldCod=crs_records.FieldCod"
+	                   " AND crs_records.UsrCod IN (",
+	             Gbl.CurrentCrs.Crs.CrsCod);
+   for (NumUsr = 0;
+	NumUsr < NumUsrs;
+	NumUsr++)
+      Length += sprintf (&Query[Length],"%s'%ld'",
+                         NumUsr ? "," :
+                                  "",
+                         LstUsrCods[NumUsr]);
+   strcpy (&Query[Length],")");
+   Texts->Num = (unsigned) DB_QuerySELECT (Query,&Texts->mysql_res,"can not get the text of fields of records");
+
+   /***** Free space used for query *****/
+   free ((void *) Query);
+
+   /***** Build a list of texts sorted by user and field *****/
+   Texts->Lst = NULL;
+   if (Texts->Num)
+     {
+      if ((Texts->Lst = (struct Rec_CrsRecordText *) malloc (Texts->Num * sizeof (struct Rec_CrsRecordText))) == NULL)
+         Lay_ShowErrorAndExit ("Not enough memory to store the text of fields of records.");
+      for (NumText = 0;
+	   NumText < Texts->Num;
+	   NumText++)
+	{
+	 row = mysql_fetch_row (Texts->mysql_res);
+	 Texts->Lst[NumText].UsrCod   = Str_ConvertStrCodToLongCod (row[0]);
+	 Texts->Lst[NumText].FieldCod = Str_ConvertStrCodToLongCod (row[1]);
+	 Texts->Lst[NumText].Txt      = row[2];
+	}
+      qsort (Texts->Lst,Texts->Num,sizeof (struct Rec_CrsRecordText),Rec_CompareCrsRecordTexts);
+     }
+  }
+
+/*****************************************************************************/
+/******** Get the text of a field of a record from a list of texts ***********/
+/*****************************************************************************/
+// Return NULL if the field of this user has no text
+
+static const char *Rec_GetCrsRecordText (const struct Rec_CrsRecordTexts *Texts,
+                                         long UsrCod,long FieldCod)
+  {
+   struct Rec_CrsRecordText Key;
+   const struct Rec_CrsRecordText *Found;
+
+   if (Texts->Num)
+     {
+      Key.UsrCod   = UsrCod;
+      Key.FieldCod = FieldCod;
+      if ((Found = bsearch (&Key,Texts->Lst,Texts->Num,sizeof (struct Rec_CrsRecordText),
+                            Rec_CompareCrsRecordTexts)))
+         return Found->Txt;
+     }
+
+   return NULL;
+  }
+
+static int Rec_CompareCrsRecordTexts (const void *p1,const void *p2)
+  {
+   const struct Rec_CrsRecordText *Txt1 = (const struct Rec_CrsRecordText *) p1;
+   const struct Rec_CrsRecordText *Txt2 = (const struct Rec_CrsRecordText *) p2;
+
+   if (Txt1->UsrCod != Txt2->UsrCod)
+      return (Txt1->UsrCod < Txt2->UsrCod) ? -1 :
+	                                     1;
+   if (Txt1->FieldCod != Txt2->FieldCod)
+      return (Txt1->FieldCod < Txt2->FieldCod) ? -1 :
+	                                         1;
+   return 0;
+  }
+
+/*****************************************************************************/
+/*************** Free the texts of the fields of the records *****************/
+/*****************************************************************************/
+
+static void Rec_FreeCrsRecordTexts (struct Rec_CrsRecordTexts *Texts)
+  {
+   if (Texts->Lst)
+     {
+      free ((void *) Texts->Lst);
+      Texts->Lst = NULL;
+     }
+   if (Texts->mysql_res)
+     {
+      DB_FreeMySQLResult (&Texts->mysql_res);
+      Texts->mysql_res = NULL;
+     }
+   Texts->Num = 0;
+  }
+
 /*****************************************************************************/
 /************** Get the text of a field of a record of course ****************/
 /*****************************************************************************/
@@ -1863,7 +2124,7 @@ static void Rec_ShowMyCrsRecordUpdated (void)
    Rec_ShowSharedUsrRecord (Rec_RECORD_LIST,&Gbl.Usrs.Me.UsrDat);
 
    /***** Show updated user's record *****/
-   Rec_ShowCrsRecord (Rec_CHECK_MY_COURSE_RECORD_AS_STUDENT,&Gbl.Usrs.Me.UsrDat,NULL);
+   Rec_ShowCrsRecord (Rec_CHECK_MY_COURSE_RECORD_AS_STUDENT,&Gbl.Usrs.Me.UsrDat,NULL,NULL);
   }
 
 /*****************************************************************************/
@@ -324,3 +324,30 @@ Sco_Scope_t Sco_GetScopeFromDBStr (const char *ScopeDBStr)
 
    return Sco_SCOPE_UNK;
   }
+
+/*****************************************************************************/
+/************ Get code of the current country, institution... ****************/
+/*****************************************************************************/
+// Returns the code of the current item in the given scope, or -1 if none
+
+long Sco_GetCodOfScope (Sco_Scope_t Scope)
+  {
+   switch (Scope)
+     {
+      case Sco_SCOPE_SYS:
+	 return -1L;
+      case Sco_SCOPE_CTY:
+	 return Gbl.CurrentCty.Cty.CtyCod;
+      case Sco_SCOPE_INS:
+	 return Gbl.CurrentIns.Ins.InsCod;
+      case Sco_SCOPE_CTR:
+	 return Gbl.CurrentCtr.Ctr.CtrCod;
+      case Sco_SCOPE_DEG:
+	 return Gbl.CurrentDeg.Deg.DegCod;
+      case Sco_SCOPE_CRS:
+	 return Gbl.CurrentCrs.Crs.CrsCod;
+      default:
+	 Lay_ShowErrorAndExit ("Wrong scope.");
+	 return -1L;	// Not reached
+     }
+  }
@@ -63,4 +63,6 @@ void Sco_SetScopesForListingStudents (void);
 Sco_Scope_t Sco_GetScopeFromUnsignedStr (const char *UnsignedStr);
 Sco_Scope_t Sco_GetScopeFromDBStr (const char *ScopeDBStr);
 
+long Sco_GetCodOfScope (Sco_Scope_t Scope);
+
 #endif
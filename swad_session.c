@@ -235,7 +235,7 @@ static void Ses_RemoveSessionFromDB (void)
 /*************************** Remove expired sessions *************************/
 /*****************************************************************************/
 
-void Ses_RemoveExpiredSessions (void)
+unsigned long Ses_RemoveExpiredSessions (void)
   {
    char Query[1024];
 
@@ -253,6 +253,9 @@ void Ses_RemoveExpiredSessions (void)
             Cfg_TIME_TO_CLOSE_SESSION_FROM_LAST_CLICK,
             Cfg_TIME_TO_CLOSE_SESSION_FROM_LAST_REFRESH);
    DB_QueryDELETE (Query,"can not remove expired sessions");
+
+   /***** Return number of sessions removed *****/
+   return (unsigned long) mysql_affected_rows (&Gbl.mysql);
   }
 
 /*****************************************************************************/
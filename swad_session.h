@@ -49,7 +49,7 @@ void Ses_CloseSession (void);
 void Ses_InsertSessionInDB (void);
 void Ses_UpdateSessionDataInDB (void);
 void Ses_UpdateSessionLastRefreshInDB (void);
-void Ses_RemoveExpiredSessions (void);
+unsigned long Ses_RemoveExpiredSessions (void);
 bool Ses_GetSessionData (void);
 void Ses_InsertHiddenParInDB (Act_Action_t Action,const char *ParamName,const char *ParamValue);
 void Ses_RemoveHiddenParFromThisSession (void);
@@ -37,6 +37,7 @@
 #include "swad_config.h"
 #include "swad_course.h"
 #include "swad_database.h"
+#include "swad_figure_cache.h"
 #include "swad_file_browser.h"
 #include "swad_follow.h"
 #include "swad_forum.h"
@@ -48,6 +49,7 @@
 #include "swad_notification.h"
 #include "swad_parameter.h"
 #include "swad_profile.h"
+#include "swad_profiler.h"
 #include "swad_social.h"
 #include "swad_statistic.h"
 #include "swad_tab.h"
@@ -327,8 +329,13 @@ void Sta_LogAccess (const char *Comments)
          Svc_Exit ("can not log access (recent)");
      }
    else
+     {
       DB_QueryINSERT (Query,"can not log access (recent)");
 
+      /* Log time spent in each phase and slowest queries */
+      Pfl_StoreProfile (LogCod,Act_Actions[Gbl.Action.Act].ActCod);
+     }
+
    if (Comments)
      {
       /* Log comments */
@@ -4147,6 +4154,7 @@ static void Sta_GetAndShowNumCtysInSWAD (void)
   {
    extern const char *Txt_Countries;
    char SubQuery[128];
+   long Cod;
    unsigned NumCtysTotal = 0;
    unsigned NumCtysWithInss = 0;
    unsigned NumCtysWithCtrs = 0;
@@ -4155,77 +4163,97 @@ static void Sta_GetAndShowNumCtysInSWAD (void)
    unsigned NumCtysWithTchs = 0;
    unsigned NumCtysWithStds = 0;
 
-   /***** Get number of countries *****/
-   switch (Gbl.Scope.Current)
+   /***** Get number of countries from cache *****/
+   Cod = Sco_GetCodOfScope (Gbl.Scope.Current);
+   if (!(FigCch_GetFigureFromCache (FigCch_NUM_CTYS,Gbl.Scope.Current,Cod,&NumCtysTotal) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTYS_WITH_INSS,Gbl.Scope.Current,Cod,&NumCtysWithInss) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTYS_WITH_CTRS,Gbl.Scope.Current,Cod,&NumCtysWithCtrs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTYS_WITH_DEGS,Gbl.Scope.Current,Cod,&NumCtysWithDegs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTYS_WITH_CRSS,Gbl.Scope.Current,Cod,&NumCtysWithCrss) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTYS_WITH_TCHS,Gbl.Scope.Current,Cod,&NumCtysWithTchs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTYS_WITH_STDS,Gbl.Scope.Current,Cod,&NumCtysWithStds)))
      {
-      case Sco_SCOPE_SYS:
-	 NumCtysTotal = Cty_GetNumCtysTotal ();
-         NumCtysWithInss = Cty_GetNumCtysWithInss ("");
-	 NumCtysWithCtrs = Cty_GetNumCtysWithCtrs ("");
-	 NumCtysWithDegs = Cty_GetNumCtysWithDegs ("");
-	 NumCtysWithCrss = Cty_GetNumCtysWithCrss ("");
-         NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,"");
-	 NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,"");
-         SubQuery[0] = '\0';
-         break;
-      case Sco_SCOPE_CTY:
-	 NumCtysTotal = 1;
-	 NumCtysWithInss = 1;
-         sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
-                  Gbl.CurrentCty.Cty.CtyCod);
-	 NumCtysWithCtrs = Cty_GetNumCtysWithCtrs (SubQuery);
-	 NumCtysWithDegs = Cty_GetNumCtysWithDegs (SubQuery);
-	 NumCtysWithCrss = Cty_GetNumCtysWithCrss (SubQuery);
-         NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_INS:
-	 NumCtysTotal = 1;
-	 NumCtysWithInss = 1;
-         sprintf (SubQuery,"centres.InsCod='%ld' AND ",
-                  Gbl.CurrentIns.Ins.InsCod);
-	 NumCtysWithCtrs = Cty_GetNumCtysWithCtrs (SubQuery);
-	 NumCtysWithDegs = Cty_GetNumCtysWithDegs (SubQuery);
-	 NumCtysWithCrss = Cty_GetNumCtysWithCrss (SubQuery);
-         NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_CTR:
-	 NumCtysTotal = 1;
-	 NumCtysWithInss = 1;
-	 NumCtysWithCtrs = 1;
-         sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
-                  Gbl.CurrentCtr.Ctr.CtrCod);
-	 NumCtysWithDegs = Cty_GetNumCtysWithDegs (SubQuery);
-	 NumCtysWithCrss = Cty_GetNumCtysWithCrss (SubQuery);
-         NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      case Sco_SCOPE_DEG:
-	 NumCtysTotal = 1;
-	 NumCtysWithInss = 1;
-	 NumCtysWithCtrs = 1;
-	 NumCtysWithDegs = 1;
-         sprintf (SubQuery,"courses.DegCod='%ld' AND ",
-                  Gbl.CurrentDeg.Deg.DegCod);
-	 NumCtysWithCrss = Cty_GetNumCtysWithCrss (SubQuery);
-         NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-     case Sco_SCOPE_CRS:
-	 NumCtysTotal = 1;
-	 NumCtysWithInss = 1;
-	 NumCtysWithCtrs = 1;
-	 NumCtysWithDegs = 1;
-	 NumCtysWithCrss = 1;
-         sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
-                  Gbl.CurrentCrs.Crs.CrsCod);
-         NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      default:
-	 Lay_ShowErrorAndExit ("Wrong scope.");
-	 break;
+      /***** Get number of countries from database *****/
+      switch (Gbl.Scope.Current)
+        {
+         case Sco_SCOPE_SYS:
+	    NumCtysTotal = Cty_GetNumCtysTotal ();
+            NumCtysWithInss = Cty_GetNumCtysWithInss ("");
+	    NumCtysWithCtrs = Cty_GetNumCtysWithCtrs ("");
+	    NumCtysWithDegs = Cty_GetNumCtysWithDegs ("");
+	    NumCtysWithCrss = Cty_GetNumCtysWithCrss ("");
+            NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,"");
+	    NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,"");
+            SubQuery[0] = '\0';
+            break;
+         case Sco_SCOPE_CTY:
+	    NumCtysTotal = 1;
+	    NumCtysWithInss = 1;
+            sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
+                     Gbl.CurrentCty.Cty.CtyCod);
+	    NumCtysWithCtrs = Cty_GetNumCtysWithCtrs (SubQuery);
+	    NumCtysWithDegs = Cty_GetNumCtysWithDegs (SubQuery);
+	    NumCtysWithCrss = Cty_GetNumCtysWithCrss (SubQuery);
+            NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_INS:
+	    NumCtysTotal = 1;
+	    NumCtysWithInss = 1;
+            sprintf (SubQuery,"centres.InsCod='%ld' AND ",
+                     Gbl.CurrentIns.Ins.InsCod);
+	    NumCtysWithCtrs = Cty_GetNumCtysWithCtrs (SubQuery);
+	    NumCtysWithDegs = Cty_GetNumCtysWithDegs (SubQuery);
+	    NumCtysWithCrss = Cty_GetNumCtysWithCrss (SubQuery);
+            NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_CTR:
+	    NumCtysTotal = 1;
+	    NumCtysWithInss = 1;
+	    NumCtysWithCtrs = 1;
+            sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
+                     Gbl.CurrentCtr.Ctr.CtrCod);
+	    NumCtysWithDegs = Cty_GetNumCtysWithDegs (SubQuery);
+	    NumCtysWithCrss = Cty_GetNumCtysWithCrss (SubQuery);
+            NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         case Sco_SCOPE_DEG:
+	    NumCtysTotal = 1;
+	    NumCtysWithInss = 1;
+	    NumCtysWithCtrs = 1;
+	    NumCtysWithDegs = 1;
+            sprintf (SubQuery,"courses.DegCod='%ld' AND ",
+                     Gbl.CurrentDeg.Deg.DegCod);
+	    NumCtysWithCrss = Cty_GetNumCtysWithCrss (SubQuery);
+            NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+        case Sco_SCOPE_CRS:
+	    NumCtysTotal = 1;
+	    NumCtysWithInss = 1;
+	    NumCtysWithCtrs = 1;
+	    NumCtysWithDegs = 1;
+	    NumCtysWithCrss = 1;
+            sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
+                     Gbl.CurrentCrs.Crs.CrsCod);
+            NumCtysWithTchs = Cty_GetNumCtysWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtysWithStds = Cty_GetNumCtysWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         default:
+	    Lay_ShowErrorAndExit ("Wrong scope.");
+	    break;
+        }
+
+      /***** Update numbers in cache *****/
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTYS,Gbl.Scope.Current,Cod,NumCtysTotal);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTYS_WITH_INSS,Gbl.Scope.Current,Cod,NumCtysWithInss);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTYS_WITH_CTRS,Gbl.Scope.Current,Cod,NumCtysWithCtrs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTYS_WITH_DEGS,Gbl.Scope.Current,Cod,NumCtysWithDegs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTYS_WITH_CRSS,Gbl.Scope.Current,Cod,NumCtysWithCrss);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTYS_WITH_TCHS,Gbl.Scope.Current,Cod,NumCtysWithTchs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTYS_WITH_STDS,Gbl.Scope.Current,Cod,NumCtysWithStds);
      }
 
    /***** Write number of countries *****/
@@ -4279,6 +4307,7 @@ static void Sta_GetAndShowNumInssInSWAD (void)
   {
    extern const char *Txt_Institutions;
    char SubQuery[128];
+   long Cod;
    unsigned NumInssTotal = 0;
    unsigned NumInssWithCtrs = 0;
    unsigned NumInssWithDegs = 0;
@@ -4286,71 +4315,89 @@ static void Sta_GetAndShowNumInssInSWAD (void)
    unsigned NumInssWithTchs = 0;
    unsigned NumInssWithStds = 0;
 
-   /***** Get number of institutions *****/
-   switch (Gbl.Scope.Current)
+   /***** Get number of institutions from cache *****/
+   Cod = Sco_GetCodOfScope (Gbl.Scope.Current);
+   if (!(FigCch_GetFigureFromCache (FigCch_NUM_INSS,Gbl.Scope.Current,Cod,&NumInssTotal) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_INSS_WITH_CTRS,Gbl.Scope.Current,Cod,&NumInssWithCtrs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_INSS_WITH_DEGS,Gbl.Scope.Current,Cod,&NumInssWithDegs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_INSS_WITH_CRSS,Gbl.Scope.Current,Cod,&NumInssWithCrss) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_INSS_WITH_TCHS,Gbl.Scope.Current,Cod,&NumInssWithTchs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_INSS_WITH_STDS,Gbl.Scope.Current,Cod,&NumInssWithStds)))
      {
-      case Sco_SCOPE_SYS:
-	 NumInssTotal = Ins_GetNumInssTotal ();
-	 NumInssWithCtrs = Ins_GetNumInssWithCtrs ("");
-	 NumInssWithDegs = Ins_GetNumInssWithDegs ("");
-	 NumInssWithCrss = Ins_GetNumInssWithCrss ("");
-         NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,"");
-	 NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,"");
-         SubQuery[0] = '\0';
-         break;
-      case Sco_SCOPE_CTY:
-	 NumInssTotal = Ins_GetNumInssInCty (Gbl.CurrentCty.Cty.CtyCod);
-         sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
-                  Gbl.CurrentCty.Cty.CtyCod);
-	 NumInssWithCtrs = Ins_GetNumInssWithCtrs (SubQuery);
-	 NumInssWithDegs = Ins_GetNumInssWithDegs (SubQuery);
-	 NumInssWithCrss = Ins_GetNumInssWithCrss (SubQuery);
-         NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_INS:
-	 NumInssTotal = 1;
-         sprintf (SubQuery,"centres.InsCod='%ld' AND ",
-                  Gbl.CurrentIns.Ins.InsCod);
-	 NumInssWithCtrs = Ins_GetNumInssWithCtrs (SubQuery);
-	 NumInssWithDegs = Ins_GetNumInssWithDegs (SubQuery);
-	 NumInssWithCrss = Ins_GetNumInssWithCrss (SubQuery);
-         NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_CTR:
-	 NumInssTotal = 1;
-	 NumInssWithCtrs = 1;
-         sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
-                  Gbl.CurrentCtr.Ctr.CtrCod);
-	 NumInssWithDegs = Ins_GetNumInssWithDegs (SubQuery);
-	 NumInssWithCrss = Ins_GetNumInssWithCrss (SubQuery);
-         NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      case Sco_SCOPE_DEG:
-	 NumInssTotal = 1;
-	 NumInssWithCtrs = 1;
-	 NumInssWithDegs = 1;
-         sprintf (SubQuery,"courses.DegCod='%ld' AND ",
-                  Gbl.CurrentDeg.Deg.DegCod);
-	 NumInssWithCrss = Ins_GetNumInssWithCrss (SubQuery);
-         NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-     case Sco_SCOPE_CRS:
-	 NumInssTotal = 1;
-	 NumInssWithCtrs = 1;
-	 NumInssWithDegs = 1;
-	 NumInssWithCrss = 1;
-         sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
-                  Gbl.CurrentCrs.Crs.CrsCod);
-         NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      default:
-	 Lay_ShowErrorAndExit ("Wrong scope.");
-	 break;
+      /***** Get number of institutions from database *****/
+      switch (Gbl.Scope.Current)
+        {
+         case Sco_SCOPE_SYS:
+	    NumInssTotal = Ins_GetNumInssTotal ();
+	    NumInssWithCtrs = Ins_GetNumInssWithCtrs ("");
+	    NumInssWithDegs = Ins_GetNumInssWithDegs ("");
+	    NumInssWithCrss = Ins_GetNumInssWithCrss ("");
+            NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,"");
+	    NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,"");
+            SubQuery[0] = '\0';
+            break;
+         case Sco_SCOPE_CTY:
+	    NumInssTotal = Ins_GetNumInssInCty (Gbl.CurrentCty.Cty.CtyCod);
+            sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
+                     Gbl.CurrentCty.Cty.CtyCod);
+	    NumInssWithCtrs = Ins_GetNumInssWithCtrs (SubQuery);
+	    NumInssWithDegs = Ins_GetNumInssWithDegs (SubQuery);
+	    NumInssWithCrss = Ins_GetNumInssWithCrss (SubQuery);
+            NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_INS:
+	    NumInssTotal = 1;
+            sprintf (SubQuery,"centres.InsCod='%ld' AND ",
+                     Gbl.CurrentIns.Ins.InsCod);
+	    NumInssWithCtrs = Ins_GetNumInssWithCtrs (SubQuery);
+	    NumInssWithDegs = Ins_GetNumInssWithDegs (SubQuery);
+	    NumInssWithCrss = Ins_GetNumInssWithCrss (SubQuery);
+            NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_CTR:
+	    NumInssTotal = 1;
+	    NumInssWithCtrs = 1;
+            sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
+                     Gbl.CurrentCtr.Ctr.CtrCod);
+	    NumInssWithDegs = Ins_GetNumInssWithDegs (SubQuery);
+	    NumInssWithCrss = Ins_GetNumInssWithCrss (SubQuery);
+            NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         case Sco_SCOPE_DEG:
+	    NumInssTotal = 1;
+	    NumInssWithCtrs = 1;
+	    NumInssWithDegs = 1;
+            sprintf (SubQuery,"courses.DegCod='%ld' AND ",
+                     Gbl.CurrentDeg.Deg.DegCod);
+	    NumInssWithCrss = Ins_GetNumInssWithCrss (SubQuery);
+            NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+        case Sco_SCOPE_CRS:
+	    NumInssTotal = 1;
+	    NumInssWithCtrs = 1;
+	    NumInssWithDegs = 1;
+	    NumInssWithCrss = 1;
+            sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
+                     Gbl.CurrentCrs.Crs.CrsCod);
+            NumInssWithTchs = Ins_GetNumInssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumInssWithStds = Ins_GetNumInssWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         default:
+	    Lay_ShowErrorAndExit ("Wrong scope.");
+	    break;
+        }
+
+      /***** Update numbers in cache *****/
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_INSS,Gbl.Scope.Current,Cod,NumInssTotal);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_INSS_WITH_CTRS,Gbl.Scope.Current,Cod,NumInssWithCtrs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_INSS_WITH_DEGS,Gbl.Scope.Current,Cod,NumInssWithDegs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_INSS_WITH_CRSS,Gbl.Scope.Current,Cod,NumInssWithCrss);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_INSS_WITH_TCHS,Gbl.Scope.Current,Cod,NumInssWithTchs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_INSS_WITH_STDS,Gbl.Scope.Current,Cod,NumInssWithStds);
      }
 
    /***** Write number of institutions *****/
@@ -4401,71 +4448,88 @@ static void Sta_GetAndShowNumCtrsInSWAD (void)
   {
    extern const char *Txt_Centres;
    char SubQuery[128];
+   long Cod;
    unsigned NumCtrsTotal = 0;
    unsigned NumCtrsWithDegs = 0;
    unsigned NumCtrsWithCrss = 0;
    unsigned NumCtrsWithTchs = 0;
    unsigned NumCtrsWithStds = 0;
 
-   /***** Get number of centres *****/
-   switch (Gbl.Scope.Current)
+   /***** Get number of centres from cache *****/
+   Cod = Sco_GetCodOfScope (Gbl.Scope.Current);
+   if (!(FigCch_GetFigureFromCache (FigCch_NUM_CTRS,Gbl.Scope.Current,Cod,&NumCtrsTotal) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTRS_WITH_DEGS,Gbl.Scope.Current,Cod,&NumCtrsWithDegs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTRS_WITH_CRSS,Gbl.Scope.Current,Cod,&NumCtrsWithCrss) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTRS_WITH_TCHS,Gbl.Scope.Current,Cod,&NumCtrsWithTchs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CTRS_WITH_STDS,Gbl.Scope.Current,Cod,&NumCtrsWithStds)))
      {
-      case Sco_SCOPE_SYS:
-	 NumCtrsTotal = Ctr_GetNumCtrsTotal ();
-	 NumCtrsWithDegs = Ctr_GetNumCtrsWithDegs ("");
-	 NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss ("");
-         NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,"");
-	 NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,"");
-         SubQuery[0] = '\0';
-         break;
-      case Sco_SCOPE_CTY:
-	 NumCtrsTotal = Ctr_GetNumCtrsInCty (Gbl.CurrentCty.Cty.CtyCod);
-         sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
-                  Gbl.CurrentCty.Cty.CtyCod);
-	 NumCtrsWithDegs = Ctr_GetNumCtrsWithDegs (SubQuery);
-	 NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss (SubQuery);
-         NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_INS:
-	 NumCtrsTotal = Ctr_GetNumCtrsInIns (Gbl.CurrentIns.Ins.InsCod);
-         sprintf (SubQuery,"centres.InsCod='%ld' AND ",
-                  Gbl.CurrentIns.Ins.InsCod);
-	 NumCtrsWithDegs = Ctr_GetNumCtrsWithDegs (SubQuery);
-	 NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss (SubQuery);
-         NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_CTR:
-	 NumCtrsTotal = 1;
-         sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
-                  Gbl.CurrentCtr.Ctr.CtrCod);
-	 NumCtrsWithDegs = Ctr_GetNumCtrsWithDegs (SubQuery);
-	 NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss (SubQuery);
-         NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      case Sco_SCOPE_DEG:
-	 NumCtrsTotal = 1;
-	 NumCtrsWithDegs = 1;
-         sprintf (SubQuery,"courses.DegCod='%ld' AND ",
-                  Gbl.CurrentDeg.Deg.DegCod);
-	 NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss (SubQuery);
-         NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-     case Sco_SCOPE_CRS:
-	 NumCtrsTotal = 1;
-	 NumCtrsWithDegs = 1;
-	 NumCtrsWithCrss = 1;
-         sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
-                  Gbl.CurrentCrs.Crs.CrsCod);
-         NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      default:
-	 Lay_ShowErrorAndExit ("Wrong scope.");
-	 break;
+      /***** Get number of centres from database *****/
+      switch (Gbl.Scope.Current)
+        {
+         case Sco_SCOPE_SYS:
+	    NumCtrsTotal = Ctr_GetNumCtrsTotal ();
+	    NumCtrsWithDegs = Ctr_GetNumCtrsWithDegs ("");
+	    NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss ("");
+            NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,"");
+	    NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,"");
+            SubQuery[0] = '\0';
+            break;
+         case Sco_SCOPE_CTY:
+	    NumCtrsTotal = Ctr_GetNumCtrsInCty (Gbl.CurrentCty.Cty.CtyCod);
+            sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
+                     Gbl.CurrentCty.Cty.CtyCod);
+	    NumCtrsWithDegs = Ctr_GetNumCtrsWithDegs (SubQuery);
+	    NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss (SubQuery);
+            NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_INS:
+	    NumCtrsTotal = Ctr_GetNumCtrsInIns (Gbl.CurrentIns.Ins.InsCod);
+            sprintf (SubQuery,"centres.InsCod='%ld' AND ",
+                     Gbl.CurrentIns.Ins.InsCod);
+	    NumCtrsWithDegs = Ctr_GetNumCtrsWithDegs (SubQuery);
+	    NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss (SubQuery);
+            NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_CTR:
+	    NumCtrsTotal = 1;
+            sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
+                     Gbl.CurrentCtr.Ctr.CtrCod);
+	    NumCtrsWithDegs = Ctr_GetNumCtrsWithDegs (SubQuery);
+	    NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss (SubQuery);
+            NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         case Sco_SCOPE_DEG:
+	    NumCtrsTotal = 1;
+	    NumCtrsWithDegs = 1;
+            sprintf (SubQuery,"courses.DegCod='%ld' AND ",
+                     Gbl.CurrentDeg.Deg.DegCod);
+	    NumCtrsWithCrss = Ctr_GetNumCtrsWithCrss (SubQuery);
+            NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+        case Sco_SCOPE_CRS:
+	    NumCtrsTotal = 1;
+	    NumCtrsWithDegs = 1;
+	    NumCtrsWithCrss = 1;
+            sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
+                     Gbl.CurrentCrs.Crs.CrsCod);
+            NumCtrsWithTchs = Ctr_GetNumCtrsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCtrsWithStds = Ctr_GetNumCtrsWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         default:
+	    Lay_ShowErrorAndExit ("Wrong scope.");
+	    break;
+        }
+
+      /***** Update numbers in cache *****/
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTRS,Gbl.Scope.Current,Cod,NumCtrsTotal);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTRS_WITH_DEGS,Gbl.Scope.Current,Cod,NumCtrsWithDegs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTRS_WITH_CRSS,Gbl.Scope.Current,Cod,NumCtrsWithCrss);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTRS_WITH_TCHS,Gbl.Scope.Current,Cod,NumCtrsWithTchs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CTRS_WITH_STDS,Gbl.Scope.Current,Cod,NumCtrsWithStds);
      }
 
    /***** Write number of centres *****/
@@ -4513,64 +4577,79 @@ static void Sta_GetAndShowNumDegsInSWAD (void)
   {
    extern const char *Txt_Degrees;
    char SubQuery[128];
+   long Cod;
    unsigned NumDegsTotal = 0;
    unsigned NumDegsWithCrss = 0;
    unsigned NumDegsWithTchs = 0;
    unsigned NumDegsWithStds = 0;
 
-   /***** Get number of degrees *****/
-   switch (Gbl.Scope.Current)
+   /***** Get number of degrees from cache *****/
+   Cod = Sco_GetCodOfScope (Gbl.Scope.Current);
+   if (!(FigCch_GetFigureFromCache (FigCch_NUM_DEGS,Gbl.Scope.Current,Cod,&NumDegsTotal) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_DEGS_WITH_CRSS,Gbl.Scope.Current,Cod,&NumDegsWithCrss) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_DEGS_WITH_TCHS,Gbl.Scope.Current,Cod,&NumDegsWithTchs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_DEGS_WITH_STDS,Gbl.Scope.Current,Cod,&NumDegsWithStds)))
      {
-      case Sco_SCOPE_SYS:
-	 NumDegsTotal = Deg_GetNumDegsTotal ();
-	 NumDegsWithCrss = Deg_GetNumDegsWithCrss ("");
-         NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,"");
-	 NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,"");
-         SubQuery[0] = '\0';
-         break;
-      case Sco_SCOPE_CTY:
-	 NumDegsTotal = Deg_GetNumDegsInCty (Gbl.CurrentCty.Cty.CtyCod);
-         sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
-                  Gbl.CurrentCty.Cty.CtyCod);
-	 NumDegsWithCrss = Deg_GetNumDegsWithCrss (SubQuery);
-         NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_INS:
-	 NumDegsTotal = Deg_GetNumDegsInIns (Gbl.CurrentIns.Ins.InsCod);
-         sprintf (SubQuery,"centres.InsCod='%ld' AND ",
-                  Gbl.CurrentIns.Ins.InsCod);
-	 NumDegsWithCrss = Deg_GetNumDegsWithCrss (SubQuery);
-         NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_CTR:
-	 NumDegsTotal = Deg_GetNumDegsInCtr (Gbl.CurrentCtr.Ctr.CtrCod);
-         sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
-                  Gbl.CurrentCtr.Ctr.CtrCod);
-	 NumDegsWithCrss = Deg_GetNumDegsWithCrss (SubQuery);
-         NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      case Sco_SCOPE_DEG:
-	 NumDegsTotal = 1;
-         sprintf (SubQuery,"courses.DegCod='%ld' AND ",
-                  Gbl.CurrentDeg.Deg.DegCod);
-	 NumDegsWithCrss = Deg_GetNumDegsWithCrss (SubQuery);
-         NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-     case Sco_SCOPE_CRS:
-	 NumDegsTotal = 1;
-	 NumDegsWithCrss = 1;
-         sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
-                  Gbl.CurrentCrs.Crs.CrsCod);
-         NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
-	 NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      default:
-	 Lay_ShowErrorAndExit ("Wrong scope.");
-	 break;
+      /***** Get number of degrees from database *****/
+      switch (Gbl.Scope.Current)
+        {
+         case Sco_SCOPE_SYS:
+	    NumDegsTotal = Deg_GetNumDegsTotal ();
+	    NumDegsWithCrss = Deg_GetNumDegsWithCrss ("");
+            NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,"");
+	    NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,"");
+            SubQuery[0] = '\0';
+            break;
+         case Sco_SCOPE_CTY:
+	    NumDegsTotal = Deg_GetNumDegsInCty (Gbl.CurrentCty.Cty.CtyCod);
+            sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
+                     Gbl.CurrentCty.Cty.CtyCod);
+	    NumDegsWithCrss = Deg_GetNumDegsWithCrss (SubQuery);
+            NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_INS:
+	    NumDegsTotal = Deg_GetNumDegsInIns (Gbl.CurrentIns.Ins.InsCod);
+            sprintf (SubQuery,"centres.InsCod='%ld' AND ",
+                     Gbl.CurrentIns.Ins.InsCod);
+	    NumDegsWithCrss = Deg_GetNumDegsWithCrss (SubQuery);
+            NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_CTR:
+	    NumDegsTotal = Deg_GetNumDegsInCtr (Gbl.CurrentCtr.Ctr.CtrCod);
+            sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
+                     Gbl.CurrentCtr.Ctr.CtrCod);
+	    NumDegsWithCrss = Deg_GetNumDegsWithCrss (SubQuery);
+            NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         case Sco_SCOPE_DEG:
+	    NumDegsTotal = 1;
+            sprintf (SubQuery,"courses.DegCod='%ld' AND ",
+                     Gbl.CurrentDeg.Deg.DegCod);
+	    NumDegsWithCrss = Deg_GetNumDegsWithCrss (SubQuery);
+            NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+        case Sco_SCOPE_CRS:
+	    NumDegsTotal = 1;
+	    NumDegsWithCrss = 1;
+            sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
+                     Gbl.CurrentCrs.Crs.CrsCod);
+            NumDegsWithTchs = Deg_GetNumDegsWithUsrs (Rol_TEACHER,SubQuery);
+	    NumDegsWithStds = Deg_GetNumDegsWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         default:
+	    Lay_ShowErrorAndExit ("Wrong scope.");
+	    break;
+        }
+
+      /***** Update numbers in cache *****/
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_DEGS,Gbl.Scope.Current,Cod,NumDegsTotal);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_DEGS_WITH_CRSS,Gbl.Scope.Current,Cod,NumDegsWithCrss);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_DEGS_WITH_TCHS,Gbl.Scope.Current,Cod,NumDegsWithTchs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_DEGS_WITH_STDS,Gbl.Scope.Current,Cod,NumDegsWithStds);
      }
 
    /***** Write number of degrees *****/
@@ -4615,57 +4694,70 @@ static void Sta_GetAndShowNumCrssInSWAD (void)
   {
    extern const char *Txt_Courses;
    char SubQuery[128];
+   long Cod;
    unsigned NumCrssTotal = 0;
    unsigned NumCrssWithTchs = 0;
    unsigned NumCrssWithStds = 0;
 
-   /***** Get number of courses *****/
-   switch (Gbl.Scope.Current)
+   /***** Get number of courses from cache *****/
+   Cod = Sco_GetCodOfScope (Gbl.Scope.Current);
+   if (!(FigCch_GetFigureFromCache (FigCch_NUM_CRSS,Gbl.Scope.Current,Cod,&NumCrssTotal) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CRSS_WITH_TCHS,Gbl.Scope.Current,Cod,&NumCrssWithTchs) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_CRSS_WITH_STDS,Gbl.Scope.Current,Cod,&NumCrssWithStds)))
      {
-      case Sco_SCOPE_SYS:
-	 NumCrssTotal = Crs_GetNumCrssTotal ();
-         NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,"");
-	 NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,"");
-         SubQuery[0] = '\0';
-         break;
-      case Sco_SCOPE_CTY:
-	 NumCrssTotal = Crs_GetNumCrssInCty (Gbl.CurrentCty.Cty.CtyCod);
-         sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
-                  Gbl.CurrentCty.Cty.CtyCod);
-         NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_INS:
-	 NumCrssTotal = Crs_GetNumCrssInIns (Gbl.CurrentIns.Ins.InsCod);
-         sprintf (SubQuery,"centres.InsCod='%ld' AND ",
-                  Gbl.CurrentIns.Ins.InsCod);
-         NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
-         break;
-      case Sco_SCOPE_CTR:
-	 NumCrssTotal = Crs_GetNumCrssInCtr (Gbl.CurrentCtr.Ctr.CtrCod);
-         sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
-                  Gbl.CurrentCtr.Ctr.CtrCod);
-         NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      case Sco_SCOPE_DEG:
-	 NumCrssTotal = Crs_GetNumCrssInDeg (Gbl.CurrentDeg.Deg.DegCod);
-         sprintf (SubQuery,"courses.DegCod='%ld' AND ",
-                  Gbl.CurrentDeg.Deg.DegCod);
-         NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-     case Sco_SCOPE_CRS:
-	 NumCrssTotal = 1;
-         sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
-                  Gbl.CurrentCrs.Crs.CrsCod);
-         NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
-	 NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
-	 break;
-      default:
-	 Lay_ShowErrorAndExit ("Wrong scope.");
-	 break;
+      /***** Get number of courses from database *****/
+      switch (Gbl.Scope.Current)
+        {
+         case Sco_SCOPE_SYS:
+	    NumCrssTotal = Crs_GetNumCrssTotal ();
+            NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,"");
+	    NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,"");
+            SubQuery[0] = '\0';
+            break;
+         case Sco_SCOPE_CTY:
+	    NumCrssTotal = Crs_GetNumCrssInCty (Gbl.CurrentCty.Cty.CtyCod);
+            sprintf (SubQuery,"institutions.CtyCod='%ld' AND ",
+                     Gbl.CurrentCty.Cty.CtyCod);
+            NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_INS:
+	    NumCrssTotal = Crs_GetNumCrssInIns (Gbl.CurrentIns.Ins.InsCod);
+            sprintf (SubQuery,"centres.InsCod='%ld' AND ",
+                     Gbl.CurrentIns.Ins.InsCod);
+            NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
+            break;
+         case Sco_SCOPE_CTR:
+	    NumCrssTotal = Crs_GetNumCrssInCtr (Gbl.CurrentCtr.Ctr.CtrCod);
+            sprintf (SubQuery,"degrees.CtrCod='%ld' AND ",
+                     Gbl.CurrentCtr.Ctr.CtrCod);
+            NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         case Sco_SCOPE_DEG:
+	    NumCrssTotal = Crs_GetNumCrssInDeg (Gbl.CurrentDeg.Deg.DegCod);
+            sprintf (SubQuery,"courses.DegCod='%ld' AND ",
+                     Gbl.CurrentDeg.Deg.DegCod);
+            NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+        case Sco_SCOPE_CRS:
+	    NumCrssTotal = 1;
+            sprintf (SubQuery,"crs_usr.CrsCod='%ld' AND ",
+                     Gbl.CurrentCrs.Crs.CrsCod);
+            NumCrssWithTchs = Crs_GetNumCrssWithUsrs (Rol_TEACHER,SubQuery);
+	    NumCrssWithStds = Crs_GetNumCrssWithUsrs (Rol_STUDENT,SubQuery);
+	    break;
+         default:
+	    Lay_ShowErrorAndExit ("Wrong scope.");
+	    break;
+        }
+
+      /***** Update numbers in cache *****/
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CRSS,Gbl.Scope.Current,Cod,NumCrssTotal);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CRSS_WITH_TCHS,Gbl.Scope.Current,Cod,NumCrssWithTchs);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_CRSS_WITH_STDS,Gbl.Scope.Current,Cod,NumCrssWithStds);
      }
 
    /***** Write number of courses *****/
@@ -7537,11 +7629,26 @@ static void Sta_WriteForumTitleAndStats (For_ForumType_t ForumType,
    float NumThrsPerForum;
    float NumPostsPerThread;
    float NumPostsPerForum;
-
-   /***** Compute number of forums, number of threads and number of posts *****/
-   NumForums  = For_GetNumTotalForumsOfType       (ForumType,CtyCod,InsCod,CtrCod,DegCod,CrsCod);
-   NumThreads = For_GetNumTotalThrsInForumsOfType (ForumType,CtyCod,InsCod,CtrCod,DegCod,CrsCod);
-   NumPosts   = For_GetNumTotalPstsInForumsOfType (ForumType,CtyCod,InsCod,CtrCod,DegCod,CrsCod,&NumUsrsToBeNotifiedByEMail);
+   long Cod;
+
+   /***** Get number of forums, number of threads and number of posts from cache *****/
+   Cod = Sco_GetCodOfScope (Gbl.Scope.Current);
+   if (!(FigCch_GetFigureFromCache (FigCch_NUM_FORUMS           + ForumType,Gbl.Scope.Current,Cod,&NumForums) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_FORUM_THREADS    + ForumType,Gbl.Scope.Current,Cod,&NumThreads) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_FORUM_POSTS      + ForumType,Gbl.Scope.Current,Cod,&NumPosts) &&
+         FigCch_GetFigureFromCache (FigCch_NUM_FORUM_USRS_NOTIF + ForumType,Gbl.Scope.Current,Cod,&NumUsrsToBeNotifiedByEMail)))
+     {
+      /***** Compute number of forums, number of threads and number of posts *****/
+      NumForums  = For_GetNumTotalForumsOfType       (ForumType,CtyCod,InsCod,CtrCod,DegCod,CrsCod);
+      NumThreads = For_GetNumTotalThrsInForumsOfType (ForumType,CtyCod,InsCod,CtrCod,DegCod,CrsCod);
+      NumPosts   = For_GetNumTotalPstsInForumsOfType (ForumType,CtyCod,InsCod,CtrCod,DegCod,CrsCod,&NumUsrsToBeNotifiedByEMail);
+
+      /***** Update numbers in cache *****/
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_FORUMS           + ForumType,Gbl.Scope.Current,Cod,NumForums);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_FORUM_THREADS    + ForumType,Gbl.Scope.Current,Cod,NumThreads);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_FORUM_POSTS      + ForumType,Gbl.Scope.Current,Cod,NumPosts);
+      FigCch_UpdateFigureIntoCache (FigCch_NUM_FORUM_USRS_NOTIF + ForumType,Gbl.Scope.Current,Cod,NumUsrsToBeNotifiedByEMail);
+     }
 
    /***** Compute number of threads per forum, number of posts per forum and number of posts per thread *****/
    NumThrsPerForum = (NumForums ? (float) NumThreads / (float) NumForums :
@@ -65,6 +65,11 @@ const char *Svy_StrAnswerTypesDB[Svy_NUM_ANS_TYPES] =
 
 #define Svy_MAX_ANSWERS_PER_QUESTION	10
 
+// Number of counter rows per answer.
+// Concurrent submissions increment different rows of the same answer,
+// so they do not wait for the same row lock
+#define Svy_NUM_ANSWER_SHARDS		16
+
 struct SurveyQuestion
   {
    long QstCod;
@@ -155,8 +160,8 @@ static void Svy_PutIconToRemoveOneQst (void);
 static void Svy_PutParamsRemoveOneQst (void);
 
 static void Svy_ReceiveAndStoreUserAnswersToASurvey (long SvyCod);
-static void Svy_IncreaseAnswerInDB (long QstCod,unsigned AnsInd);
-static void Svy_RegisterIHaveAnsweredSvy (long SvyCod);
+static void Svy_IncreaseAnswersInDB (const char *MarkedAnswers,unsigned Shard);
+static bool Svy_RegisterIHaveAnsweredSvy (long SvyCod);
 static bool Svy_CheckIfIHaveAnsweredSvy (long SvyCod);
 static unsigned Svy_GetNumUsrsWhoHaveAnsweredSvy (long SvyCod);
 
@@ -1550,6 +1555,11 @@ void Svy_RemoveSurvey (void)
    DB_QueryDELETE (Query,"can not remove users who are answered a survey");
 
    /***** Remove all the answers in this survey *****/
+   sprintf (Query,"DELETE FROM svy_answers_counters USING svy_questions,svy_answers_counters"
+                  " WHERE svy_questions.SvyCod='%ld'"
+                  " AND svy_questions.QstCod=svy_answers_counters.QstCod",
+            Svy.SvyCod);
+   DB_QueryDELETE (Query,"can not remove answers of a survey");
    sprintf (Query,"DELETE FROM svy_answers USING svy_questions,svy_answers"
                   " WHERE svy_questions.SvyCod='%ld'"
                   " AND svy_questions.QstCod=svy_answers.QstCod",
@@ -1663,6 +1673,11 @@ void Svy_ResetSurvey (void)
                   " AND svy_questions.QstCod=svy_answers.QstCod",
             Svy.SvyCod);
    DB_QueryUPDATE (Query,"can not reset answers of a survey");
+   sprintf (Query,"DELETE FROM svy_answers_counters USING svy_questions,svy_answers_counters"
+                  " WHERE svy_questions.SvyCod='%ld'"
+                  " AND svy_questions.QstCod=svy_answers_counters.QstCod",
+            Svy.SvyCod);
+   DB_QueryDELETE (Query,"can not reset answers of a survey");
 
    /***** Write message to show the change made *****/
    sprintf (Gbl.Message,Txt_Survey_X_reset,
@@ -2473,6 +2488,13 @@ void Svy_RemoveSurveys (Sco_Scope_t Scope,long Cod)
 	                 " who had answered surveys in a place on the hierarchy");
 
    /***** Remove all the answers in course surveys *****/
+   sprintf (Query,"DELETE FROM svy_answers_counters"
+	          " USING surveys,svy_questions,svy_answers_counters"
+                  " WHERE surveys.Scope='%s' AND surveys.Cod='%ld'"
+                  " AND surveys.SvyCod=svy_questions.SvyCod"
+                  " AND svy_questions.QstCod=svy_answers_counters.QstCod",
+            Sco_ScopeDB[Scope],Cod);
+   DB_QueryDELETE (Query,"can not remove answers of surveys in a place on the hierarchy");
    sprintf (Query,"DELETE FROM svy_answers"
 	          " USING surveys,svy_questions,svy_answers"
                   " WHERE surveys.Scope='%s' AND surveys.Cod='%ld'"
@@ -2797,6 +2819,8 @@ static void Svy_RemAnswersOfAQuestion (long QstCod)
    char Query[512];
 
    /***** Remove answers *****/
+   sprintf (Query,"DELETE FROM svy_answers_counters WHERE QstCod='%ld'",QstCod);
+   DB_QueryDELETE (Query,"can not remove the answers of a question");
    sprintf (Query,"DELETE FROM svy_answers WHERE QstCod='%ld'",QstCod);
    DB_QueryDELETE (Query,"can not remove the answers of a question");
   }
@@ -2858,8 +2882,16 @@ static unsigned Svy_GetAnswersQst (long QstCod,MYSQL_RES **mysql_res)
    unsigned long NumRows;
 
    /***** Get answers of a question from database *****/
-   sprintf (Query,"SELECT AnsInd,NumUsrs,Answer FROM svy_answers"
-                  " WHERE QstCod='%ld' ORDER BY AnsInd",
+   // Number of users is the sum of old NumUsrs and the counters in all shards
+   sprintf (Query,"SELECT svy_answers.AnsInd,"
+	          "svy_answers.NumUsrs+IFNULL(SUM(svy_answers_counters.NumUsrs),0),"
+	          "svy_answers.Answer"
+	          " FROM svy_answers LEFT JOIN svy_answers_counters"
+                  " ON (svy_answers.QstCod=svy_answers_counters.QstCod"
+                  " AND svy_answers.AnsInd=svy_answers_counters.AnsInd)"
+                  " WHERE svy_answers.QstCod='%ld'"
+                  " GROUP BY svy_answers.AnsInd"
+                  " ORDER BY svy_answers.AnsInd",
             QstCod);
    NumRows = DB_QuerySELECT (Query,mysql_res,"can not get answers of a question");
 
@@ -3045,6 +3077,10 @@ void Svy_ReceiveQst (void)
             else	// Answer is empty
               {
                /* Delete answer from database */
+               sprintf (Query,"DELETE FROM svy_answers_counters"
+                              " WHERE QstCod='%ld' AND AnsInd='%u'",
+                        SvyQst.QstCod,NumAns);
+               DB_QueryDELETE (Query,"can not delete answer");
                sprintf (Query,"DELETE FROM svy_answers"
                               " WHERE QstCod='%ld' AND AnsInd='%u'",
                         SvyQst.QstCod,NumAns);
@@ -3640,78 +3676,124 @@ static void Svy_ReceiveAndStoreUserAnswersToASurvey (long SvyCod)
    const char *Ptr;
    char UnsignedStr[10+1];
    unsigned AnsInd;
+   bool AnswerMarked[Svy_MAX_ANSWERS_PER_QUESTION];
+   char *MarkedAnswers;
+   size_t Length = 0;
 
    /***** Get questions of this survey from database *****/
    sprintf (Query,"SELECT QstCod FROM svy_questions"
                   " WHERE SvyCod='%ld' ORDER BY QstCod",
             SvyCod);
-   DB_QuerySELECT (Query,&mysql_res,"can not get questions of a survey");
+   if (!(NumQsts = (unsigned) DB_QuerySELECT (Query,&mysql_res,"can not get surveys")))	// The survey has no questions and answers
+      Lay_ShowErrorAndExit ("Error: this survey has no questions.");
 
-   if ((NumQsts = (unsigned) DB_QuerySELECT (Query,&mysql_res,"can not get surveys"))) // The survey has questions
+   /***** Allocate memory for the list of marked answers *****/
+   // Each marked answer is stored as ",('QstCod','AnsInd')"
+   if ((MarkedAnswers = malloc (NumQsts * Svy_MAX_ANSWERS_PER_QUESTION *
+                                (2+1+10+3+10+2) + 1)) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store answers.");
+   MarkedAnswers[0] = '\0';
+
+   /***** Get questions *****/
+   for (NumQst = 0;
+	NumQst < NumQsts;
+	NumQst++)
      {
-      /***** Get questions *****/
-      for (NumQst = 0;
-	   NumQst < NumQsts;
-	   NumQst++)
-        {
-         /* Get next answer */
-         row = mysql_fetch_row (mysql_res);
-
-         /* Get question code (row[0]) */
-         if ((QstCod = Str_ConvertStrCodToLongCod (row[0])) <= 0)
-            Lay_ShowErrorAndExit ("Error: wrong question code.");
+      /* Get next answer */
+      row = mysql_fetch_row (mysql_res);
 
-         /* Get possible parameter with the user's answer */
-         sprintf (ParamName,"Ans%010u",(unsigned) QstCod);
-         // Lay_ShowAlert (Lay_INFO,ParamName);
-         Par_GetParMultiToText (ParamName,StrAnswersIndexes,Svy_MAX_ANSWERS_PER_QUESTION*(10+1));
-         Ptr = StrAnswersIndexes;
-         while (*Ptr)
-           {
-            Par_GetNextStrUntilSeparParamMult (&Ptr,UnsignedStr,10);
-            if (sscanf (UnsignedStr,"%u",&AnsInd) == 1)
-               // Parameter exists, so user has marked this answer, so store it in database
-               Svy_IncreaseAnswerInDB (QstCod,AnsInd);
-           }
+      /* Get question code (row[0]) */
+      if ((QstCod = Str_ConvertStrCodToLongCod (row[0])) <= 0)
+         Lay_ShowErrorAndExit ("Error: wrong question code.");
+
+      /* Get possible parameter with the user's answer */
+      sprintf (ParamName,"Ans%010u",(unsigned) QstCod);
+      // Lay_ShowAlert (Lay_INFO,ParamName);
+      Par_GetParMultiToText (ParamName,StrAnswersIndexes,Svy_MAX_ANSWERS_PER_QUESTION*(10+1));
+      for (AnsInd = 0;
+	   AnsInd < Svy_MAX_ANSWERS_PER_QUESTION;
+	   AnsInd++)
+	 AnswerMarked[AnsInd] = false;
+      Ptr = StrAnswersIndexes;
+      while (*Ptr)
+        {
+         Par_GetNextStrUntilSeparParamMult (&Ptr,UnsignedStr,10);
+         if (sscanf (UnsignedStr,"%u",&AnsInd) == 1)
+            // Parameter exists, so user has marked this answer, so add it to the list
+            if (AnsInd < Svy_MAX_ANSWERS_PER_QUESTION)
+               if (!AnswerMarked[AnsInd])	// Each answer is counted only once
+        	 {
+        	  AnswerMarked[AnsInd] = true;
+        	  Length += (size_t) sprintf (&MarkedAnswers[Length],"%s('%ld','%u')",
+        	                              Length ? "," :
+        	                        	       "",
+        	                              QstCod,AnsInd);
+        	 }
         }
      }
-   else		// The survey has no questions and answers
-      Lay_ShowErrorAndExit ("Error: this survey has no questions.");
 
    /***** Free structure that stores the query result *****/
    DB_FreeMySQLResult (&mysql_res);
 
-   /***** Register that you have answered this survey *****/
-   Svy_RegisterIHaveAnsweredSvy (SvyCod);
+   /***** Register that you have answered this survey
+          and store all your answers at once *****/
+   DB_Query ("START TRANSACTION","can not start transaction");
+   Gbl.DB.OpenTransaction = true;
+   if (Svy_RegisterIHaveAnsweredSvy (SvyCod))	// Not registered before by a simultaneous request
+      if (MarkedAnswers[0])
+         // Concurrent users write into different counters of the same answer
+         Svy_IncreaseAnswersInDB (MarkedAnswers,
+                                  (unsigned) (Gbl.Usrs.Me.UsrDat.UsrCod % Svy_NUM_ANSWER_SHARDS));
+   DB_Query ("COMMIT","can not commit transaction");
+   Gbl.DB.OpenTransaction = false;
+
+   /***** Free list of marked answers *****/
+   free ((void *) MarkedAnswers);
   }
 
 /*****************************************************************************/
-/************ Increase number of users who have marked one answer ************/
+/*********** Increase number of users who have marked some answers ***********/
 /*****************************************************************************/
+// MarkedAnswers is a list of ('QstCod','AnsInd')
+// The number of users of an answer is the sum of svy_answers.NumUsrs
+// and the counters of the answer in all the shards
 
-static void Svy_IncreaseAnswerInDB (long QstCod,unsigned AnsInd)
+static void Svy_IncreaseAnswersInDB (const char *MarkedAnswers,unsigned Shard)
   {
-   char Query[512];
-
-   /***** Increase number of users who have selected the answer AnsInd in the question QstCod *****/
-   sprintf (Query,"UPDATE svy_answers SET NumUsrs=NumUsrs+1"
-                  " WHERE QstCod='%ld' AND AnsInd='%u'",
-            QstCod,AnsInd);
-   DB_QueryINSERT (Query,"can not register your answer to the survey");
+   char *Query;
+
+   /***** Allocate memory for the query *****/
+   if ((Query = malloc (512 + strlen (MarkedAnswers))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store database query.");
+
+   /***** Increase number of users who have selected the answers,
+          only if the answers exist *****/
+   sprintf (Query,"INSERT INTO svy_answers_counters"
+	          " (QstCod,AnsInd,Shard,NumUsrs)"
+                  " SELECT QstCod,AnsInd,'%u','1' FROM svy_answers"
+                  " WHERE (QstCod,AnsInd) IN (%s)"
+                  " ON DUPLICATE KEY UPDATE"
+                  " svy_answers_counters.NumUsrs=svy_answers_counters.NumUsrs+1",
+            Shard,MarkedAnswers);
+   DB_QueryINSERT (Query,"can not register your answers to the survey");
+
+   /***** Free query *****/
+   free ((void *) Query);
   }
 
 /*****************************************************************************/
 /***************** Register that I have answered this survey *****************/
 /*****************************************************************************/
+// Return false if I had already answered this survey
 
-static void Svy_RegisterIHaveAnsweredSvy (long SvyCod)
+static bool Svy_RegisterIHaveAnsweredSvy (long SvyCod)
   {
    char Query[512];
 
-   sprintf (Query,"INSERT INTO svy_users (SvyCod,UsrCod)"
+   sprintf (Query,"INSERT IGNORE INTO svy_users (SvyCod,UsrCod)"
                   " VALUES ('%ld','%ld')",
             SvyCod,Gbl.Usrs.Me.UsrDat.UsrCod);
-   DB_QueryINSERT (Query,"can not register that you have answered the survey");
+   return DB_QueryINSERTandReturnNumRows (Query,"can not register that you have answered the survey") != 0;
   }
 
 /*****************************************************************************/
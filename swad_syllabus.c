@@ -31,6 +31,7 @@
 #include <stdsoap2.h>		// For SOAP_OK and soap functions
 #include <stdlib.h>		// For free ()
 #include <string.h>		// For strcat (), etc.
+#include <sys/stat.h>		// For stat
 #include <time.h>		// For time ()
 
 #include "swad_changelog.h"
@@ -84,6 +85,30 @@ struct ItemSyllabus
    char Text[Syl_MAX_BYTES_TEXT_ITEM+1];
   };
 
+// Binary form of a syllabus, stored in a file with this header,
+// followed by the items and then by the texts of the items
+#define Syl_COMPILED_SYLLABUS_VERSION 1
+#define Syl_MAX_BYTES_PATH_COMPILED_SYLLABUS (PATH_MAX+1+sizeof (Cfg_SYLLABUS_COMPILED_FILENAME))
+
+struct CompiledSyllabusHeader
+  {
+   unsigned Version;			// Syl_COMPILED_SYLLABUS_VERSION
+   ino_t XMLIno;			// Inode, modification time and size
+   time_t XMLMTime;			// of the XML file used
+   off_t XMLSize;			// to build the binary form
+   unsigned NumItems;
+   unsigned NumItemsWithChildren;
+   int NumLevels;
+  };
+
+struct CompiledItemSyllabus
+  {
+   int Level;
+   int CodItem[1+Syl_MAX_LEVELS_SYLLABUS];
+   bool HasChildren;
+   unsigned LengthText;			// Length of the text, without final '\0'
+  };
+
 /*****************************************************************************/
 /***************************** Private variables *****************************/
 /*****************************************************************************/
@@ -101,6 +126,9 @@ struct
 /*****************************************************************************/
 
 static void Syl_SetSyllabusTypeFromAction (void);
+static void Syl_BuildPathFileCompiledSyllabus (char *PathFile);
+static bool Syl_LoadCompiledSyllabus (const struct stat *XMLStatus);
+static void Syl_WriteCompiledSyllabus (const struct stat *XMLStatus);
 static void Syl_ShowSyllabus (void);
 static void Syl_ShowRowSyllabus (unsigned NumItem,
                                  int Level,int *CodItem,const char *Text,bool NewItem);
@@ -356,6 +384,7 @@ void Syl_LoadListItemsSyllabusIntoMemory (long CrsCod)
    int CodItem[1+Syl_MAX_LEVELS_SYLLABUS];	// To make numeration
    int Result;
    unsigned NumItemsWithChildren = 0;
+   struct stat XMLStatus;
 
    /* Path of the private directory for the XML file with the syllabus */
    sprintf (Gbl.Syllabus.PathDir,"%s/%s/%ld/%s",
@@ -366,6 +395,16 @@ void Syl_LoadListItemsSyllabusIntoMemory (long CrsCod)
    /***** Open the file with the syllabus *****/
    Syl_OpenSyllabusFile (Gbl.Syllabus.PathDir,PathFile);
 
+   /***** Try to load the binary form of the syllabus,
+          built the last time the XML file was read *****/
+   if (fstat (fileno (Gbl.F.XML),&XMLStatus))
+      Lay_ShowErrorAndExit ("Can not get information about syllabus file.");
+   if (Syl_LoadCompiledSyllabus (&XMLStatus))
+     {
+      Fil_CloseXMLFile ();
+      return;
+     }
+
    /***** Go to the start of the list of items *****/
    if (!Str_FindStrInFile (Gbl.F.XML,"<lista>",Str_NO_SKIP_HTML_COMMENTS))
       Lay_ShowErrorAndExit ("Wrong syllabus format.");
@@ -465,6 +504,184 @@ void Syl_LoadListItemsSyllabusIntoMemory (long CrsCod)
       LstItemsSyllabus.Lst[LstItemsSyllabus.NumItems - 1].HasChildren = false;
      }
    LstItemsSyllabus.NumItemsWithChildren = NumItemsWithChildren;
+
+   /***** Store the binary form of the syllabus
+          to avoid reading the XML file next time *****/
+   Syl_WriteCompiledSyllabus (&XMLStatus);
+  }
+
+/*****************************************************************************/
+/******* Build the path of the file with the binary form of syllabus *********/
+/*****************************************************************************/
+
+static void Syl_BuildPathFileCompiledSyllabus (char *PathFile)
+  {
+   sprintf (PathFile,"%s/%s",Gbl.Syllabus.PathDir,Cfg_SYLLABUS_COMPILED_FILENAME);
+  }
+
+/*****************************************************************************/
+/********* Load in memory the binary form of a syllabus if valid *************/
+/*****************************************************************************/
+// Return false if the binary form does not exist
+// or it was not built from the current XML file
+
+static bool Syl_LoadCompiledSyllabus (const struct stat *XMLStatus)
+  {
+   char PathFile[Syl_MAX_BYTES_PATH_COMPILED_SYLLABUS];
+   struct stat FileStatus;
+   FILE *FileCompiled;
+   char *Buffer;
+   const struct CompiledSyllabusHeader *Header;
+   const struct CompiledItemSyllabus *Item;
+   const char *Text;
+   size_t SizeItems;
+   unsigned NumItem;
+   unsigned LengthTexts = 0;
+   int N;
+
+   /***** Read the whole file at once *****/
+   Syl_BuildPathFileCompiledSyllabus (PathFile);
+   if ((FileCompiled = fopen (PathFile,"rb")) == NULL)
+      return false;
+   if (fstat (fileno (FileCompiled),&FileStatus) ||
+       (size_t) FileStatus.st_size < sizeof (struct CompiledSyllabusHeader))
+     {
+      fclose (FileCompiled);
+      return false;
+     }
+   if ((Buffer = (char *) malloc ((size_t) FileStatus.st_size)) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store syllabus.");
+   if (fread (Buffer,1,(size_t) FileStatus.st_size,FileCompiled) != (size_t) FileStatus.st_size)
+     {
+      free ((void *) Buffer);
+      fclose (FileCompiled);
+      return false;
+     }
+   fclose (FileCompiled);
+
+   /***** Check that it was built from the current XML file *****/
+   Header = (const struct CompiledSyllabusHeader *) Buffer;
+   SizeItems = (size_t) Header->NumItems * sizeof (struct CompiledItemSyllabus);
+   if (Header->Version  != Syl_COMPILED_SYLLABUS_VERSION ||
+       Header->XMLIno   != XMLStatus->st_ino ||
+       Header->XMLMTime != XMLStatus->st_mtime ||
+       Header->XMLSize  != XMLStatus->st_size ||
+       (size_t) FileStatus.st_size < sizeof (struct CompiledSyllabusHeader) + SizeItems)
+     {
+      free ((void *) Buffer);
+      return false;
+     }
+   Item = (const struct CompiledItemSyllabus *) (Buffer + sizeof (struct CompiledSyllabusHeader));
+   for (NumItem = 0;
+	NumItem < Header->NumItems;
+	NumItem++)
+     {
+      if (Item[NumItem].LengthText > Syl_MAX_BYTES_TEXT_ITEM)
+	{
+	 free ((void *) Buffer);
+	 return false;
+	}
+      LengthTexts += Item[NumItem].LengthText;
+     }
+   if ((size_t) FileStatus.st_size != sizeof (struct CompiledSyllabusHeader) + SizeItems + LengthTexts)
+     {
+      free ((void *) Buffer);
+      return false;
+     }
+
+   /***** Allocate memory for the list of items *****/
+   if ((LstItemsSyllabus.Lst = (struct ItemSyllabus *) calloc (Header->NumItems + 1,sizeof (struct ItemSyllabus))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store syllabus.");
+   LstItemsSyllabus.NumItems             = Header->NumItems;
+   LstItemsSyllabus.NumItemsWithChildren = Header->NumItemsWithChildren;
+   LstItemsSyllabus.NumLevels            = Header->NumLevels;
+
+   /***** Copy the items *****/
+   if (LstItemsSyllabus.NumItems == 0)
+     {
+      /* The syllabus is empty ==> initialize an item to be edited */
+      LstItemsSyllabus.Lst[0].Level = 1;
+      LstItemsSyllabus.Lst[0].CodItem[1] = 1;
+      LstItemsSyllabus.Lst[0].Text[0] = '\0';
+     }
+   else
+     {
+      Text = (const char *) &Item[LstItemsSyllabus.NumItems];
+      for (NumItem = 0;
+	   NumItem < LstItemsSyllabus.NumItems;
+	   NumItem++)
+	{
+	 LstItemsSyllabus.Lst[NumItem].Level = Item[NumItem].Level;
+	 for (N = 1;
+	      N <= Syl_MAX_LEVELS_SYLLABUS;
+	      N++)
+	    LstItemsSyllabus.Lst[NumItem].CodItem[N] = Item[NumItem].CodItem[N];
+	 LstItemsSyllabus.Lst[NumItem].HasChildren = Item[NumItem].HasChildren;
+	 strncpy (LstItemsSyllabus.Lst[NumItem].Text,Text,Item[NumItem].LengthText);
+	 LstItemsSyllabus.Lst[NumItem].Text[Item[NumItem].LengthText] = '\0';
+	 Text += Item[NumItem].LengthText;
+	}
+     }
+
+   free ((void *) Buffer);
+   return true;
+  }
+
+/*****************************************************************************/
+/******** Write the binary form of the syllabus loaded in memory *************/
+/*****************************************************************************/
+
+static void Syl_WriteCompiledSyllabus (const struct stat *XMLStatus)
+  {
+   char PathFile[Syl_MAX_BYTES_PATH_COMPILED_SYLLABUS];
+   char PathFileNew[Syl_MAX_BYTES_PATH_COMPILED_SYLLABUS+1+Cry_LENGTH_ENCRYPTED_STR_SHA256_BASE64];
+   FILE *FileCompiled;
+   struct CompiledSyllabusHeader Header;
+   struct CompiledItemSyllabus Item;
+   unsigned NumItem;
+
+   /***** Create a new file.
+          It will replace the old one when completely written,
+          so other concurrent executions never read a partial syllabus *****/
+   Syl_BuildPathFileCompiledSyllabus (PathFile);
+   sprintf (PathFileNew,"%s.%s",PathFile,Gbl.UniqueNameEncrypted);
+   if ((FileCompiled = fopen (PathFileNew,"wb")) == NULL)
+      return;
+
+   /***** Write header *****/
+   memset (&Header,0,sizeof (Header));
+   Header.Version              = Syl_COMPILED_SYLLABUS_VERSION;
+   Header.XMLIno               = XMLStatus->st_ino;
+   Header.XMLMTime             = XMLStatus->st_mtime;
+   Header.XMLSize              = XMLStatus->st_size;
+   Header.NumItems             = LstItemsSyllabus.NumItems;
+   Header.NumItemsWithChildren = LstItemsSyllabus.NumItemsWithChildren;
+   Header.NumLevels            = LstItemsSyllabus.NumLevels;
+   fwrite (&Header,sizeof (Header),1,FileCompiled);
+
+   /***** Write items *****/
+   for (NumItem = 0;
+	NumItem < LstItemsSyllabus.NumItems;
+	NumItem++)
+     {
+      memset (&Item,0,sizeof (Item));
+      Item.Level = LstItemsSyllabus.Lst[NumItem].Level;
+      memcpy (Item.CodItem,LstItemsSyllabus.Lst[NumItem].CodItem,sizeof (Item.CodItem));
+      Item.HasChildren = LstItemsSyllabus.Lst[NumItem].HasChildren;
+      Item.LengthText = (unsigned) strlen (LstItemsSyllabus.Lst[NumItem].Text);
+      fwrite (&Item,sizeof (Item),1,FileCompiled);
+     }
+
+   /***** Write texts of items *****/
+   for (NumItem = 0;
+	NumItem < LstItemsSyllabus.NumItems;
+	NumItem++)
+      fputs (LstItemsSyllabus.Lst[NumItem].Text,FileCompiled);
+
+   /***** Replace old file by new one *****/
+   if (fclose (FileCompiled) ||
+       rename (PathFileNew,PathFile))
+      unlink (PathFileNew);
   }
 
 /*****************************************************************************/
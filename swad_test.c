@@ -5924,6 +5924,8 @@ static long Tst_GetQstCod (void)
 
 void Tst_InsertOrUpdateQstTagsAnsIntoDB (void)
   {
+   bool NewQuestion = (Gbl.Test.QstCod < 0);
+
    /***** Insert or update question in the table of questions *****/
    Tst_InsertOrUpdateQstIntoDB ();
 
@@ -5931,7 +5933,8 @@ void Tst_InsertOrUpdateQstTagsAnsIntoDB (void)
    Tst_InsertTagsIntoDB ();
 
    /***** Remove unused tags in current course *****/
-   Tst_RemoveUnusedTagsFromCurrentCrs ();
+   if (!NewQuestion)	// A new question only adds tags, so no tag can become unused
+      Tst_RemoveUnusedTagsFromCurrentCrs ();
 
    /***** Insert answers in the answers table *****/
    Tst_InsertAnswersIntoDB ();
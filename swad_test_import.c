@@ -67,7 +67,15 @@ static void TsI_PutParamsExportQsts (void);
 static void TsI_GetAndWriteTagsXML (long QstCod);
 static void TsI_WriteAnswersOfAQstXML (long QstCod);
 static void TsI_ReadQuestionsFromXMLFileAndStoreInDB (const char *FileNameXML);
-static void TsI_ImportQuestionsFromXMLBuffer (const char *XMLBuffer);
+static void TsI_PrintAndCheckQuestionsFromXMLFile (void);
+static void TsI_ImportQuestionsFromXMLFile (void);
+static void TsI_CheckQuestionFromXML (struct XMLElement *QuestionElem);
+static void TsI_ImportQuestionFromXML (struct XMLElement *QuestionElem);
+static void TsI_GetQuestionFromXML (struct XMLElement *QuestionElem,
+                                    struct XMLElement **StemElem,
+                                    struct XMLElement **FeedbackElem,
+                                    char Stem[Cns_MAX_BYTES_TEXT+1],
+                                    char Feedback[Cns_MAX_BYTES_TEXT+1]);
 static Tst_AnswerType_t TsI_ConvertFromStrAnsTypXMLToAnsTyp (const char *StrAnsTypeXML);
 static bool TsI_CheckIfQuestionExistsInDB (void);
 static void TsI_GetAnswerFromXML (struct XMLElement *AnswerElem);
@@ -446,226 +454,290 @@ void TsI_ImportQstsFromXML (void)
 
 static void TsI_ReadQuestionsFromXMLFileAndStoreInDB (const char *FileNameXML)
   {
-   char *XMLBuffer;
-   unsigned long FileSize;
-
    /***** Open file *****/
    if ((Gbl.Test.XML.FileXML = fopen (FileNameXML,"rb")) == NULL)
       Lay_ShowErrorAndExit ("Can not open XML file.");
 
-   /***** Compute file size *****/
-   fseek (Gbl.Test.XML.FileXML,0L,SEEK_END);
-   FileSize = (unsigned long) ftell (Gbl.Test.XML.FileXML);
-   fseek (Gbl.Test.XML.FileXML,0L,SEEK_SET);
-
-   /***** Allocate memory for XML buffer *****/
-   if ((XMLBuffer = malloc (FileSize + 1)) == NULL)
-      Lay_ShowErrorAndExit ("Not enough memory for XML buffer.");
-   else
-     {
-      /***** Read file contents into XML buffer *****/
-      if (fread ((void *) XMLBuffer,sizeof (char),(size_t) FileSize,Gbl.Test.XML.FileXML))
-         XMLBuffer[FileSize] = '\0';
-      else
-         XMLBuffer[0] = '\0';
-
-      /***** Import questions from XML buffer *****/
-      TsI_ImportQuestionsFromXMLBuffer (XMLBuffer);
+   /***** Read file once to print it and check its syntax and its questions,
+          so no question is imported if the file is wrong *****/
+   // Questions with empty fields are not errors:
+   // in the second pass they are not imported and a warning is shown
+   TsI_PrintAndCheckQuestionsFromXMLFile ();
 
-      free (XMLBuffer);
-     }
+   /***** Read file again to import questions *****/
+   rewind (Gbl.Test.XML.FileXML);
+   TsI_ImportQuestionsFromXMLFile ();
 
    /***** Close file *****/
    fclose (Gbl.Test.XML.FileXML);
   }
 
 /*****************************************************************************/
-/******************** Import questions from XML buffer ***********************/
+/**************** Print and check questions from XML file ********************/
 /*****************************************************************************/
+// The file is read one element at a time, so memory used is limited.
+// Each question is got from its XML tree as when it is imported,
+// so errors in the file are found before importing any question
 
-static void TsI_ImportQuestionsFromXMLBuffer (const char *XMLBuffer)
+static void TsI_PrintAndCheckQuestionsFromXMLFile (void)
   {
    extern const char *Txt_XML_file_content;
-   extern const char *Txt_Imported_questions;
    struct XMLElement *RootElem;
-   struct XMLElement *TestElem = NULL;
    struct XMLElement *QuestionElem;
-   struct XMLElement *TagsElem;
-   struct XMLElement *TagElem;
-   struct XMLElement *StemElem;
-   struct XMLElement *FeedbackElem;
-   struct XMLElement *AnswerElem;
-   struct XMLAttribute *Attribute;
-   bool AnswerTypeFound;
-   bool QuestionExists;
-   char Stem[Cns_MAX_BYTES_TEXT+1];
-   char Feedback[Cns_MAX_BYTES_TEXT+1];
 
-   /***** Allocate and get XML tree *****/
-   XML_GetTree (XMLBuffer,&RootElem);
+   /***** Go to <test> element *****/
+   if (!XML_StartReadingRootElementFromFile (Gbl.Test.XML.FileXML,"test"))
+      Lay_ShowErrorAndExit ("Root element &lt;test&gt; not found.");
 
-   /***** Print XML tree *****/
+   /***** Print XML trees *****/
    Lay_WriteTitle (Txt_XML_file_content);
    fprintf (Gbl.F.Out,"<div class=\"CENTER_MIDDLE\">"
 	              "<textarea cols=\"60\" rows=\"5\""
-	              " spellcheck=\"false\" readonly>");
-   XML_PrintTree (RootElem);
-   fprintf (Gbl.F.Out,"</textarea>"
-                      "</div>");
-
-   /***** Get questions from XML tree and print them *****/
-   /* Go to <test> element */
-   if (RootElem->FirstChild)
+	              " spellcheck=\"false\" readonly>"
+	              "&lt;test&gt;\n");
+   while (XML_GetNextElementFromFile (Gbl.Test.XML.FileXML,"test",&RootElem))
      {
-      TestElem = RootElem->FirstChild;
-      if (strcmp (TestElem->TagName,"test"))	// <test> must be at level 1
-         TestElem = NULL;
+      XML_PrintTree (RootElem);
+
+      /***** Check this question *****/
+      QuestionElem = RootElem->FirstChild;
+      if (!strcmp (QuestionElem->TagName,"question"))
+         TsI_CheckQuestionFromXML (QuestionElem);
+
+      /***** Free XML tree *****/
+      XML_FreeTree (RootElem);
+      free ((void *) RootElem);
      }
-   if (!TestElem)
-      Lay_ShowErrorAndExit ("Root element &lt;test&gt; not found.");
+   fprintf (Gbl.F.Out,"&lt;/test&gt;\n"
+	              "</textarea>"
+                      "</div>");
+  }
 
-   /* Current element is <test> */
+/*****************************************************************************/
+/********************* Import questions from XML file ************************/
+/*****************************************************************************/
+
+static void TsI_ImportQuestionsFromXMLFile (void)
+  {
+   extern const char *Txt_Imported_questions;
+   struct XMLElement *RootElem;
+   struct XMLElement *QuestionElem;
+
+   /***** Go to <test> element *****/
+   if (!XML_StartReadingRootElementFromFile (Gbl.Test.XML.FileXML,"test"))
+      Lay_ShowErrorAndExit ("Root element &lt;test&gt; not found.");
 
    /***** Write heading of list of imported questions *****/
    Lay_WriteTitle (Txt_Imported_questions);
    TsI_WriteHeadingListImportedQst ();
 
    /***** For each question... *****/
-   for (QuestionElem = TestElem->FirstChild;
-	QuestionElem != NULL;
-	QuestionElem = QuestionElem->NextBrother)
+   // Errors in questions have been found in the first pass.
+   // All questions are stored in one transaction, so if a database error
+   // happens, the transaction is rolled back and no question is stored.
+   // Besides, storing thousands of questions is too slow
+   // if each question is committed separately
+   DB_Query ("START TRANSACTION","can not start transaction");
+   Gbl.DB.OpenTransaction = true;
+   while (XML_GetNextElementFromFile (Gbl.Test.XML.FileXML,"test",&RootElem))
      {
+      QuestionElem = RootElem->FirstChild;
       if (!strcmp (QuestionElem->TagName,"question"))
         {
-         /***** Create test question *****/
-         Tst_QstConstructor ();
-
-         /* Get type of questions (in mandatory attribute "type") */
-         AnswerTypeFound = false;
-         for (Attribute = QuestionElem->FirstAttribute;
-              Attribute != NULL;
-              Attribute = Attribute->Next)
-            if (!strcmp (Attribute->AttributeName,"type"))
-              {
-               Gbl.Test.AnswerType = TsI_ConvertFromStrAnsTypXMLToAnsTyp (Attribute->Content);
-               AnswerTypeFound = true;
-               break;	// Only first attribute "type"
-              }
-         if (!AnswerTypeFound)
-            Lay_ShowErrorAndExit ("Wrong type of answer.");
-
-         /* Get tags */
-         for (TagsElem = QuestionElem->FirstChild, Gbl.Test.Tags.Num = 0;
-              TagsElem != NULL;
-              TagsElem = TagsElem->NextBrother)
-            if (!strcmp (TagsElem->TagName,"tags"))
-              {
-               for (TagElem = TagsElem->FirstChild;
-                    TagElem != NULL && Gbl.Test.Tags.Num < Tst_MAX_TAGS_PER_QUESTION;
-                    TagElem = TagElem->NextBrother)
-                  if (!strcmp (TagElem->TagName,"tag"))
-                    {
-                     if (TagElem->Content)
-                       {
-                        strncpy (Gbl.Test.Tags.Txt[Gbl.Test.Tags.Num],TagElem->Content,Tst_MAX_BYTES_TAG);
-                        Gbl.Test.Tags.Txt[Gbl.Test.Tags.Num][Tst_MAX_BYTES_TAG] = '\0';
-                        Gbl.Test.Tags.Num++;
-                       }
-                    }
-               break;	// Only first element "tags"
-              }
+	 /***** Import this question *****/
+         TsI_ImportQuestionFromXML (QuestionElem);
+        }
 
-         /* Get stem (mandatory) */
-         for (StemElem = QuestionElem->FirstChild;
-              StemElem != NULL;
-              StemElem = StemElem->NextBrother)
-            if (!strcmp (StemElem->TagName,"stem"))
-              {
-               if (StemElem->Content)
-                 {
-        	  /* Convert stem from text to HTML (in database stem is stored in HTML) */
-        	  strncpy (Stem,StemElem->Content,Cns_MAX_BYTES_TEXT);
-        	  Stem[Cns_MAX_BYTES_TEXT] = '\0';
-                  Str_ChangeFormat (Str_FROM_TEXT,Str_TO_HTML,
-                                    Stem,Cns_MAX_BYTES_TEXT,true);
-
-                  Gbl.Test.Stem.Text   = Stem;
-                  Gbl.Test.Stem.Length = strlen (Stem);
-                 }
-               break;	// Only first element "stem"
-              }
+      /***** Free XML tree *****/
+      XML_FreeTree (RootElem);
+      free ((void *) RootElem);
+     }
+   DB_Query ("COMMIT","can not commit transaction");
+   Gbl.DB.OpenTransaction = false;
 
-         /* Get feedback (optional) */
-         for (FeedbackElem = QuestionElem->FirstChild;
-              FeedbackElem != NULL;
-              FeedbackElem = FeedbackElem->NextBrother)
-            if (!strcmp (FeedbackElem->TagName,"feedback"))
-              {
-               if (FeedbackElem->Content)
-                 {
-        	  /* Convert feedback from text to HTML (in database feedback is stored in HTML) */
-        	  strncpy (Feedback,FeedbackElem->Content,Cns_MAX_BYTES_TEXT);
-        	  Feedback[Cns_MAX_BYTES_TEXT] = '\0';
-                  Str_ChangeFormat (Str_FROM_TEXT,Str_TO_HTML,
-                                    Feedback,Cns_MAX_BYTES_TEXT,true);
-
-                  Gbl.Test.Feedback.Text   = Feedback;
-                  Gbl.Test.Feedback.Length = strlen (Feedback);
-                 }
-               break;	// Only first element "feedback"
-              }
+   /***** Write ending of list of imported questions *****/
+   TsI_WriteEndingListImportedQst ();
+  }
 
-         /* Get shuffle. By default, shuffle is false. */
-         Gbl.Test.Shuffle = false;
-         for (AnswerElem = QuestionElem->FirstChild;
-              AnswerElem != NULL;
-              AnswerElem = AnswerElem->NextBrother)
-            if (!strcmp (AnswerElem->TagName,"answer"))
-              {
-               if (Gbl.Test.AnswerType == Tst_ANS_UNIQUE_CHOICE ||
-                   Gbl.Test.AnswerType == Tst_ANS_MULTIPLE_CHOICE)
-                  /* Get whether shuffle answers (in attribute "shuffle") */
-                  for (Attribute = AnswerElem->FirstAttribute;
-                       Attribute != NULL;
-                       Attribute = Attribute->Next)
-                     if (!strcmp (Attribute->AttributeName,"shuffle"))
-                       {
-                        Gbl.Test.Shuffle = XML_GetAttributteYesNoFromXMLTree (Attribute);
-                        break;	// Only first attribute "shuffle"
-                       }
-               break;	// Only first element "answer"
-              }
+/*****************************************************************************/
+/********************* Check one question from XML tree ***********************/
+/*****************************************************************************/
+// Exit with an error if the question is wrong
 
-         /* Get answer (mandatory) */
-         TsI_GetAnswerFromXML (AnswerElem);
+static void TsI_CheckQuestionFromXML (struct XMLElement *QuestionElem)
+  {
+   struct XMLElement *StemElem;
+   struct XMLElement *FeedbackElem;
+   char Stem[Cns_MAX_BYTES_TEXT+1];
+   char Feedback[Cns_MAX_BYTES_TEXT+1];
 
-         /* Make sure that tags, text and answer are not empty */
-         if (Tst_CheckIfQstFormatIsCorrectAndCountNumOptions ())
-           {
-            /* Check if question already exists in database */
-            QuestionExists = TsI_CheckIfQuestionExistsInDB ();
+   /***** Create test question *****/
+   Tst_QstConstructor ();
+
+   /***** Get question from XML tree *****/
+   TsI_GetQuestionFromXML (QuestionElem,&StemElem,&FeedbackElem,Stem,Feedback);
+
+   /***** Destroy test question *****/
+   Tst_QstDestructor ();
+  }
+
+/*****************************************************************************/
+/******************** Import one question from XML tree **********************/
+/*****************************************************************************/
+
+static void TsI_ImportQuestionFromXML (struct XMLElement *QuestionElem)
+  {
+   struct XMLElement *StemElem;
+   struct XMLElement *FeedbackElem;
+   bool QuestionExists;
+   char Stem[Cns_MAX_BYTES_TEXT+1];
+   char Feedback[Cns_MAX_BYTES_TEXT+1];
+
+   /***** Create test question *****/
+   Tst_QstConstructor ();
+
+   /***** Get question from XML tree *****/
+   TsI_GetQuestionFromXML (QuestionElem,&StemElem,&FeedbackElem,Stem,Feedback);
+
+   /* Make sure that tags, text and answer are not empty */
+   if (Tst_CheckIfQstFormatIsCorrectAndCountNumOptions ())
+     {
+      /* Check if question already exists in database */
+      QuestionExists = TsI_CheckIfQuestionExistsInDB ();
+
+      /* Write row with this imported question */
+      TsI_WriteRowImportedQst (StemElem,FeedbackElem,QuestionExists);
+
+      /***** If a new question ==> insert question, tags and answer in the database *****/
+      if (!QuestionExists)
+        {
+         Gbl.Test.QstCod = -1L;
+         Tst_InsertOrUpdateQstTagsAnsIntoDB ();
+        }
+     }
+
+   /***** Destroy test question *****/
+   Tst_QstDestructor ();
+  }
 
-            /* Write row with this imported question */
-            TsI_WriteRowImportedQst (StemElem,FeedbackElem,QuestionExists);
+/*****************************************************************************/
+/**************** Get one question from XML tree into memory *****************/
+/*****************************************************************************/
+// Exit with an error if the type of answer or the answer are wrong.
+// Stem and Feedback are used to store the texts of the question
+
+static void TsI_GetQuestionFromXML (struct XMLElement *QuestionElem,
+                                    struct XMLElement **StemElem,
+                                    struct XMLElement **FeedbackElem,
+                                    char Stem[Cns_MAX_BYTES_TEXT+1],
+                                    char Feedback[Cns_MAX_BYTES_TEXT+1])
+  {
+   struct XMLElement *TagsElem;
+   struct XMLElement *TagElem;
+   struct XMLElement *AnswerElem;
+   struct XMLAttribute *Attribute;
+   bool AnswerTypeFound;
 
-            /***** If a new question ==> insert question, tags and answer in the database *****/
-            if (!QuestionExists)
+   /* Get type of questions (in mandatory attribute "type") */
+   AnswerTypeFound = false;
+   for (Attribute = QuestionElem->FirstAttribute;
+        Attribute != NULL;
+        Attribute = Attribute->Next)
+      if (!strcmp (Attribute->AttributeName,"type"))
+        {
+         Gbl.Test.AnswerType = TsI_ConvertFromStrAnsTypXMLToAnsTyp (Attribute->Content);
+         AnswerTypeFound = true;
+         break;	// Only first attribute "type"
+        }
+   if (!AnswerTypeFound)
+      Lay_ShowErrorAndExit ("Wrong type of answer.");
+
+   /* Get tags */
+   for (TagsElem = QuestionElem->FirstChild, Gbl.Test.Tags.Num = 0;
+        TagsElem != NULL;
+        TagsElem = TagsElem->NextBrother)
+      if (!strcmp (TagsElem->TagName,"tags"))
+        {
+         for (TagElem = TagsElem->FirstChild;
+              TagElem != NULL && Gbl.Test.Tags.Num < Tst_MAX_TAGS_PER_QUESTION;
+              TagElem = TagElem->NextBrother)
+            if (!strcmp (TagElem->TagName,"tag"))
               {
-               Gbl.Test.QstCod = -1L;
-               Tst_InsertOrUpdateQstTagsAnsIntoDB ();
+               if (TagElem->Content)
+                 {
+                  strncpy (Gbl.Test.Tags.Txt[Gbl.Test.Tags.Num],TagElem->Content,Tst_MAX_BYTES_TAG);
+                  Gbl.Test.Tags.Txt[Gbl.Test.Tags.Num][Tst_MAX_BYTES_TAG] = '\0';
+                  Gbl.Test.Tags.Num++;
+                 }
               }
+         break;	// Only first element "tags"
+        }
+
+   /* Get stem (mandatory) */
+   for (*StemElem = QuestionElem->FirstChild;
+        *StemElem != NULL;
+        *StemElem = (*StemElem)->NextBrother)
+      if (!strcmp ((*StemElem)->TagName,"stem"))
+        {
+         if ((*StemElem)->Content)
+           {
+	    /* Convert stem from text to HTML (in database stem is stored in HTML) */
+	    strncpy (Stem,(*StemElem)->Content,Cns_MAX_BYTES_TEXT);
+	    Stem[Cns_MAX_BYTES_TEXT] = '\0';
+            Str_ChangeFormat (Str_FROM_TEXT,Str_TO_HTML,
+                              Stem,Cns_MAX_BYTES_TEXT,true);
+
+            Gbl.Test.Stem.Text   = Stem;
+            Gbl.Test.Stem.Length = strlen (Stem);
            }
+         break;	// Only first element "stem"
+        }
 
-	 /***** Destroy test question *****/
-	 Tst_QstDestructor ();
+   /* Get feedback (optional) */
+   for (*FeedbackElem = QuestionElem->FirstChild;
+        *FeedbackElem != NULL;
+        *FeedbackElem = (*FeedbackElem)->NextBrother)
+      if (!strcmp ((*FeedbackElem)->TagName,"feedback"))
+        {
+         if ((*FeedbackElem)->Content)
+           {
+	    /* Convert feedback from text to HTML (in database feedback is stored in HTML) */
+	    strncpy (Feedback,(*FeedbackElem)->Content,Cns_MAX_BYTES_TEXT);
+	    Feedback[Cns_MAX_BYTES_TEXT] = '\0';
+            Str_ChangeFormat (Str_FROM_TEXT,Str_TO_HTML,
+                              Feedback,Cns_MAX_BYTES_TEXT,true);
+
+            Gbl.Test.Feedback.Text   = Feedback;
+            Gbl.Test.Feedback.Length = strlen (Feedback);
+           }
+         break;	// Only first element "feedback"
         }
-     }
 
-   /***** Write ending of list of imported questions *****/
-   TsI_WriteEndingListImportedQst ();
+   /* Get shuffle. By default, shuffle is false. */
+   Gbl.Test.Shuffle = false;
+   for (AnswerElem = QuestionElem->FirstChild;
+        AnswerElem != NULL;
+        AnswerElem = AnswerElem->NextBrother)
+      if (!strcmp (AnswerElem->TagName,"answer"))
+        {
+         if (Gbl.Test.AnswerType == Tst_ANS_UNIQUE_CHOICE ||
+             Gbl.Test.AnswerType == Tst_ANS_MULTIPLE_CHOICE)
+            /* Get whether shuffle answers (in attribute "shuffle") */
+            for (Attribute = AnswerElem->FirstAttribute;
+                 Attribute != NULL;
+                 Attribute = Attribute->Next)
+               if (!strcmp (Attribute->AttributeName,"shuffle"))
+                 {
+                  Gbl.Test.Shuffle = XML_GetAttributteYesNoFromXMLTree (Attribute);
+                  break;	// Only first attribute "shuffle"
+                 }
+         break;	// Only first element "answer"
+        }
 
-   /***** Free XML tree *****/
-   XML_FreeTree (RootElem);
+   /* Get answer (mandatory) */
+   if (!AnswerElem)
+      Lay_ShowErrorAndExit ("Answer not found.");
+   TsI_GetAnswerFromXML (AnswerElem);
   }
 
 /*****************************************************************************/
@@ -191,19 +191,6 @@ const char *Txt_Switch_to_LANGUAGE[1+Txt_NUM_LANGUAGES] =
 	"Prze&lstrok;&aogon;cz na polski",
 	"Mudar para portugu&ecirc;s",
 	};
-const char *Txt_Switching_to_LANGUAGE[1+Txt_NUM_LANGUAGES] =
-	{
-	"",
-	"Canviant a catal&agrave;&hellip;",
-	"Umschaltung auf Deutsch&hellip;",
-	"Switching to English&hellip;",
-	"Cambiando a espa&ntilde;ol&hellip;",
-	"Passant au fran&ccedil;ais&hellip;",
-	"Moambue pe &ntilde;e'&#7869; ava&ntilde;e'&#7869;&hellip;",
-	"Passando a italiano&hellip;",
-	"Prze&lstrok;&aogon;cz na polski&hellip;",
-	"Mudando para portugu&ecirc;s&hellip;",
-	};
 
 /*****************************************************************************
 		  #   #  ###       #   # ##### #   # #
@@ -27,6 +27,8 @@
 /********************************** Headers **********************************/
 /*****************************************************************************/
 
+#include <stddef.h>		// For size_t
+
 /*****************************************************************************/
 /****************************** Public constants *****************************/
 /*****************************************************************************/
@@ -51,6 +53,13 @@ typedef enum
    Txt_LANGUAGE_PT = 9,
   } Txt_Language_t; // ISO 639-1 language codes
 
+struct Txt_Table	// Generated in swad_text_tables.c from swad_text.o
+  {
+   void *Text;					// Variable used by the program
+   const void *Lang[1+Txt_NUM_LANGUAGES];	// Values of the variable in each language
+   size_t Size;					// Size in bytes of the variable
+  };
+
 /*****************************************************************************/
 /****************************** Public prototypes ****************************/
 /*****************************************************************************/
@@ -0,0 +1,54 @@
+#!/bin/sh
+#
+# swad_text_tables.sh: generate, from the symbols of swad_text.o,
+# a C file with the addresses of all the text variables
+# in each language, in order to switch language at run time
+#
+# Usage: swad_text_tables.sh swad_text.o > swad_text_tables.c
+#
+# The objects with the texts in each language must have been compiled
+# from swad_text.c with -D L=1 ... -D L=9 and their symbols renamed
+# with objcopy --prefix-symbols=ca_ ... --prefix-symbols=pt_
+
+# Languages in the same order as Txt_Language_t (from 1 to Txt_NUM_LANGUAGES)
+LANGS="ca de en es fr gn it pl pt"
+
+echo "// swad_text_tables.c: generated by swad_text_tables.sh. Don't edit!"
+echo
+echo "#include <linux/stddef.h>	// For NULL"
+echo
+echo "#include \"swad_text.h\""
+echo
+
+# Only variables (type D) are switched.
+# Constants (type R), like Txt_Current_CGI_SWAD_Language, are not.
+nm -S --defined-only "$1" | awk -v langs="$LANGS" '
+BEGIN {
+   NumLangs = split (langs,Lang," ");
+   NumTxts = 0;
+}
+NF == 4 && $3 == "D" {
+   NumTxts++;
+   Name[NumTxts] = $4;
+   Size[NumTxts] = $2;
+}
+END {
+   for (i = 1; i <= NumTxts; i++)
+     {
+      printf "extern char %s[]",Name[i];
+      for (l = 1; l <= NumLangs; l++)
+         printf ",%s_%s[]",Lang[l],Name[i];
+      printf ";\n";
+     }
+
+   printf "\nconst struct Txt_Table Txt_Tables[] =\n  {\n";
+   for (i = 1; i <= NumTxts; i++)
+     {
+      printf "   {%s,{NULL",Name[i];
+      for (l = 1; l <= NumLangs; l++)
+         printf ",%s_%s",Lang[l],Name[i];
+      printf "},0x%s},\n",Size[i];
+     }
+   printf "  };\n\n";
+   printf "const unsigned Txt_NumTables = sizeof (Txt_Tables) / sizeof (Txt_Tables[0]);\n";
+}'
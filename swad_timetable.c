@@ -29,6 +29,7 @@
 #include <stdio.h>		// For fprintf, etc.
 #include <string.h>		// For string functions
 
+#include "swad_cache.h"
 #include "swad_calendar.h"
 #include "swad_database.h"
 #include "swad_global.h"
@@ -101,13 +102,16 @@ struct TimeTableColumn
    unsigned Duration;
    char Place[TT_MAX_BYTES_PLACE+1];
    char Group[TT_MAX_BYTES_GROUP+1];
+   char CrsShrtName[Crs_MAX_LENGTH_COURSE_SHRT_NAME+1];	// Short name of course (got with the timetable)
+   char GrpTypName[MAX_LENGTH_GROUP_TYPE_NAME+1];	// Type of group (got with the timetable)
+   char GrpName[MAX_LENGTH_GROUP_NAME+1];		// Name of group (got with the timetable)
   };
 struct
   {
    unsigned NumColumns;
    struct TimeTableColumn Columns[TT_MAX_COLUMNS_PER_CELL];
   } TimeTable[TT_DAYS][TT_HOURS_PER_DAY*2];
-bool TimeTableHoursChecked[TT_HOURS_PER_DAY*2];
+unsigned TimeTableColsToDraw[TT_DAYS][TT_HOURS_PER_DAY*2];	// Computed once for all the cells
 
 /*****************************************************************************/
 /***************************** Internal prototypes **************************/
@@ -123,15 +127,19 @@ static void TT_PutIconToViewMyTT (void);
 
 static void TT_WriteCrsTimeTableIntoDB (long CrsCod);
 static void TT_WriteTutTimeTableIntoDB (long UsrCod);
+static void TT_CreatAndDrawTimeTable (long UsrCod);
 static void TT_CreatTimeTableFromDB (long UsrCod);
+static void TT_CopyStrOrEmpty (char *Dst,const char *Src);
 static void TT_ModifTimeTable (void);
 static void TT_DrawTimeTable (void);
 static void TT_TimeTableDrawAdjustRow (void);
 static void TT_TimeTableDrawDaysCells (void);
-static unsigned TT_TimeTableCalculateColsToDraw (unsigned Day,unsigned Hour);
+static void TT_TimeTableCalculateColsToDraw (void);
+static bool TT_CheckIfAClassContinuesInHour (unsigned Day,unsigned Hour);
 static void TT_DrawCellAlignTimeTable (void);
 static void TT_TimeTableDrawCell (unsigned Day,unsigned Hour,unsigned Column,unsigned ColSpan,
-                                  long CrsCod,TT_HourType_t HourType,TT_ClassType_t ClassType,unsigned Duration,char *Group,long GrpCod,char *Place);
+                                  const char *CrsShrtName,TT_HourType_t HourType,TT_ClassType_t ClassType,unsigned Duration,
+                                  const char *Group,long GrpCod,const char *GrpTypName,const char *GrpName,const char *Place);
 
 /*****************************************************************************/
 /*********** Show whether only my groups or all groups are shown *************/
@@ -397,40 +405,141 @@ static void TT_PutIconToViewMyTT (void)
 
 void TT_ShowTimeTable (long UsrCod)
   {
-   /***** Create an internal table with the timetable from database *****/
-   TT_CreatTimeTableFromDB (UsrCod);
+   Cac_Fragment_t Fragment;
+   long Cod;
+   char Variant[64];
 
-   /***** If timetable must be modified... *****/
-   if (Gbl.Action.Act == ActChgCrsTT ||
-       Gbl.Action.Act == ActChgTut)
+   switch (Gbl.Action.Act)
      {
-      /* Get parameters for time table editing */
-      TT_GetParamsTimeTable ();
+      case ActEdiCrsTT:
+      case ActEdiTut:
+	 /***** Timetables being edited are never cached *****/
+	 TT_CreatAndDrawTimeTable (UsrCod);
+	 return;
+      case ActChgCrsTT:
+      case ActChgTut:
+	 /***** Create an internal table with the timetable from database *****/
+	 TT_CreatTimeTableFromDB (UsrCod);
+
+	 /* Get parameters for time table editing */
+	 TT_GetParamsTimeTable ();
+
+	 /* Modify timetable in memory */
+	 TT_ModifTimeTable ();
+
+	 /* Write a new timetable in database */
+	 switch (Gbl.TimeTable.Type)
+	   {
+	    case TT_COURSE_TIMETABLE:
+	       TT_WriteCrsTimeTableIntoDB (Gbl.CurrentCrs.Crs.CrsCod);
+	       break;
+	    case TT_TUTOR_TIMETABLE:
+	       TT_WriteTutTimeTableIntoDB (UsrCod);
+	       break;
+	    default:
+	       break;
+	   }
 
-      /* Modify timetable in memory */
-      TT_ModifTimeTable ();
+	 /* Get a new table from database and draw it */
+	 TT_CreatAndDrawTimeTable (UsrCod);
+	 return;
+      default:
+	 break;
+     }
 
-      /* Write a new timetable in database */
-      switch (Gbl.TimeTable.Type)
-        {
-         case TT_COURSE_TIMETABLE:
-            TT_WriteCrsTimeTableIntoDB (Gbl.CurrentCrs.Crs.CrsCod);
-	    break;
-         case TT_TUTOR_TIMETABLE:
-            TT_WriteTutTimeTableIntoDB (UsrCod);
-            break;
-         default:
-            break;
-        }
+   /***** Get the fragment of cache for this timetable *****/
+   switch (Gbl.TimeTable.Type)
+     {
+      case TT_COURSE_TIMETABLE:
+	 Fragment = Cac_CRS_TT;
+	 Cod = Gbl.CurrentCrs.Crs.CrsCod;
+	 sprintf (Variant,"%ld_%u",
+		  Gbl.CurrentCrs.Grps.WhichGrps == Grp_ALL_GROUPS ? -1L :	// All groups: shared by all users
+								    UsrCod,	// Only my groups
+		  Gbl.Prefs.FirstDayOfWeek);
+	 break;
+      case TT_MY_TIMETABLE:
+	 Fragment = Cac_MY_TT;
+	 Cod = UsrCod;
+	 sprintf (Variant,"%u_%u",
+		  (unsigned) Gbl.CurrentCrs.Grps.WhichGrps,
+		  Gbl.Prefs.FirstDayOfWeek);
+	 break;
+      default:	// TT_TUTOR_TIMETABLE
+	 Fragment = Cac_TUT_TT;
+	 Cod = UsrCod;
+	 sprintf (Variant,"%u",
+		  Gbl.Prefs.FirstDayOfWeek);
+	 break;
+     }
 
-      /* Get a new table from database */
-      TT_CreatTimeTableFromDB (UsrCod);
+   /***** Draw timetable from cache or from database *****/
+   if (Cac_StartFragment (Fragment,Cod,Variant))
+     {
+      TT_CreatAndDrawTimeTable (UsrCod);
+      Cac_EndFragment ();
      }
+  }
+
+/*****************************************************************************/
+/************** Create timetable from database and draw it *******************/
+/*****************************************************************************/
+
+static void TT_CreatAndDrawTimeTable (long UsrCod)
+  {
+   /***** Create an internal table with the timetable from database *****/
+   TT_CreatTimeTableFromDB (UsrCod);
 
    /***** Draw timetable *****/
    TT_DrawTimeTable ();
   }
 
+/*****************************************************************************/
+/************* Invalidate timetables stored in cache for views ***************/
+/*****************************************************************************/
+// Must be called when the timetable of a course is changed,
+// or when the groups of a course or the users in them are changed.
+// If CrsCod <= 0, timetables of all courses are invalidated.
+// If UsrCod <= 0, personal timetables of all users in the course are invalidated,
+// so it must be called before removing users from the course.
+// If both are <= 0, personal timetables of all users are invalidated.
+
+void TT_InvalidateCachedTimeTables (long CrsCod,long UsrCod)
+  {
+   char Query[128];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumUsrs;
+   unsigned NumUsr;
+
+   /***** Invalidate timetable of the course *****/
+   Cac_InvalidateFragment (Cac_CRS_TT,CrsCod);
+
+   /***** Invalidate personal timetables *****/
+   if (UsrCod > 0 || CrsCod <= 0)
+      Cac_InvalidateFragment (Cac_MY_TT,UsrCod);
+   else
+     {
+      /* Get users in the course from database */
+      sprintf (Query,"SELECT UsrCod FROM crs_usr WHERE CrsCod='%ld'",
+	       CrsCod);
+      NumUsrs = (unsigned) DB_QuerySELECT (Query,&mysql_res,"can not get users in a course");
+
+      /* Invalidate the timetable of each user */
+      for (NumUsr = 0;
+	   NumUsr < NumUsrs;
+	   NumUsr++)
+	{
+	 row = mysql_fetch_row (mysql_res);
+	 if ((UsrCod = Str_ConvertStrCodToLongCod (row[0])) > 0)
+	    Cac_InvalidateFragment (Cac_MY_TT,UsrCod);
+	}
+
+      /* Free structure that stores the query result */
+      DB_FreeMySQLResult (&mysql_res);
+     }
+  }
+
 /*****************************************************************************/
 /******************* Write course timetable into database ********************/
 /*****************************************************************************/
@@ -469,6 +578,9 @@ static void TT_WriteCrsTimeTableIntoDB (long CrsCod)
 		        TimeTable[Day][Hour].Columns[Column].Group);
                DB_QueryINSERT (Query,"can not create course timetable");
               }
+
+   /***** Invalidate cached timetables of this course and all its users *****/
+   TT_InvalidateCachedTimeTables (CrsCod,-1L);
   }
 
 /*****************************************************************************/
@@ -504,6 +616,10 @@ static void TT_WriteTutTimeTableIntoDB (long UsrCod)
 			TimeTable[Day][Hour].Columns[Column].Place);
                DB_QueryINSERT (Query,"can not create office timetable");
               }
+
+   /***** Invalidate cached timetables of this user *****/
+   Cac_InvalidateFragment (Cac_TUT_TT,UsrCod);
+   Cac_InvalidateFragment (Cac_MY_TT,UsrCod);
   }
 
 /*****************************************************************************/
@@ -544,10 +660,15 @@ static void TT_CreatTimeTableFromDB (long UsrCod)
 	    TimeTable[Day][Hour].Columns[Column].Duration  = 0;
 	    TimeTable[Day][Hour].Columns[Column].Group[0]  = '\0';
 	    TimeTable[Day][Hour].Columns[Column].Place[0]  = '\0';
+	    TimeTable[Day][Hour].Columns[Column].CrsShrtName[0] = '\0';
+	    TimeTable[Day][Hour].Columns[Column].GrpTypName[0]  = '\0';
+	    TimeTable[Day][Hour].Columns[Column].GrpName[0]     = '\0';
 	   }
         }
 
    /***** Get timetable from database *****/
+   // Short name of course and type and name of group are got in the same query
+   // in order to avoid one query per cell when drawing timetable
    switch (Gbl.TimeTable.Type)
      {
       case TT_MY_TIMETABLE:
@@ -555,17 +676,24 @@ static void TT_CreatTimeTableFromDB (long UsrCod)
            {
             case Grp_ONLY_MY_GROUPS:
                sprintf (Query,"SELECT timetable_crs.Day,timetable_crs.Hour,timetable_crs.Duration,timetable_crs.Place,"
-                              "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod,timetable_crs.CrsCod"
-                              " FROM timetable_crs,crs_usr"
+                              "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod,timetable_crs.CrsCod,"
+                              "courses.ShortName,'' AS GrpTypName,'' AS GrpName"
+                              " FROM crs_usr,timetable_crs"
+                              " LEFT JOIN courses ON timetable_crs.CrsCod=courses.CrsCod"
                               " WHERE crs_usr.UsrCod='%ld' AND timetable_crs.GrpCod='-1' AND timetable_crs.CrsCod=crs_usr.CrsCod"
                               " UNION DISTINCT "
                               "SELECT timetable_crs.Day,timetable_crs.Hour,timetable_crs.Duration,timetable_crs.Place,"
-                              "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod,timetable_crs.CrsCod"
-                              " FROM timetable_crs,crs_grp_usr"
+                              "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod,timetable_crs.CrsCod,"
+                              "courses.ShortName,crs_grp_types.GrpTypName,crs_grp.GrpName"
+                              " FROM crs_grp_usr,timetable_crs"
+                              " LEFT JOIN courses ON timetable_crs.CrsCod=courses.CrsCod"
+                              " LEFT JOIN crs_grp ON timetable_crs.GrpCod=crs_grp.GrpCod"
+                              " LEFT JOIN crs_grp_types ON crs_grp.GrpTypCod=crs_grp_types.GrpTypCod"
                               " WHERE crs_grp_usr.UsrCod='%ld' AND timetable_crs.GrpCod=crs_grp_usr.GrpCod"
                               " UNION "
                               "SELECT Day,Hour,Duration,Place,"
-                              "'tutorias' AS ClassType,'' AS GroupName,'-1' AS GrpCod,'-1' AS CrsCod"
+                              "'tutorias' AS ClassType,'' AS GroupName,'-1' AS GrpCod,'-1' AS CrsCod,"
+                              "'' AS ShortName,'' AS GrpTypName,'' AS GrpName"
                               " FROM timetable_tut"
                               " WHERE UsrCod='%ld'"
                               " ORDER BY Day,Hour,ClassType,GroupName,GrpCod,Place,Duration DESC,CrsCod",
@@ -573,12 +701,17 @@ static void TT_CreatTimeTableFromDB (long UsrCod)
                break;
             case Grp_ALL_GROUPS:
                sprintf (Query,"SELECT timetable_crs.Day,timetable_crs.Hour,timetable_crs.Duration,timetable_crs.Place,"
-                              "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod,timetable_crs.CrsCod"
-                              " FROM timetable_crs,crs_usr"
+                              "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod,timetable_crs.CrsCod,"
+                              "courses.ShortName,crs_grp_types.GrpTypName,crs_grp.GrpName"
+                              " FROM crs_usr,timetable_crs"
+                              " LEFT JOIN courses ON timetable_crs.CrsCod=courses.CrsCod"
+                              " LEFT JOIN crs_grp ON timetable_crs.GrpCod=crs_grp.GrpCod"
+                              " LEFT JOIN crs_grp_types ON crs_grp.GrpTypCod=crs_grp_types.GrpTypCod"
                               " WHERE crs_usr.UsrCod='%ld' AND timetable_crs.CrsCod=crs_usr.CrsCod"
                               " UNION "
                               "SELECT Day,Hour,Duration,Place,"
-                              "'tutorias' AS ClassType,'' AS GroupName,'-1' AS GrpCod,'-1' AS CrsCod"
+                              "'tutorias' AS ClassType,'' AS GroupName,'-1' AS GrpCod,'-1' AS CrsCod,"
+                              "'' AS ShortName,'' AS GrpTypName,'' AS GrpName"
                               " FROM timetable_tut"
                               " WHERE UsrCod='%ld'"
                               " ORDER BY Day,Hour,ClassType,"
@@ -591,19 +724,28 @@ static void TT_CreatTimeTableFromDB (long UsrCod)
          if (Gbl.CurrentCrs.Grps.WhichGrps == Grp_ALL_GROUPS ||
              Gbl.Action.Act == ActEdiCrsTT ||
              Gbl.Action.Act == ActChgCrsTT)	// If we are editing, all groups are shown
-            sprintf (Query,"SELECT Day,Hour,Duration,Place,ClassType,GroupName,GrpCod"
+            sprintf (Query,"SELECT timetable_crs.Day,timetable_crs.Hour,timetable_crs.Duration,timetable_crs.Place,"
+                           "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod,timetable_crs.CrsCod,"
+                           "'' AS ShortName,crs_grp_types.GrpTypName,crs_grp.GrpName"
         	           " FROM timetable_crs"
-                           " WHERE CrsCod='%ld'"
+                           " LEFT JOIN crs_grp ON timetable_crs.GrpCod=crs_grp.GrpCod"
+                           " LEFT JOIN crs_grp_types ON crs_grp.GrpTypCod=crs_grp_types.GrpTypCod"
+                           " WHERE timetable_crs.CrsCod='%ld'"
                            " ORDER BY Day,Hour,ClassType,GroupName,GrpCod,Place,Duration DESC",
                      Gbl.CurrentCrs.Crs.CrsCod);
          else
-            sprintf (Query,"SELECT timetable_crs.Day,timetable_crs.Hour,timetable_crs.Duration,timetable_crs.Place,timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod"
+            sprintf (Query,"SELECT timetable_crs.Day,timetable_crs.Hour,timetable_crs.Duration,timetable_crs.Place,"
+                           "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod,timetable_crs.CrsCod,"
+                           "'' AS ShortName,'' AS GrpTypName,'' AS GrpName"
                            " FROM timetable_crs,crs_usr"
                            " WHERE timetable_crs.CrsCod='%ld' AND timetable_crs.GrpCod='-1' AND crs_usr.UsrCod='%ld' AND timetable_crs.CrsCod=crs_usr.CrsCod"
                            " UNION DISTINCT "
                            "SELECT timetable_crs.Day,timetable_crs.Hour,timetable_crs.Duration,timetable_crs.Place,"
-                           "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod"
-			   " FROM timetable_crs,crs_grp_usr"
+                           "timetable_crs.ClassType,timetable_crs.GroupName,timetable_crs.GrpCod,timetable_crs.CrsCod,"
+                           "'' AS ShortName,crs_grp_types.GrpTypName,crs_grp.GrpName"
+			   " FROM crs_grp_usr,timetable_crs"
+                           " LEFT JOIN crs_grp ON timetable_crs.GrpCod=crs_grp.GrpCod"
+                           " LEFT JOIN crs_grp_types ON crs_grp.GrpTypCod=crs_grp_types.GrpTypCod"
                            " WHERE timetable_crs.CrsCod='%ld' AND crs_grp_usr.UsrCod='%ld' AND timetable_crs.GrpCod=crs_grp_usr.GrpCod"
                            " ORDER BY Day,Hour,ClassType,GroupName,GrpCod,Place,Duration DESC",
                      Gbl.CurrentCrs.Crs.CrsCod,UsrCod,
@@ -714,11 +856,15 @@ static void TT_CreatTimeTableFromDB (long UsrCod)
                  {
                   case TT_MY_TIMETABLE:
                   case TT_COURSE_TIMETABLE:
-                     TimeTable[Day][Hour].Columns[FirstFreeColumn].CrsCod =
-                        (Gbl.TimeTable.Type == TT_MY_TIMETABLE ? Str_ConvertStrCodToLongCod (row[7]) :
-                                                                 Gbl.CurrentCrs.Crs.CrsCod);
+                     TimeTable[Day][Hour].Columns[FirstFreeColumn].CrsCod = Str_ConvertStrCodToLongCod (row[7]);
                      strcpy (TimeTable[Day][Hour].Columns[FirstFreeColumn].Group,row[5]);
                      TimeTable[Day][Hour].Columns[FirstFreeColumn].GrpCod = GrpCod;
+
+                     /* Names of course and group (row[8], row[9], row[10])
+                        are NULL if course or group have been removed */
+                     TT_CopyStrOrEmpty (TimeTable[Day][Hour].Columns[FirstFreeColumn].CrsShrtName,row[8]);
+                     TT_CopyStrOrEmpty (TimeTable[Day][Hour].Columns[FirstFreeColumn].GrpTypName,row[9]);
+                     TT_CopyStrOrEmpty (TimeTable[Day][Hour].Columns[FirstFreeColumn].GrpName,row[10]);
                      // no break;
                   case TT_TUTOR_TIMETABLE:
                      strcpy (TimeTable[Day][Hour].Columns[FirstFreeColumn].Place,row[3]);
@@ -743,6 +889,18 @@ static void TT_CreatTimeTableFromDB (long UsrCod)
       Lay_WriteTitle (Txt_Incomplete_timetable_for_lack_of_space);
   }
 
+/*****************************************************************************/
+/************** Copy a string got from database that may be NULL *************/
+/*****************************************************************************/
+
+static void TT_CopyStrOrEmpty (char *Dst,const char *Src)
+  {
+   if (Src)
+      strcpy (Dst,Src);
+   else
+      Dst[0] = '\0';
+  }
+
 /*****************************************************************************/
 /*********************** Modify a class in timetable *************************/
 /*****************************************************************************/
@@ -758,6 +916,8 @@ static void TT_ModifTimeTable (void)
       TimeTable[Gbl.TimeTable.Day][Gbl.TimeTable.Hour].Columns[Gbl.TimeTable.Column].Duration  = 0;
       TimeTable[Gbl.TimeTable.Day][Gbl.TimeTable.Hour].Columns[Gbl.TimeTable.Column].Group[0]  = '\0';
       TimeTable[Gbl.TimeTable.Day][Gbl.TimeTable.Hour].Columns[Gbl.TimeTable.Column].Place[0]  = '\0';
+      TimeTable[Gbl.TimeTable.Day][Gbl.TimeTable.Hour].Columns[Gbl.TimeTable.Column].GrpTypName[0] = '\0';
+      TimeTable[Gbl.TimeTable.Day][Gbl.TimeTable.Hour].Columns[Gbl.TimeTable.Column].GrpName[0]    = '\0';
       TimeTable[Gbl.TimeTable.Day][Gbl.TimeTable.Hour].NumColumns--;
      }
 
@@ -785,7 +945,6 @@ static void TT_DrawTimeTable (void)
    unsigned DayColumn;	// Column from left (0) to right (6)
    unsigned Day;	// Day of week
    unsigned Hour;
-   unsigned H;
    unsigned Column;
    unsigned ColumnsToDraw;
    unsigned ColumnsToDrawIncludingExtraColumn;
@@ -805,6 +964,9 @@ static void TT_DrawTimeTable (void)
          break;
      }
 
+   /***** Calculate number of columns to draw in each cell *****/
+   TT_TimeTableCalculateColsToDraw ();
+
    /***** Table start *****/
    fprintf (Gbl.F.Out,"<table id=\"timetable\">");
 
@@ -861,13 +1023,8 @@ static void TT_DrawTimeTable (void)
 	    Day == 6 ==> sunday */
 	 Day = (DayColumn + Gbl.Prefs.FirstDayOfWeek) % 7;
 
-         /* Check how many colums are needed.
-            For each item (class) in this hour from left to right, we must check the maximum of columns */
-         for (H = 0;
-              H < TT_HOURS_PER_DAY * 2;
-              H++)
-            TimeTableHoursChecked[H] = false;
-         ColumnsToDraw = TT_TimeTableCalculateColsToDraw (Day,Hour);
+         /* Get how many colums are needed */
+         ColumnsToDraw = TimeTableColsToDraw[Day][Hour];
          if (!Editing && ColumnsToDraw == 0)
             ColumnsToDraw = 1;
          ColumnsToDrawIncludingExtraColumn = ColumnsToDraw;
@@ -885,21 +1042,23 @@ static void TT_DrawTimeTable (void)
                if (ContinuousFreeMinicolumns)
                  {
                   TT_TimeTableDrawCell (Day,Hour,Column-1,ContinuousFreeMinicolumns,
-                                        -1L,TT_FREE_HOUR,TT_NO_CLASS,0,NULL,-1,NULL);
+                                        NULL,TT_FREE_HOUR,TT_NO_CLASS,0,NULL,-1L,NULL,NULL,NULL);
                   ContinuousFreeMinicolumns = 0;
                  }
                TT_TimeTableDrawCell (Day,Hour,Column,TT_NUM_MINICOLUMNS_PER_DAY/ColumnsToDrawIncludingExtraColumn,
-	                             TimeTable[Day][Hour].Columns[Column].CrsCod,
+	                             TimeTable[Day][Hour].Columns[Column].CrsShrtName,
 				     TimeTable[Day][Hour].Columns[Column].HourType,
 	                             TimeTable[Day][Hour].Columns[Column].ClassType,
                                      TimeTable[Day][Hour].Columns[Column].Duration,
 	                             TimeTable[Day][Hour].Columns[Column].Group,
 	                             TimeTable[Day][Hour].Columns[Column].GrpCod,
+	                             TimeTable[Day][Hour].Columns[Column].GrpTypName,
+	                             TimeTable[Day][Hour].Columns[Column].GrpName,
                                      TimeTable[Day][Hour].Columns[Column].Place);
               }
          if (ContinuousFreeMinicolumns)
             TT_TimeTableDrawCell (Day,Hour,Column-1,ContinuousFreeMinicolumns,
-                                  -1L,TT_FREE_HOUR,TT_NO_CLASS,0,NULL,-1L,NULL);
+                                  NULL,TT_FREE_HOUR,TT_NO_CLASS,0,NULL,-1L,NULL,NULL,NULL);
         }
 
       /* Empty column used to adjust height */
@@ -998,62 +1157,61 @@ static void TT_TimeTableDrawDaysCells (void)
   }
 
 /*****************************************************************************/
-/**** Calculate recursively number of columns to draw for a day and hour *****/
+/******** Calculate the number of columns to draw for each day and hour ******/
 /*****************************************************************************/
+// The hours of a day are grouped in intervals of consecutive hours
+// linked by classes lasting more than one hour.
+// All the hours in an interval are drawn with the same number of columns:
+// the maximum number of columns of any hour in the interval
 
-static unsigned TT_TimeTableCalculateColsToDraw (unsigned Day,unsigned Hour)
+static void TT_TimeTableCalculateColsToDraw (void)
   {
+   unsigned Day;
+   unsigned FirstHour;
+   unsigned Hour;
+   unsigned H;
    unsigned ColumnsToDraw;
+
+   for (Day = 0;
+	Day < TT_DAYS;
+	Day++)
+      for (FirstHour = 0;
+	   FirstHour < TT_HOURS_PER_DAY * 2;
+	   FirstHour = Hour)
+	{
+	 /***** Find the end of the interval starting at this hour,
+		and the maximum number of columns in it *****/
+	 ColumnsToDraw = TimeTable[Day][FirstHour].NumColumns;
+	 for (Hour = FirstHour + 1;
+	      Hour < TT_HOURS_PER_DAY * 2 &&
+	      TT_CheckIfAClassContinuesInHour (Day,Hour);
+	      Hour++)
+	    if (TimeTable[Day][Hour].NumColumns > ColumnsToDraw)
+	       ColumnsToDraw = TimeTable[Day][Hour].NumColumns;
+
+	 /***** All the hours in the interval have the same number of columns *****/
+	 for (H = FirstHour;
+	      H < Hour;
+	      H++)
+	    TimeTableColsToDraw[Day][H] = ColumnsToDraw;
+	}
+  }
+
+/*****************************************************************************/
+/********** Check if any class started before continues in an hour ***********/
+/*****************************************************************************/
+
+static bool TT_CheckIfAClassContinuesInHour (unsigned Day,unsigned Hour)
+  {
    unsigned Column;
-   unsigned H;
-   unsigned FirstHour;
-   unsigned Cols;
 
-   ColumnsToDraw = TimeTable[Day][Hour].NumColumns;
+   for (Column = 0;
+	Column < TT_MAX_COLUMNS_PER_CELL;
+	Column++)
+      if (TimeTable[Day][Hour].Columns[Column].HourType == TT_NEXT_HOUR)
+	 return true;
 
-   if (!TimeTableHoursChecked[Hour])
-     {
-      TimeTableHoursChecked[Hour] = true;
-      for (Column = 0;
-	   Column < TT_MAX_COLUMNS_PER_CELL;
-	   Column++)
-        {
-         switch (TimeTable[Day][Hour].Columns[Column].HourType)
-           {
-            case TT_FREE_HOUR:
-               break;
-            case TT_FIRST_HOUR:
-               /* Check from first hour (this one) to last hour searching maximum number of columns */
-               for (H = Hour + 1;
-        	    H < Hour + TimeTable[Day][Hour].Columns[Column].Duration;
-        	    H++)
-                  if (!TimeTableHoursChecked[H])
-                    {
-                     Cols = TT_TimeTableCalculateColsToDraw (Day,H);
-                     if (Cols > ColumnsToDraw)
-                        ColumnsToDraw = Cols;
-                    }
-               break;
-            case TT_NEXT_HOUR:
-               /* Find first hour for this item (class) */
-               for (FirstHour = Hour;
-        	    TimeTable[Day][FirstHour].Columns[Column].HourType == TT_NEXT_HOUR;
-        	    FirstHour--);
-                 /* Check from first hour to last hour searching maximum number of columns */
-               for (H = FirstHour;
-        	    H < FirstHour + TimeTable[Day][FirstHour].Columns[Column].Duration;
-        	    H++)
-                  if (!TimeTableHoursChecked[H])
-                    {
-                     Cols = TT_TimeTableCalculateColsToDraw (Day,H);
-                     if (Cols > ColumnsToDraw)
-                        ColumnsToDraw = Cols;
-                    }
-               break;
-           }
-        }
-     }
-   return ColumnsToDraw;
+   return false;
   }
 
 /*****************************************************************************/
@@ -1073,7 +1231,8 @@ static void TT_DrawCellAlignTimeTable (void)
 /*****************************************************************************/
 
 static void TT_TimeTableDrawCell (unsigned Day,unsigned Hour,unsigned Column,unsigned ColSpan,
-                                  long CrsCod,TT_HourType_t HourType,TT_ClassType_t ClassType,unsigned Duration,char *Group,long GrpCod,char *Place)
+                                  const char *CrsShrtName,TT_HourType_t HourType,TT_ClassType_t ClassType,unsigned Duration,
+                                  const char *Group,long GrpCod,const char *GrpTypName,const char *GrpName,const char *Place)
   {
    extern const char *Txt_unknown_removed_course;
    extern const char *Txt_TIMETABLE_CLASS_TYPES[TT_NUM_CLASS_TYPES];
@@ -1095,7 +1254,8 @@ static void TT_TimeTableDrawCell (unsigned Day,unsigned Hour,unsigned Column,uns
       TT_TUT_SHOW,
       TT_TUT_EDIT,
      } TimeTableView = TT_CRS_SHOW;
-   struct GroupData GrpDat;
+   char GrpTypNameShort[MAX_LENGTH_GROUP_TYPE_NAME+1];
+   char GrpNameShort[MAX_LENGTH_GROUP_NAME+1];
    unsigned NumGrpTyp;
    unsigned NumGrp;
    unsigned H;
@@ -1103,7 +1263,6 @@ static void TT_TimeTableDrawCell (unsigned Day,unsigned Hour,unsigned Column,uns
    unsigned MaxDuration;
    unsigned RowSpan = 0;
    TT_ClassType_t CT;
-   struct Course Crs;
 
    /***** Compute row span and background color depending on hour type *****/
    switch (HourType)
@@ -1140,17 +1299,6 @@ static void TT_TimeTableDrawCell (unsigned Day,unsigned Hour,unsigned Column,uns
 	 break;
      }
 
-   /***** If group code > 0, a group is selected ==> get group type and name *****/
-   if (HourType == TT_FIRST_HOUR &&
-       (TimeTableView == TT_CRS_SHOW ||
-        TimeTableView == TT_CRS_EDIT) &&
-       GrpCod > 0)
-     {
-      /* Get group type and name */
-      GrpDat.GrpCod = GrpCod;
-      Grp_GetDataOfGroupByCod (&GrpDat);
-     }
-
    /***** Cell start *****/
    fprintf (Gbl.F.Out,"<td rowspan=\"%u\" colspan=\"%u\" class=\"%s",
             RowSpan,ColSpan,TimeTableClasses[ClassType]);
@@ -1173,15 +1321,11 @@ static void TT_TimeTableDrawCell (unsigned Day,unsigned Hour,unsigned Column,uns
 	   {
 	    fprintf (Gbl.F.Out,"<span class=\"TT_TXT\">");
 	    if (Gbl.TimeTable.Type == TT_MY_TIMETABLE)
-              {
-               Crs.CrsCod = CrsCod;
-               Crs_GetDataOfCourseByCod (&Crs);
                if (ClassType == TT_THEORY_CLASS ||
                    ClassType == TT_PRACT_CLASS)
 		  fprintf (Gbl.F.Out,"%s<br />",
-		           Crs.ShrtName[0] ? Crs.ShrtName :
-			                     Txt_unknown_removed_course);
-              }
+		           CrsShrtName[0] ? CrsShrtName :
+			                    Txt_unknown_removed_course);
 	    fprintf (Gbl.F.Out,"%s (%dh%s)",
 		     Txt_TIMETABLE_CLASS_TYPES[ClassType],
 	             Duration / 2,
@@ -1196,10 +1340,12 @@ static void TT_TimeTableDrawCell (unsigned Day,unsigned Hour,unsigned Column,uns
                  }
                else
                  {
-                  Str_LimitLengthHTMLStr (GrpDat.GrpTypName,12);
-                  Str_LimitLengthHTMLStr (GrpDat.GrpName,12);
+                  strcpy (GrpTypNameShort,GrpTypName);
+                  strcpy (GrpNameShort,GrpName);
+                  Str_LimitLengthHTMLStr (GrpTypNameShort,12);
+                  Str_LimitLengthHTMLStr (GrpNameShort,12);
 		  fprintf (Gbl.F.Out,"<br />%s %s",
-                           GrpDat.GrpTypName,GrpDat.GrpName);
+                           GrpTypNameShort,GrpNameShort);
                  }
 	       if (Place[0])
 		  fprintf (Gbl.F.Out,"<br />%s",Place);
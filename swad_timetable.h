@@ -68,5 +68,6 @@ void TT_ShowClassTimeTable (void);
 void TT_EditCrsTimeTable (void);
 void TT_ShowMyTutTimeTable (void);
 void TT_ShowTimeTable (long UsrCod);
+void TT_InvalidateCachedTimeTables (long CrsCod,long UsrCod);
 
 #endif
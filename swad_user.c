@@ -108,6 +108,15 @@ extern struct Globals Gbl;
 /***************************** Private prototypes ****************************/
 /*****************************************************************************/
 
+static void Usr_GetUsrDataFromRow (struct UsrData *UsrDat,MYSQL_ROW row);
+static void Usr_SetRoleWhenNotInCurrentCrs (struct UsrData *UsrDat);
+static void Usr_PrefetchRows (struct Usr_PrefetchedRows *Prefetched,
+                              const char *Select,const char *From,
+                              const char *GroupBy,const char *OrderBy,
+                              unsigned NumUsrs,const long *LstUsrCods);
+static unsigned Usr_GetFirstPrefetchedRow (const struct Usr_PrefetchedRows *Prefetched,
+                                           long UsrCod);
+static void Usr_FreePrefetchedRows (struct Usr_PrefetchedRows *Prefetched);
 static void Usr_GetMyLastData (void);
 static void Usr_GetUsrCommentsFromString (char *Str,struct UsrData *UsrDat);
 static Usr_Sex_t Usr_GetSexFromStr (const char *Str);
@@ -437,28 +446,21 @@ void Usr_GetEncryptedUsrCodFromUsrCod (struct UsrData *UsrDat)
 /*****************************************************************************/
 // UsrDat->UsrCod must contain an existing user's code
 
+#define Usr_USR_DATA_FIELDS "EncryptedUsrCod,Password,Surname1,Surname2,FirstName,Sex," \
+                            "Theme,IconSet,Language,FirstDayOfWeek,Photo,PhotoVisibility,ProfileVisibility," \
+                            "CtyCod,InsCtyCod,InsCod,DptCod,CtrCod,Office,OfficePhone," \
+                            "LocalAddress,LocalPhone,FamilyAddress,FamilyPhone,OriginPlace,Birthday,Comments," \
+                            "Menu,SideCols,NotifNtfEvents,EmailNtfEvents"
+
 void Usr_GetUsrDataFromUsrCod (struct UsrData *UsrDat)
   {
-   extern const bool Cal_DayIsValidAsFirstDayOfWeek[7];
-   extern const char *Txt_STR_LANG_ID[1+Txt_NUM_LANGUAGES];
-   extern const char *The_ThemeId[The_NUM_THEMES];
-   extern const char *Ico_IconSetId[Ico_NUM_ICON_SETS];
    char Query[1024];
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
    unsigned long NumRows;
-   The_Theme_t Theme;
-   Ico_IconSet_t IconSet;
-   Txt_Language_t Lan;
-   unsigned UnsignedNum;
-   char StrBirthday[4+1+2+1+2+1];
 
    /***** Get user's data from database *****/
-   sprintf (Query,"SELECT EncryptedUsrCod,Password,Surname1,Surname2,FirstName,Sex,"
-                  "Theme,IconSet,Language,FirstDayOfWeek,Photo,PhotoVisibility,ProfileVisibility,"
-                  "CtyCod,InsCtyCod,InsCod,DptCod,CtrCod,Office,OfficePhone,"
-                  "LocalAddress,LocalPhone,FamilyAddress,FamilyPhone,OriginPlace,Birthday,Comments,"
-                  "Menu,SideCols,NotifNtfEvents,EmailNtfEvents"
+   sprintf (Query,"SELECT " Usr_USR_DATA_FIELDS
                   " FROM usr_data WHERE UsrCod='%ld'",
             UsrDat->UsrCod);
    NumRows = DB_QuerySELECT (Query,&mysql_res,"can not get user's data");
@@ -469,6 +471,37 @@ void Usr_GetUsrDataFromUsrCod (struct UsrData *UsrDat)
 
    /***** Read user's data *****/
    row = mysql_fetch_row (mysql_res);
+   Usr_GetUsrDataFromRow (UsrDat,row);
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Get roles *****/
+   UsrDat->RoleInCurrentCrsDB = Rol_GetRoleInCrs (Gbl.CurrentCrs.Crs.CrsCod,UsrDat->UsrCod);
+   UsrDat->Roles = Rol_GetRolesInAllCrss (UsrDat->UsrCod);
+   Usr_SetRoleWhenNotInCurrentCrs (UsrDat);
+
+   /***** Get nickname and e-mail *****/
+   Nck_GetNicknameFromUsrCod (UsrDat->UsrCod,UsrDat->Nickname);
+   Mai_GetEmailFromUsrCod (UsrDat);
+  }
+
+/*****************************************************************************/
+/********** Get user's data from a row with the fields of usr_data ***********/
+/*****************************************************************************/
+// row must hold the fields in Usr_USR_DATA_FIELDS
+
+static void Usr_GetUsrDataFromRow (struct UsrData *UsrDat,MYSQL_ROW row)
+  {
+   extern const bool Cal_DayIsValidAsFirstDayOfWeek[7];
+   extern const char *Txt_STR_LANG_ID[1+Txt_NUM_LANGUAGES];
+   extern const char *The_ThemeId[The_NUM_THEMES];
+   extern const char *Ico_IconSetId[Ico_NUM_ICON_SETS];
+   The_Theme_t Theme;
+   Ico_IconSet_t IconSet;
+   Txt_Language_t Lan;
+   unsigned UnsignedNum;
+   char StrBirthday[4+1+2+1+2+1];
 
    /* Get encrypted user's code */
    strncpy (UsrDat->EncryptedUsrCod,row[0],sizeof (UsrDat->EncryptedUsrCod) - 1);
@@ -478,14 +511,6 @@ void Usr_GetUsrDataFromUsrCod (struct UsrData *UsrDat)
    strncpy (UsrDat->Password,row[1],sizeof (UsrDat->Password) - 1);
    UsrDat->Password[sizeof (UsrDat->Password) - 1] = '\0';
 
-   /* Get roles */
-   UsrDat->RoleInCurrentCrsDB = Rol_GetRoleInCrs (Gbl.CurrentCrs.Crs.CrsCod,UsrDat->UsrCod);
-   UsrDat->Roles = Rol_GetRolesInAllCrss (UsrDat->UsrCod);
-   if (UsrDat->RoleInCurrentCrsDB == Rol_UNKNOWN)
-      UsrDat->RoleInCurrentCrsDB = (UsrDat->Roles < (1 << Rol_STUDENT)) ?
-	                           Rol__GUEST_ :	// User does not belong to any course
-	                           Rol_VISITOR;		// User belongs to some courses
-
    /* Get name */
    strncpy (UsrDat->Surname1 ,row[2],sizeof (UsrDat->Surname1 ) - 1);
    UsrDat->Surname1 [sizeof (UsrDat->Surname1 ) - 1] = '\0';
@@ -607,13 +632,257 @@ void Usr_GetUsrDataFromUsrCod (struct UsrData *UsrDat)
 	       &(UsrDat->Birthday.Day)) != 3)
       Lay_ShowErrorAndExit ("Wrong date.");
    Dat_ConvDateToDateStr (&(UsrDat->Birthday),UsrDat->StrBirthday);
+  }
 
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
+/*****************************************************************************/
+/******* Set user's role when he/she does not belong to current course *******/
+/*****************************************************************************/
 
-   /***** Get nickname and e-mail *****/
-   Nck_GetNicknameFromUsrCod (UsrDat->UsrCod,UsrDat->Nickname);
-   Mai_GetEmailFromUsrCod (UsrDat);
+static void Usr_SetRoleWhenNotInCurrentCrs (struct UsrData *UsrDat)
+  {
+   if (UsrDat->RoleInCurrentCrsDB == Rol_UNKNOWN)
+      UsrDat->RoleInCurrentCrsDB = (UsrDat->Roles < (1 << Rol_STUDENT)) ?
+	                           Rol__GUEST_ :	// User does not belong to any course
+	                           Rol_VISITOR;		// User belongs to some courses
+  }
+
+/*****************************************************************************/
+/**************** Get all the data of several users at once ******************/
+/*****************************************************************************/
+// Users' data, roles, IDs, nicknames and e-mails are got with one query each.
+// The rows remain in memory until Usr_FreePrefetchedUsrsData is called
+
+void Usr_PrefetchAllUsrDataOfUsrs (struct Usr_PrefetchedUsrsData *Prefetched,
+                                   unsigned NumUsrs,const long *LstUsrCods)
+  {
+   char SelectRoles[128];
+
+   sprintf (SelectRoles,"UsrCod,Role,MAX(CrsCod='%ld')",
+            Gbl.CurrentCrs.Crs.CrsCod);
+
+   Usr_PrefetchRows (&Prefetched->Data,
+                     "UsrCod," Usr_USR_DATA_FIELDS,"usr_data",
+                     NULL,"UsrCod",
+                     NumUsrs,LstUsrCods);
+   Usr_PrefetchRows (&Prefetched->Roles,
+                     SelectRoles,"crs_usr",
+                     "UsrCod,Role","UsrCod",
+                     NumUsrs,LstUsrCods);
+   // First the confirmed (Confirmed == 'Y')
+   // Then the unconfirmed (Confirmed == 'N')
+   Usr_PrefetchRows (&Prefetched->IDs,
+                     "UsrCod,UsrID,Confirmed","usr_IDs",
+                     NULL,"UsrCod,Confirmed DESC,UsrID",
+                     NumUsrs,LstUsrCods);
+   Usr_PrefetchRows (&Prefetched->Nicknames,
+                     "UsrCod,Nickname","usr_nicknames",
+                     NULL,"UsrCod,CreatTime DESC",
+                     NumUsrs,LstUsrCods);
+   Usr_PrefetchRows (&Prefetched->Emails,
+                     "UsrCod,E_mail,Confirmed","usr_emails",
+                     NULL,"UsrCod,CreatTime DESC",
+                     NumUsrs,LstUsrCods);
+  }
+
+/*****************************************************************************/
+/********* Get rows of a table for several users ordered by user *************/
+/*****************************************************************************/
+
+static void Usr_PrefetchRows (struct Usr_PrefetchedRows *Prefetched,
+                              const char *Select,const char *From,
+                              const char *GroupBy,const char *OrderBy,
+                              unsigned NumUsrs,const long *LstUsrCods)
+  {
+   char *Query;
+   size_t Length;
+   unsigned NumUsr;
+   unsigned NumRow;
+
+   Prefetched->mysql_res = NULL;
+   Prefetched->NumRows = 0;
+   Prefetched->Rows = NULL;
+   if (!NumUsrs)
+      return;
+
+   /***** Allocate space for query *****/
+   if ((Query = (char *) malloc (1024 + NumUsrs * (1+1+10+1))) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory to store database query.");
+
+   /***** Build query *****/
+   Length = sprintf (Query,"SELECT %s FROM %s WHERE UsrCod IN (",
+                     Select,From);
+   for (NumUsr = 0;
+	NumUsr < NumUsrs;
+	NumUsr++)
+      Length += sprintf (&Query[Length],"%s'%ld'",
+                         NumUsr ? "," :
+                                  "",
+                         LstUsrCods[NumUsr]);
+   Length += sprintf (&Query[Length],")");
+   if (GroupBy)
+      Length += sprintf (&Query[Length]," GROUP BY %s",GroupBy);
+   sprintf (&Query[Length]," ORDER BY %s",OrderBy);
+
+   /***** Get rows from database *****/
+   Prefetched->NumRows = (unsigned) DB_QuerySELECT (Query,&Prefetched->mysql_res,"can not get data of users");
+
+   /***** Free space used for query *****/
+   free ((void *) Query);
+
+   /***** Keep pointers to the rows in order to search them quickly *****/
+   if (Prefetched->NumRows)
+     {
+      if ((Prefetched->Rows = (MYSQL_ROW *) malloc (Prefetched->NumRows * sizeof (MYSQL_ROW))) == NULL)
+         Lay_ShowErrorAndExit ("Not enough memory to store data of users.");
+      for (NumRow = 0;
+	   NumRow < Prefetched->NumRows;
+	   NumRow++)
+         Prefetched->Rows[NumRow] = mysql_fetch_row (Prefetched->mysql_res);
+     }
+  }
+
+/*****************************************************************************/
+/************ Get the first prefetched row of a user, if exists **************/
+/*****************************************************************************/
+// Return the index of the first row of the user, or Prefetched->NumRows if not found
+
+static unsigned Usr_GetFirstPrefetchedRow (const struct Usr_PrefetchedRows *Prefetched,
+                                           long UsrCod)
+  {
+   unsigned Low = 0;
+   unsigned High = Prefetched->NumRows;
+   unsigned Mid;
+
+   /***** Binary search of the first row with a user's code >= UsrCod *****/
+   while (Low < High)
+     {
+      Mid = Low + (High - Low) / 2;
+      if (Str_ConvertStrCodToLongCod (Prefetched->Rows[Mid][0]) < UsrCod)
+	 Low = Mid + 1;
+      else
+	 High = Mid;
+     }
+
+   if (Low < Prefetched->NumRows)
+      if (Str_ConvertStrCodToLongCod (Prefetched->Rows[Low][0]) == UsrCod)
+         return Low;
+   return Prefetched->NumRows;
+  }
+
+/*****************************************************************************/
+/************ Get all the user's data from prefetched data *******************/
+/*****************************************************************************/
+// Input: UsrDat->UsrCod must hold user's code
+// If the user is not in prefetched data, his/her data are got from database
+
+void Usr_GetAllUsrDataFromPrefetched (const struct Usr_PrefetchedUsrsData *Prefetched,
+                                      struct UsrData *UsrDat)
+  {
+   unsigned NumRow;
+   unsigned NumIDs;
+   unsigned NumID;
+   MYSQL_ROW row;
+   Rol_Role_t Role;
+
+   /***** Get user's data *****/
+   if ((NumRow = Usr_GetFirstPrefetchedRow (&Prefetched->Data,UsrDat->UsrCod)) == Prefetched->Data.NumRows)
+     {
+      Usr_GetAllUsrDataFromUsrCod (UsrDat);
+      return;
+     }
+   Usr_GetUsrDataFromRow (UsrDat,Prefetched->Data.Rows[NumRow] + 1);
+
+   /***** Get roles *****/
+   UsrDat->RoleInCurrentCrsDB = Rol_UNKNOWN;
+   UsrDat->Roles = 0;
+   for (NumRow = Usr_GetFirstPrefetchedRow (&Prefetched->Roles,UsrDat->UsrCod);
+	NumRow < Prefetched->Roles.NumRows;
+	NumRow++)
+     {
+      row = Prefetched->Roles.Rows[NumRow];
+      if (Str_ConvertStrCodToLongCod (row[0]) != UsrDat->UsrCod)
+	 break;
+      if ((Role = Rol_ConvertUnsignedStrToRole (row[1])) != Rol_UNKNOWN)
+	{
+         UsrDat->Roles |= (1 << Role);
+         if (row[2][0] == '1')	// User has this role in current course
+            UsrDat->RoleInCurrentCrsDB = Role;
+	}
+     }
+   Usr_SetRoleWhenNotInCurrentCrs (UsrDat);
+
+   /***** Get list of IDs *****/
+   ID_FreeListIDs (UsrDat);
+   NumRow = Usr_GetFirstPrefetchedRow (&Prefetched->IDs,UsrDat->UsrCod);
+   for (NumIDs = 0;
+	NumRow + NumIDs < Prefetched->IDs.NumRows;
+	NumIDs++)
+      if (Str_ConvertStrCodToLongCod (Prefetched->IDs.Rows[NumRow + NumIDs][0]) != UsrDat->UsrCod)
+	 break;
+   if (NumIDs)
+     {
+      ID_ReallocateListIDs (UsrDat,NumIDs);
+      for (NumID = 0;
+	   NumID < NumIDs;
+	   NumID++)
+	{
+	 row = Prefetched->IDs.Rows[NumRow + NumID];
+
+	 /* Get ID from row[1] */
+	 strncpy (UsrDat->IDs.List[NumID].ID,row[1],ID_MAX_LENGTH_USR_ID);
+	 UsrDat->IDs.List[NumID].ID[ID_MAX_LENGTH_USR_ID] = '\0';
+
+	 /* Get if ID is confirmed from row[2] */
+	 UsrDat->IDs.List[NumID].Confirmed = (row[2][0] == 'Y');
+	}
+     }
+
+   /***** Get current (last updated) nickname *****/
+   if ((NumRow = Usr_GetFirstPrefetchedRow (&Prefetched->Nicknames,UsrDat->UsrCod)) < Prefetched->Nicknames.NumRows)
+     {
+      strncpy (UsrDat->Nickname,Prefetched->Nicknames.Rows[NumRow][1],Nck_MAX_LENGTH_NICKNAME_WITHOUT_ARROBA);
+      UsrDat->Nickname[Nck_MAX_LENGTH_NICKNAME_WITHOUT_ARROBA] = '\0';
+     }
+   else
+      UsrDat->Nickname[0] = '\0';
+
+   /***** Get current (last updated) e-mail *****/
+   if ((NumRow = Usr_GetFirstPrefetchedRow (&Prefetched->Emails,UsrDat->UsrCod)) < Prefetched->Emails.NumRows)
+     {
+      row = Prefetched->Emails.Rows[NumRow];
+      strncpy (UsrDat->Email,row[1],sizeof (UsrDat->Email) - 1);
+      UsrDat->Email[sizeof (UsrDat->Email) - 1] = '\0';
+      UsrDat->EmailConfirmed = (row[2][0] == 'Y');
+     }
+   else
+     {
+      UsrDat->Email[0] = '\0';
+      UsrDat->EmailConfirmed = false;
+     }
+  }
+
+/*****************************************************************************/
+/******************* Free data of users got at once **************************/
+/*****************************************************************************/
+
+void Usr_FreePrefetchedUsrsData (struct Usr_PrefetchedUsrsData *Prefetched)
+  {
+   Usr_FreePrefetchedRows (&Prefetched->Data);
+   Usr_FreePrefetchedRows (&Prefetched->Roles);
+   Usr_FreePrefetchedRows (&Prefetched->IDs);
+   Usr_FreePrefetchedRows (&Prefetched->Nicknames);
+   Usr_FreePrefetchedRows (&Prefetched->Emails);
+  }
+
+static void Usr_FreePrefetchedRows (struct Usr_PrefetchedRows *Prefetched)
+  {
+   if (Prefetched->Rows)
+     {
+      free ((void *) Prefetched->Rows);
+      Prefetched->Rows = NULL;
+     }
+   DB_FreeMySQLResult (&Prefetched->mysql_res);
+   Prefetched->NumRows = 0;
   }
 
 /*****************************************************************************/
@@ -1813,62 +2082,55 @@ void Usr_WriteFormLogin (void)
 
 void Usr_WelcomeUsr (void)
   {
-   extern const unsigned Txt_Current_CGI_SWAD_Language;
    extern const char *Txt_Happy_birthday;
    extern const char *Txt_Welcome_X_and_happy_birthday[Usr_NUM_SEXS];
    extern const char *Txt_Welcome_X[Usr_NUM_SEXS];
    extern const char *Txt_Welcome[Usr_NUM_SEXS];
-   extern const char *Txt_Switching_to_LANGUAGE[1+Txt_NUM_LANGUAGES];
    bool CongratulateMyBirthday;
 
    if (Gbl.Usrs.Me.Logged)
      {
-      if (Gbl.Usrs.Me.UsrDat.Prefs.Language == Txt_Current_CGI_SWAD_Language)
-        {
-	 fprintf (Gbl.F.Out,"<div class=\"CENTER_MIDDLE\""
-	                    " style=\"margin:12px;\">");
+      fprintf (Gbl.F.Out,"<div class=\"CENTER_MIDDLE\""
+	                 " style=\"margin:12px;\">");
 
-         /***** Welcome to a user *****/
-         if (Gbl.Usrs.Me.UsrDat.FirstName[0])
-           {
-            CongratulateMyBirthday = false;
-            if (Gbl.Usrs.Me.UsrDat.Birthday.Day   == Gbl.Now.Date.Day &&
-                Gbl.Usrs.Me.UsrDat.Birthday.Month == Gbl.Now.Date.Month)
-               if ((CongratulateMyBirthday = Usr_CheckIfMyBirthdayHasNotBeenCongratulated ()))
-                 {
-                  Usr_InsertMyBirthday ();
-                  fprintf (Gbl.F.Out,"<img src=\"%s/%s/cake128x128.gif\""
-                	             " alt=\"%s\" title=\"%s\""
-                                     " class=\"ICON160x160\" />",
-                           Gbl.Prefs.PathIconSet,Cfg_ICON_128x128,
-                           Txt_Happy_birthday,
-                           Txt_Happy_birthday);
-                  sprintf (Gbl.Message,Txt_Welcome_X_and_happy_birthday[Gbl.Usrs.Me.UsrDat.Sex],
-                           Gbl.Usrs.Me.UsrDat.FirstName);
-                 }
-            if (!CongratulateMyBirthday)
-               sprintf (Gbl.Message,Txt_Welcome_X[Gbl.Usrs.Me.UsrDat.Sex],
+      /***** Welcome to a user *****/
+      if (Gbl.Usrs.Me.UsrDat.FirstName[0])
+        {
+         CongratulateMyBirthday = false;
+         if (Gbl.Usrs.Me.UsrDat.Birthday.Day   == Gbl.Now.Date.Day &&
+             Gbl.Usrs.Me.UsrDat.Birthday.Month == Gbl.Now.Date.Month)
+            if ((CongratulateMyBirthday = Usr_CheckIfMyBirthdayHasNotBeenCongratulated ()))
+              {
+               Usr_InsertMyBirthday ();
+               fprintf (Gbl.F.Out,"<img src=\"%s/%s/cake128x128.gif\""
+                                  " alt=\"%s\" title=\"%s\""
+                                  " class=\"ICON160x160\" />",
+                        Gbl.Prefs.PathIconSet,Cfg_ICON_128x128,
+                        Txt_Happy_birthday,
+                        Txt_Happy_birthday);
+               sprintf (Gbl.Message,Txt_Welcome_X_and_happy_birthday[Gbl.Usrs.Me.UsrDat.Sex],
                         Gbl.Usrs.Me.UsrDat.FirstName);
-            Lay_ShowAlert (Lay_INFO,Gbl.Message);
-           }
-         else
-            Lay_ShowAlert (Lay_INFO,Txt_Welcome[Gbl.Usrs.Me.UsrDat.Sex]);
+              }
+         if (!CongratulateMyBirthday)
+            sprintf (Gbl.Message,Txt_Welcome_X[Gbl.Usrs.Me.UsrDat.Sex],
+                     Gbl.Usrs.Me.UsrDat.FirstName);
+         Lay_ShowAlert (Lay_INFO,Gbl.Message);
+        }
+      else
+         Lay_ShowAlert (Lay_INFO,Txt_Welcome[Gbl.Usrs.Me.UsrDat.Sex]);
 
-         /***** Warning to confirm my e-mail address *****/
-         if (Gbl.Usrs.Me.UsrDat.Email[0] &&
-             !Gbl.Usrs.Me.UsrDat.EmailConfirmed)
-            Mai_PutButtonToCheckEmailAddress ();
+      /***** Warning to confirm my e-mail address *****/
+      if (Gbl.Usrs.Me.UsrDat.Email[0] &&
+          !Gbl.Usrs.Me.UsrDat.EmailConfirmed)
+         Mai_PutButtonToCheckEmailAddress ();
 
-	 /***** Show help to enroll me *****/
-	 Hlp_ShowHelpWhatWouldYouLikeToDo ();
+      /***** Show help to enroll me *****/
+      Hlp_ShowHelpWhatWouldYouLikeToDo ();
 
-	 fprintf (Gbl.F.Out,"</div>");
+      fprintf (Gbl.F.Out,"</div>");
 
-         /***** Show the global announcements I have not seen *****/
-         Ann_ShowMyAnnouncementsNotMarkedAsSeen ();
-        }
-      else        // The current language is not my preferred language ==> change automatically to my language
-         Lay_ShowAlert (Lay_INFO,Txt_Switching_to_LANGUAGE[Gbl.Usrs.Me.UsrDat.Prefs.Language]);
+      /***** Show the global announcements I have not seen *****/
+      Ann_ShowMyAnnouncementsNotMarkedAsSeen ();
      }
   }
 
@@ -2542,6 +2804,8 @@ static void Usr_SetUsrRoleAndPrefs (void)
       Pre_UpdateMyLanguageToCurrentLanguage ();	// Update my language in database
 
    /***** Set preferences from my preferences *****/
+   Gbl.Prefs.Language       = Gbl.Usrs.Me.UsrDat.Prefs.Language;
+   Pre_SetLanguageOfTexts (Gbl.Prefs.Language);	// Show texts in my language
    Gbl.Prefs.FirstDayOfWeek = Gbl.Usrs.Me.UsrDat.Prefs.FirstDayOfWeek;
    Gbl.Prefs.Menu           = Gbl.Usrs.Me.UsrDat.Prefs.Menu;
    Gbl.Prefs.SideCols       = Gbl.Usrs.Me.UsrDat.Prefs.SideCols;
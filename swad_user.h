@@ -201,6 +201,22 @@ struct ListUsrCods
    unsigned NumUsrs;	// Number of users in the list
   };
 
+struct Usr_PrefetchedRows
+  {
+   MYSQL_RES *mysql_res;	// Holds the rows until they are freed
+   unsigned NumRows;
+   MYSQL_ROW *Rows;		// Rows ordered by user's code (first column)
+  };
+
+struct Usr_PrefetchedUsrsData	// Data of several users got with a few queries
+  {
+   struct Usr_PrefetchedRows Data;	// Rows of usr_data
+   struct Usr_PrefetchedRows Roles;	// Distinct roles of each user
+   struct Usr_PrefetchedRows IDs;	// IDs of each user
+   struct Usr_PrefetchedRows Nicknames;	// Nicknames of each user, last first
+   struct Usr_PrefetchedRows Emails;	// E-mails of each user, last first
+  };
+
 /*****************************************************************************/
 /****************************** Public prototypes ****************************/
 /*****************************************************************************/
@@ -217,6 +233,11 @@ void Usr_FreeListUsrCods (struct ListUsrCods *ListUsrCods);
 void Usr_GetUsrCodFromEncryptedUsrCod (struct UsrData *UsrDat);
 void Usr_GetEncryptedUsrCodFromUsrCod (struct UsrData *UsrDat);
 void Usr_GetUsrDataFromUsrCod (struct UsrData *UsrDat);
+void Usr_PrefetchAllUsrDataOfUsrs (struct Usr_PrefetchedUsrsData *Prefetched,
+                                   unsigned NumUsrs,const long *LstUsrCods);
+void Usr_GetAllUsrDataFromPrefetched (const struct Usr_PrefetchedUsrsData *Prefetched,
+                                      struct UsrData *UsrDat);
+void Usr_FreePrefetchedUsrsData (struct Usr_PrefetchedUsrsData *Prefetched);
 
 void Usr_BuildFullName (struct UsrData *UsrDat);
 
@@ -109,6 +109,7 @@ cp -f /home/acanas/swad/swad/swad /var/www/cgi-bin/
 #include "swad_notice.h"
 #include "swad_notification.h"
 #include "swad_password.h"
+#include "swad_preference.h"
 #include "swad_search.h"
 #include "swad_user.h"
 #include "swad_web_service.h"
@@ -156,8 +157,15 @@ static const char *Svc_Functions[1+Svc_NUM_FUNCTIONS] =
    "getTrivialQuestion",	// 25
    "findUsers",			// 26
    "removeAttendanceEvent",	// 27
+   "getDirectoryTreeIfChanged",	// 28
   };
 
+/* Cache of directory trees */
+#define Svc_LENGTH_TREE_VERSION		16				// Hexadecimal digits of a 64-bit hash
+#define Svc_HASH_INITIAL_VALUE		14695981039346656037ULL		// FNV-1a offset basis
+#define Svc_HASH_PRIME			1099511628211ULL		// FNV-1a prime
+#define Svc_TIME_TO_REFRESH_CACHE	((time_t) (24UL*60UL*60UL))	// Rebuild cached trees after one day (publishers' names and photos may change)
+
 /* Web service roles (they do not match internal swad-core roles) */
 #define Svc_NUM_ROLES 4
 typedef enum
@@ -228,11 +236,23 @@ static int Svc_SendMessageToUsr (long OriginalMsgCod,long SenderUsrCod,long Repl
 
 static int Svc_GetTstConfig (long CrsCod);
 static int Svc_GetNumTestQuestionsInCrs (long CrsCod);
+static long Svc_GetTimeOfLastChangeInTstQuestions (long CrsCod);
 static int Svc_GetTstTags (long CrsCod,struct swad__getTestsOutput *getTestsOut);
 static int Svc_GetTstQuestions (long CrsCod,long BeginTime,struct swad__getTestsOutput *getTestsOut);
 static int Svc_GetTstAnswers (long CrsCod,long BeginTime,struct swad__getTestsOutput *getTestsOut);
 static int Svc_GetTstQuestionTags (long CrsCod,long BeginTime,struct swad__getTestsOutput *getTestsOut);
 
+static int Svc_CheckParamsAndSetDirectoryTree (char *wsKey,int courseCode,int groupCode,int treeCode);
+static void Svc_ComputeDirectoryTreeVersion (char Version[Svc_LENGTH_TREE_VERSION+1]);
+static void Svc_AddDirToHash (unsigned long long *Hash,const char *Path);
+static void Svc_AddToHash (unsigned long long *Hash,const void *Data,size_t Length);
+static int Svc_GetDirectoryTree (const char Version[Svc_LENGTH_TREE_VERSION+1],char **Tree);
+static void Svc_BuildDirectoryTreeCacheFileName (const char *PathCacheCrs,
+                                                 const char Version[Svc_LENGTH_TREE_VERSION+1],
+                                                 char CacheFileName[PATH_MAX+1]);
+static void Svc_RemoveOldDirectoryTreeCacheFiles (const char *PathCacheCrs,
+                                                  const char *CurrentCacheFileName);
+static bool Svc_ReadXMLFileIntoString (const char *FileName,char **Str);
 static void Svc_ListDir (unsigned Level,const char *Path,const char *PathInTree);
 static bool Svc_WriteRowFileBrowser (unsigned Level,Brw_FileType_t FileType,const char *FileName);
 static void Svc_IndentXMLLine (unsigned Level);
@@ -2667,8 +2687,7 @@ int swad__sendAttendanceUsers (struct soap *soap,
    char LongStr[1+10+1];
    long UsrCod;
    unsigned NumCodsInList;
-   char SubQuery[256];
-   char *Query = NULL;	// Initialized to avoid warning
+   long *LstUsrCods;
 
    /***** Initializations *****/
    Gbl.soap = soap;
@@ -2706,25 +2725,19 @@ int swad__sendAttendanceUsers (struct soap *soap,
 	                          "Request forbidden",
 	                          "Requester must be a teacher");
 
-   if (setOthersAsAbsent)
-     {
-      /* Count number of codes in list */
-      for (Ptr = users, NumCodsInList = 0;
-	   *Ptr;
-	   NumCodsInList++)
-	 /* Find next string in text until comma (leading and trailing spaces are removed) */
-	 Str_GetNextStringUntilComma (&Ptr,LongStr,1+10);
-
-      /* Start query used to mark not present users as absent */
-      if ((Query = (char *) malloc (256 + NumCodsInList * (1+1+10+1))) == NULL)
-	 return soap_receiver_fault (Gbl.soap,
-	                             "Not enough memory",
-	                             "Not enough memory to store list of users");
-      sprintf (Query,"UPDATE att_usr SET Present='N'"
-		     " WHERE AttCod='%ld'",
-	       Att.AttCod);
-     }
+   /***** Count number of codes in list *****/
+   for (Ptr = users, NumCodsInList = 0;
+	*Ptr;
+	NumCodsInList++)
+      /* Find next string in text until comma (leading and trailing spaces are removed) */
+      Str_GetNextStringUntilComma (&Ptr,LongStr,1+10);
 
+   /***** Get list of users who must be marked as present *****/
+   if ((LstUsrCods = (long *) malloc ((NumCodsInList ? NumCodsInList :
+	                                                1) * sizeof (long))) == NULL)
+      return soap_receiver_fault (Gbl.soap,
+				  "Not enough memory",
+				  "Not enough memory to store list of users");
    for (Ptr = users;
 	*Ptr;
 	)
@@ -2738,35 +2751,20 @@ int swad__sendAttendanceUsers (struct soap *soap,
 	    if (Usr_CheckIfUsrBelongsToCrs (UsrCod,
 	                                    Gbl.CurrentCrs.Crs.CrsCod,
 	                                    false))
-	      {
-	       /* Mark user as present */
-	       Att_RegUsrInAttEventNotChangingComments (Att.AttCod,UsrCod);
-
-	       /* Add this user to query used to mark not present users as absent */
-	       if (setOthersAsAbsent)
-		 {
-		  sprintf (SubQuery,sendAttendanceUsersOut->numUsers ? ",'%ld'" :
-								       " AND UsrCod NOT IN ('%ld'",
-			   UsrCod);
-		  strcat (Query,SubQuery);
-		 }
-
-	       sendAttendanceUsersOut->numUsers++;
-	      }
+	       /* Add this user to list */
+	       LstUsrCods[sendAttendanceUsersOut->numUsers++] = UsrCod;
      }
 
-   if (setOthersAsAbsent)
-     {
-      /* Mark not present users as absent in table of users */
-      if (sendAttendanceUsersOut->numUsers)
-        strcat (Query,")");
+   /***** Mark users in list as present *****/
+   Att_RegUsrsInAttEventNotChangingComments (Att.AttCod,
+                                             (unsigned) sendAttendanceUsersOut->numUsers,LstUsrCods);
 
-      DB_QueryUPDATE (Query,"can not set other users as absent");
-      free ((void *) Query);
+   /***** Mark users not in list as absent *****/
+   if (setOthersAsAbsent)
+      Att_SetOtherUsrsAsAbsentInAttEvent (Att.AttCod,
+                                          (unsigned) sendAttendanceUsersOut->numUsers,LstUsrCods);
 
-      /* Clean table att_usr */
-      Att_RemoveUsrsAbsentWithoutCommentsFromAttEvent (Att.AttCod);
-     }
+   free ((void *) LstUsrCods);
 
    sendAttendanceUsersOut->success = 1;
 
@@ -3041,6 +3039,7 @@ static int Svc_GetMyLanguage (void)
         }
    if (Gbl.Prefs.Language == Txt_LANGUAGE_UNKNOWN)	// Language stored in database is unknown
       Gbl.Prefs.Language = Cfg_DEFAULT_LANGUAGE;
+   Pre_SetLanguageOfTexts (Gbl.Prefs.Language);
 
    /***** Free structure that stores the query result *****/
    DB_FreeMySQLResult (&mysql_res);
@@ -3105,6 +3104,10 @@ int swad__markNotificationsAsRead (struct soap *soap,
 	    NumNtfsMarkedAsRead++;
            }
         }
+
+      /***** My number of unseen notifications must be computed again *****/
+      if (NumNtfsMarkedAsRead)
+	 Ntf_RemoveNumUnseenNtfsOfUsr (Gbl.Usrs.Me.UsrDat.UsrCod);
      }
 
    /***** Return notification code *****/
@@ -3365,6 +3368,7 @@ static int Svc_SendMessageToUsr (long OriginalMsgCod,
             (unsigned) (NotifyByEmail ? Ntf_STATUS_BIT_EMAIL :
         	                        0));
    DB_QueryINSERT (Query,"can not create new notification event");
+   Ntf_RemoveNumUnseenNtfsOfUsr (RecipientUsrCod);
 
    /***** If this recipient is the original sender of a message been replied... *****/
    if (RecipientUsrCod == ReplyUsrCod)
@@ -3647,22 +3651,63 @@ int swad__getTests (struct soap *soap,
       if ((ReturnCode = Svc_GetTstTags ((long) courseCode,getTestsOut)) != SOAP_OK)
          return ReturnCode;
 
-      /***** Get questions *****/
-      if ((ReturnCode = Svc_GetTstQuestions ((long) courseCode,beginTime,getTestsOut)) != SOAP_OK)
-         return ReturnCode;
+      /***** Get recent questions, answers and tags for each question,
+             only if any question or tag has changed since begin time *****/
+      // When nothing has changed, the three queries below would return empty results
+      if (Svc_GetTimeOfLastChangeInTstQuestions ((long) courseCode) >= beginTime)
+	{
+	 /***** Get questions *****/
+	 if ((ReturnCode = Svc_GetTstQuestions ((long) courseCode,beginTime,getTestsOut)) != SOAP_OK)
+	    return ReturnCode;
 
-      /***** Get answers *****/
-      if ((ReturnCode = Svc_GetTstAnswers ((long) courseCode,beginTime,getTestsOut)) != SOAP_OK)
-         return ReturnCode;
+	 /***** Get answers *****/
+	 if ((ReturnCode = Svc_GetTstAnswers ((long) courseCode,beginTime,getTestsOut)) != SOAP_OK)
+	    return ReturnCode;
 
-      /***** Get tags for each question *****/
-      if ((ReturnCode = Svc_GetTstQuestionTags ((long) courseCode,beginTime,getTestsOut)) != SOAP_OK)
-         return ReturnCode;
+	 /***** Get tags for each question *****/
+	 if ((ReturnCode = Svc_GetTstQuestionTags ((long) courseCode,beginTime,getTestsOut)) != SOAP_OK)
+	    return ReturnCode;
+	}
      }
 
    return SOAP_OK;
   }
 
+/*****************************************************************************/
+/********* Get the time of the most recent change in test questions **********/
+/********* or in test tags of a course                               **********/
+/*****************************************************************************/
+// Return UTC time of last change, or 0 if there are no questions nor tags
+
+static long Svc_GetTimeOfLastChangeInTstQuestions (long CrsCod)
+  {
+   char Query[512];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   long LastChange = 0L;
+
+   /***** Get time of last change from database *****/
+   // Both tables have an index on (CrsCod,time), so MAX is immediate
+   sprintf (Query,"SELECT GREATEST("
+                  "COALESCE((SELECT UNIX_TIMESTAMP(MAX(EditTime))"
+                  " FROM tst_questions WHERE CrsCod='%ld'),0),"
+                  "COALESCE((SELECT UNIX_TIMESTAMP(MAX(ChangeTime))"
+                  " FROM tst_tags WHERE CrsCod='%ld'),0))",
+            CrsCod,CrsCod);
+   if (DB_QuerySELECT (Query,&mysql_res,"can not get time of last change in test questions"))
+     {
+      row = mysql_fetch_row (mysql_res);
+      if (row[0])
+         if (sscanf (row[0],"%ld",&LastChange) != 1)
+            LastChange = 0L;
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   return LastChange;
+  }
+
 /*****************************************************************************/
 /**** Get test tags (only not hidden) from database giving a course code *****/
 /*****************************************************************************/
@@ -4220,16 +4265,77 @@ int swad__getDirectoryTree (struct soap *soap,
                             char *wsKey,int courseCode,int groupCode,int treeCode,	// input
                             struct swad__getDirectoryTreeOutput *getDirectoryTreeOut)	// output
   {
-   extern const char *Brw_RootFolderInternalNames[Brw_NUM_TYPES_FILE_BROWSER];
    int ReturnCode;
-   char PathXMLPriv[PATH_MAX+1];
-   char XMLFileName[PATH_MAX+1];
-   unsigned long FileSize;
-   unsigned long NumBytesRead;
+   char Version[Svc_LENGTH_TREE_VERSION+1];
 
    /***** Initializations *****/
    Gbl.soap = soap;
    Gbl.WebService.Function = Svc_getDirectoryTree;
+
+   /***** Check parameters and set file browser *****/
+   if ((ReturnCode = Svc_CheckParamsAndSetDirectoryTree (wsKey,courseCode,groupCode,treeCode)) != SOAP_OK)
+      return ReturnCode;
+
+   /***** Return directory tree *****/
+   Svc_ComputeDirectoryTreeVersion (Version);
+   return Svc_GetDirectoryTree (Version,&getDirectoryTreeOut->tree);
+  }
+
+/*****************************************************************************/
+/******** Get a directory tree in a course or a group only if changed ********/
+/*****************************************************************************/
+// The client sends the version of the tree it already has
+// (empty string if it has none).
+// If the tree has not changed since then, only the version is returned
+
+int swad__getDirectoryTreeIfChanged (struct soap *soap,
+                                     char *wsKey,int courseCode,int groupCode,int treeCode,char *version,	// input
+                                     struct swad__getDirectoryTreeIfChangedOutput *getDirectoryTreeIfChangedOut)	// output
+  {
+   int ReturnCode;
+   char Version[Svc_LENGTH_TREE_VERSION+1];
+
+   /***** Initializations *****/
+   Gbl.soap = soap;
+   Gbl.WebService.Function = Svc_getDirectoryTreeIfChanged;
+
+   /***** Check parameters and set file browser *****/
+   if ((ReturnCode = Svc_CheckParamsAndSetDirectoryTree (wsKey,courseCode,groupCode,treeCode)) != SOAP_OK)
+      return ReturnCode;
+
+   /***** Compute current version of the tree *****/
+   Svc_ComputeDirectoryTreeVersion (Version);
+
+   if (version && !strcmp (version,Version))	// Client already has the current version
+     {
+      getDirectoryTreeIfChangedOut->changed = 0;
+      getDirectoryTreeIfChangedOut->tree = (char *) soap_malloc (Gbl.soap,1);
+      getDirectoryTreeIfChangedOut->tree[0] = '\0';
+     }
+   else
+     {
+      getDirectoryTreeIfChangedOut->changed = 1;
+      if ((ReturnCode = Svc_GetDirectoryTree (Version,&getDirectoryTreeIfChangedOut->tree)) != SOAP_OK)
+	 return ReturnCode;
+     }
+
+   /***** Return version of the tree *****/
+   getDirectoryTreeIfChangedOut->version = (char *) soap_malloc (Gbl.soap,Svc_LENGTH_TREE_VERSION+1);
+   strcpy (getDirectoryTreeIfChangedOut->version,Version);
+
+   return SOAP_OK;
+  }
+
+/*****************************************************************************/
+/**** Check parameters of a request of directory tree and set file browser ***/
+/*****************************************************************************/
+
+static int Svc_CheckParamsAndSetDirectoryTree (char *wsKey,int courseCode,int groupCode,int treeCode)
+  {
+   extern const char *Brw_RootFolderInternalNames[Brw_NUM_TYPES_FILE_BROWSER];
+   int ReturnCode;
+
+   /***** Initializations *****/
    Gbl.CurrentCrs.Crs.CrsCod = (long) courseCode;
    Gbl.CurrentCrs.Grps.GrpCod = (long) groupCode;
 
@@ -4272,8 +4378,7 @@ int swad__getDirectoryTree (struct soap *soap,
 	                        "Bad tree code",
 	                        "Tree code must be 1 (documents), 2 (shared files) or 3 (marks)");
 
-   /***** Return directory tree *****/
-   /* Get directory tree into XML file */
+   /***** Set file browser *****/
    if (courseCode > 0)
      {
       if (groupCode > 0)
@@ -4319,6 +4424,141 @@ int swad__getDirectoryTree (struct soap *soap,
    Brw_InitializeFileBrowser ();
    Brw_SetFullPathInTree (Brw_RootFolderInternalNames[Gbl.FileBrowser.Type],".");
 
+   return SOAP_OK;
+  }
+
+/*****************************************************************************/
+/************* Compute the version of the current directory tree *************/
+/*****************************************************************************/
+// The version is a hash of the names, sizes and dates of files and folders
+// and of the rows of the table of files for the current file browser,
+// so it changes when anything included in the XML tree changes
+
+static void Svc_ComputeDirectoryTreeVersion (char Version[Svc_LENGTH_TREE_VERSION+1])
+  {
+   extern const Brw_FileBrowser_t Brw_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+   char Query[512];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned long long Hash = Svc_HASH_INITIAL_VALUE;
+
+   /***** Hash files and folders in the database *****/
+   sprintf (Query,"SELECT COUNT(*),"
+                  "COALESCE(BIT_XOR(CRC32(CONCAT_WS('/',FilCod,PublisherUsrCod,"
+                  "FileType,Hidden,License,Path))),0)"
+                  " FROM files"
+                  " WHERE FileBrowser='%u' AND Cod='%ld' AND ZoneUsrCod='-1'",
+            (unsigned) Brw_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+            Brw_GetCodForFiles ());
+   if (DB_QuerySELECT (Query,&mysql_res,"can not get version of files"))
+     {
+      row = mysql_fetch_row (mysql_res);
+      Svc_AddToHash (&Hash,row[0],strlen (row[0]));
+      Svc_AddToHash (&Hash,row[1],strlen (row[1]));
+     }
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Hash files and folders in the file system *****/
+   Svc_AddDirToHash (&Hash,Gbl.FileBrowser.Priv.PathRootFolder);
+
+   /***** Version is the hash in hexadecimal *****/
+   sprintf (Version,"%016llx",Hash);
+  }
+
+/*****************************************************************************/
+/********* Add names, sizes and dates of a directory tree to a hash **********/
+/*****************************************************************************/
+
+static void Svc_AddDirToHash (unsigned long long *Hash,const char *Path)
+  {
+   struct dirent **FileList;
+   int NumFile;
+   int NumFiles;
+   char PathFileRel[PATH_MAX+1];
+   struct stat FileStatus;
+
+   /***** Scan directory *****/
+   if ((NumFiles = scandir (Path,&FileList,NULL,alphasort)) >= 0)	// No error
+     {
+      for (NumFile = 0;
+	   NumFile < NumFiles;
+	   NumFile++)
+	{
+	 if (strcmp (FileList[NumFile]->d_name,".") &&
+	     strcmp (FileList[NumFile]->d_name,".."))	// Skip directories "." and ".."
+	   {
+	    sprintf (PathFileRel,"%s/%s",Path,FileList[NumFile]->d_name);
+	    lstat (PathFileRel,&FileStatus);
+
+	    Svc_AddToHash (Hash,FileList[NumFile]->d_name,strlen (FileList[NumFile]->d_name));
+	    if (S_ISDIR (FileStatus.st_mode))	// It's a directory
+	      {
+	       Svc_AddToHash (Hash,"/",1);
+	       Svc_AddDirToHash (Hash,PathFileRel);
+	       Svc_AddToHash (Hash,"..",2);
+	      }
+	    else if (S_ISREG (FileStatus.st_mode))	// It's a regular file
+	      {
+	       Svc_AddToHash (Hash,&FileStatus.st_size ,sizeof (FileStatus.st_size ));
+	       Svc_AddToHash (Hash,&FileStatus.st_mtime,sizeof (FileStatus.st_mtime));
+	      }
+	   }
+	 free ((void *) FileList[NumFile]);
+	}
+      free ((void *) FileList);
+     }
+  }
+
+/*****************************************************************************/
+/**************** Add some bytes to a FNV-1a hash of 64 bits *****************/
+/*****************************************************************************/
+
+static void Svc_AddToHash (unsigned long long *Hash,const void *Data,size_t Length)
+  {
+   const unsigned char *Ptr = (const unsigned char *) Data;
+
+   for ( ;
+	Length;
+	Length--, Ptr++)
+     {
+      *Hash ^= (unsigned long long) *Ptr;
+      *Hash *= Svc_HASH_PRIME;
+     }
+  }
+
+/*****************************************************************************/
+/************** Get a directory tree from cache or build it ******************/
+/*****************************************************************************/
+// The tree is stored in cache with the version computed before building it.
+// If building it adds missing files to database, the version changes
+// and the tree will be built again in the next request
+
+static int Svc_GetDirectoryTree (const char Version[Svc_LENGTH_TREE_VERSION+1],char **Tree)
+  {
+   extern const char *Brw_RootFolderInternalNames[Brw_NUM_TYPES_FILE_BROWSER];
+   char PathCacheCrs[PATH_MAX+1];
+   char CacheFileName[PATH_MAX+1];
+   char PathXMLPriv[PATH_MAX+1];
+   char XMLFileName[PATH_MAX+1];
+   struct stat FileStatus;
+
+   /***** Check if exists the directory for the cache of this course. If not exists, create it *****/
+   sprintf (PathCacheCrs,"%s/%s",Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_WS_CACHE);
+   Fil_CreateDirIfNotExists (PathCacheCrs);
+   sprintf (PathCacheCrs,"%s/%s/%ld",
+            Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_WS_CACHE,Gbl.CurrentCrs.Crs.CrsCod);
+   Fil_CreateDirIfNotExists (PathCacheCrs);
+
+   /***** Get tree from cache if it exists and it is recent *****/
+   // The file may be removed by a concurrent request
+   // between lstat and open, so a failed read is a cache miss
+   Svc_BuildDirectoryTreeCacheFileName (PathCacheCrs,Version,CacheFileName);
+   if (lstat (CacheFileName,&FileStatus) == 0)
+      if (FileStatus.st_mtime >= Gbl.StartExecutionTimeUTC - Svc_TIME_TO_REFRESH_CACHE)
+	 if (Svc_ReadXMLFileIntoString (CacheFileName,Tree))
+	    return SOAP_OK;
+
+   /***** Cache miss: build tree into a temporary XML file *****/
    /* Check if exists the directory for HTML output. If not exists, create it */
    sprintf (PathXMLPriv,"%s/%s",Cfg_PATH_SWAD_PRIVATE,Cfg_FOLDER_OUT);
    Fil_CreateDirIfNotExists (PathXMLPriv);
@@ -4327,8 +4567,8 @@ int swad__getDirectoryTree (struct soap *soap,
    sprintf (XMLFileName,"%s/%s.xml",
             PathXMLPriv,Gbl.UniqueNameEncrypted);
 
-   /* Open file for writing and reading */
-   if ((Gbl.F.XML = fopen (XMLFileName,"w+t")) == NULL)
+   /* Open file for writing */
+   if ((Gbl.F.XML = fopen (XMLFileName,"wt")) == NULL)
       return soap_receiver_fault (Gbl.soap,
 	                          "Can not get tree",
 	                          "Can not create temporary XML file");
@@ -4339,24 +4579,112 @@ int swad__getDirectoryTree (struct soap *soap,
                                                   Gbl.FileBrowser.Priv.FullPathInTree)) // If root folder is visible
       Svc_ListDir (1,Gbl.FileBrowser.Priv.PathRootFolder,Brw_RootFolderInternalNames[Gbl.FileBrowser.Type]);
    XML_WriteEndFile (Gbl.F.XML,"tree");
+   Fil_CloseXMLFile ();
 
-   /* Compute file size */
-   // fseek (Gbl.F.XML,0L,SEEK_END);
-   FileSize = (unsigned long) ftell (Gbl.F.XML);
-   fseek (Gbl.F.XML,0L,SEEK_SET);
-
-   /* Copy XML content from file to memory */
-   getDirectoryTreeOut->tree = (char *) soap_malloc (Gbl.soap,FileSize + 1);
-   NumBytesRead = fread (getDirectoryTreeOut->tree,1,FileSize,Gbl.F.XML);
-   getDirectoryTreeOut->tree[NumBytesRead] = '\0';
+   /***** Read the tree from the temporary file,
+          which can not be removed by other requests *****/
+   if (!Svc_ReadXMLFileIntoString (XMLFileName,Tree))
+     {
+      unlink (XMLFileName);
+      return soap_receiver_fault (Gbl.soap,
+	                          "Can not get tree",
+	                          "Can not open XML file");
+     }
 
-   /* Close and remove XML file */
-   Fil_CloseXMLFile ();
-   unlink (XMLFileName);
+   /***** Store the tree in cache,
+          replacing previous versions *****/
+   if (rename (XMLFileName,CacheFileName))	// Atomic, so concurrent requests always read a complete file
+      unlink (XMLFileName);			// The tree is not cached, but it has been read
+   else
+      Svc_RemoveOldDirectoryTreeCacheFiles (PathCacheCrs,CacheFileName);
 
    return SOAP_OK;
   }
 
+/*****************************************************************************/
+/******** Build the name of the cache file of the current directory tree ****/
+/*****************************************************************************/
+
+static void Svc_BuildDirectoryTreeCacheFileName (const char *PathCacheCrs,
+                                                 const char Version[Svc_LENGTH_TREE_VERSION+1],
+                                                 char CacheFileName[PATH_MAX+1])
+  {
+   // The tree includes texts in the language of the user
+   sprintf (CacheFileName,"%s/tree_%ld_%u_%u_%s.xml",
+            PathCacheCrs,
+            Gbl.CurrentCrs.Grps.GrpCod,(unsigned) Gbl.FileBrowser.Type,
+            (unsigned) Gbl.Prefs.Language,
+            Version);
+  }
+
+/*****************************************************************************/
+/******* Remove the cache files of old versions of current directory tree ****/
+/*****************************************************************************/
+
+static void Svc_RemoveOldDirectoryTreeCacheFiles (const char *PathCacheCrs,
+                                                  const char *CurrentCacheFileName)
+  {
+   struct dirent **FileList;
+   int NumFile;
+   int NumFiles;
+   char Prefix[NAME_MAX+1];
+   size_t LengthPrefix;
+   char Path[PATH_MAX+1];
+
+   sprintf (Prefix,"tree_%ld_%u_%u_",
+            Gbl.CurrentCrs.Grps.GrpCod,(unsigned) Gbl.FileBrowser.Type,
+            (unsigned) Gbl.Prefs.Language);
+   LengthPrefix = strlen (Prefix);
+
+   if ((NumFiles = scandir (PathCacheCrs,&FileList,NULL,NULL)) >= 0)	// No error
+     {
+      for (NumFile = 0;
+	   NumFile < NumFiles;
+	   NumFile++)
+	{
+	 if (!strncmp (FileList[NumFile]->d_name,Prefix,LengthPrefix))
+	   {
+	    sprintf (Path,"%s/%s",PathCacheCrs,FileList[NumFile]->d_name);
+	    if (strcmp (Path,CurrentCacheFileName))
+	       unlink (Path);
+	   }
+	 free ((void *) FileList[NumFile]);
+	}
+      free ((void *) FileList);
+     }
+  }
+
+/*****************************************************************************/
+/************** Copy the content of a XML file to soap memory ****************/
+/*****************************************************************************/
+// Return false if the file can not be opened
+
+static bool Svc_ReadXMLFileIntoString (const char *FileName,char **Str)
+  {
+   FILE *FileXML;
+   unsigned long FileSize;
+   unsigned long NumBytesRead;
+
+   /***** Open file for reading *****/
+   if ((FileXML = fopen (FileName,"rb")) == NULL)
+      return false;
+
+   /***** Compute file size *****/
+   fseek (FileXML,0L,SEEK_END);
+   FileSize = (unsigned long) ftell (FileXML);
+   fseek (FileXML,0L,SEEK_SET);
+
+   /***** Copy XML content from file to memory *****/
+   *Str = (char *) soap_malloc (Gbl.soap,FileSize + 1);
+   NumBytesRead = fread (*Str,1,FileSize,FileXML);
+   (*Str)[NumBytesRead] = '\0';
+
+   /***** Close file *****/
+   fclose (FileXML);
+
+   return true;
+  }
+
 /*****************************************************************************/
 /************************ List a directory recursively ***********************/
 /*****************************************************************************/
@@ -4458,7 +4786,7 @@ static bool Svc_WriteRowFileBrowser (unsigned Level,Brw_FileType_t FileType,cons
 
       Gbl.Usrs.Other.UsrDat.UsrCod = FileMetadata.PublisherUsrCod;
       Usr_ChkUsrCodAndGetAllUsrDataFromUsrCod (&Gbl.Usrs.Other.UsrDat);
-      Pho_BuildLinkToPhoto (&Gbl.Usrs.Me.UsrDat,PhotoURL);
+      Pho_BuildLinkToPhoto (&Gbl.Usrs.Other.UsrDat,PhotoURL);
 
       fprintf (Gbl.F.XML,"<file name=\"%s\">"
 			 "<code>%ld</code>"
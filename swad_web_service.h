@@ -31,7 +31,7 @@
 /***************************** Public constants ******************************/
 /*****************************************************************************/
 
-#define Svc_NUM_FUNCTIONS 27
+#define Svc_NUM_FUNCTIONS 28
 
 /*****************************************************************************/
 /******************************* Public types ********************************/
@@ -68,6 +68,7 @@ typedef enum
    Svc_getTrivialQuestion       = 25,
    Svc_findUsers		= 26,
    Svc_removeAttendanceEvent	= 27,
+   Svc_getDirectoryTreeIfChanged= 28,
   } Svc_Function_t;
 
 /*****************************************************************************/
@@ -44,6 +44,9 @@ extern struct Globals Gbl;
 /***************************** Private constants *****************************/
 /*****************************************************************************/
 
+#define XML_INITIAL_BYTES_ELEMENT	(  4*1024)
+#define XML_MAX_BYTES_ELEMENT		(  4*1024*1024)	// Maximum size of an element read from a file
+
 /*****************************************************************************/
 /******************************* Private types *******************************/
 /*****************************************************************************/
@@ -52,6 +55,8 @@ extern struct Globals Gbl;
 /***************************** Private variables *****************************/
 /*****************************************************************************/
 
+static bool XML_EndOfRootElement;	// End tag of root element already read from file
+
 /*****************************************************************************/
 /***************************** Private prototypes ****************************/
 /*****************************************************************************/
@@ -59,6 +64,15 @@ extern struct Globals Gbl;
 static void XML_GetElement (struct XMLElement *ParentElem);
 static void XML_GetAttributes (struct XMLElement *Elem);
 static void XML_SkipSpaces (void);
+static void XML_AddToContent (struct XMLElement *Elem,
+                              const char *Text,size_t Length,bool IsCDATA);
+static const char *XML_GetEntityOfChar (char Ch);
+
+static void XML_CopyElementFromFile (FILE *FileXML,char **Buffer,size_t *Length,size_t *Size);
+static int XML_CopyCharFromFile (FILE *FileXML,char **Buffer,size_t *Length,size_t *Size);
+static void XML_AddCharToBuffer (char **Buffer,size_t *Length,size_t *Size,int Ch);
+static int XML_SkipSpacesInFile (FILE *FileXML);
+static void XML_SkipUntilEndOfTagInFile (FILE *FileXML,int TypeOfTag);
 
 /*****************************************************************************/
 /****** Write the start of an XML file with author and date of creation ******/
@@ -113,11 +127,9 @@ void XML_GetTree (const char *XMLBuffer,struct XMLElement **XMLRootElem)
 static void XML_GetElement (struct XMLElement *ParentElem)
   {
    struct XMLElement *ChildElem;
-   const char *StartContent;
    const char *Ptr;
    size_t ContentLength;
    size_t EndTagNameLength;
-   size_t TagLength;
 
    /*
    <parent...>  element content  </parent>
@@ -127,8 +139,8 @@ static void XML_GetElement (struct XMLElement *ParentElem)
    /* Skip spaces */
    XML_SkipSpaces ();
 
-   StartContent = Gbl.XMLPtr;
-   ContentLength = strcspn (StartContent,"<");
+   ContentLength = strcspn (Gbl.XMLPtr,"<");
+   XML_AddToContent (ParentElem,Gbl.XMLPtr,ContentLength,false);
    Gbl.XMLPtr += ContentLength;
 
    while (*Gbl.XMLPtr == '<')	// For each child until parent end tag
@@ -169,31 +181,51 @@ static void XML_GetElement (struct XMLElement *ParentElem)
                                             Gbl.XMLPtr
          */
          /* Remove trailing spaces in content */
-         for (Ptr = StartContent + ContentLength - 1;
-              ContentLength;
-              ContentLength--, Ptr--)
-            if (!isspace ((int) *Ptr))
-               break;
-
-         /* Copy content */
-         if (ContentLength)
+         while (ParentElem->ContentLength &&
+                isspace ((int) ParentElem->Content[ParentElem->ContentLength - 1]))
+            ParentElem->Content[--ParentElem->ContentLength] = '\0';
+         if (ParentElem->Content && !ParentElem->ContentLength)
            {
-            if ((ParentElem->Content = malloc (ContentLength+1)) == NULL)
-               Lay_ShowErrorAndExit ("Not enough memory.");
-            strncpy (ParentElem->Content,StartContent,ContentLength);
-            ParentElem->Content[ContentLength] = '\0';
-            ParentElem->ContentLength = ContentLength;
+            free ((void *) ParentElem->Content);
+            ParentElem->Content = NULL;
            }
 
          return;
         }
+      else if (!strncmp (Gbl.XMLPtr,"![CDATA[",8))	// Add <![CDATA[...]]> to content
+        {
+         Gbl.XMLPtr += 8;
+         if ((Ptr = strstr (Gbl.XMLPtr,"]]>")) == NULL)
+            Lay_ShowErrorAndExit ("XML syntax error. Expect ]]&gt; ending CDATA section.");
+         XML_AddToContent (ParentElem,Gbl.XMLPtr,(size_t) (Ptr - Gbl.XMLPtr),true);
+         Gbl.XMLPtr = Ptr + 3;
+
+         /* Add text after CDATA section to content */
+         ContentLength = strcspn (Gbl.XMLPtr,"<");
+         XML_AddToContent (ParentElem,Gbl.XMLPtr,ContentLength,false);
+         Gbl.XMLPtr += ContentLength;
+        }
       else if (*Gbl.XMLPtr == '!' ||
-               *Gbl.XMLPtr == '?')	// Skip <!...> and <?...>
+               *Gbl.XMLPtr == '?')	// Skip <!--...-->, <!...> and <?...>
         {
-         TagLength = strcspn (Gbl.XMLPtr,">");
-         Gbl.XMLPtr += TagLength;
-         if (*Gbl.XMLPtr == '>')
-           Gbl.XMLPtr++;
+         if (!strncmp (Gbl.XMLPtr,"!--",3))
+           {
+            Gbl.XMLPtr += 3;
+            Ptr = strstr (Gbl.XMLPtr,"-->");
+            Gbl.XMLPtr = Ptr ? Ptr + 3 :
+        	               Gbl.XMLPtr + strlen (Gbl.XMLPtr);
+           }
+         else
+           {
+            Gbl.XMLPtr += strcspn (Gbl.XMLPtr,">");
+            if (*Gbl.XMLPtr == '>')
+               Gbl.XMLPtr++;
+           }
+
+         /* Add text after comment to content */
+         ContentLength = strcspn (Gbl.XMLPtr,"<");
+         XML_AddToContent (ParentElem,Gbl.XMLPtr,ContentLength,false);
+         Gbl.XMLPtr += ContentLength;
         }
       else		// New start tag
         {
@@ -383,6 +415,68 @@ static void XML_GetAttributes (struct XMLElement *Elem)
    while (!EndOfStartTag);
   }
 
+/*****************************************************************************/
+/******************** Add text to the content of an element ******************/
+/*****************************************************************************/
+// Text outside CDATA sections is added without changes.
+// Special characters inside CDATA sections are not escaped, so they are
+// changed to entities, as they are written in the rest of the content
+
+static void XML_AddToContent (struct XMLElement *Elem,
+                              const char *Text,size_t Length,bool IsCDATA)
+  {
+   const char *End = Text + Length;
+   const char *Ptr;
+   const char *Entity;
+   size_t NewLength;
+
+   if (!Length)
+      return;
+
+   /***** Compute length of content after adding the text *****/
+   for (Ptr = Text, NewLength = Elem->ContentLength;
+	Ptr < End;
+	Ptr++)
+      NewLength += (IsCDATA && (Entity = XML_GetEntityOfChar (*Ptr))) ? strlen (Entity) :
+	                                                                 1;
+
+   /***** Allocate space for new content *****/
+   if ((Elem->Content = realloc (Elem->Content,NewLength + 1)) == NULL)
+      Lay_ShowErrorAndExit ("Not enough memory.");
+
+   /***** Add text to content *****/
+   for (Ptr = Text;
+	Ptr < End;
+	Ptr++)
+      if (IsCDATA && (Entity = XML_GetEntityOfChar (*Ptr)))
+	{
+	 strcpy (Elem->Content + Elem->ContentLength,Entity);
+	 Elem->ContentLength += strlen (Entity);
+	}
+      else
+	 Elem->Content[Elem->ContentLength++] = *Ptr;
+   Elem->Content[Elem->ContentLength] = '\0';
+  }
+
+/*****************************************************************************/
+/********* Get the entity of a special character, or NULL if none ************/
+/*****************************************************************************/
+
+static const char *XML_GetEntityOfChar (char Ch)
+  {
+   switch (Ch)
+     {
+      case '&':
+	 return "&amp;";
+      case '<':
+	 return "&lt;";
+      case '>':
+	 return "&gt;";
+      default:
+	 return NULL;
+     }
+  }
+
 /*****************************************************************************/
 /****************** Skip spaces while parsing XML buffer *********************/
 /*****************************************************************************/
@@ -393,6 +487,301 @@ static void XML_SkipSpaces (void)
       Gbl.XMLPtr++;
   }
 
+/*****************************************************************************/
+/************ Start reading the children of root element in a file ***********/
+/*****************************************************************************/
+// Elements inside root element are read one by one with XML_GetNextElementFromFile,
+// so memory used does not depend on the size of the file.
+// Return false if root element is not found
+
+bool XML_StartReadingRootElementFromFile (FILE *FileXML,const char *RootTagName)
+  {
+   int Ch;
+   int PrevCh = '\0';
+   const char *Ptr;
+
+   XML_EndOfRootElement = false;
+
+   /***** Skip spaces, <?...> and <!...> before root element *****/
+   for (;;)
+     {
+      Ch = XML_SkipSpacesInFile (FileXML);
+      if (Ch != '<')
+	 return false;
+      Ch = getc (FileXML);
+      if (Ch != '?' && Ch != '!')
+	 break;
+      XML_SkipUntilEndOfTagInFile (FileXML,Ch);
+     }
+
+   /***** Check root tag name *****/
+   for (Ptr = RootTagName;
+	*Ptr;
+	Ptr++, Ch = getc (FileXML))
+      if (Ch != (int) *Ptr)	// XML tags are case sensitive
+	 return false;
+   if (Ch != '>' && Ch != '/' && !isspace (Ch))
+      return false;
+
+   /***** Skip attributes of root element *****/
+   for (;
+	Ch != '>';
+	PrevCh = Ch, Ch = getc (FileXML))
+      if (Ch == EOF)
+	 Lay_ShowErrorAndExit ("XML syntax error. Unexpected end of file.");
+
+   /***** Check if root element is empty: <root/> *****/
+   if (PrevCh == '/')
+      XML_EndOfRootElement = true;
+
+   return true;
+  }
+
+/*****************************************************************************/
+/*************** Get next child of root element from a file ******************/
+/*****************************************************************************/
+// Only one child element is read from file and stored in a tree.
+// The tree must be freed with XML_FreeTree and free.
+// Return false when the end tag of root element is reached
+
+bool XML_GetNextElementFromFile (FILE *FileXML,const char *RootTagName,
+                                 struct XMLElement **XMLRootElem)
+  {
+   char *Buffer = NULL;
+   size_t Length = 0;
+   size_t Size = 0;
+   int Ch;
+   const char *Ptr;
+
+   if (XML_EndOfRootElement)
+      return false;
+
+   /***** Skip content of root element and <?...> and <!...> until a tag *****/
+   for (;;)
+     {
+      while ((Ch = getc (FileXML)) != '<')
+	 if (Ch == EOF)
+	   {
+	    sprintf (Gbl.Message,"XML syntax error. Expect end tag &lt;/%s&gt;.",RootTagName);
+	    Lay_ShowErrorAndExit (Gbl.Message);
+	   }
+      Ch = getc (FileXML);
+      if (Ch == '/')	// Root end tag
+	{
+	 for (Ptr = RootTagName;
+	      *Ptr;
+	      Ptr++)
+	    if (getc (FileXML) != (int) *Ptr)	// XML tags are case sensitive
+	       break;
+	 if (*Ptr || getc (FileXML) != '>')
+	   {
+	    sprintf (Gbl.Message,"XML syntax error. Expect end tag &lt;/%s&gt;.",RootTagName);
+	    Lay_ShowErrorAndExit (Gbl.Message);
+	   }
+	 XML_EndOfRootElement = true;
+	 return false;
+	}
+      if (Ch != '?' && Ch != '!')	// Start tag of child element
+	 break;
+      XML_SkipUntilEndOfTagInFile (FileXML,Ch);
+     }
+
+   /***** Copy child element from file to buffer *****/
+   XML_AddCharToBuffer (&Buffer,&Length,&Size,'<');
+   XML_AddCharToBuffer (&Buffer,&Length,&Size,Ch);
+   XML_CopyElementFromFile (FileXML,&Buffer,&Length,&Size);
+   XML_AddCharToBuffer (&Buffer,&Length,&Size,'\0');
+
+   /***** Get tree of child element *****/
+   XML_GetTree (Buffer,XMLRootElem);
+   free ((void *) Buffer);
+
+   return true;
+  }
+
+/*****************************************************************************/
+/*********** Copy an element from a file to a buffer, until its end **********/
+/*****************************************************************************/
+/*
+<parent><child attribute1="value" attribute2="value">...</child>...</parent>
+          ^                                                     ^
+          |                                                     |
+     FileXML (start)                                       FileXML (end)
+*/
+
+static void XML_CopyElementFromFile (FILE *FileXML,char **Buffer,size_t *Length,size_t *Size)
+  {
+   enum
+     {
+      XML_START_TAG,	// Inside <...>
+      XML_END_TAG,	// Inside </...>
+      XML_OTHER_TAG,	// Inside <!...> or <?...>
+      XML_COMMENT,	// Inside <!--...-->
+      XML_CDATA,	// Inside <![CDATA[...]]>
+      XML_CONTENT,	// Between tags
+     } Where = XML_START_TAG;
+   unsigned Level = 1;
+   int Ch;
+   int PrevCh = '\0';
+   int PrevPrevCh = '\0';
+   int Quote = '\0';
+
+   while (Level)
+     {
+      Ch = XML_CopyCharFromFile (FileXML,Buffer,Length,Size);
+
+      switch (Where)
+	{
+	 case XML_START_TAG:
+	    if (Quote)				// Inside the content of an attribute
+	      {
+	       if (Ch == Quote)
+		  Quote = '\0';
+	      }
+	    else if (Ch == '\"' || Ch == '\'')	// Start of the content of an attribute
+	       Quote = Ch;
+	    else if (Ch == '>')
+	      {
+	       if (PrevCh == '/')		// Unary tag
+		  Level--;
+	       Where = XML_CONTENT;
+	      }
+	    break;
+	 case XML_END_TAG:
+	    if (Ch == '>')
+	      {
+	       Level--;
+	       Where = XML_CONTENT;
+	      }
+	    break;
+	 case XML_OTHER_TAG:
+	    if (Ch == '>')
+	       Where = XML_CONTENT;
+	    break;
+	 case XML_COMMENT:
+	    if (Ch == '>' && PrevCh == '-' && PrevPrevCh == '-')
+	       Where = XML_CONTENT;
+	    break;
+	 case XML_CDATA:
+	    if (Ch == '>' && PrevCh == ']' && PrevPrevCh == ']')
+	       Where = XML_CONTENT;
+	    break;
+	 case XML_CONTENT:
+	    if (Ch == '<')
+	      {
+	       Ch = XML_CopyCharFromFile (FileXML,Buffer,Length,Size);
+	       if (Ch == '/')
+		  Where = XML_END_TAG;
+	       else if (Ch == '?')
+		  Where = XML_OTHER_TAG;
+	       else if (Ch == '!')
+		 {
+		  Ch = XML_CopyCharFromFile (FileXML,Buffer,Length,Size);
+		  if (Ch == '-')		// <!--...-->
+		     Where = XML_COMMENT;
+		  else if (Ch == '[')		// <![CDATA[...]]>
+		     Where = XML_CDATA;
+		  else if (Ch == '>')		// <!>
+		     Where = XML_CONTENT;
+		  else
+		     Where = XML_OTHER_TAG;
+		  Ch = '\0';	// Characters of start of tag can not end it
+		 }
+	       else
+		 {
+		  Level++;
+		  Where = XML_START_TAG;
+		 }
+	      }
+	    break;
+	}
+      PrevPrevCh = PrevCh;
+      PrevCh = Ch;
+     }
+  }
+
+/*****************************************************************************/
+/************ Read a character from a file and add it to a buffer ************/
+/*****************************************************************************/
+
+static int XML_CopyCharFromFile (FILE *FileXML,char **Buffer,size_t *Length,size_t *Size)
+  {
+   int Ch;
+
+   if ((Ch = getc (FileXML)) == EOF)
+      Lay_ShowErrorAndExit ("XML syntax error. Unexpected end of file.");
+   XML_AddCharToBuffer (Buffer,Length,Size,Ch);
+   return Ch;
+  }
+
+/*****************************************************************************/
+/***************** Add a character to a buffer of an element *****************/
+/*****************************************************************************/
+
+static void XML_AddCharToBuffer (char **Buffer,size_t *Length,size_t *Size,int Ch)
+  {
+   if (*Length == *Size)	// Buffer is full
+     {
+      if (*Size == 0)
+	 *Size = XML_INITIAL_BYTES_ELEMENT;
+      else if (*Size < XML_MAX_BYTES_ELEMENT)
+	 *Size *= 2;
+      else
+	 Lay_ShowErrorAndExit ("XML element too large.");
+      if ((*Buffer = realloc (*Buffer,*Size)) == NULL)
+	 Lay_ShowErrorAndExit ("Not enough memory for XML element.");
+     }
+   (*Buffer)[(*Length)++] = (char) Ch;
+  }
+
+/*****************************************************************************/
+/*************** Skip spaces while reading XML from a file *******************/
+/*****************************************************************************/
+// Return the first character which is not a space
+
+static int XML_SkipSpacesInFile (FILE *FileXML)
+  {
+   int Ch;
+
+   while (isspace (Ch = getc (FileXML)));
+   return Ch;
+  }
+
+/*****************************************************************************/
+/********* Skip until the end of <?...> or <!...> in an XML file *************/
+/*****************************************************************************/
+// TypeOfTag is the character after '<', already read from file ('?' or '!').
+// Comments <!--...--> and <![CDATA[...]]> end with "-->" and "]]>",
+// so they may contain '>'
+
+static void XML_SkipUntilEndOfTagInFile (FILE *FileXML,int TypeOfTag)
+  {
+   int Ch;
+   int PrevCh = '\0';
+   int PrevPrevCh = '\0';
+   int CharBeforeEnd = '\0';	// '-' in comments, ']' in CDATA
+
+   if ((Ch = getc (FileXML)) == EOF)
+      Lay_ShowErrorAndExit ("XML syntax error. Unexpected end of file.");
+   if (TypeOfTag == '!' &&
+       (Ch == '-' ||	// <!--...-->
+        Ch == '['))	// <![CDATA[...]]>
+     {
+      CharBeforeEnd = (Ch == '-') ? '-' :
+	                            ']';
+      Ch = '\0';	// Characters of start of tag can not end it
+     }
+
+   while (Ch != '>' ||
+	  (CharBeforeEnd && (PrevCh != CharBeforeEnd || PrevPrevCh != CharBeforeEnd)))
+     {
+      PrevPrevCh = PrevCh;
+      PrevCh = Ch;
+      if ((Ch = getc (FileXML)) == EOF)
+	 Lay_ShowErrorAndExit ("XML syntax error. Unexpected end of file.");
+     }
+  }
+
 /*****************************************************************************/
 /**************************** Print an XML element ***************************/
 /*****************************************************************************/
@@ -498,6 +887,7 @@ void XML_FreeTree (struct XMLElement *ParentElem)
      {
       NextElemBrother = ChildElem->NextBrother;
       XML_FreeTree (ChildElem);
+      free ((void *) ChildElem);
       ChildElem = NextElemBrother;
      }
 
@@ -63,6 +63,9 @@ void XML_WriteStartFile (FILE *FileTgt,const char *Type,bool Credits);
 void XML_WriteEndFile (FILE *FileTgt,const char *Type);
 
 void XML_GetTree (const char *XMLBuffer,struct XMLElement **XMLRootElem);
+bool XML_StartReadingRootElementFromFile (FILE *FileXML,const char *RootTagName);
+bool XML_GetNextElementFromFile (FILE *FileXML,const char *RootTagName,
+                                 struct XMLElement **XMLRootElem);
 void XML_PrintTree (struct XMLElement *ParentElem);
 bool XML_GetAttributteYesNoFromXMLTree (struct XMLAttribute *Attribute);
 void XML_FreeTree (struct XMLElement *ParentElem);